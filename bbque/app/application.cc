@@ -90,13 +90,14 @@ Application::Application(std::string const & _name,
 	schedule.state        = NEW;
 	schedule.preSyncState = NEW;
 	schedule.syncState    = SYNC_NONE;
+	UpdateSchedulingSnapshot();
 	logger->Info("Built new EXC [%s]", StrId());
 }
 
 Application::~Application() {
 	logger->Debug("Destroying EXC [%s]", StrId());
 	awms.recipe_vect.clear();
-	awms.enabled_list.clear();
+	awms.index.Clear();
 	rsrc_constraints.clear();
 #ifdef CONFIG_BBQUE_TG_PROG_MODEL
 	if (tg_sem != nullptr)
@@ -121,28 +122,33 @@ void Application::InitWorkingModes(AppPtr_t & papp) {
 	awms.upp_id   = awms.max_id;
 	awms.curr_inv = false;
 	awms.enabled_bset.set();
+	awms.out_of_bounds.reset();
 	logger->Debug("InitWorkingModes: max ID = %d", awms.max_id);
 
-	// Init AWM lists
+	// Init AWM vector
 	for (int i = 0; i <= awms.max_id; ++i) {
 		// Copy the working mode and set the owner (current Application)
 		AwmPtr_t app_awm = std::make_shared<WorkingMode>(*recipe_awms[i]);
 		app_awm->SetOwner(papp);
 		awms.recipe_vect[app_awm->Id()] = app_awm;
+	}
 
+	// Build the index (order by "value" and dominance relations)
+	awms.index.Init(AwmPtrVect_t(
+		awms.recipe_vect.begin(), awms.recipe_vect.begin() + awms.max_id + 1));
+	for (int i = 0; i <= awms.max_id; ++i) {
 		// Do not insert the hidden AWMs into the enabled list
-		if (app_awm->Hidden()) {
-			logger->Debug("InitWorkingModes: skipping hidden AWM %d", app_awm->Id());
+		if (awms.recipe_vect[i]->Hidden()) {
+			logger->Debug("InitWorkingModes: skipping hidden AWM %d", i);
 			continue;
 		}
 
 		// Valid (not hidden) AWM: Insert it into the list
-		awms.enabled_list.push_back(app_awm);
+		awms.index.SetEnabled(i, true);
 	}
-
-	// Sort the enabled list by "value"
-	awms.enabled_list.sort(AwmValueLesser);
-	logger->Info("InitWorkingModes: %d enabled AWMs", awms.enabled_list.size());
+	awms.index.Commit();
+	logger->Info("InitWorkingModes: %d enabled AWMs (%d Pareto optimal)",
+		awms.index.Enabled().size(), awms.index.Pareto().size());
 }
 
 void Application::InitResourceConstraints() {
@@ -178,7 +184,7 @@ Application::SetRecipe(RecipePtr_t & _recipe, AppPtr_t & papp) {
 
 	// Set working modes
 	InitWorkingModes(papp);
-	logger->Info("SetRecipe: %d working modes", awms.enabled_list.size());
+	logger->Info("SetRecipe: %d working modes", awms.index.Enabled().size());
 
 	// Set (optional) resource constraints
 	InitResourceConstraints();
@@ -192,12 +198,9 @@ Application::SetRecipe(RecipePtr_t & _recipe, AppPtr_t & papp) {
 }
 
 AwmPtr_t Application::GetWorkingMode(uint8_t wmId) {
-	for (auto & awm: awms.enabled_list) {
-		if (awm->Id() == wmId)
-			return awm;
-	}
-
-	return nullptr;
+	if (!awms.index.IsEnabled(wmId))
+		return nullptr;
+	return awms.recipe_vect[wmId];
 }
 
 
@@ -208,6 +211,7 @@ AwmPtr_t Application::GetWorkingMode(uint8_t wmId) {
 void Application::SetNextAWM(AwmPtr_t awm) {
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	schedule.next_awm = awm;
+	UpdateSchedulingSnapshot();
 	awms.curr_inv = false;
 	logger->Debug("SetNewAWM: [%s] next_awm = %d",
 		StrId(), schedule.next_awm->Id());
@@ -247,7 +251,7 @@ Application::ExitCode_t Application::SyncCommit() {
 				logger->Error("SyncCommit: status transition failed");
 				return ret;
 			}
-			logger->Debug("Scheduling count: %" PRIu64 "", schedule.count);
+			logger->Debug("Scheduling count: %" PRIu64 "", schedule.count.load());
 			break;
 
 		case BLOCKED:
@@ -258,6 +262,7 @@ Application::ExitCode_t Application::SyncCommit() {
 			SetState(FINISHED);
 			schedule.awm.reset();
 			schedule.next_awm.reset();
+			UpdateSchedulingSnapshot();
 			break;
 
 		default:
@@ -279,6 +284,7 @@ Application::ExitCode_t Application::SyncContinue() {
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	// Reset next AWM (only current must be set)
 	schedule.next_awm.reset();
+	UpdateSchedulingSnapshot();
 	schedule.awm->IncSchedulingCount();
 	return APP_SUCCESS;
 }
@@ -327,7 +333,7 @@ Application::ExitCode_t Application::SetWorkingModeConstraint(
 	logger->Debug("SetConstraint (AWMs): %d total working modes",
 			awms.recipe_vect.size());
 	logger->Debug("SetConstraint (AWMs): %d enabled working modes",
-			awms.enabled_list.size());
+			awms.index.Enabled().size());
 
 	DB(DumpValidAWMs());
 
@@ -485,26 +491,21 @@ void Application::ClearWorkingModeConstraints() {
 	RebuildEnabledWorkingModes();
 
 	logger->Debug("ClearConstraint (AWMs): %d total working modes", awms.recipe_vect.size());
-	logger->Debug("ClearConstraint (AWMs): %d enabled working modes", awms.enabled_list.size());
+	logger->Debug("ClearConstraint (AWMs): %d enabled working modes", awms.index.Enabled().size());
 }
 
 void Application::RebuildEnabledWorkingModes() {
-	// Clear the list
-	awms.enabled_list.clear();
-
-	// Rebuild the enabled working modes list
+	// Update the enabled working modes: only the ones changing state
+	// update the index
 	for (int j = 0; j <= awms.max_id; ++j) {
-		// Skip if the related bit of the map is not set, or one of the
+		// Disable if the related bit of the map is not set, or one of the
 		// resource usage required violates a resource constraint, or
 		// the AWM is hidden according to the current status of the hardware
 		// resources
-		if ((!awms.enabled_bset.test(j))
-				|| (UsageOutOfBounds(awms.recipe_vect[j]))
-				|| awms.recipe_vect[j]->Hidden())
-			continue;
-
-		// Insert the working mode
-		awms.enabled_list.push_back(awms.recipe_vect[j]);
+		awms.index.SetEnabled(j,
+			awms.enabled_bset.test(j)
+			&& !awms.out_of_bounds.test(j)
+			&& !awms.recipe_vect[j]->Hidden());
 	}
 
 	// Check current AWM and re-order the list
@@ -521,8 +522,8 @@ void Application::FinalizeEnabledWorkingModes() {
 		awms.curr_inv = true;
 	}
 
-	// Sort by working mode "value
-	awms.enabled_list.sort(AwmValueLesser);
+	// Refresh the list (sorted by "value") and the Pareto frontier
+	awms.index.Commit();
 }
 
 /************************** Resource Constraints ****************************/
@@ -548,11 +549,13 @@ bool Application::UsageOutOfBounds(AwmPtr_t & awm) {
 }
 
 void Application::UpdateEnabledWorkingModes() {
-	// Remove AWMs violating resources constraints
-	awms.enabled_list.remove_if([this](AwmPtr_t & awm){ return UsageOutOfBounds(awm); });
-	// Check current AWM and re-order the list
-	FinalizeEnabledWorkingModes();
-	logger->Debug("UpdateEnabledWorkingModes:", awms.enabled_list.size());
+	// Mark the AWMs violating resources constraints
+	for (int j = 0; j <= awms.max_id; ++j)
+		awms.out_of_bounds.set(j, UsageOutOfBounds(awms.recipe_vect[j]));
+	// Enable/disable the AWMs accordingly
+	RebuildEnabledWorkingModes();
+	logger->Debug("UpdateEnabledWorkingModes: %d enabled working modes",
+		awms.index.Enabled().size());
 }
 
 Application::ExitCode_t Application::SetResourceConstraint(
@@ -640,7 +643,7 @@ uint64_t Application::GetResourceRequestStat(
 	uint64_t max_val  = 0;
 	uint64_t total = 0;
 
-	for (auto const & awm: awms.enabled_list) {                 // AWMs (enabled)
+	for (auto const & awm: awms.index.Enabled()) {             // AWMs (enabled)
 		for (auto const & r_entry: awm->ResourceRequests()) {      // Resources
 			ResourcePathPtr_t const & curr_path(r_entry.first);
 			uint64_t curr_amount = (r_entry.second)->GetAmount();
@@ -662,7 +665,7 @@ uint64_t Application::GetResourceRequestStat(
 	case RU_STAT_MIN:
 		return min_val;
 	case RU_STAT_AVG:
-		return total / awms.enabled_list.size();
+		return total / awms.index.Enabled().size();
 	case RU_STAT_MAX:
 		return max_val;
 	};
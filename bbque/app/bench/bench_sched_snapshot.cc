@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Scheduling state reads: locked getters vs snapshot
+ *
+ * A set of EXCs whose state is changed by W writer threads, one state
+ * change every period, as the synchronization and the application manager
+ * do. R reader threads check the state of all the EXCs, as a policy does
+ * at each scheduling round, with three checks per EXC (Disabled, Active
+ * and Blocking):
+ * - locked: each check takes the scheduling info mutex, as the getters did
+ *   before the snapshot;
+ * - snapshot: a single GetSchedulingSnapshot() per EXC, no lock.
+ *
+ * For each number of readers, the benchmark reports the EXC checks per
+ * second of all the readers.
+ *
+ * Usage: bbque-app-bench-snapshot [writers] [period_us] [duration_ms]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "bbque/app/schedulable.h"
+#include "bbque/resource_accounter.h"
+
+#define NR_EXCS 64
+
+using bbque::app::Schedulable;
+
+namespace bbque {
+
+// The scheduling state is changed without working modes: the accounter,
+// used by Schedulable::Reshuffling() only, is never accessed
+ResourceAccounter & ResourceAccounter::GetInstance() {
+	static std::aligned_storage<sizeof(ResourceAccounter),
+		alignof(ResourceAccounter)>::type unused;
+	return *reinterpret_cast<ResourceAccounter *>(&unused);
+}
+
+bool ResourceAccounter::IsReshuffling(
+		br::ResourceAssignmentMapPtr_t const &,
+		br::ResourceAssignmentMapPtr_t const &) {
+	return false;
+}
+
+} // namespace bbque
+
+/**
+ * An EXC moving between READY and SYNC, with the state checks done either
+ * under the scheduling info mutex or on a snapshot
+ */
+class BenchEXC: public Schedulable {
+
+public:
+
+	BenchEXC() {
+		schedule.state = NEW;
+		schedule.preSyncState = NEW;
+		schedule.syncState = SYNC_NONE;
+		SetState(READY);
+	}
+
+	void Change(uint64_t i) {
+		if (_Synching())
+			SetState(READY);
+		else
+			SetState(SYNC, (SyncState_t)(i % DISABLED));
+	}
+
+	/** The checks of a policy, with a lock each */
+	uint32_t CheckLocked() const {
+		uint32_t checks = 0;
+		{
+			std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
+			checks += _Disabled();
+		}
+		{
+			std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
+			checks += _Active();
+		}
+		{
+			std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
+			checks += _Blocking();
+		}
+		return checks;
+	}
+
+	/** The checks of a policy, on a single snapshot */
+	uint32_t CheckSnapshot() const {
+		auto snap(GetSchedulingSnapshot());
+		return snap.Disabled() + snap.Active() + snap.Blocking();
+	}
+
+};
+
+using Clock = std::chrono::steady_clock;
+
+static double RunCase(std::vector<std::unique_ptr<BenchEXC>> & excs,
+		uint32_t nr_writers, uint32_t nr_readers, uint32_t period_us,
+		uint32_t duration_ms, bool snapshot) {
+	std::atomic<bool> stop(false);
+	std::atomic<uint64_t> nr_checks(0);
+	std::vector<std::thread> threads;
+
+	for (uint32_t w = 0; w < nr_writers; ++w) {
+		threads.emplace_back([&, w]() {
+			uint64_t i = w;
+			while (!stop) {
+				excs[i % excs.size()]->Change(i);
+				i += nr_writers;
+				std::this_thread::sleep_for(
+					std::chrono::microseconds(period_us));
+			}
+		});
+	}
+	for (uint32_t r = 0; r < nr_readers; ++r) {
+		threads.emplace_back([&]() {
+			uint64_t checks = 0;
+			uint64_t result = 0;
+			while (!stop) {
+				for (auto & exc: excs)
+					result += snapshot ?
+						exc->CheckSnapshot() : exc->CheckLocked();
+				checks += excs.size();
+			}
+			// The result is used, not to have the checks optimized out
+			nr_checks += checks + (result == 0);
+		});
+	}
+
+	auto start = Clock::now();
+	std::this_thread::sleep_for(std::chrono::milliseconds(duration_ms));
+	stop = true;
+	for (auto & thr: threads)
+		thr.join();
+	double elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+	return nr_checks / elapsed_s / 1e6;
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t nr_writers  = (argc > 1) ? atoi(argv[1]) : 2;
+	uint32_t period_us   = (argc > 2) ? atoi(argv[2]) : 50;
+	uint32_t duration_ms = (argc > 3) ? atoi(argv[3]) : 500;
+
+	std::vector<std::unique_ptr<BenchEXC>> excs;
+	for (int i = 0; i < NR_EXCS; ++i)
+		excs.emplace_back(new BenchEXC());
+
+	printf("%d EXCs, %u writers, a state change every %u us each\n",
+		NR_EXCS, nr_writers, period_us);
+	printf("%7s %18s %20s\n", "readers", "locked [M EXC/s]",
+		"snapshot [M EXC/s]");
+	for (uint32_t nr_readers: { 1, 2, 4, 8 }) {
+		double locked = RunCase(excs, nr_writers, nr_readers, period_us,
+			duration_ms, false);
+		double snapshot = RunCase(excs, nr_writers, nr_readers, period_us,
+			duration_ms, true);
+		printf("%7u %18.2f %20.2f\n", nr_readers, locked, snapshot);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * Enabled working modes of an application: list rebuild vs index
+ *
+ * Generated recipes of N working modes requesting R resources, and a
+ * sequence of constraint changes, each one enabling a range of working
+ * modes by ID, with a constraint on the amount of CPU. After each change,
+ * the enabled working modes sorted by value are refreshed:
+ * - rebuild: a std::list of the enabled working modes, skipping the ones
+ *   out of the constraint bounds, then sorted, as the Application did;
+ * - index: SetEnabled() of each working mode, with the out of bounds ones
+ *   cached, then WorkingModeIndex::Commit().
+ * Both give the same enabled working modes, in the same order, and the
+ * Pareto frontier of the index matches a brute-force scan.
+ *
+ * Usage: bbque-app-bench-wm-index [rounds]
+ */
+
+#include <bitset>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <utility>
+
+#include "bbque/app/working_mode_index.h"
+#include "recipes.h"
+
+#define NR_CHANGES 64
+#define CPU_UPPER  600
+
+using Clock = std::chrono::steady_clock;
+
+/** The upper bound constraint on the CPU amount */
+static bool OutOfBounds(ba::AwmPtr_t const & awm,
+		br::ResourcePathPtr_t const & cpu_path) {
+	return RequestedAmount(awm, cpu_path->ToString()) > CPU_UPPER;
+}
+
+/** The enabled working modes not dominated by another enabled one */
+static size_t ParetoScan(ba::AwmPtrVect_t const & enabled) {
+	size_t nr_pareto = 0;
+	for (auto const & awm: enabled) {
+		bool dominated = false;
+		for (auto const & other: enabled) {
+			if (other == awm)
+				continue;
+			bool better = (other->Value() > awm->Value());
+			bool worse  = (other->Value() < awm->Value());
+			for (auto const & r_entry: awm->ResourceRequests()) {
+				uint64_t amount = r_entry.second->GetAmount();
+				uint64_t other_amount =
+					RequestedAmount(other, r_entry.first->ToString());
+				better |= (other_amount < amount);
+				worse  |= (other_amount > amount);
+			}
+			dominated |= (better && !worse);
+		}
+		nr_pareto += !dominated;
+	}
+	return nr_pareto;
+}
+
+static double ElapsedUs(Clock::time_point start) {
+	return std::chrono::duration<double, std::micro>(
+		Clock::now() - start).count();
+}
+
+static void RunCase(int nr_awms, std::vector<br::ResourcePathPtr_t> r_paths,
+		uint32_t rounds) {
+	std::mt19937 rng(nr_awms * 7 + r_paths.size());
+	auto awms(GenerateWorkingModes(rng, nr_awms, r_paths));
+
+	std::bitset<MAX_NUM_AWM> out_of_bounds;
+	for (int id = 0; id < nr_awms; ++id)
+		out_of_bounds.set(id, OutOfBounds(awms[id], r_paths[0]));
+
+	// The ranges of working modes enabled by the constraint changes
+	std::vector<std::pair<int, int>> changes;
+	for (int k = 0; k < NR_CHANGES; ++k)
+		changes.emplace_back(rng() % (nr_awms / 4),
+			nr_awms - 1 - rng() % (nr_awms / 4));
+	std::bitset<MAX_NUM_AWM> enabled;
+
+	// Rebuild of the sorted list at each change
+	std::list<ba::AwmPtr_t> awms_list;
+	auto start = Clock::now();
+	for (uint32_t round = 0; round < rounds; ++round) {
+		for (auto const & range: changes) {
+			for (int id = 0; id < nr_awms; ++id)
+				enabled.set(id, (id >= range.first) && (id <= range.second));
+			awms_list.clear();
+			for (int id = 0; id < nr_awms; ++id) {
+				if (!enabled.test(id) || awms[id]->Hidden() ||
+						OutOfBounds(awms[id], r_paths[0]))
+					continue;
+				awms_list.push_back(awms[id]);
+			}
+			awms_list.sort([](ba::AwmPtr_t const & a, ba::AwmPtr_t const & b) {
+				return a->Value() < b->Value();
+			});
+		}
+	}
+	double rebuild_us = ElapsedUs(start);
+
+	// Index update at each change
+	ba::WorkingModeIndex index;
+	start = Clock::now();
+	index.Init(awms);
+	double init_us = ElapsedUs(start);
+	start = Clock::now();
+	for (uint32_t round = 0; round < rounds; ++round) {
+		for (auto const & range: changes) {
+			for (int id = 0; id < nr_awms; ++id)
+				enabled.set(id, (id >= range.first) && (id <= range.second));
+			for (int id = 0; id < nr_awms; ++id)
+				index.SetEnabled(id, enabled.test(id) &&
+					!out_of_bounds.test(id) && !awms[id]->Hidden());
+			index.Commit();
+		}
+	}
+	double index_us = ElapsedUs(start);
+
+	// Same working modes after the last change, and same frontier
+	bool same = (awms_list.size() == index.Enabled().size());
+	auto list_it = awms_list.begin();
+	for (auto const & awm: index.Enabled())
+		same = same && (awm == *list_it++);
+	if (!same || (ParetoScan(index.Enabled()) != index.Pareto().size())) {
+		fprintf(stderr, "Index mismatch [%d AWMs, %zu resources]\n",
+			nr_awms, r_paths.size());
+		exit(EXIT_FAILURE);
+	}
+
+	double nr_updates = rounds * changes.size();
+	printf("%5d %9zu %7zu/%-3zu %14.2f %12.2f %7.1fx %10.1f\n",
+		nr_awms, r_paths.size(), index.Pareto().size(), index.Enabled().size(),
+		rebuild_us / nr_updates, index_us / nr_updates, rebuild_us / index_us,
+		init_us);
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t rounds = (argc > 1) ? atoi(argv[1]) : 200;
+	std::vector<br::ResourcePathPtr_t> r_paths = {
+		std::make_shared<br::ResourcePath>("sys0.cpu.pe"),
+		std::make_shared<br::ResourcePath>("sys0.mem"),
+		std::make_shared<br::ResourcePath>("sys0.gpu.pe"),
+		std::make_shared<br::ResourcePath>("sys0.cpu.mem")
+	};
+
+	printf("%d constraint changes x %u rounds, times per change [us]\n",
+		NR_CHANGES, rounds);
+	printf("%5s %9s %11s %14s %12s %8s %10s\n", "AWMs", "resources",
+		"pareto/enab", "rebuild", "index", "speedup", "init");
+	for (int nr_awms: { 32, 64, 128, 255 }) {
+		for (size_t nr_resources: { 2, 4 })
+			RunCase(nr_awms, std::vector<br::ResourcePathPtr_t>(
+				r_paths.begin(), r_paths.begin() + nr_resources), rounds);
+	}
+
+	return EXIT_SUCCESS;
+}
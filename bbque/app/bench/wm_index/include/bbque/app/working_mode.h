@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_WORKING_MODE_H_
+#define BBQUE_WORKING_MODE_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "bbque/res/resource_assignment.h"
+#include "bbque/res/resource_path.h"
+
+namespace br = bbque::res;
+
+namespace bbque { namespace app {
+
+/**
+ * @class WorkingMode
+ *
+ * The working mode of the WorkingModeIndex benchmark and test: it replaces
+ * the daemon one, which needs the ResourceAccounter to add the resource
+ * requests, with the ID, the value and the resource requests only.
+ */
+class WorkingMode {
+
+public:
+
+	WorkingMode(int8_t id, float value):
+		id(id), value(value) {
+	}
+
+	inline int8_t Id() const {
+		return id;
+	}
+
+	inline float Value() const {
+		return value;
+	}
+
+	inline bool Hidden() const {
+		return false;
+	}
+
+	/** Add a request of an amount of resource */
+	inline void AddResourceRequest(
+			br::ResourcePathPtr_t resource_path, uint64_t amount) {
+		requested.emplace(resource_path,
+			std::make_shared<br::ResourceAssignment>(amount));
+	}
+
+	inline br::ResourceAssignmentMap_t const & ResourceRequests() const {
+		return requested;
+	}
+
+private:
+
+	int8_t id;
+
+	float value;
+
+	br::ResourceAssignmentMap_t requested;
+
+};
+
+} // namespace app
+
+} // namespace bbque
+
+#endif // BBQUE_WORKING_MODE_H_
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_WM_INDEX_RECIPES_H_
+#define BBQUE_WM_INDEX_RECIPES_H_
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bbque/app/recipe.h"
+#include "bbque/app/working_mode.h"
+
+namespace ba = bbque::app;
+namespace br = bbque::res;
+
+/**
+ * @brief Generate the working modes of a large recipe
+ *
+ * Each working mode requests an amount of each resource path, from 50 to
+ * 800 in steps of 50, and has a value growing with the total amount
+ * requested, with some noise: the Pareto frontier is a fraction of the
+ * working modes, as in profiled recipes.
+ *
+ * @param rng The random number generator
+ * @param nr_awms The number of working modes
+ * @param r_paths The resource paths requested
+ *
+ * @return The working modes, indexed by ID
+ */
+inline ba::AwmPtrVect_t GenerateWorkingModes(
+		std::mt19937 & rng,
+		int nr_awms,
+		std::vector<br::ResourcePathPtr_t> const & r_paths) {
+	std::uniform_int_distribution<int> steps(1, 16);
+	std::uniform_real_distribution<float> noise(0.6, 1.0);
+
+	ba::AwmPtrVect_t awms(MAX_NUM_AWM);
+	for (int id = 0; id < nr_awms; ++id) {
+		std::vector<uint64_t> amounts;
+		uint64_t total = 0;
+		for (size_t r = 0; r < r_paths.size(); ++r) {
+			amounts.push_back(50 * steps(rng));
+			total += amounts.back();
+		}
+		float value = total / (800.0 * r_paths.size()) * noise(rng);
+		awms[id] = std::make_shared<ba::WorkingMode>(id, value);
+		for (size_t r = 0; r < r_paths.size(); ++r)
+			awms[id]->AddResourceRequest(r_paths[r], amounts[r]);
+	}
+	return awms;
+}
+
+/**
+ * @brief The amount of a resource requested by a working mode
+ *
+ * The paths are matched by string, as the index does, since the ordering
+ * of the resource paths is not suitable for the lookups of equal paths.
+ */
+inline uint64_t RequestedAmount(
+		ba::AwmPtr_t const & awm,
+		std::string const & path_str) {
+	uint64_t amount = 0;
+	for (auto const & r_entry: awm->ResourceRequests())
+		if (r_entry.first->ToString() == path_str)
+			amount += r_entry.second->GetAmount();
+	return amount;
+}
+
+#endif // BBQUE_WM_INDEX_RECIPES_H_
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * Pareto frontier of the WorkingModeIndex vs a brute-force scan
+ *
+ * Generated recipes of 16 to 255 working modes, requesting 1 to 4
+ * resources, with some working modes equal to the previous one (same value
+ * and requests), some with the same value of the previous one and less of a
+ * resource, and some not requesting all the resources. The working
+ * modes are enabled and disabled at random and, after each Commit(), the
+ * enabled working modes and the Pareto frontier of the index are checked
+ * against the ones of a scan of all the enabled pairs.
+ *
+ * Usage: bbque-app-test-wm-index [seed]
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "bbque/app/working_mode_index.h"
+#include "recipes.h"
+
+#define NR_STEPS 200
+
+/** Whether a working mode is dominated by another one */
+static bool Dominates(ba::AwmPtr_t const & awm, ba::AwmPtr_t const & other,
+		std::vector<br::ResourcePathPtr_t> const & r_paths) {
+	if (awm->Value() < other->Value())
+		return false;
+	bool better = (awm->Value() > other->Value());
+	for (auto const & r_path: r_paths) {
+		uint64_t amount = RequestedAmount(awm, r_path->ToString());
+		uint64_t other_amount = RequestedAmount(other, r_path->ToString());
+		if (amount > other_amount)
+			return false;
+		better |= (amount < other_amount);
+	}
+	return better;
+}
+
+static bool Check(ba::WorkingModeIndex const & index,
+		ba::AwmPtrVect_t const & awms, std::vector<bool> const & enabled,
+		std::vector<br::ResourcePathPtr_t> const & r_paths) {
+	// Enabled working modes, by increasing value and ID
+	ba::AwmPtrVect_t exp_enabled;
+	for (size_t id = 0; id < enabled.size(); ++id)
+		if (enabled[id])
+			exp_enabled.push_back(awms[id]);
+	std::stable_sort(exp_enabled.begin(), exp_enabled.end(),
+		[](ba::AwmPtr_t const & a, ba::AwmPtr_t const & b) {
+			return a->Value() < b->Value();
+		});
+
+	ba::AwmPtrVect_t exp_pareto;
+	for (auto const & awm: exp_enabled) {
+		bool dominated = false;
+		for (auto const & other: exp_enabled)
+			dominated |= Dominates(other, awm, r_paths);
+		if (!dominated)
+			exp_pareto.push_back(awm);
+	}
+
+	return (index.Enabled() == exp_enabled) && (index.Pareto() == exp_pareto);
+}
+
+static bool RunCase(std::mt19937 & rng, int nr_awms,
+		std::vector<br::ResourcePathPtr_t> const & r_paths) {
+	auto awms(GenerateWorkingModes(rng, nr_awms, r_paths));
+	for (int id = 1; id < nr_awms; ++id) {
+		// Equal to the previous working mode
+		if ((id % 8) == 0) {
+			awms[id] = std::make_shared<ba::WorkingMode>(
+				id, awms[id - 1]->Value());
+			for (auto const & r_entry: awms[id - 1]->ResourceRequests())
+				awms[id]->AddResourceRequest(
+					r_entry.first, r_entry.second->GetAmount());
+		}
+		// Same value of the previous working mode, less of a resource
+		else if ((id % 8) == 3) {
+			awms[id] = std::make_shared<ba::WorkingMode>(
+				id, awms[id - 1]->Value());
+			for (auto const & r_entry: awms[id - 1]->ResourceRequests()) {
+				uint64_t amount = r_entry.second->GetAmount();
+				if (r_entry.first == r_paths[0])
+					amount /= 2;
+				awms[id]->AddResourceRequest(r_entry.first, amount);
+			}
+		}
+		// Not requesting the first resource
+		else if (((id % 8) == 5) && (r_paths.size() > 1)) {
+			awms[id] = std::make_shared<ba::WorkingMode>(
+				id, awms[id]->Value());
+			for (size_t r = 1; r < r_paths.size(); ++r)
+				awms[id]->AddResourceRequest(r_paths[r], 50 * (1 + rng() % 16));
+		}
+	}
+
+	ba::WorkingModeIndex index;
+	index.Init(awms);
+	std::vector<bool> enabled(nr_awms, false);
+	std::uniform_int_distribution<int> awm_id(0, nr_awms - 1);
+	for (int step = 0; step < NR_STEPS; ++step) {
+		// A few changes per step, or a whole new set every 16 steps
+		int nr_changes = (step % 16) ? 1 + rng() % 8 : nr_awms;
+		for (int c = 0; c < nr_changes; ++c) {
+			int id = (step % 16) ? awm_id(rng) : c;
+			bool enable = (step % 16) ? !enabled[id] : (rng() % 2);
+			if (index.SetEnabled(id, enable) != (enabled[id] != enable)) {
+				fprintf(stderr, "SetEnabled(%d): wrong change\n", id);
+				return false;
+			}
+			enabled[id] = enable;
+		}
+		index.Commit();
+		if (!Check(index, awms, enabled, r_paths)) {
+			fprintf(stderr, "Index mismatch [%d AWMs, %zu resources, "
+				"step %d]\n", nr_awms, r_paths.size(), step);
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t seed = (argc > 1) ? atoi(argv[1]) : 2019;
+	std::mt19937 rng(seed);
+	std::vector<br::ResourcePathPtr_t> r_paths = {
+		std::make_shared<br::ResourcePath>("sys0.cpu.pe"),
+		std::make_shared<br::ResourcePath>("sys0.mem"),
+		std::make_shared<br::ResourcePath>("sys0.gpu.pe"),
+		std::make_shared<br::ResourcePath>("sys0.cpu.mem")
+	};
+
+	for (int nr_awms: { 16, 64, 255 }) {
+		for (size_t nr_resources = 1; nr_resources <= r_paths.size();
+				++nr_resources) {
+			if (!RunCase(rng, nr_awms, std::vector<br::ResourcePathPtr_t>(
+					r_paths.begin(), r_paths.begin() + nr_resources)))
+				return EXIT_FAILURE;
+		}
+	}
+
+	printf("Pareto frontier index: PASSED [seed %u]\n", seed);
+	return EXIT_SUCCESS;
+}
@@ -32,7 +32,9 @@ Process::Process(
 	priority = _prio;
 	type = Schedulable::Type::PROCESS;
 	schedule.state = _state;
+	schedule.preSyncState = _state;
 	schedule.syncState = _sync;
+	UpdateSchedulingSnapshot();
 
 	logger = bbque::utils::Logger::GetLogger(MODULE_NAMESPACE);
 	// Format the application string identifier for logging purpose
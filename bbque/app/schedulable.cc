@@ -42,6 +42,49 @@ char const *Schedulable::syncStateStr[] = {
 };
 
 
+/*******************************************************************************
+ *  EXC Scheduling State Snapshot
+ ******************************************************************************/
+
+// Packing of the SchedulingSnapshot_t into a 64 bits word
+#define SNAP_STATE_SHIFT     0
+#define SNAP_PRESYNC_SHIFT   8
+#define SNAP_SYNC_SHIFT     16
+#define SNAP_AWM_SHIFT      24
+#define SNAP_NEXT_AWM_SHIFT 32
+#define SNAP_HAS_AWM        (1ULL << 40)
+#define SNAP_HAS_NEXT_AWM   (1ULL << 41)
+#define SNAP_FIELD(word, shift) (((word) >> (shift)) & 0xFF)
+
+void Schedulable::UpdateSchedulingSnapshot() noexcept {
+	uint64_t word =
+		((uint64_t)(uint8_t) schedule.state        << SNAP_STATE_SHIFT)   |
+		((uint64_t)(uint8_t) schedule.preSyncState << SNAP_PRESYNC_SHIFT) |
+		((uint64_t)(uint8_t) schedule.syncState    << SNAP_SYNC_SHIFT);
+	if (schedule.awm) {
+		word |= SNAP_HAS_AWM;
+		word |= (uint64_t)(uint8_t) schedule.awm->Id() << SNAP_AWM_SHIFT;
+	}
+	if (schedule.next_awm) {
+		word |= SNAP_HAS_NEXT_AWM;
+		word |= (uint64_t)(uint8_t) schedule.next_awm->Id() << SNAP_NEXT_AWM_SHIFT;
+	}
+	schedule.snapshot.store(word, std::memory_order_release);
+}
+
+Schedulable::SchedulingSnapshot_t Schedulable::GetSchedulingSnapshot() const noexcept {
+	uint64_t word = schedule.snapshot.load(std::memory_order_acquire);
+	SchedulingSnapshot_t snap;
+	snap.state        = (State_t) SNAP_FIELD(word, SNAP_STATE_SHIFT);
+	snap.preSyncState = (State_t) SNAP_FIELD(word, SNAP_PRESYNC_SHIFT);
+	snap.syncState    = (SyncState_t) SNAP_FIELD(word, SNAP_SYNC_SHIFT);
+	snap.has_awm      = word & SNAP_HAS_AWM;
+	snap.has_next_awm = word & SNAP_HAS_NEXT_AWM;
+	snap.awm_id       = (int8_t) SNAP_FIELD(word, SNAP_AWM_SHIFT);
+	snap.next_awm_id  = (int8_t) SNAP_FIELD(word, SNAP_NEXT_AWM_SHIFT);
+	return snap;
+}
+
 /*******************************************************************************
  *  EXC State and SyncState Management
  ******************************************************************************/
@@ -49,6 +92,7 @@ char const *Schedulable::syncStateStr[] = {
 void Schedulable::SetSyncState(SyncState_t sync) {
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	schedule.syncState = sync;
+	UpdateSchedulingSnapshot();
 }
 
 
@@ -60,8 +104,9 @@ Schedulable::ExitCode_t Schedulable::SetState(State_t next_state, SyncState_t ne
 		if (next_sync == SYNC_NONE)
 			return APP_SYNC_NOT_EXP;
 		schedule.preSyncState = _State();         // Previous pre-synchronization state
-		SetSyncState(next_sync);                  // Update synchronization state
+		schedule.syncState = next_sync;           // Update synchronization state
 		schedule.state = Schedulable::SYNC;       // Update state
+		UpdateSchedulingSnapshot();
 		return APP_SUCCESS;
 	}
 	// Switching to a stable state
@@ -71,7 +116,7 @@ Schedulable::ExitCode_t Schedulable::SetState(State_t next_state, SyncState_t ne
 			return APP_SYNC_NOT_EXP;
 		schedule.preSyncState = schedule.state;   // Previous pre-synchronization state
 		schedule.state = next_state;              // Updating state
-		SetSyncState(SYNC_NONE);                  // Update synchronization state
+		schedule.syncState = SYNC_NONE;           // Update synchronization state
 	}
 
 	// Update current and next working mode: SYNC case
@@ -88,6 +133,7 @@ Schedulable::ExitCode_t Schedulable::SetState(State_t next_state, SyncState_t ne
 		schedule.next_awm.reset();
 	}
 
+	UpdateSchedulingSnapshot();
 	return APP_SUCCESS;
 }
 
@@ -97,8 +143,7 @@ Schedulable::State_t Schedulable::_State() const {
 }
 
 Schedulable::State_t Schedulable::State() const {
-	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
-	return _State();
+	return GetSchedulingSnapshot().state;
 }
 
 Schedulable::State_t Schedulable::_PreSyncState() const {
@@ -106,8 +151,7 @@ Schedulable::State_t Schedulable::_PreSyncState() const {
 }
 
 Schedulable::State_t Schedulable::PreSyncState() const {
-	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
-	return _PreSyncState();
+	return GetSchedulingSnapshot().preSyncState;
 }
 
 Schedulable::SyncState_t Schedulable::_SyncState() const {
@@ -115,8 +159,7 @@ Schedulable::SyncState_t Schedulable::_SyncState() const {
 }
 
 Schedulable::SyncState_t Schedulable::SyncState() const {
-	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
-	return _SyncState();
+	return GetSchedulingSnapshot().syncState;
 }
 
 Schedulable::SyncState_t Schedulable::NextSyncState(AwmPtr_t const & next_awm) const {
@@ -154,6 +197,7 @@ Schedulable::SyncState_t Schedulable::NextSyncState(AwmPtr_t const & next_awm) c
 void Schedulable::SetNextAWM(AwmPtr_t awm) {
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	schedule.next_awm = awm;
+	UpdateSchedulingSnapshot();
 }
 
 bool Schedulable::_Disabled() const {
@@ -161,8 +205,7 @@ bool Schedulable::_Disabled() const {
 }
 
 bool Schedulable::Disabled() const {
-	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
-	return _Disabled();
+	return GetSchedulingSnapshot().Disabled();
 }
 
 bool Schedulable::_Finished() const {
@@ -170,8 +213,7 @@ bool Schedulable::_Finished() const {
 }
 
 bool Schedulable::Finished() const {
-	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
-	return _Finished();
+	return GetSchedulingSnapshot().Finished();
 }
 
 bool Schedulable::_Active() const {
@@ -180,8 +222,7 @@ bool Schedulable::_Active() const {
 }
 
 bool Schedulable::Active() const {
-	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
-	return _Active();
+	return GetSchedulingSnapshot().Active();
 }
 
 bool Schedulable::_Running() const {
@@ -189,8 +230,7 @@ bool Schedulable::_Running() const {
 }
 
 bool Schedulable::Running() const {
-	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
-	return _Running();
+	return GetSchedulingSnapshot().Running();
 }
 
 bool Schedulable::_Synching() const {
@@ -198,8 +238,7 @@ bool Schedulable::_Synching() const {
 }
 
 bool Schedulable::Synching() const {
-	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
-	return _Synching();
+	return GetSchedulingSnapshot().Synching();
 }
 
 bool Schedulable::_Starting() const {
@@ -207,8 +246,7 @@ bool Schedulable::_Starting() const {
 }
 
 bool Schedulable::Starting() const {
-	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
-	return _Starting();
+	return GetSchedulingSnapshot().Starting();
 }
 
 bool Schedulable::_Blocking() const {
@@ -216,8 +254,7 @@ bool Schedulable::_Blocking() const {
 }
 
 bool Schedulable::Blocking() const {
-	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
-	return _Blocking();
+	return GetSchedulingSnapshot().Blocking();
 }
 
 AwmPtr_t const & Schedulable::_CurrentAWM() const {
@@ -252,8 +289,7 @@ bool Schedulable::SwitchingAWM() const noexcept {
 }
 
 uint64_t Schedulable::ScheduleCount() const noexcept {
-	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
-	return schedule.count;
+	return schedule.count.load(std::memory_order_relaxed);
 }
 
 bool Schedulable::Reshuffling(AwmPtr_t const & next_awm) const {
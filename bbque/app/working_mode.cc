@@ -99,6 +99,7 @@ br::ResourceAssignmentPtr_t WorkingMode::AddResourceRequest(
 	// Insert a new resource usage object in the map
 	auto r_assign = std::make_shared<br::ResourceAssignment>(amount, split_policy);
 	resources.requested.emplace(resource_path, r_assign);
+	std::atomic_store(&resources.binding_domains, br::BindingDomainsPtr_t());
 	logger->Debug("AddResourceRequest: %s added {%s} \t[usage: %" PRIu64 "] [c=%2d]",
 			str_id, resource_path->ToString().c_str(),amount,
 			resources.requested.size());
@@ -256,6 +257,34 @@ int32_t WorkingMode::BindResource(
 }
 
 
+br::BindingCandidate WorkingMode::GetBindingCandidate(
+		br::ResourceType r_type,
+		BBQUE_RID_TYPE out_id) {
+	// Concurrent evaluations may build the binding lists more than once:
+	// the last one built is kept
+	auto domains = std::atomic_load(&resources.binding_domains);
+	if (!domains || (domains->Type() != r_type)) {
+		domains = std::make_shared<br::BindingDomains>(resources.requested, r_type);
+		std::atomic_store(&resources.binding_domains, domains);
+		logger->Debug("GetBindingCandidate: %s R{%-3s} binding lists updated",
+			str_id, br::GetResourceTypeString(r_type));
+	}
+	return br::BindingCandidate(domains, out_id);
+}
+
+
+int32_t WorkingMode::BindResource(
+		br::BindingCandidate const & candidate,
+		int32_t prev_refn) {
+	if (!candidate.Valid()) {
+		logger->Error("BindResource: %s invalid candidate", str_id);
+		return -1;
+	}
+	return BindResource(
+		candidate.Type(), R_ID_ANY, candidate.DomainID(), prev_refn);
+}
+
+
 uint32_t WorkingMode::AddMissingResourceRequests(
 		br::ResourceAssignmentMapPtr_t bound_map,
 		br::ResourceType r_type) {
@@ -342,8 +371,8 @@ int32_t WorkingMode::StoreBinding(
 
 	int32_t refn = -1;
 	if (prev_refn < 0) {
-		refn = 0;
 		resources.sched_bindings.push_back(out_map);
+		refn = resources.sched_bindings.size() - 1;
 		logger->Debug("StoreBinding: first binding stored");
 	}
 	else if (prev_refn < (int32_t) resources.sched_bindings.size()) {
@@ -408,14 +437,14 @@ void WorkingMode::UpdateBindingInfo(
 					str_id, br::GetResourceTypeString(r_type));
 			// 'Deep' get bit-mask in this case
 			new_mask = br::ResourceBinder::GetMask(
-				resources.sched_bindings[resources.sync_refn],
+				resources.sync_bindings,
 				static_cast<br::ResourceType>(r_type),
 				br::ResourceType::CPU,
 				R_ID_ANY, owner, status_view);
 		}
 		else {
 			new_mask = br::ResourceBinder::GetMask(
-				resources.sched_bindings[resources.sync_refn],
+				resources.sync_bindings,
 				static_cast<br::ResourceType>(r_type));
 		}
 		logger->Debug("UpdateBinding: %s R{%-3s}: %s",
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/app/working_mode_index.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include "bbque/app/working_mode.h"
+
+namespace bbque { namespace app {
+
+
+void WorkingModeIndex::Init(AwmPtrVect_t const & awms) {
+	Clear();
+	nodes.resize(std::min<size_t>(awms.size(), MAX_NUM_AWM));
+
+	// The resource vectors: one dimension for each resource path requested
+	// by at least one working mode (not requested means an amount of 0).
+	// Paths are keyed by string, to match exactly the same path.
+	std::map<std::string, size_t> dims;
+	std::vector<std::vector<uint64_t>> amounts(nodes.size());
+	for (size_t id = 0; id < nodes.size(); ++id) {
+		nodes[id].awm = awms[id];
+		if (!awms[id])
+			continue;
+		value_order.push_back(id);
+		for (auto const & r_entry: awms[id]->ResourceRequests())
+			dims.emplace(r_entry.first->ToString(), dims.size());
+	}
+	for (uint8_t id: value_order) {
+		amounts[id].resize(dims.size(), 0);
+		for (auto const & r_entry: nodes[id].awm->ResourceRequests())
+			amounts[id][dims[r_entry.first->ToString()]] +=
+				r_entry.second->GetAmount();
+	}
+
+	// Dominance relations
+	for (uint8_t i: value_order) {
+		for (uint8_t j: value_order) {
+			float v_i = nodes[i].awm->Value();
+			float v_j = nodes[j].awm->Value();
+			if ((i == j) || (v_i < v_j))
+				continue;
+			bool better = (v_i > v_j);
+			bool worse  = false;
+			for (size_t d = 0; (d < dims.size()) && !worse; ++d) {
+				worse  |= (amounts[i][d] > amounts[j][d]);
+				better |= (amounts[i][d] < amounts[j][d]);
+			}
+			if (better && !worse)
+				nodes[i].dominated.push_back(j);
+		}
+	}
+
+	// Increasing value, and increasing ID for the same value
+	std::stable_sort(value_order.begin(), value_order.end(),
+		[this](uint8_t i, uint8_t j) {
+			return nodes[i].awm->Value() < nodes[j].awm->Value();
+		});
+}
+
+
+bool WorkingModeIndex::SetEnabled(uint8_t id, bool enabled) {
+	if ((id >= nodes.size()) || !nodes[id].awm)
+		return false;
+	Node & node(nodes[id]);
+	if (node.enabled == enabled)
+		return false;
+
+	node.enabled = enabled;
+	for (uint8_t j: node.dominated) {
+		if (enabled)
+			++nodes[j].dominators;
+		else
+			--nodes[j].dominators;
+	}
+	return true;
+}
+
+
+void WorkingModeIndex::Commit() {
+	enabled.clear();
+	pareto.clear();
+	for (uint8_t id: value_order) {
+		Node const & node(nodes[id]);
+		if (!node.enabled)
+			continue;
+		enabled.push_back(node.awm);
+		if (node.dominators == 0)
+			pareto.push_back(node.awm);
+	}
+}
+
+
+void WorkingModeIndex::Clear() {
+	nodes.clear();
+	value_order.clear();
+	enabled.clear();
+	pareto.clear();
+}
+
+} // namespace app
+
+} // namespace bbque
@@ -80,6 +80,17 @@ ApplicationManager::ApplicationManager() :
 	// Debug logging
 	logger->Debug("Priority levels: %d, (O = highest)", BBQUE_APP_PRIO_LEVELS);
 
+	// Setup the EXC queues
+	uids_q.Init(Application::QUEUE_ALL, 0);
+	for (uint8_t level = 0; level < BBQUE_APP_PRIO_LEVELS; ++level)
+		prio_vec[level].Init(Application::QUEUE_PRIO, level);
+	for (uint8_t state = 0; state < Application::STATE_COUNT; ++state)
+		status_vec[state].Init(Application::QUEUE_STATE, state);
+	for (uint8_t state = 0; state < Application::SYNC_STATE_COUNT; ++state)
+		sync_vec[state].Init(Application::QUEUE_SYNC, state);
+	for (uint8_t lang = 0; lang < RTLIB_LANG_COUNT; ++lang)
+		lang_vec[lang].Init(Application::QUEUE_LANG, lang);
+
 	// Register commands
 #define CMD_WIPE_RECP ".recipes_wipe"
 	cm.RegisterCommand(
@@ -180,23 +191,26 @@ ApplicationManager::~ApplicationManager() {
 	logger->Debug("Clearing SYNC vector...");
 	for (uint8_t state = 0;
 			state < Application::SYNC_STATE_COUNT; ++state) {
-		sync_vec[state].clear();
-		sync_ret[state].clear();
+		sync_vec[state].Clear();
 	}
 
 	// Clear the status vector
 	logger->Debug("Clearing STATUS vector...");
 	for (uint8_t state = 0;
 			state < Application::STATE_COUNT; ++state) {
-		status_vec[state].clear();
-		status_ret[state].clear();
+		status_vec[state].Clear();
 	}
 
 	// Clear the priority vector
 	logger->Debug("Clearing PRIO vector...");
 	for (uint8_t level = 0; level < BBQUE_APP_PRIO_LEVELS; ++level) {
-		prio_vec[level].clear();
-		prio_ret[level].clear();
+		prio_vec[level].Clear();
+	}
+
+	// Clear the language vector
+	logger->Debug("Clearing LANG vector...");
+	for (uint8_t lang = 0; lang < RTLIB_LANG_COUNT; ++lang) {
+		lang_vec[lang].Clear();
 	}
 
 	// Clear the APPs map
@@ -205,8 +219,8 @@ ApplicationManager::~ApplicationManager() {
 
 	// Clear the applications map
 	logger->Debug("Clearing UIDs map...");
+	uids_q.Clear();
 	uids.clear();
-	uids_ret.clear();
 
 	// Clear the recipes
 	logger->Debug("Clearing RECIPES...");
@@ -270,41 +284,98 @@ bp::RecipeLoaderIF::ExitCode_t ApplicationManager::LoadRecipe(
 
 }
 
+void ApplicationManager::RegisterRecipe(RecipePtr_t recipe) {
+	std::unique_lock<std::mutex> recipes_ul(recipes_mtx);
+	recipe->Validate();
+	recipes[recipe->Path()] = recipe;
+	logger->Debug("RegisterRecipe: <%s> registered", recipe->Path().c_str());
+}
+
 
 /*******************************************************************************
   *     Queued Access Functions
   *****************************************************************************/
 
-void
-ApplicationManager::UpdateIterators(AppsUidMapItRetainer_t & ret,
-		AppPtr_t papp) {
-	AppsUidMapItRetainer_t::iterator it;
-	AppsUidMapIt* pati;
+void ExcQueue::Init(app::Application::QueueType_t _type, int16_t _id) {
+	assert(Empty());
+	type = _type;
+	id   = _id;
+}
+
+bool ExcQueue::Insert(AppPtr_t const & papp) {
+	auto & hook(papp->queue_hooks[type]);
+	if (hook.queue >= 0)
+		return (hook.queue == id);
+
+	// Append to the tail
+	hook.next.reset();
+	hook.prev  = tail;
+	hook.queue = id;
+	if (tail)
+		tail->queue_hooks[type].next = papp;
+	else
+		head = papp;
+	tail = papp.get();
+	++count;
+
+	return true;
+}
 
-	logger->Debug("Checking [%d] iterators...", ret.size());
-	// Lookup for iterators on the specified map which pointes to the
-	// specified apps
-	for (it = ret.begin(); it != ret.end(); ++it) {
-		pati = (*it);
+bool ExcQueue::Remove(AppPtr_t const & papp) {
+	auto & hook(papp->queue_hooks[type]);
+	if (hook.queue != id)
+		return false;
 
-		// Ignore iterators not pointing to the application of interest
-		if (pati->it->first != papp->Uid())
-			continue;
+	// Move forward the iterators pointing to the EXC to remove
+	for (auto pati: ret) {
+		if (pati->curr == papp)
+			pati->Update();
+	}
 
-		// Update the iterator position one step backward
-		logger->Debug("~ Updating iterator [@%p => %d]", pati->it, papp->Uid());
+	// Unlink
+	AppPtr_t next(std::move(hook.next));
+	if (hook.prev)
+		hook.prev->queue_hooks[type].next = next;
+	else
+		head = next;
+	if (next)
+		next->queue_hooks[type].prev = hook.prev;
+	else
+		tail = hook.prev;
+	hook.prev  = nullptr;
+	hook.queue = -1;
+	--count;
 
-		// Move the iterator forward
-		pati->Update();
+	return true;
+}
+
+bool ExcQueue::Contains(AppPtr_t const & papp) const {
+	return (papp->queue_hooks[type].queue == id);
+}
+
+void ExcQueue::Clear() {
+	// Unlink iteratively, to avoid a recursive release of the chain
+	while (head) {
+		auto & hook(head->queue_hooks[type]);
+		AppPtr_t next(std::move(hook.next));
+		hook.prev  = nullptr;
+		hook.queue = -1;
+		head = std::move(next);
 	}
+	tail  = nullptr;
+	count = 0;
+	ret.clear();
+}
 
+AppPtr_t const & ExcQueue::Next(AppPtr_t const & papp) const {
+	return papp->queue_hooks[type].next;
 }
 
 AppPtr_t ApplicationManager::GetFirst(AppsUidMapIt & ait) {
 	std::unique_lock<std::recursive_mutex> uids_ul(uids_mtx);
 	AppPtr_t papp;
 
-	ait.Init(uids, uids_ret);
+	ait.Init(uids_q);
 	if (ait.End())
 		return AppPtr_t();
 
@@ -314,7 +385,7 @@ AppPtr_t ApplicationManager::GetFirst(AppsUidMapIt & ait) {
 	// Add iterator to the retainers list
 	ait.Retain();
 	logger->Debug("GetFirst: > ADD retained UIDs iterator [@%p => %d]",
-			&(ait.it), papp->Uid());
+			ait.curr.get(), papp->Uid());
 
 	return papp;
 }
@@ -328,7 +399,7 @@ AppPtr_t ApplicationManager::GetNext(AppsUidMapIt & ait) {
 		// Release the iterator retainer
 		ait.Release();
 		logger->Debug("GetNext: < DEL retained UIDs iterator [@%p => %d]",
-				&(ait.it));
+				ait.curr.get());
 		return AppPtr_t();
 	}
 
@@ -342,7 +413,7 @@ AppPtr_t ApplicationManager::GetFirst(AppPrio_t prio,
 	std::unique_lock<std::mutex> prio_ul(prio_mtx[prio]);
 	AppPtr_t papp;
 
-	ait.Init(prio_vec[prio], prio_ret[prio]);
+	ait.Init(prio_vec[prio]);
 	if (ait.End())
 		return AppPtr_t();
 
@@ -351,7 +422,7 @@ AppPtr_t ApplicationManager::GetFirst(AppPrio_t prio,
 	// Add iterator to the retainers list
 	ait.Retain();
 	logger->Debug("GetFirst: > ADD retained PRIO[%d] iterator [@%p => %d]",
-			prio, &(ait.it), papp->Uid());
+			prio, ait.curr.get(), papp->Uid());
 
 	return papp;
 }
@@ -367,7 +438,7 @@ AppPtr_t ApplicationManager::GetNext(AppPrio_t prio,
 		// Release the iterator retainer
 		ait.Release();
 		logger->Debug("GetNext: < DEL retained PRIO[%d] iterator [@%p]",
-			prio, &(ait.it));
+			prio, ait.curr.get());
 		return AppPtr_t();
 	}
 
@@ -381,7 +452,7 @@ AppPtr_t ApplicationManager::GetFirst(ApplicationStatusIF::State_t state,
 	std::unique_lock<std::mutex> status_ul(status_mtx[state]);
 	AppPtr_t papp;
 
-	ait.Init(status_vec[state], status_ret[state]);
+	ait.Init(status_vec[state]);
 	if (ait.End())
 		return AppPtr_t();
 
@@ -390,7 +461,7 @@ AppPtr_t ApplicationManager::GetFirst(ApplicationStatusIF::State_t state,
 	// Add iterator to the retainers list
 	ait.Retain();
 	logger->Debug("GetFirst: > ADD retained STATUS[%s] iterator [@%p => %d]",
-			Application::StateStr(state), &(ait.it), papp->Uid());
+			Application::StateStr(state), ait.curr.get(), papp->Uid());
 
 	return papp;
 }
@@ -406,7 +477,7 @@ AppPtr_t ApplicationManager::GetNext(ApplicationStatusIF::State_t state,
 		// Release the iterator retainer
 		ait.Release();
 		logger->Debug("GetNext: < DEL retained STATUS[%s] iterator [@%p]",
-			Application::StateStr(state), &(ait.it));
+			Application::StateStr(state), ait.curr.get());
 		return AppPtr_t();
 	}
 
@@ -420,7 +491,7 @@ AppPtr_t ApplicationManager::GetFirst(ApplicationStatusIF::SyncState_t state,
 	std::unique_lock<std::mutex> sync_ul(sync_mtx[state]);
 	AppPtr_t papp;
 
-	ait.Init(sync_vec[state], sync_ret[state]);
+	ait.Init(sync_vec[state]);
 	if (ait.End())
 		return AppPtr_t();
 
@@ -429,7 +500,7 @@ AppPtr_t ApplicationManager::GetFirst(ApplicationStatusIF::SyncState_t state,
 	// Add iterator to the retainers list
 	ait.Retain();
 	logger->Debug("GetFirst: > ADD retained SYNCS[%s] iterator [@%p => %d]",
-			Application::SyncStateStr(state), &(ait.it),
+			Application::SyncStateStr(state), ait.curr.get(),
 			papp->Uid());
 
 	return papp;
@@ -446,7 +517,7 @@ AppPtr_t ApplicationManager::GetNext(ApplicationStatusIF::SyncState_t state,
 		// Release the iterator retainer
 		ait.Release();
 		logger->Debug("GetNext: < DEL retained SYNCS[%s] iterator [@%p]",
-			Application::SyncStateStr(state), &(ait.it));
+			Application::SyncStateStr(state), ait.curr.get());
 		return AppPtr_t();
 	}
 
@@ -457,49 +528,49 @@ AppPtr_t ApplicationManager::GetNext(ApplicationStatusIF::SyncState_t state,
 bool ApplicationManager::HasApplications (
 		AppPrio_t prio) {
 	assert(prio < BBQUE_APP_PRIO_LEVELS);
-	return !(prio_vec[prio].empty());
+	return !(prio_vec[prio].Empty());
 }
 
 bool ApplicationManager::HasApplications (ApplicationStatusIF::State_t state) {
 	assert(state < Application::STATE_COUNT);
-	return !(status_vec[state].empty());
+	return !(status_vec[state].Empty());
 }
 
 bool ApplicationManager::HasApplications (ApplicationStatusIF::SyncState_t state) {
 	assert(state < Application::SYNC_STATE_COUNT);
-	return !(sync_vec[state].empty());
+	return !(sync_vec[state].Empty());
 }
 
 bool ApplicationManager::HasApplications (RTLIB_ProgrammingLanguage_t lang) {
 	assert(lang < RTLIB_LANG_COUNT);
-	return !(lang_vec[lang].empty());
+	return !(lang_vec[lang].Empty());
 }
 
 uint16_t ApplicationManager::AppsCount() const {
 	uint16_t count = 0;
 	for (uint16_t prio = 0; prio < BBQUE_APP_PRIO_LEVELS; ++prio)
-		count +=  prio_vec[prio].size();
+		count +=  prio_vec[prio].Size();
 	return count;
 }
 
 uint16_t ApplicationManager::AppsCount (AppPrio_t prio) const {
 	assert(prio < BBQUE_APP_PRIO_LEVELS);
-	return prio_vec[prio].size();
+	return prio_vec[prio].Size();
 }
 
 uint16_t ApplicationManager::AppsCount (ApplicationStatusIF::State_t state) const {
 	assert(state < Application::STATE_COUNT);
-	return status_vec[state].size();
+	return status_vec[state].Size();
 }
 
 uint16_t ApplicationManager::AppsCount (ApplicationStatusIF::SyncState_t state) const {
 	assert(state < Application::SYNC_STATE_COUNT);
-	return sync_vec[state].size();
+	return sync_vec[state].Size();
 }
 
 uint16_t ApplicationManager::AppsCount (RTLIB_ProgrammingLanguage_t lang) const {
 	assert(lang < RTLIB_LANG_COUNT);
-	return lang_vec[lang].size();
+	return lang_vec[lang].Size();
 }
 
 AppPtr_t ApplicationManager::HighestPrio(ApplicationStatusIF::State_t state) {
@@ -679,21 +750,20 @@ ApplicationManager::UpdateStatusMaps(AppPtr_t papp,
 			status_mtx[next], std::defer_lock);
 	std::lock(currState_ul, nextState_ul);
 
-	// Retrieve the runtime map from the status vector
-	AppsUidMap_t *curr_state_map = &(status_vec[prev]);
-	AppsUidMap_t *next_state_map = &(status_vec[next]);
-	assert(curr_state_map != next_state_map);
+	// Retrieve the runtime queue from the status vector
+	ExcQueue *curr_state_q = &(status_vec[prev]);
+	ExcQueue *next_state_q = &(status_vec[next]);
+	assert(curr_state_q != next_state_q);
 	logger->Debug("UpdateStatusMap: [%s] moving %s => %s (sync=%s)",
 		papp->StrId(),
 		papp->StateStr(prev),
 		papp->StateStr(next),
 		papp->SyncStateStr(papp->SyncState()));
 
-	// Move it from the current to the next status map
+	// Move it from the current to the next status queue
 	// FIXME: maybe we could avoid to enqueue FINISHED EXCs
-	next_state_map->insert(UidsMapEntry_t(papp->Uid(), papp));
-	UpdateIterators(status_ret[prev], papp);
-	curr_state_map->erase(papp->Uid());
+	curr_state_q->Remove(papp);
+	next_state_q->Insert(papp);
 
 	PrintStatusQ();
 	return AM_SUCCESS;
@@ -851,25 +921,26 @@ AppPtr_t ApplicationManager::CreateEXC(
 
 	uids_ul.lock();
 	uids.insert(UidsMapEntry_t(papp->Uid(), papp));
+	uids_q.Insert(papp);
 	uids_ul.unlock();
 	logger->Debug("CreateEXC: [%s] inserted in UIDs map", papp->StrId());
 
 	// Priority vector
 	prio_ul.lock();
-	prio_vec[papp->Priority()].insert(UidsMapEntry_t(papp->Uid(), papp));
+	prio_vec[papp->Priority()].Insert(papp);
 	prio_ul.unlock();
 	logger->Debug("CreateEXC: [%s] inserted in priority map", papp->StrId());
 
 	// Status vector (all new EXC are initially disabled)
 	assert(papp->State() == Application::NEW);
 	status_ul.lock();
-	status_vec[papp->State()].insert(UidsMapEntry_t(papp->Uid(), papp));
+	status_vec[papp->State()].Insert(papp);
 	status_ul.unlock();
 	logger->Debug("CreateEXC: [%s] inserted in status map", papp->StrId());
 
 	// Language vector
 	lang_ul.lock();
-	lang_vec[papp->Language()].insert(UidsMapEntry_t(papp->Uid(), papp));
+	lang_vec[papp->Language()].Insert(papp);
 	lang_ul.unlock();
 	logger->Info("CreateEXC: [%s] CREATED", papp->StrId());
 
@@ -885,8 +956,7 @@ ApplicationManager::ExitCode_t
 ApplicationManager::PriorityRemove(AppPtr_t papp) {
 	logger->Debug("PriorityRemove: releasing [%s] from PRIORITY map...", papp->StrId());
 	std::unique_lock<std::mutex> prio_ul(prio_mtx[papp->Priority()]);
-	UpdateIterators(prio_ret[papp->Priority()], papp);
-	prio_vec[papp->Priority()].erase(papp->Uid());
+	prio_vec[papp->Priority()].Remove(papp);
 	return AM_SUCCESS;
 }
 
@@ -894,8 +964,7 @@ ApplicationManager::ExitCode_t
 ApplicationManager::StatusRemove(AppPtr_t papp) {
 	logger->Debug("StatusRemove: releasing [%s] from STATUS map...", papp->StrId());
 	std::unique_lock<std::mutex> status_ul(status_mtx[papp->State()]);
-	UpdateIterators(status_ret[papp->State()], papp);
-	status_vec[papp->State()].erase(papp->Uid());
+	status_vec[papp->State()].Remove(papp);
 	return AM_SUCCESS;
 }
 
@@ -903,8 +972,7 @@ ApplicationManager::ExitCode_t
 ApplicationManager::LangRemove(AppPtr_t papp) {
 	logger->Debug("LangRemove: releasing [%s] from LANGUAGE map...", papp->StrId());
 	std::unique_lock<std::mutex> lang_ul(lang_mtx[papp->Language()]);
-	UpdateIterators(lang_ret[papp->Language()], papp);
-	lang_vec[papp->Language()].erase(papp->Uid());
+	lang_vec[papp->Language()].Remove(papp);
 	return AM_SUCCESS;
 }
 
@@ -960,7 +1028,7 @@ ApplicationManager::CleanupEXC(AppPtr_t papp) {
 
 	// Remove application descriptor from UIDs map
 	uids_ul.lock();
-	UpdateIterators(uids_ret, papp);
+	uids_q.Remove(papp);
 	uids.erase(papp->Uid());
 	uids_ul.unlock();
 
@@ -1657,14 +1725,13 @@ void ApplicationManager::RemoveFromSyncMap(AppPtr_t papp, Application::SyncState
 		papp->StrId(), ba::Schedulable::SyncStateStr(state));
 	std::unique_lock<std::mutex> sync_ul(sync_mtx[state]);
 	assert(papp);
-	UpdateIterators(sync_ret[state], papp);
 
 	PrintSyncQ();
 	logger->Debug("RemoveFromSyncMap: [%s] removing sync [%s] after request ...",
 		papp->StrId(), ba::Schedulable::SyncStateStr(state));
 
-	// Get the applications map
-	if (sync_vec[state].erase(papp->Uid())) {
+	// Unlink from the synchronization queue
+	if (sync_vec[state].Remove(papp)) {
 		logger->Debug("RemoveFromSyncMap: [%s, %s] removed sync request",
 			papp->StrId(), papp->SyncStateStr(state));
 		PrintSyncQ();
@@ -1710,7 +1777,9 @@ void ApplicationManager::AddToSyncMap(AppPtr_t papp, Application::SyncState_t st
 		return;
 	}
 	std::unique_lock<std::mutex> sync_ul(sync_mtx[state]);
-	sync_vec[state].insert(UidsMapEntry_t(papp->Uid(), papp));
+	if (!sync_vec[state].Insert(papp))
+		logger->Error("AddToSyncMap: [%s] already in another sync queue",
+			papp->StrId());
 }
 
 void ApplicationManager::AddToSyncMap(AppPtr_t papp) {
@@ -339,12 +339,29 @@ ApplicationProxy::Prof_GetRuntimeDataRecv(pcmdSn_t pcs) {
 	assert(pcs->papp->CurrentAWM());
 	pcs->papp->CurrentAWM()->SetRuntimeProfExecTime(pmsg_pyl->exec_time);
 	pcs->papp->CurrentAWM()->SetRuntimeProfMemTime(pmsg_pyl->mem_time);
+	SetRuntimeProfQuantiles(pcs->papp, pmsg_pyl->ctime_q, pmsg_pyl->rtime_q);
 	logger->Info("Prof_GetRuntimeDataRecv: [%s %s] runtime profile set",
 		pcs->papp->StrId(), pcs->papp->CurrentAWM()->StrId());
 
 	return RTLIB_OK;
 }
 
+void ApplicationProxy::SetRuntimeProfQuantiles(
+		ba::AppPtr_t papp,
+		bl::rpc_msg_quantiles_t const & ctime_q,
+		bl::rpc_msg_quantiles_t const & rtime_q) {
+	ba::AwmPtr_t pawm(papp->CurrentAWM());
+	if (!pawm) {
+		logger->Debug("SetRuntimeProfQuantiles: [%s] no AWM assigned",
+			papp->StrId());
+		return;
+	}
+
+	uint32_t ctime_us[3] = { ctime_q.p50_us, ctime_q.p95_us, ctime_q.p99_us };
+	uint32_t rtime_us[3] = { rtime_q.p50_us, rtime_q.p95_us, rtime_q.p99_us };
+	pawm->SetRuntimeProfQuantiles(ctime_us, rtime_us);
+}
+
 /*******************************************************************************
  * Synchronization Protocol - PreChange
  ******************************************************************************/
@@ -1311,6 +1328,11 @@ void ApplicationProxy::RpcExcRuntimeProfileNotify(prqsSn_t prqs) {
 	result = am.SetRuntimeProfile(pcon->app_pid, pmsg_hdr->exc_id,
 				pmsg_pyl->gap, pmsg_pyl->cusage, pmsg_pyl->ctime_ms);
 
+	// Tail latency statistics of the current AWM
+	ba::AppPtr_t papp(am.GetApplication(pcon->app_pid, pmsg_hdr->exc_id));
+	if (papp)
+		SetRuntimeProfQuantiles(papp, pmsg_pyl->ctime_q, pmsg_pyl->rtime_q);
+
 	switch (result) {
 		case ApplicationManager::AM_SUCCESS:
 			break;
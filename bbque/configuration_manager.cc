@@ -33,7 +33,8 @@ ConfigurationManager::ConfigurationManager() :
 #ifdef BBQUE_DEBUG
 	//dbg_opts_desc("Debugging Options"),
 #endif
-	cmd_opts_desc("") {
+	cmd_opts_desc(""),
+	conf_file_desc("") {
 
 	// BBQ core options (exposed to command line)
 	core_opts_desc.add_options()
@@ -130,13 +131,35 @@ void ConfigurationManager::ParseCommandLine(int argc, char *argv[]) {
 
 }
 
+void ConfigurationManager::LoadConfigurationFile() {
+	if (conf_file_opts)
+		return;
+
+	// Tokenize the whole file once: all the options are unregistered here,
+	// since each module provides its own description later on
+	std::ifstream in(conf_file_path);
+	conf_file_opts.reset(new po::parsed_options(
+		po::parse_config_file(in, conf_file_desc, true)));
+}
+
 void ConfigurationManager::ParseConfigurationFile(
 		po::options_description const & opts_desc,
 		po::variables_map & opts) {
-	std::ifstream in(conf_file_path);
+	po::parsed_options parsed(&opts_desc);
+
+	// Select, among the cached options, the ones known by the module
+	{
+		std::unique_lock<std::mutex> conf_file_ul(conf_file_mtx);
+		LoadConfigurationFile();
+		for (auto const & opt: conf_file_opts->options) {
+			if (opts_desc.find_nothrow(opt.string_key, false) == nullptr)
+				continue;
+			parsed.options.push_back(opt);
+			parsed.options.back().unregistered = false;
+		}
+	}
 
-	// Parse configuration file (allowing for unregistered options)
-	po::store(po::parse_config_file(in, opts_desc, true), opts);
+	po::store(parsed, opts);
 	po::notify(opts);
 
 }
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "bbque/contention_monitor.h"
+
+#include "bbque/resource_accounter.h"
+
+
+#define MODULE_CONFIG "ContentionMonitor"
+#define MODULE_NAMESPACE CONTENTION_MONITOR_NAMESPACE
+
+namespace po = boost::program_options;
+
+namespace bbque {
+
+using CInfo = br::Resource::ContentionInfoType;
+
+
+ContentionMonitor & ContentionMonitor::GetInstance() {
+	static ContentionMonitor instance;
+	return instance;
+}
+
+ContentionMonitor::ContentionMonitor():
+		Worker(),
+		cfm(ConfigurationManager::GetInstance()) {
+
+	// Initialization
+	logger = bu::Logger::GetLogger(CONTENTION_MONITOR_NAMESPACE);
+	assert(logger);
+	logger->Info("ContentionMonitor initialization...");
+
+	// Configuration options
+	try {
+		po::options_description opts_desc("Contention Monitor options");
+		opts_desc.add_options()
+			(MODULE_CONFIG ".period_ms",
+			 po::value<uint32_t>(&period_ms)->default_value(HM_DEFAULT_PERIOD_MS),
+			 "Performance counters sampling period [ms]")
+			(MODULE_CONFIG ".samples_window",
+			 po::value<uint16_t>(&samples_window)->default_value(HM_DEFAULT_SAMPLES_WIN),
+			 "Number of samples for the mean values computation")
+			;
+		po::variables_map opts_vm;
+		cfm.ParseConfigurationFile(opts_desc, opts_vm);
+	}
+	catch(boost::program_options::invalid_option_value ex) {
+		logger->Error("Errors in configuration file [%s]", ex.what());
+	}
+	logger->Info("Sampling period: %d ms, samples window: %d",
+		period_ms, samples_window);
+
+	//---------- Setup Worker
+	Worker::Setup(BBQUE_MODULE_NAME("hm"), CONTENTION_MONITOR_NAMESPACE);
+	Worker::Start();
+}
+
+ContentionMonitor::~ContentionMonitor() {
+	Stop();
+	Worker::Terminate();
+}
+
+
+ContentionMonitor::ExitCode_t ContentionMonitor::Register(
+		std::string const & rp_str,
+		int cpu_id) {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+
+	auto rsrc(ra.GetResource(rp_str));
+	if (rsrc == nullptr) {
+		logger->Warn("Register: no resource to monitor <%s>", rp_str.c_str());
+		return ExitCode_t::ERR_RSRC_MISSING;
+	}
+
+	// Open the system-wide counters on the CPU
+	auto pcpu = std::make_shared<CPUCounters>();
+	pcpu->rsrc = rsrc;
+	pcpu->perf.reset(new bu::Perf(cpu_id));
+	pcpu->cycles       = pcpu->perf->AddCounterHW(CPU_CYCLES);
+	pcpu->instructions = pcpu->perf->AddCounterHW(INSTRUCTIONS);
+	pcpu->llc_misses   = pcpu->perf->AddCounterHC(LLC_RM);
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(3,1,0)
+	pcpu->stalls       = pcpu->perf->AddCounterHW(STALLED_CYCLES_BACKEND);
+#endif
+	if ((pcpu->cycles < 0) || (pcpu->instructions < 0)) {
+		logger->Warn("Register: <%s> performance counters not available "
+			"on CPU %d", rp_str.c_str(), cpu_id);
+		return ExitCode_t::ERR_PERF_OPEN;
+	}
+	if (pcpu->llc_misses < 0)
+		logger->Warn("Register: <%s> LLC misses counter not available",
+			rp_str.c_str());
+	if (pcpu->stalls < 0)
+		logger->Warn("Register: <%s> back-end stalls counter not available",
+			rp_str.c_str());
+	pcpu->perf->Enable();
+
+	rsrc->EnableContentionProfile(samples_window);
+	logger->Info("Register: adding <%s> [cpu=%d] to contention monitoring...",
+		rsrc->Path().c_str(), cpu_id);
+
+	std::unique_lock<std::mutex> cpus_ul(cpus_mtx);
+	cpus.push_back(pcpu);
+
+	return ExitCode_t::OK;
+}
+
+
+void ContentionMonitor::Start(uint32_t _period_ms) {
+	std::unique_lock<std::mutex> worker_status_ul(worker_status_mtx);
+	if ((_period_ms != 0) && (_period_ms != period_ms))
+		period_ms = _period_ms;
+
+	if (started) {
+		logger->Warn("Start: monitoring already started (T = %d ms)...",
+			period_ms);
+		return;
+	}
+
+	logger->Info("Start: starting contention monitoring (T = %d ms)...",
+		period_ms);
+	started = true;
+	worker_status_cv.notify_all();
+}
+
+void ContentionMonitor::Stop() {
+	std::unique_lock<std::mutex> worker_status_ul(worker_status_mtx);
+	if (!started) {
+		logger->Warn("Stop: monitoring already stopped");
+		return;
+	}
+
+	logger->Info("Stop: stopping contention monitoring...");
+	started = false;
+	worker_status_cv.notify_all();
+}
+
+
+void ContentionMonitor::Task() {
+	logger->Debug("Task: waiting for platform to be ready...");
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+	ra.WaitForPlatformReady();
+
+	while (!done) {
+		if (!started) {
+			logger->Debug("Task: monitoring not started");
+			Wait();
+			continue;
+		}
+
+		SampleCounters();
+		std::this_thread::sleep_for(std::chrono::milliseconds(period_ms));
+	}
+	logger->Notice("Task: terminating");
+}
+
+
+double ContentionMonitor::ReadScaled(bu::Perf & perf, int id) {
+	double value   = perf.Read(id);
+	double enabled = perf.Enabled(id);
+	double running = perf.Running(id);
+
+	// Counters multiplexing: scale up the value read
+	if ((running > 0) && (running < enabled))
+		value *= (enabled / running);
+	return value;
+}
+
+
+void ContentionMonitor::SampleCounters() {
+	std::unique_lock<std::mutex> cpus_ul(cpus_mtx);
+
+	for (auto & pcpu: cpus) {
+		auto & perf(*(pcpu->perf));
+		// Read all the counters of the CPU at once
+		if (perf.UpdateAll() < 0) {
+			logger->Warn("SampleCounters: <%s> counters read failed",
+				pcpu->rsrc->Path().c_str());
+			continue;
+		}
+		double cycles = ReadScaled(perf, pcpu->cycles);
+		double instr  = ReadScaled(perf, pcpu->instructions);
+		if ((cycles == 0) || (instr == 0)) {
+			logger->Debug("SampleCounters: <%s> idle",
+				pcpu->rsrc->Path().c_str());
+			continue;
+		}
+
+		double ipc = instr / cycles;
+		pcpu->rsrc->UpdateContentionInfo(CInfo::IPC, ipc);
+
+		double mpki = 0.0;
+		if (pcpu->llc_misses >= 0) {
+			mpki = ReadScaled(perf, pcpu->llc_misses) * 1000.0 / instr;
+			pcpu->rsrc->UpdateContentionInfo(CInfo::LLC_MPKI, mpki);
+		}
+
+		double stalls_perc = 0.0;
+		if (pcpu->stalls >= 0) {
+			stalls_perc = ReadScaled(perf, pcpu->stalls) * 100.0 / cycles;
+			pcpu->rsrc->UpdateContentionInfo(CInfo::MEM_STALLS_PERC, stalls_perc);
+		}
+
+		logger->Debug("SampleCounters: <%s> ipc=%.2f llc_mpki=%.2f stalls=%.1f%%",
+			pcpu->rsrc->Path().c_str(), ipc, mpki, stalls_perc);
+	}
+}
+
+} // namespace bbque
@@ -670,19 +670,26 @@ void DataManager::UpdateData(){
 void DataManager::UpdateResourcesData(){
 	logger->Debug("UpdateData: resources status...");
 
-	// Taking data from Resource accounter and Power Manager
-	std::set<br::ResourcePtr_t> resource_set = ra.GetResourceSet();
-	num_resources = resource_set.size();
+	// Taking data from the last committed snapshot of the Resource
+	// Accounter (no waiting for synchronizations in progress) and from the
+	// Power Manager
+	auto snapshot(ra.GetSnapshot());
+	if (!snapshot) {
+		logger->Debug("UpdateData: resources status not available yet");
+		return;
+	}
+	num_resources = snapshot->entries.size();
 
 	// Updating resource status list
 	res_stats.clear();
-	for (auto & resource_ptr : resource_set) {
-		br::ResourcePathPtr_t resource_path = ra.GetPath(resource_ptr->Path());
+	for (auto & entry : snapshot->entries) {
+		auto const & resource_ptr(entry.second.rsrc);
+		br::ResourcePathPtr_t const & resource_path(entry.second.path);
 		logger->Debug("UpdateData: <%lu>: used=%lu  unreserved=%lu total=%lu",
 			BuildResourceBitset(resource_path),
-			resource_ptr->Used(),
-			resource_ptr->Unreserved(),
-			resource_ptr->Total());
+			entry.second.used,
+			entry.second.unreserved,
+			entry.second.total);
 
 #ifdef CONFIG_BBQUE_PM
 		logger->Debug("UpdateData: <%ld>: temp=%d freq=%d power=%2.2f",
@@ -699,7 +706,7 @@ void DataManager::UpdateResourcesData(){
 		temp_res.id = BuildResourceBitset(resource_path);
 		temp_res.model = resource_ptr->Model();
 		temp_res.occupancy = static_cast<uint8_t>(
-			(float(resource_ptr->Used()) / resource_ptr->Total()) * 100 );
+			(float(entry.second.used) / entry.second.total) * 100 );
 #ifdef CONFIG_BBQUE_PM
 		temp_res.load = static_cast<uint8_t>(
 			resource_ptr->GetPowerInfo(PowerManager::InfoType::LOAD, br::Resource::ValueType::INSTANT));
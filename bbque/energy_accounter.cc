@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/energy_accounter.h"
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "bbque/configuration_manager.h"
+
+/** The fields of /proc/stat "cpu" line: user nice system idle iowait irq
+ * softirq steal */
+#define PROCSTAT_FIELDS  8
+#define PROCSTAT_IDLE    3
+#define PROCSTAT_IOWAIT  4
+
+/** Position of 'utime' in /proc/<pid>/stat, after the command name */
+#define PROCPIDSTAT_UTIME 11
+
+namespace po = boost::program_options;
+
+namespace bbque {
+
+EnergyAccounter & EnergyAccounter::GetInstance() {
+	static EnergyAccounter instance;
+	return instance;
+}
+
+EnergyAccounter::EnergyAccounter():
+		am(ApplicationManager::GetInstance()),
+		pm(PowerManager::GetInstance()),
+		cpu_path(std::make_shared<br::ResourcePath>("sys0.cpu.pe")) {
+	logger = bu::Logger::GetLogger(ENERGY_ACCOUNTER_NAMESPACE);
+	assert(logger);
+
+	ConfigurationManager & cfm(ConfigurationManager::GetInstance());
+	po::variables_map opts_vm;
+	po::options_description opts_desc("EnergyAccounter options");
+	opts_desc.add_options()
+		("PowerManager.procfs_root",
+		 po::value<std::string>(&procfs_root)->default_value(
+			BBQUE_PROCFS_ROOT),
+		 "The root of the procfs tree");
+	cfm.ParseConfigurationFile(opts_desc, opts_vm);
+}
+
+
+void EnergyAccounter::Update() {
+	std::unique_lock<std::mutex> ea_ul(ea_mtx);
+	PowerManager::PMResult pm_result;
+	uint64_t energy_uj;
+	uint64_t busy_ticks;
+
+	pm_result = pm.GetEnergyUsage(cpu_path, energy_uj);
+	if (pm_result != PowerManager::PMResult::OK) {
+		logger->Debug("Update: CPU energy consumption not available");
+		return;
+	}
+	if (!ReadSystemTicks(busy_ticks)) {
+		logger->Error("Update: system CPU time not available");
+		return;
+	}
+
+	uint64_t delta_energy_uj = energy_uj - last_energy_uj;
+	uint64_t delta_busy_ticks = busy_ticks - last_busy_ticks;
+	bool attribute = initialized && (delta_busy_ticks > 0);
+	last_energy_uj  = energy_uj;
+	last_busy_ticks = busy_ticks;
+	initialized = true;
+	logger->Debug("Update: CPU energy: +%lu uJ, CPU time: +%lu ticks",
+		delta_energy_uj, delta_busy_ticks);
+
+	// The RUNNING EXCs of each process
+	std::map<ba::AppPid_t, std::vector<ba::AppPtr_t>> proc_excs;
+	AppsUidMapIt apps_it;
+	ba::AppPtr_t papp = am.GetFirst(ApplicationStatusIF::RUNNING, apps_it);
+	for (; papp; papp = am.GetNext(ApplicationStatusIF::RUNNING, apps_it))
+		proc_excs[papp->Pid()].push_back(papp);
+
+	for (auto & proc_entry: proc_excs) {
+		uint64_t ticks;
+		if (!ReadProcessTicks(proc_entry.first, ticks))
+			continue;
+
+		// First sampling of the process
+		auto ticks_it = proc_ticks.find(proc_entry.first);
+		if (ticks_it == proc_ticks.end()) {
+			proc_ticks.emplace(proc_entry.first, ticks);
+			continue;
+		}
+		uint64_t delta_ticks = ticks - ticks_it->second;
+		ticks_it->second = ticks;
+		if (!attribute)
+			continue;
+
+		// Share of the system CPU time
+		double share = std::min(
+			static_cast<double>(delta_ticks) / delta_busy_ticks, 1.0);
+		uint64_t exc_energy_uj =
+			share * delta_energy_uj / proc_entry.second.size();
+		for (auto & papp: proc_entry.second) {
+			exc_energy[papp->Uid()] += exc_energy_uj;
+			logger->Debug("Update: [%s] CPU share: %5.1f%%, energy: "
+				"+%.3f J (total: %.3f J)",
+				papp->StrId(), share * 100.0, exc_energy_uj / 1e6,
+				exc_energy[papp->Uid()] / 1e6);
+		}
+	}
+
+	Prune();
+}
+
+
+uint64_t EnergyAccounter::GetEnergy(ba::AppUid_t uid) {
+	std::unique_lock<std::mutex> ea_ul(ea_mtx);
+	auto energy_it = exc_energy.find(uid);
+	if (energy_it == exc_energy.end())
+		return 0;
+	return energy_it->second;
+}
+
+
+void EnergyAccounter::Prune() {
+	std::map<ba::AppUid_t, bool> uids;
+	std::map<ba::AppPid_t, bool> pids;
+	AppsUidMapIt apps_it;
+	ba::AppPtr_t papp = am.GetFirst(apps_it);
+	for (; papp; papp = am.GetNext(apps_it)) {
+		uids[papp->Uid()] = true;
+		pids[papp->Pid()] = true;
+	}
+
+	for (auto it = exc_energy.begin(); it != exc_energy.end(); ) {
+		if (uids.count(it->first)) {
+			++it;
+			continue;
+		}
+		logger->Info("EXC [%05d:*:%02d] energy consumption: %.3f J",
+			ba::Application::Uid2Pid(it->first),
+			ba::Application::Uid2Eid(it->first),
+			it->second / 1e6);
+		it = exc_energy.erase(it);
+	}
+
+	for (auto it = proc_ticks.begin(); it != proc_ticks.end(); ) {
+		if (pids.count(it->first))
+			++it;
+		else
+			it = proc_ticks.erase(it);
+	}
+}
+
+
+bool EnergyAccounter::ReadSystemTicks(uint64_t & ticks) const {
+	std::ifstream stat_fd(procfs_root + "/stat");
+	std::string label;
+	if (!(stat_fd >> label) || (label.compare("cpu") != 0))
+		return false;
+
+	ticks = 0;
+	for (int i = 0; i < PROCSTAT_FIELDS; ++i) {
+		uint64_t value;
+		if (!(stat_fd >> value))
+			return false;
+		if ((i != PROCSTAT_IDLE) && (i != PROCSTAT_IOWAIT))
+			ticks += value;
+	}
+	return true;
+}
+
+
+bool EnergyAccounter::ReadProcessTicks(
+		ba::AppPid_t pid,
+		uint64_t & ticks) const {
+	std::ifstream stat_fd(procfs_root + "/" + std::to_string(pid) + "/stat");
+	std::string line;
+	if (!std::getline(stat_fd, line))
+		return false;
+
+	// The command name may contain spaces
+	size_t comm_end = line.rfind(')');
+	if (comm_end == std::string::npos)
+		return false;
+	std::istringstream fields(line.substr(comm_end + 1));
+	std::string field;
+	for (int i = 0; i < PROCPIDSTAT_UTIME; ++i)
+		fields >> field;
+
+	uint64_t utime, stime;
+	if (!(fields >> utime >> stime))
+		return false;
+	ticks = utime + stime;
+	return true;
+}
+
+} // namespace bbque
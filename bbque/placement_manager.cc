@@ -0,0 +1,431 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/placement_manager.h"
+
+#include <algorithm>
+
+#include "bbque/configuration_manager.h"
+#include "bbque/platform_manager.h"
+#include "bbque/resource_accounter.h"
+#include "bbque/resource_manager.h"
+#include "bbque/pp/remote_platform_proxy.h"
+#include "bbque/utils/utility.h"
+
+#define MODULE_NAMESPACE PLACEMENT_MANAGER_NAMESPACE
+#define MODULE_CONFIG    PLACEMENT_MANAGER_CONFIG
+
+namespace po = boost::program_options;
+
+namespace bbque {
+
+bu::MetricsCollector::MetricsCollection_t
+PlacementManager::metrics[4] = {
+	{MODULE_NAMESPACE ".offloaded",
+	 "EXCs offloaded to remote nodes",
+	 bu::MetricsCollector::COUNTER, 0, NULL, 0},
+	{MODULE_NAMESPACE ".recalled",
+	 "EXCs recalled from remote nodes",
+	 bu::MetricsCollector::COUNTER, 0, NULL, 0},
+	{MODULE_NAMESPACE ".rejected",
+	 "Offloading requests rejected by remote nodes",
+	 bu::MetricsCollector::COUNTER, 0, NULL, 0},
+	{MODULE_NAMESPACE ".headroom",
+	 "Local processing headroom [%]",
+	 bu::MetricsCollector::SAMPLE, 0, NULL, 0}
+};
+
+
+PlacementManager & PlacementManager::GetInstance() {
+	static PlacementManager instance;
+	return instance;
+}
+
+PlacementManager::PlacementManager():
+		Worker(),
+		am(ApplicationManager::GetInstance()),
+		mc(bu::MetricsCollector::GetInstance()),
+		last_rebalance(std::chrono::steady_clock::now()) {
+
+	logger = bu::Logger::GetLogger(MODULE_NAMESPACE);
+	assert(logger);
+
+	uint16_t headroom_min_perc, hysteresis_perc, exc_demand_perc;
+	try {
+		po::options_description opts_desc("Placement Manager options");
+		opts_desc.add_options()
+			(MODULE_CONFIG ".enabled",
+			 po::value<bool>(&enabled)->default_value(false),
+			 "Enable the cross-node placement of the EXCs")
+			(MODULE_CONFIG ".headroom_min_perc",
+			 po::value<uint16_t>(&headroom_min_perc)->default_value(
+				BBQUE_PLC_HEADROOM_MIN_PERC),
+			 "Minimum processing headroom [%] before offloading")
+			(MODULE_CONFIG ".hysteresis_perc",
+			 po::value<uint16_t>(&hysteresis_perc)->default_value(
+				BBQUE_PLC_HYSTERESIS_PERC),
+			 "Hysteresis band [%] around the headroom threshold")
+			(MODULE_CONFIG ".exc_demand_perc",
+			 po::value<uint16_t>(&exc_demand_perc)->default_value(
+				BBQUE_PLC_EXC_DEMAND_PERC),
+			 "Estimated processing demand [%] of an EXC")
+			(MODULE_CONFIG ".rebalance_period_ms",
+			 po::value<uint32_t>(&rebalance_period_ms)->default_value(
+				BBQUE_PLC_REBALANCE_PERIOD_MS),
+			 "Period of the placement rebalancing [ms]")
+			(MODULE_CONFIG ".min_residence_ms",
+			 po::value<uint32_t>(&min_residence_ms)->default_value(
+				BBQUE_PLC_MIN_RESIDENCE_MS),
+			 "Minimum time on a node before moving an EXC again [ms]")
+			;
+		po::variables_map opts_vm;
+		ConfigurationManager::GetInstance().ParseConfigurationFile(
+			opts_desc, opts_vm);
+	}
+	catch(boost::program_options::invalid_option_value const & ex) {
+		logger->Error("Errors in configuration file [%s]", ex.what());
+	}
+
+	float headroom_min = std::min<uint16_t>(headroom_min_perc, 100) / 100.0;
+	float hysteresis   = std::min<uint16_t>(hysteresis_perc, 100) / 100.0;
+	float exc_demand   = std::min<uint16_t>(exc_demand_perc, 100) / 100.0;
+	policy = std::unique_ptr<PlacementPolicy>(
+		new PlacementPolicy(headroom_min, hysteresis, exc_demand));
+	logger->Info("Placement: %s, headroom min=%.2f hyst=%.2f demand=%.2f",
+		enabled ? "enabled" : "disabled",
+		headroom_min, hysteresis, exc_demand);
+
+	mc.Register(metrics, 4);
+
+	//---------- Setup Worker
+	if (!enabled)
+		return;
+	Worker::Setup(BBQUE_MODULE_NAME("plc"), PLACEMENT_MANAGER_NAMESPACE);
+	Worker::Start();
+}
+
+PlacementManager::~PlacementManager() {
+	if (enabled)
+		Worker::Terminate();
+}
+
+
+float PlacementManager::LocalFreeFraction() const {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+	auto snapshot(ra.GetSnapshot());
+	if (snapshot == nullptr)
+		return 0.0;
+
+	// Processing elements of the local system only
+	auto const & pd(PlatformProxy::GetPlatformDescription());
+	std::string prefix("sys" + std::to_string(pd.GetLocalSystem().GetId()) + ".");
+	uint64_t total = 0, used = 0;
+	for (auto const & entry: snapshot->entries) {
+		auto const & status(entry.second);
+		if (status.offline
+				|| (status.rsrc->Type() != br::ResourceType::PROC_ELEMENT)
+				|| (entry.first.compare(0, prefix.size(), prefix) != 0))
+			continue;
+		total += status.total;
+		used  += status.used;
+	}
+	if (total == 0)
+		return 0.0;
+
+	return float(total - std::min(used, total)) / total;
+}
+
+float PlacementManager::LocalHeadroom() const {
+	// READY EXCs to schedule on the local node
+	uint32_t ready = 0;
+	AppsUidMapIt apps_it;
+	ba::AppPtr_t papp = am.GetFirst(ba::ApplicationStatusIF::READY, apps_it);
+	for (; papp; papp = am.GetNext(ba::ApplicationStatusIF::READY, apps_it)) {
+		if (!IsPlaced(papp->Uid()))
+			++ready;
+	}
+	return policy->LocalHeadroom(LocalFreeFraction(), ready, hosted.size());
+}
+
+std::map<int, float>
+PlacementManager::RemoteHeadrooms(pp::RemotePlatformProxy & rpp) const {
+	std::map<int, float> headrooms;
+	auto const & pd(PlatformProxy::GetPlatformDescription());
+	for (auto const & sys_entry: pd.GetSystemsAll()) {
+		auto const & sys(sys_entry.second);
+		if (sys.IsLocal())
+			continue;
+		float headroom;
+		if (rpp.GetProcessingHeadroom(sys.GetId(), headroom)
+				!= agent::ExitCode_t::OK) {
+			logger->Debug("RemoteHeadrooms: sys%d status not available",
+				sys.GetId());
+			continue;
+		}
+		headrooms[sys.GetId()] = headroom;
+	}
+	return headrooms;
+}
+
+
+PlacementManager::ExitCode_t PlacementManager::Run() {
+	if (!enabled)
+		return ExitCode_t::SKIPPED;
+
+	PlatformManager & plm(PlatformManager::GetInstance());
+	pp::RemotePlatformProxy & rpp(plm.GetRemotePlatformProxy());
+
+	auto remote(RemoteHeadrooms(rpp));
+	if (remote.empty()) {
+		logger->Debug("Run: no remote nodes available");
+		return ExitCode_t::SKIPPED;
+	}
+
+	RequestBatches_t batches;
+	auto make_request = [](ba::AppPtr_t papp, int16_t awm_id) {
+		agent::ApplicationScheduleRequest request;
+		request.app_id   = papp->Uid();
+		request.app_name = papp->Name();
+		request.awm_id   = awm_id;
+		return request;
+	};
+
+	std::unique_lock<std::mutex> placement_ul(placement_mtx);
+	float local = LocalHeadroom();
+	mc.AddSample(metrics[3].mh, std::max(local, 0.0f) * 100.0);
+	logger->Debug("Run: local headroom = %.2f", local);
+
+	// Release the placements of the EXCs no longer existing
+	for (auto it = placements.begin(); it != placements.end(); ) {
+		if (am.GetApplication(it->first) != nullptr) {
+			++it;
+			continue;
+		}
+		agent::ApplicationScheduleRequest request;
+		request.app_id = it->first;
+		request.awm_id = -1;
+		batches[it->second.system_id].push_back(request);
+		it = placements.erase(it);
+	}
+
+	// Rebalancing: recall the EXCs if the local node has room again, or
+	// the hosting node is overloaded
+	if (ElapsedMs(last_rebalance) >= rebalance_period_ms) {
+		last_rebalance = std::chrono::steady_clock::now();
+		for (auto it = placements.begin(); it != placements.end(); ) {
+			auto & placement(it->second);
+			float remote_headroom = remote.count(placement.system_id) ?
+				remote[placement.system_id] : 0.0;
+			if ((ElapsedMs(placement.since) < min_residence_ms)
+					|| !policy->MustRecall(local, remote_headroom)) {
+				++it;
+				continue;
+			}
+
+			// Exited after the check above: just release the placement
+			auto papp(am.GetApplication(it->first));
+			if (!papp) {
+				agent::ApplicationScheduleRequest request;
+				request.app_id = it->first;
+				request.awm_id = -1;
+				batches[placement.system_id].push_back(request);
+				it = placements.erase(it);
+				continue;
+			}
+			logger->Info("Run: recalling [%s] from sys%d "
+				"[local=%.2f remote=%.2f]",
+				papp->StrId(), placement.system_id,
+				local, remote_headroom);
+			batches[placement.system_id].push_back(make_request(papp, -1));
+			local -= policy->ExcDemand();
+			remote[placement.system_id] += policy->ExcDemand();
+			mc.Count(metrics[1].mh);
+			it = placements.erase(it);
+		}
+	}
+
+	// Offloading: move READY EXCs until the local headroom is back over the
+	// threshold. The EXCs are skipped locally from now on.
+	AppsUidMapIt apps_it;
+	ba::AppPtr_t papp = am.GetFirst(ba::ApplicationStatusIF::READY, apps_it);
+	for (; papp && policy->MustOffload(local);
+			papp = am.GetNext(ba::ApplicationStatusIF::READY, apps_it)) {
+		if (IsPlaced(papp->Uid()))
+			continue;
+
+		float local_before = local;
+		int system_id = policy->SelectTarget(local, remote);
+		if (system_id < 0) {
+			logger->Debug("Run: no remote node can host [%s]",
+				papp->StrId());
+			break;
+		}
+
+		logger->Info("Run: offloading [%s] to sys%d [local=%.2f remote=%.2f]",
+			papp->StrId(), system_id, local_before, remote[system_id]);
+		batches[system_id].push_back(make_request(papp, 0));
+		pending[papp->Uid()] = system_id;
+	}
+	placement_ul.unlock();
+
+	if (batches.empty())
+		return ExitCode_t::OK;
+
+	// Queue the requests for the worker thread
+	std::unique_lock<std::mutex> worker_status_ul(worker_status_mtx);
+	for (auto & batch: batches) {
+		auto & requests(outbox[batch.first]);
+		requests.insert(requests.end(),
+			batch.second.begin(), batch.second.end());
+	}
+	worker_status_cv.notify_all();
+	return ExitCode_t::OK;
+}
+
+void PlacementManager::ReleaseOffloaded(br::RViewToken_t status_view) {
+	if (!enabled)
+		return;
+
+	std::vector<ba::AppUid_t> offloaded;
+	std::unique_lock<std::mutex> placement_ul(placement_mtx);
+	for (auto const & entry: placements)
+		offloaded.push_back(entry.first);
+	for (auto const & entry: pending)
+		offloaded.push_back(entry.first);
+	placement_ul.unlock();
+
+	for (auto uid: offloaded) {
+		auto papp(am.GetApplication(uid));
+		if (!papp || !papp->NextAWM())
+			continue;
+		logger->Debug("ReleaseOffloaded: [%s] scheduled remotely",
+			papp->StrId());
+		am.ScheduleRequestAbort(papp, status_view);
+	}
+}
+
+void PlacementManager::Task() {
+	PlatformManager & plm(PlatformManager::GetInstance());
+	pp::RemotePlatformProxy & rpp(plm.GetRemotePlatformProxy());
+
+	while (!done) {
+		std::unique_lock<std::mutex> worker_status_ul(worker_status_mtx);
+		while (!done && outbox.empty())
+			worker_status_cv.wait(worker_status_ul);
+		if (done)
+			break;
+		RequestBatches_t batches;
+		batches.swap(outbox);
+		worker_status_ul.unlock();
+
+		SendRequests(rpp, batches);
+	}
+	logger->Notice("Task: terminating");
+}
+
+void PlacementManager::SendRequests(
+		pp::RemotePlatformProxy & rpp,
+		RequestBatches_t const & batches) {
+	bool rejected = false;
+
+	for (auto const & batch: batches) {
+		int system_id = batch.first;
+		auto const & requests(batch.second);
+		std::vector<agent::ExitCode_t> results;
+
+		logger->Debug("SendRequests: %d requests to sys%d",
+			requests.size(), system_id);
+		auto ec = rpp.SendScheduleRequests(system_id, requests, results);
+		if (ec != agent::ExitCode_t::OK)
+			logger->Warn("SendRequests: sys%d not reachable [err=%d]",
+				system_id, static_cast<int>(ec));
+
+		std::unique_lock<std::mutex> placement_ul(placement_mtx);
+		for (size_t i = 0; i < requests.size(); ++i) {
+			auto const & request(requests[i]);
+			if (request.awm_id < 0)
+				continue;
+			pending.erase(request.app_id);
+			if ((i >= results.size())
+					|| (results[i] != agent::ExitCode_t::OK)) {
+				logger->Info("SendRequests: [%s] rejected by sys%d",
+					request.app_name.c_str(), system_id);
+				mc.Count(metrics[2].mh);
+				rejected = true;
+				continue;
+			}
+			// If terminated in the meanwhile, released at the next run
+			placements[request.app_id] =
+				{ system_id, std::chrono::steady_clock::now() };
+			mc.Count(metrics[0].mh);
+		}
+	}
+
+	// The rejected EXCs must be scheduled locally
+	if (rejected) {
+		ResourceManager & rm(ResourceManager::GetInstance());
+		rm.NotifyEvent(ResourceManager::BBQ_OPTS);
+	}
+}
+
+
+int PlacementManager::GetPlacement(ba::AppUid_t uid) const {
+	std::unique_lock<std::mutex> placement_ul(placement_mtx);
+	auto it = placements.find(uid);
+	if (it != placements.end())
+		return it->second.system_id;
+	auto pending_it = pending.find(uid);
+	if (pending_it != pending.end())
+		return pending_it->second;
+	return -1;
+}
+
+bool PlacementManager::AcceptRemote(
+		uint32_t sender_id,
+		agent::ApplicationScheduleRequest const & request) {
+	auto key = std::make_pair(sender_id, request.app_id);
+
+	// Release
+	if (request.awm_id < 0) {
+		std::unique_lock<std::mutex> placement_ul(placement_mtx);
+		hosted.erase(key);
+		logger->Info("AcceptRemote: [%s] released by sys%d [hosted=%d]",
+			request.app_name.c_str(), sender_id, hosted.size());
+		return true;
+	}
+
+	if (!enabled) {
+		logger->Debug("AcceptRemote: placement disabled");
+		return false;
+	}
+
+	// Keep enough room to stay out of the hysteresis band
+	std::unique_lock<std::mutex> placement_ul(placement_mtx);
+	float local = LocalHeadroom();
+	if (!policy->CanHost(local)) {
+		logger->Info("AcceptRemote: [%s] from sys%d rejected [headroom=%.2f]",
+			request.app_name.c_str(), sender_id, local);
+		return false;
+	}
+
+	hosted[key] = std::chrono::steady_clock::now();
+	logger->Info("AcceptRemote: [%s] from sys%d accepted [hosted=%d]",
+		request.app_name.c_str(), sender_id, hosted.size());
+	return true;
+}
+
+} // namespace bbque
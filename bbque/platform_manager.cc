@@ -15,10 +15,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <future>
+
 #include "bbque/config.h"
 #include "bbque/platform_manager.h"
 #include "bbque/res/binder.h"
 #include "bbque/res/resource_utils.h"
+#include "bbque/utils/timer.h"
 #include "bbque/resource_manager.h"
 
 namespace bbque
@@ -200,9 +203,25 @@ PlatformManager::ExitCode_t PlatformManager::LoadPlatformData()
 	}
 
 	ExitCode_t ec;
+	bu::Timer load_tmr(true);
+
+#ifdef CONFIG_BBQUE_DIST_MODE
+	// Remote platforms data are retrieved while probing the local one
+	logger->Debug("Loading REMOTE platform data...");
+	auto remote_result = std::async(std::launch::async,
+		[this]() { return this->rpp->LoadPlatformData(); });
+#endif
 
 	logger->Debug("Loading LOCAL platform data...");
 	ec = this->lpp->LoadPlatformData();
+	logger->Info("Startup trace: LOCAL platform data loaded in %.3f ms",
+		load_tmr.getElapsedTimeMs());
+
+#ifdef CONFIG_BBQUE_DIST_MODE
+	ExitCode_t remote_ec = remote_result.get();
+	logger->Info("Startup trace: REMOTE platform data loaded in %.3f ms",
+		load_tmr.getElapsedTimeMs());
+#endif
 
 	if (unlikely(ec != PLATFORM_OK)) {
 		logger->Error("Error %i trying to load LOCAL platform data", ec);
@@ -211,13 +230,10 @@ PlatformManager::ExitCode_t PlatformManager::LoadPlatformData()
 	}
 
 #ifdef CONFIG_BBQUE_DIST_MODE
-	logger->Debug("Loading REMOTE platform data...");
-	ec = this->rpp->LoadPlatformData();
+	if (unlikely(remote_ec != PLATFORM_OK)) {
+		logger->Error("Error %i trying to load REMOTE platform data", remote_ec);
 
-	if (unlikely(ec != PLATFORM_OK)) {
-		logger->Error("Error %i trying to load REMOTE platform data", ec);
-
-		return ec;
+		return remote_ec;
 	}
 #endif
 
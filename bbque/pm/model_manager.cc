@@ -15,6 +15,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <fstream>
+
 #include "bbque/config.h"
 #include "bbque/pm/model_manager.h"
 #include "bbque/pm/models/model_arm_cortexa15.h"
@@ -24,6 +26,9 @@
 
 #define MODULE_MANAGER_NAMESPACE "bq.mm"
 
+/** The state of the online models: one file for each resource */
+#define MODEL_ONLINE_FILE_FMT BBQUE_PATH_VAR "/BBQ_Model_"
+
 namespace bbque  { namespace pm {
 
 
@@ -56,20 +61,111 @@ ModelManager::~ModelManager() {
 }
 
 ModelPtr_t ModelManager::GetModel(std::string const & id) {
-	if (models[id] == nullptr) {
+	std::unique_lock<std::mutex> models_ul(models_mtx);
+	auto m_it = models.find(id);
+	if ((m_it == models.end()) || (m_it->second == nullptr)) {
 		logger->Debug("Model '%s' missing. Using default model (%s)",
 				id.c_str(), default_model->GetID().c_str());
 		return default_model;
 	}
-	return models[id];
+	return m_it->second;
 }
 
 void ModelManager::Register(ModelPtr_t model) {
 	std::string id(model->GetID());
+	std::unique_lock<std::mutex> models_ul(models_mtx);
 	models.insert(std::pair<std::string, ModelPtr_t>(id, model));
 	logger->Info("Registered model '%s'", id.c_str());
 }
 
+#ifdef CONFIG_BBQUE_PM_ONLINE_MODELS
+
+std::string ModelManager::OnlineModelFile(std::string const & r_path) {
+	return MODEL_ONLINE_FILE_FMT + r_path + ".dat";
+}
+
+void ModelManager::Update(
+		std::string const & r_path,
+		OnlineModel::Sample const & sample) {
+	std::unique_lock<std::mutex> models_ul(models_mtx);
+	auto m_it = online_models.find(r_path);
+	if (m_it != online_models.end()) {
+		OnlineModelPtr_t model(m_it->second);
+		models_ul.unlock();
+		model->Update(sample);
+		return;
+	}
+
+	// First sample: create the model, restoring the previous state
+	OnlineModelPtr_t model(std::make_shared<OnlineModel>(
+		r_path, default_model->GetTPD()));
+	std::ifstream ifs(OnlineModelFile(r_path));
+	if (ifs.is_open() && !model->Load(ifs))
+		logger->Warn("Online model '%s': invalid saved state [%s]",
+			r_path.c_str(), OnlineModelFile(r_path).c_str());
+	else if (ifs.is_open())
+		logger->Info("Online model '%s': restored state (%lu samples)",
+			r_path.c_str(), model->Samples());
+	online_models.emplace(r_path, model);
+	models.emplace(r_path, model);
+	logger->Info("Registered model '%s'", r_path.c_str());
+	models_ul.unlock();
+
+	model->Update(sample);
+}
+
+ModelPtr_t ModelManager::GetResourceModel(
+		std::string const & r_path,
+		std::string const & id) {
+	std::unique_lock<std::mutex> models_ul(models_mtx);
+	auto m_it = online_models.find(r_path);
+	if ((m_it != online_models.end()) && m_it->second->Trained())
+		return m_it->second;
+	models_ul.unlock();
+	return GetModel(id);
+}
+
+ModelPtr_t ModelManager::GetResourceModel(
+		std::string const & r_path,
+		std::vector<std::string> const & r_paths,
+		std::string const & id) {
+	std::unique_lock<std::mutex> models_ul(models_mtx);
+	auto m_it = online_models.find(r_path);
+	if ((m_it != online_models.end()) && m_it->second->Trained())
+		return m_it->second;
+
+	std::vector<OnlineModelPtr_t> group;
+	for (auto const & path: r_paths) {
+		m_it = online_models.find(path);
+		if ((m_it == online_models.end()) || !m_it->second->Trained())
+			break;
+		group.push_back(m_it->second);
+	}
+	models_ul.unlock();
+
+	if (group.empty() || (group.size() < r_paths.size()))
+		return GetModel(id);
+	return std::make_shared<OnlineModelGroup>(r_path, group);
+}
+
+void ModelManager::SaveOnlineModels() {
+	std::unique_lock<std::mutex> models_ul(models_mtx);
+	for (auto & m_entry: online_models) {
+		std::ofstream ofs(OnlineModelFile(m_entry.first));
+		if (!ofs.is_open()) {
+			logger->Error("Online model '%s': cannot save the state [%s]",
+				m_entry.first.c_str(),
+				OnlineModelFile(m_entry.first).c_str());
+			continue;
+		}
+		m_entry.second->Save(ofs);
+		logger->Debug("Online model '%s': saved state (%lu samples)",
+			m_entry.first.c_str(), m_entry.second->Samples());
+	}
+}
+
+#endif // CONFIG_BBQUE_PM_ONLINE_MODELS
+
 } // namespace pm
 
 } // namespace bbque
@@ -0,0 +1,297 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/pm/models/model_online.h"
+
+#include <algorithm>
+#include <cmath>
+#include <istream>
+#include <limits>
+#include <ostream>
+
+// Version of the saved state format
+#define MODEL_ONLINE_STATE_VERSION 1
+
+namespace bbque  { namespace pm {
+
+
+template <size_t N>
+void RecursiveLeastSquares<N>::Save(std::ostream & os) const {
+	for (size_t i = 0; i < N; ++i)
+		os << theta[i] << " ";
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+			os << P[i][j] << " ";
+	os << "\n";
+}
+
+template <size_t N>
+bool RecursiveLeastSquares<N>::Load(std::istream & is) {
+	Vector_t _theta;
+	std::array<Vector_t, N> _P;
+	for (size_t i = 0; i < N; ++i)
+		is >> _theta[i];
+	for (size_t i = 0; i < N; ++i)
+		for (size_t j = 0; j < N; ++j)
+			is >> _P[i][j];
+	if (!is)
+		return false;
+	for (size_t i = 0; i < N; ++i) {
+		if (!std::isfinite(_theta[i]))
+			return false;
+		for (size_t j = 0; j < N; ++j)
+			if (!std::isfinite(_P[i][j]))
+				return false;
+	}
+	theta = _theta;
+	P = _P;
+	return true;
+}
+
+template class RecursiveLeastSquares<4>;
+template class RecursiveLeastSquares<3>;
+
+
+OnlineModel::OnlineModel(std::string const & _id, uint32_t _tpd):
+	Model(_id, _tpd) {
+}
+
+RecursiveLeastSquares<4>::Vector_t OnlineModel::PowerRegressors(
+		double load,
+		double freq) {
+	return { 1.0, freq, load * freq, load * freq * freq * freq };
+}
+
+void OnlineModel::Update(Sample const & sample) {
+	// Power monitoring not available
+	if ((sample.power_mw == 0) || (sample.freq_khz == 0))
+		return;
+
+	double load  = std::min<double>(sample.load, 100) / 100.0;
+	double freq  = sample.freq_khz / 1e6;
+	double power = sample.power_mw / 1e3;
+	double temp  = (sample.temp > 1000) ? sample.temp / 1e3 : sample.temp;
+
+	std::unique_lock<std::mutex> ul(mtx);
+	if ((std::fabs(load - fit_load) >= BBQUE_MODEL_ONLINE_LOAD_STEP) ||
+			(freq != fit_freq)) {
+		power_rls.Update(PowerRegressors(load, freq), power);
+		fit_load = load;
+		fit_freq = freq;
+		++nr_samples;
+	}
+
+	if ((temp > 0) && (last_temp > 0) &&
+			((std::fabs(power - fit_power) >=
+				BBQUE_MODEL_ONLINE_POWER_STEP * power) ||
+			(std::fabs(last_temp - fit_temp) >=
+				BBQUE_MODEL_ONLINE_TEMP_STEP))) {
+		thermal_rls.Update({ 1.0, power, last_temp }, temp);
+		fit_power = power;
+		fit_temp  = last_temp;
+	}
+	last_freq = freq;
+	last_temp = temp;
+}
+
+bool OnlineModel::ThermalValid() const {
+	auto const & b(thermal_rls.Parameters());
+	// Stable first-order response, with the temperature increasing with the
+	// power
+	return (std::fabs(b[2]) < 1.0) && (b[1] > 0);
+}
+
+double OnlineModel::LoadFromPower(double power) {
+	auto const & a(power_rls.Parameters());
+	double f = last_freq;
+	double dyn = a[2] * f + a[3] * f * f * f;
+	// The load does not change the power consumption
+	if (dyn <= std::numeric_limits<float>::epsilon())
+		return 1.0;
+	return (power - a[0] - a[1] * f) / dyn;
+}
+
+uint32_t OnlineModel::GetPowerFromLoad(uint32_t load, uint32_t freq_khz) {
+	std::unique_lock<std::mutex> ul(mtx);
+	double power = power_rls.Predict(PowerRegressors(
+		std::min<double>(load, 100) / 100.0, freq_khz / 1e6));
+	return static_cast<uint32_t>(std::max(power, 0.0) * 1e3);
+}
+
+uint32_t OnlineModel::GetPowerFromTemperature(
+		uint32_t temp_mc,
+		std::string const & freq_governor) {
+	std::unique_lock<std::mutex> ul(mtx);
+	if (!Trained() || !ThermalValid())
+		return Model::GetPowerFromTemperature(temp_mc, freq_governor);
+
+	// Steady state: T = (b0 + b1*P) / (1 - b2)
+	auto const & b(thermal_rls.Parameters());
+	double power = (temp_mc / 1e3 * (1 - b[2]) - b[0]) / b[1];
+	return static_cast<uint32_t>(std::max(power, 0.0) * 1e3);
+}
+
+uint32_t OnlineModel::GetPowerFromSystemBudget(
+		uint32_t power_mw,
+		std::string const & freq_governor) {
+	std::unique_lock<std::mutex> ul(mtx);
+	if (!Trained())
+		return Model::GetPowerFromSystemBudget(power_mw, freq_governor);
+
+	// The resource cannot draw more than its full load consumption
+	double power_max = power_rls.Predict(PowerRegressors(1.0, last_freq));
+	power_max = std::max(power_max, 0.0) * 1e3;
+	return static_cast<uint32_t>(std::min<double>(power_mw, power_max));
+}
+
+uint32_t OnlineModel::GetTemperatureFromPower(
+		uint32_t power_mw,
+		std::string const & freq_governor) {
+	std::unique_lock<std::mutex> ul(mtx);
+	if (!Trained() || !ThermalValid())
+		return Model::GetTemperatureFromPower(power_mw, freq_governor);
+
+	auto const & b(thermal_rls.Parameters());
+	double temp = (b[0] + b[1] * power_mw / 1e3) / (1 - b[2]);
+	return static_cast<uint32_t>(std::max(temp, 0.0) * 1e3);
+}
+
+float OnlineModel::GetResourcePercentageFromPower(
+		uint32_t power_mw,
+		std::string const & freq_governor) {
+	std::unique_lock<std::mutex> ul(mtx);
+	if (!Trained())
+		return Model::GetResourcePercentageFromPower(power_mw, freq_governor);
+
+	double load = LoadFromPower(power_mw / 1e3);
+	return static_cast<float>(std::min(std::max(load, 0.0), 1.0));
+}
+
+uint32_t OnlineModel::GetResourceFromPower(
+		uint32_t power_mw,
+		uint32_t total_amount,
+		std::string const & freq_governor) {
+	std::unique_lock<std::mutex> ul(mtx);
+	if (!Trained()) {
+		ul.unlock();
+		return Model::GetResourceFromPower(
+			power_mw, total_amount, freq_governor);
+	}
+
+	double load = LoadFromPower(power_mw / 1e3);
+	return static_cast<uint32_t>(
+		total_amount * std::min(std::max(load, 0.0), 1.0));
+}
+
+void OnlineModel::Save(std::ostream & os) {
+	std::unique_lock<std::mutex> ul(mtx);
+	os.precision(std::numeric_limits<double>::max_digits10);
+	os << MODEL_ONLINE_STATE_VERSION << " " << nr_samples << " "
+		<< last_freq << " " << last_temp << "\n";
+	power_rls.Save(os);
+	thermal_rls.Save(os);
+}
+
+bool OnlineModel::Load(std::istream & is) {
+	int version;
+	uint64_t _nr_samples;
+	double _last_freq, _last_temp;
+	is >> version >> _nr_samples >> _last_freq >> _last_temp;
+	if (!is || (version != MODEL_ONLINE_STATE_VERSION))
+		return false;
+
+	RecursiveLeastSquares<4> _power_rls;
+	RecursiveLeastSquares<3> _thermal_rls(BBQUE_MODEL_ONLINE_THERMAL_FORGETTING);
+	if (!_power_rls.Load(is) || !_thermal_rls.Load(is))
+		return false;
+
+	std::unique_lock<std::mutex> ul(mtx);
+	power_rls   = _power_rls;
+	thermal_rls = _thermal_rls;
+	nr_samples  = _nr_samples;
+	last_freq   = _last_freq;
+	last_temp   = _last_temp;
+	return true;
+}
+
+
+OnlineModelGroup::OnlineModelGroup(
+		std::string const & _id,
+		std::vector<std::shared_ptr<OnlineModel>> const & _models):
+	Model(_id, 0),
+	models(_models) {
+	for (auto & model: models)
+		tpd += model->GetTPD();
+}
+
+uint32_t OnlineModelGroup::GetPowerFromTemperature(
+		uint32_t temp_mc,
+		std::string const & freq_governor) {
+	uint32_t power = 0;
+	for (auto & model: models)
+		power += model->GetPowerFromTemperature(temp_mc, freq_governor);
+	return power;
+}
+
+uint32_t OnlineModelGroup::GetPowerFromSystemBudget(
+		uint32_t power_mw,
+		std::string const & freq_governor) {
+	uint32_t power = 0;
+	for (auto & model: models)
+		power += model->GetPowerFromSystemBudget(
+			power_mw / models.size(), freq_governor);
+	return power;
+}
+
+uint32_t OnlineModelGroup::GetTemperatureFromPower(
+		uint32_t power_mw,
+		std::string const & freq_governor) {
+	uint32_t temp = 0;
+	for (auto & model: models)
+		temp = std::max(temp, model->GetTemperatureFromPower(
+			power_mw / models.size(), freq_governor));
+	return temp;
+}
+
+float OnlineModelGroup::GetResourcePercentageFromPower(
+		uint32_t power_mw,
+		std::string const & freq_governor) {
+	float perc = 0;
+	for (auto & model: models)
+		perc += model->GetResourcePercentageFromPower(
+			power_mw / models.size(), freq_governor);
+	return perc / models.size();
+}
+
+uint32_t OnlineModelGroup::GetResourceFromPower(
+		uint32_t power_mw,
+		uint32_t total_amount,
+		std::string const & freq_governor) {
+	uint32_t amount = 0;
+	for (size_t i = 0; i < models.size(); ++i) {
+		// The share of the total amount of each resource
+		uint32_t share = (uint64_t) total_amount * (i + 1) / models.size()
+			- (uint64_t) total_amount * i / models.size();
+		amount += models[i]->GetResourceFromPower(
+			power_mw / models.size(), share, freq_governor);
+	}
+	return amount;
+}
+
+} // namespace pm
+
+} // namespace bbque
@@ -43,6 +43,9 @@
 #ifdef CONFIG_TARGET_ARM_CORTEX_A9
 # include "bbque/pm/power_manager_cpu_arm_cortexa9.h"
 #endif // CONFIG_TARGET_FREESCALE_IMX6Q
+#ifdef CONFIG_BBQUE_PM_POWERCAP
+# include "bbque/pm/power_manager_cpu_powercap.h"
+#endif // CONFIG_BBQUE_PM_POWERCAP
 #endif
 
 #ifdef CONFIG_BBQUE_PM_MANGO
@@ -136,10 +139,16 @@ PowerManager::PowerManager() {
 		std::shared_ptr<PowerManager>(new ARM_CortexA9_CPUPowerManager());
 	return;
 # endif
+# ifdef CONFIG_BBQUE_PM_POWERCAP
+	logger->Notice("Using powercap (RAPL) CPU power management module");
+	device_managers[br::ResourceType::CPU] =
+		std::shared_ptr<PowerManager>(new PowercapCPUPowerManager());
+# else
 	// Generic
 	logger->Notice("Using generic CPU power management module");
 	device_managers[br::ResourceType::CPU] =
 		std::shared_ptr<PowerManager>(new CPUPowerManager());
+# endif
 #endif // CONFIG_BBQUE_PM_CPU
 
 	// MANGO accelerators
@@ -357,6 +366,30 @@ PowerManager::GetPowerInfo(
 	return dm->GetPowerInfo(rp, mwatt_min, mwatt_max);
 }
 
+PowerManager::PMResult
+PowerManager::GetEnergyUsage(br::ResourcePathPtr_t const & rp, uint64_t &ujoule) {
+	auto dm = GetDeviceManager(rp, "GetEnergyUsage");
+	if (dm == nullptr)
+		return PMResult::ERR_API_NOT_SUPPORTED;
+	return dm->GetEnergyUsage(rp, ujoule);
+}
+
+PowerManager::PMResult
+PowerManager::GetPowerCap(br::ResourcePathPtr_t const & rp, uint32_t &mwatt) {
+	auto dm = GetDeviceManager(rp, "GetPowerCap");
+	if (dm == nullptr)
+		return PMResult::ERR_API_NOT_SUPPORTED;
+	return dm->GetPowerCap(rp, mwatt);
+}
+
+PowerManager::PMResult
+PowerManager::SetPowerCap(br::ResourcePathPtr_t const & rp, uint32_t mwatt) {
+	auto dm = GetDeviceManager(rp, "SetPowerCap");
+	if (dm == nullptr)
+		return PMResult::ERR_API_NOT_SUPPORTED;
+	return dm->SetPowerCap(rp, mwatt);
+}
+
 PowerManager::PMResult
 PowerManager::GetPowerState(br::ResourcePathPtr_t const & rp, uint32_t &state) {
 	auto dm = GetDeviceManager(rp, "GetPowerState");
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/pm/power_manager_cpu_powercap.h"
+
+#include "bbque/configuration_manager.h"
+
+namespace po  = boost::program_options;
+
+namespace bbque {
+
+
+PowercapCPUPowerManager::PowercapCPUPowerManager() {
+	ConfigurationManager & cfm(ConfigurationManager::GetInstance());
+	po::variables_map opts_vm;
+	po::options_description opts_desc("PowerManager powercap options");
+	opts_desc.add_options()
+		("PowerManager.sysfs_root",
+		 po::value<std::string>(&sysfs_root)->default_value(
+			BBQUE_PM_POWERCAP_SYSFS_ROOT),
+		 "The root of the sysfs tree");
+	cfm.ParseConfigurationFile(opts_desc, opts_vm);
+
+	zones = std::unique_ptr<PowercapZones>(new PowercapZones(sysfs_root));
+	if (zones->Zones().empty()) {
+		logger->Warn("Powercap: no RAPL zones available in <%s>",
+			zones->ClassDir().c_str());
+		return;
+	}
+	for (auto const & zone: zones->Zones())
+		logger->Info("Powercap: <%s> zone '%s' (package %d)",
+			zone.dir.c_str(), zone.name.c_str(), zone.package);
+}
+
+PowercapCPUPowerManager::~PowercapCPUPowerManager() {
+	// The power limits are restored by the zones
+	for (auto const & zone: zones->Zones()) {
+		if (zone.limit_changed)
+			logger->Notice("Powercap: restoring <%s> power limit: %lu uW",
+				zone.dir.c_str(), zone.orig_limit_uw);
+	}
+	zones.reset();
+}
+
+
+std::vector<PowercapZones::Zone_t *>
+PowercapCPUPowerManager::GetZones(br::ResourcePathPtr_t const & rp) {
+	return zones->Select(
+		rp->GetID(br::ResourceType::CPU),
+		rp->IncludesType(br::ResourceType::MEMORY));
+}
+
+
+PowerManager::PMResult
+PowercapCPUPowerManager::GetPowerUsage(
+		br::ResourcePathPtr_t const & rp,
+		uint32_t & mwatt) {
+	std::unique_lock<std::mutex> zones_ul(zones_mtx);
+	mwatt = 0;
+	auto rp_zones(GetZones(rp));
+	if (rp_zones.empty())
+		return PMResult::ERR_INFO_NOT_SUPPORTED;
+
+	zones->Sample();
+	for (auto zone: rp_zones)
+		mwatt += zone->power_mw;
+	return PMResult::OK;
+}
+
+PowerManager::PMResult
+PowercapCPUPowerManager::GetPowerInfo(
+		br::ResourcePathPtr_t const & rp,
+		uint32_t & mwatt_min,
+		uint32_t & mwatt_max) {
+	std::unique_lock<std::mutex> zones_ul(zones_mtx);
+	mwatt_min = 0;
+	mwatt_max = 0;
+	auto rp_zones(GetZones(rp));
+	if (rp_zones.empty())
+		return PMResult::ERR_INFO_NOT_SUPPORTED;
+
+	for (auto zone: rp_zones) {
+		uint64_t max_uw;
+		if (!zones->GetMaxPower(*zone, max_uw))
+			return PMResult::ERR_SENSORS_ERROR;
+		mwatt_max += max_uw / 1000;
+	}
+	return PMResult::OK;
+}
+
+PowerManager::PMResult
+PowercapCPUPowerManager::GetEnergyUsage(
+		br::ResourcePathPtr_t const & rp,
+		uint64_t & ujoule) {
+	std::unique_lock<std::mutex> zones_ul(zones_mtx);
+	ujoule = 0;
+	auto rp_zones(GetZones(rp));
+	if (rp_zones.empty())
+		return PMResult::ERR_INFO_NOT_SUPPORTED;
+
+	zones->Sample();
+	for (auto zone: rp_zones)
+		ujoule += zone->energy_uj;
+	return PMResult::OK;
+}
+
+
+PowerManager::PMResult
+PowercapCPUPowerManager::GetPowerCap(
+		br::ResourcePathPtr_t const & rp,
+		uint32_t & mwatt) {
+	std::unique_lock<std::mutex> zones_ul(zones_mtx);
+	mwatt = 0;
+	auto rp_zones(GetZones(rp));
+	if (rp_zones.empty())
+		return PMResult::ERR_INFO_NOT_SUPPORTED;
+
+	for (auto zone: rp_zones) {
+		uint64_t limit_uw;
+		if (!zones->GetLimit(*zone, limit_uw))
+			return PMResult::ERR_SENSORS_ERROR;
+		mwatt += limit_uw / 1000;
+	}
+	return PMResult::OK;
+}
+
+PowerManager::PMResult
+PowercapCPUPowerManager::SetPowerCap(
+		br::ResourcePathPtr_t const & rp,
+		uint32_t mwatt) {
+	std::unique_lock<std::mutex> zones_ul(zones_mtx);
+	auto rp_zones(GetZones(rp));
+	if (rp_zones.empty())
+		return PMResult::ERR_INFO_NOT_SUPPORTED;
+
+	// The cap is evenly split among the zones referenced
+	uint64_t limit_uw = static_cast<uint64_t>(mwatt) * 1000 / rp_zones.size();
+	for (auto zone: rp_zones) {
+		if (!zones->SetLimit(*zone, limit_uw)) {
+			logger->Error("Powercap: <%s> power limit setting failed",
+				zone->dir.c_str());
+			return PMResult::ERR_SENSORS_ERROR;
+		}
+		logger->Debug("Powercap: <%s> power limit: %lu uW",
+			zone->dir.c_str(), limit_uw);
+	}
+	return PMResult::OK;
+}
+
+} // namespace bbque
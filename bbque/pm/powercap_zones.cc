@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/pm/powercap_zones.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+
+#include "bbque/utils/iofs.h"
+
+#define POWERCAP_ENERGY_FILE     "/energy_uj"
+#define POWERCAP_MAX_ENERGY_FILE "/max_energy_range_uj"
+#define POWERCAP_NAME_FILE       "/name"
+#define POWERCAP_LIMIT_FILE      "/constraint_0_power_limit_uw"
+#define POWERCAP_MAX_POWER_FILE  "/constraint_0_max_power_uw"
+
+namespace bfs = boost::filesystem;
+namespace bu  = bbque::utils;
+
+namespace bbque {
+
+
+/** Read an unsigned 64-bit value from an attribute file */
+static bool ReadUInt64From(std::string const & filepath, uint64_t & value) {
+	std::string value_str;
+	if (bu::IoFs::ReadValueFrom(filepath, value_str) != bu::IoFs::OK)
+		return false;
+	char * end;
+	value = std::strtoull(value_str.c_str(), &end, 10);
+	return (end != value_str.c_str());
+}
+
+
+PowercapZones::PowercapZones(std::string const & sysfs_root):
+		class_dir(sysfs_root + BBQUE_PM_POWERCAP_CLASS_DIR) {
+	InitZones();
+
+	// Reference sampling
+	for (auto & zone: zones)
+		ReadEnergy(zone, zone.last_energy_uj);
+	sample_tmr.start();
+}
+
+PowercapZones::~PowercapZones() {
+	for (auto & zone: zones) {
+		if (zone.limit_changed)
+			bu::IoFs::WriteValueTo<uint64_t>(
+				zone.dir + POWERCAP_LIMIT_FILE, zone.orig_limit_uw);
+		if (zone.energy_fd >= 0)
+			::close(zone.energy_fd);
+	}
+	zones.clear();
+}
+
+
+void PowercapZones::InitZones() {
+	if (!bfs::is_directory(class_dir))
+		return;
+
+	// Zones ordered by name, such that sub-zones follow their package
+	std::vector<std::string> zone_dirs;
+	for (bfs::directory_iterator it(class_dir), end; it != end; ++it) {
+		std::string dir_name(it->path().filename().string());
+		if (dir_name.find(BBQUE_PM_POWERCAP_RAPL_PREFIX) == 0)
+			zone_dirs.push_back(it->path().string());
+	}
+	std::sort(zone_dirs.begin(), zone_dirs.end());
+
+	int package = -1;
+	for (auto const & dir: zone_dirs) {
+		Zone_t zone;
+		zone.dir = dir;
+		if (bu::IoFs::ReadValueFrom(dir + POWERCAP_NAME_FILE, zone.name)
+				!= bu::IoFs::OK)
+			continue;
+		zone.name.erase(zone.name.find_last_not_of(" \n") + 1);
+
+		// "package-N": the sub-zones (e.g. "core", "dram") that follow
+		// belong to package N
+		if (zone.name.find("package-") == 0)
+			package = std::atoi(zone.name.substr(8).c_str());
+		if (package < 0)
+			continue;
+		zone.package = package;
+
+		zone.energy_fd = ::open((dir + POWERCAP_ENERGY_FILE).c_str(), O_RDONLY);
+		if (zone.energy_fd < 0)
+			continue;
+		ReadUInt64From(dir + POWERCAP_MAX_ENERGY_FILE, zone.max_energy_uj);
+		ReadUInt64From(dir + POWERCAP_LIMIT_FILE, zone.orig_limit_uw);
+		zones.push_back(std::move(zone));
+	}
+}
+
+
+bool PowercapZones::ReadEnergy(Zone_t const & zone, uint64_t & ujoule) const {
+	char buff[32];
+	ssize_t len = ::pread(zone.energy_fd, buff, sizeof(buff) - 1, 0);
+	if (len <= 0)
+		return false;
+	buff[len] = '\0';
+	ujoule = std::strtoull(buff, nullptr, 10);
+	return true;
+}
+
+
+void PowercapZones::Sample() {
+	double elapsed_us = sample_tmr.getElapsedTimeUs();
+	if (elapsed_us < BBQUE_PM_POWERCAP_SAMPLE_MS * 1e3)
+		return;
+	sample_tmr.start();
+	sample_us = elapsed_us;
+
+	// All the counters in a single pass, to keep the packages consistent
+	for (auto & zone: zones) {
+		uint64_t curr_uj;
+		if (!ReadEnergy(zone, curr_uj))
+			continue;
+
+		uint64_t delta_uj = EnergyDelta(
+			zone.last_energy_uj, curr_uj, zone.max_energy_uj);
+		zone.last_energy_uj = curr_uj;
+		zone.energy_uj += delta_uj;
+		zone.power_mw = static_cast<uint32_t>(delta_uj * 1e3 / sample_us);
+	}
+}
+
+
+std::vector<PowercapZones::Zone_t *>
+PowercapZones::Select(int package, bool dram) {
+	std::vector<Zone_t *> selected;
+	for (auto & zone: zones) {
+		if ((package >= 0) && (zone.package != package))
+			continue;
+		if (dram && (zone.name.compare("dram") == 0))
+			selected.push_back(&zone);
+		else if (!dram && (zone.name.find("package-") == 0))
+			selected.push_back(&zone);
+	}
+	return selected;
+}
+
+
+bool PowercapZones::GetLimit(Zone_t const & zone, uint64_t & limit_uw) const {
+	return ReadUInt64From(zone.dir + POWERCAP_LIMIT_FILE, limit_uw);
+}
+
+bool PowercapZones::SetLimit(Zone_t & zone, uint64_t limit_uw) {
+	if (bu::IoFs::WriteValueTo<uint64_t>(
+			zone.dir + POWERCAP_LIMIT_FILE, limit_uw) != bu::IoFs::OK)
+		return false;
+	zone.limit_changed = true;
+	return true;
+}
+
+bool PowercapZones::GetMaxPower(Zone_t const & zone, uint64_t & max_uw) const {
+	return ReadUInt64From(zone.dir + POWERCAP_MAX_POWER_FILE, max_uw);
+}
+
+} // namespace bbque
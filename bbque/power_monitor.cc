@@ -21,6 +21,9 @@
 #include <string>
 
 #include "bbque/power_monitor.h"
+#ifdef CONFIG_BBQUE_PM_ONLINE_MODELS
+#include "bbque/pm/model_manager.h"
+#endif
 
 #include "bbque/resource_accounter.h"
 #include "bbque/res/resource_path.h"
@@ -203,12 +206,14 @@ PowerMonitor::~PowerMonitor() {
 }
 
 void PowerMonitor::Task() {
-	logger->Debug("Monitor: waiting for platform to be ready...");
+	logger->Debug("Monitor: waiting for platform to be loaded...");
 	ResourceAccounter & ra(ResourceAccounter::GetInstance());
-	ra.WaitForPlatformReady();
+	ra.WaitForSnapshot();
 	std::vector<std::thread> samplers(nr_threads);
 
+	std::unique_lock<std::mutex> register_ul(wm_info.register_mtx);
 	uint16_t nr_resources_to_monitor = wm_info.resources.size();
+	register_ul.unlock();
 	uint16_t nr_resources_per_thread = nr_resources_to_monitor;
 	uint16_t nr_resources_left = 0;
 	if (nr_resources_to_monitor > nr_threads) {
@@ -296,7 +301,9 @@ PowerMonitor::ExitCode_t PowerMonitor::Register(
 
 	// Register each resource to monitor, specifying the number of samples to
 	// consider in the (exponential) mean computation and the output log file
-	// descriptor
+	// descriptor. The platform proxies can register their resources from
+	// parallel loading threads.
+	std::unique_lock<std::mutex> register_ul(wm_info.register_mtx);
 	for (auto & rsrc: r_list) {
 		rsrc->EnablePowerProfile(samples_window);
 		logger->Info("Register: adding <%s> to power monitoring...",
@@ -346,6 +353,9 @@ void PowerMonitor::Stop() {
 	logger->Info("Stop: stopping power logging...");
 	events.reset(WM_EVENT_UPDATE);
 	worker_status_cv.notify_all();
+#ifdef CONFIG_BBQUE_PM_ONLINE_MODELS
+	pm::ModelManager::GetInstance().SaveOnlineModels();
+#endif
 }
 
 
@@ -426,6 +436,11 @@ void  PowerMonitor::SampleResourcesStatus(
 			uint info_count = 0;
 			logger->Debug("SampleResourcesStatus: [thread %d] monitoring <%s>",
 				thd_id, r_path->ToString().c_str());
+#ifdef CONFIG_BBQUE_PM_ONLINE_MODELS
+			// Not sampled information must not be taken from the previous
+			// resource
+			samples.fill(0);
+#endif
 
 			for (; info_idx < PowerManager::InfoTypeIndex.size() &&
 					info_count < rsrc->GetPowerInfoEnabledCount();
@@ -465,6 +480,14 @@ void  PowerMonitor::SampleResourcesStatus(
 			if (wm_info.log_enabled) {
 				DataLogWrite(r_path, i_values);
 			}
+#ifdef CONFIG_BBQUE_PM_ONLINE_MODELS
+			// Online power-thermal model of the resource
+			pm::ModelManager::GetInstance().Update(r_path->ToString(), {
+				samples[int(PowerManager::InfoType::LOAD)],
+				samples[int(PowerManager::InfoType::FREQUENCY)],
+				samples[int(PowerManager::InfoType::POWER)],
+				samples[int(PowerManager::InfoType::TEMPERATURE)] });
+#endif
 		}
 
 		std::this_thread::sleep_for(std::chrono::milliseconds(wm_info.period_ms));
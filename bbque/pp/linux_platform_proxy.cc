@@ -39,6 +39,10 @@
 #include "bbque/power_monitor.h"
 #endif
 
+#ifdef CONFIG_BBQUE_CONTENTION_MONITOR
+#include "bbque/contention_monitor.h"
+#endif
+
 #ifdef CONFIG_BBQUE_LINUX_CG_NET_BANDWIDTH
 #include <asm/types.h>
 #include <linux/if_ether.h>
@@ -963,6 +967,10 @@ void LinuxPlatformProxy::InitPowerInfo(
 	wm.Register(resourcePath);
 	logger->Debug("InitPowerInfo: [%s] registered for monitoring", resourcePath);
 #endif
+#ifdef CONFIG_BBQUE_CONTENTION_MONITOR
+	ContentionMonitor & hm(ContentionMonitor::GetInstance());
+	hm.Register(resourcePath, core_id);
+#endif
 
 }
 
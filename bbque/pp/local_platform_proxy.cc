@@ -1,3 +1,6 @@
+#include <future>
+#include <vector>
+
 #include "bbque/pp/local_platform_proxy.h"
 #include "bbque/pp/test_platform_proxy.h"
 #include "bbque/config.h"
@@ -95,21 +98,27 @@ LocalPlatformProxy::ExitCode_t LocalPlatformProxy::Setup(SchedPtr_t papp) {
 
 
 LocalPlatformProxy::ExitCode_t LocalPlatformProxy::LoadPlatformData() {
-	ExitCode_t ec;
+	std::vector<std::future<ExitCode_t>> results;
 
-	ec = this->host->LoadPlatformData();
-	if (ec != PLATFORM_OK) {
-		return ec;
+	// The auxiliary platforms (accelerators) are probed in parallel with
+	// the host, each one registering its own resources
+	for (auto it=this->aux.begin() ; it < this->aux.end(); it++) {
+		PlatformProxy * pp = it->get();
+		results.push_back(std::async(std::launch::async,
+			[pp]() { return pp->LoadPlatformData(); }));
 	}
 
-	for (auto it=this->aux.begin() ; it < this->aux.end(); it++) {
-		ec = (*it)->LoadPlatformData();
-		if (ec != PLATFORM_OK) {
-			return ec;
-		}
+	ExitCode_t ec = this->host->LoadPlatformData();
+
+	// Wait for all the auxiliary platforms, even in case of errors, since
+	// they are still accessing the resource accounter
+	for (auto & result: results) {
+		ExitCode_t aux_ec = result.get();
+		if ((ec == PLATFORM_OK) && (aux_ec != PLATFORM_OK))
+			ec = aux_ec;
 	}
 
-	return PLATFORM_OK;
+	return ec;
 }
 
 
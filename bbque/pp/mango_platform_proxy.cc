@@ -798,6 +798,7 @@ MangoPlatformProxy::ReclaimResources(SchedPtr_t sched) noexcept {
 
 	// Release resources by navigating the task graph...
 	int err = ReleaseProcessingUnits(*tg);
+	ResourcePartitionValidator::GetInstance().InvalidatePartitions();
 	if (err < 0) {
 		logger->Error("ReclaimResources: [%s] failed while reserving processing units", papp->StrId());
 		return PLATFORM_MAPPING_FAILED;
@@ -843,8 +844,9 @@ MangoPlatformProxy::MapResources(
 		return ret;
 	}
 
-	// Reserve processing units
+	// Reserve processing units, out of the partition skimmers knowledge
 	int err = ReserveProcessingUnits(*tg);
+	ResourcePartitionValidator::GetInstance().InvalidatePartitions();
 	if (err < 0) {
 		logger->Error("MapResources: [%s] failed while reserving processing units", papp->StrId());
 		return PLATFORM_MAPPING_FAILED;
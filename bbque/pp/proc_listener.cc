@@ -17,46 +17,72 @@
 
 #include "bbque/pp/proc_listener.h"
 #include <cstdlib>
+#include <cstddef>
 #include <linux/cn_proc.h>
+#include <linux/filter.h>
 #include <linux/netlink.h>
 #include <linux/connector.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
 #include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <errno.h>
-#include <sstream>
-#include <fstream>
+#include <cstring>
 
 #define MODULE_NAMESPACE "bq.pp.linux_ps"
 
 namespace bbque {
 
+bu::MetricsCollector::MetricsCollection_t
+ProcessListener::metrics[3] = {
+	{MODULE_NAMESPACE ".events",
+	 "Process events (EXEC/EXIT) received",
+	 bu::MetricsCollector::COUNTER, 0, NULL, 0},
+	{MODULE_NAMESPACE ".drops",
+	 "Receive buffer overruns (process events lost)",
+	 bu::MetricsCollector::COUNTER, 0, NULL, 0},
+	{MODULE_NAMESPACE ".events_rate",
+	 "Process events received per second",
+	 bu::MetricsCollector::SAMPLE, 0, NULL, 0}
+};
+
 ProcessListener & ProcessListener::GetInstance() {
 	static ProcessListener instance;
 	return instance;
 }
 
 std::string ProcessListener::GetProcName(int pid) {
-	std::stringstream ss;
-	std::string pname("");
-	ss << "/proc/" << pid << "/comm";
-	try {
-		std::ifstream ifs(ss.str());
-		ifs >> pname;
-		ifs.close();
-	}
-	catch(std::exception & ex) {
-		logger->Debug("GetProcName: %s", ex.what());
+	char path[32];
+	char pname[32];
+	snprintf(path, sizeof(path), "/proc/%d/comm", pid);
+
+	int fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		logger->Debug("GetProcName: %s: %s", path, strerror(errno));
+		return std::string();
 	}
-	return pname;
+	ssize_t len = read(fd, pname, sizeof(pname) - 1);
+	close(fd);
+	if (len <= 0)
+		return std::string();
+
+	// Trim the trailing newline
+	if (pname[len-1] == '\n')
+		--len;
+	return std::string(pname, len);
 }
 
 ProcessListener::ProcessListener():
-		prm(ProcessManager::GetInstance()) {
+		prm(ProcessManager::GetInstance()),
+		mc(bu::MetricsCollector::GetInstance()) {
 	sock = -1;
 	buffSize = getpagesize();
-	buf = new char[buffSize];
+	buf = new char[buffSize * BBQUE_PROCLISTENER_BATCH_SIZE];
 	logger = bu::Logger::GetLogger(MODULE_NAMESPACE);
 	logger->Info("Linux Process Listener Started");
+	mc.Register(metrics, 3);
 
 	// Setup the worker thread (calling Task())
 	Worker::Setup(BBQUE_MODULE_NAME("pp.linux_ps"), MODULE_NAMESPACE);
@@ -65,17 +91,46 @@ ProcessListener::ProcessListener():
 	 * Initialization of Linux Connector Channel
 	 */
 	//Socket creation (Datagram)
-	sock = socket (PF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+	sock = socket (PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC,
 		NETLINK_CONNECTOR);
+	if (sock < 0) {
+		logger->Error("Linux proc connector socket failed: %s",
+			strerror(errno));
+		return;
+	}
+
+	// Blocking receive, with a timeout to check for termination
+	timeval tv;
+	tv.tv_sec  = BBQUE_PROCLISTENER_TIMEOUT_MS / 1000;
+	tv.tv_usec = (BBQUE_PROCLISTENER_TIMEOUT_MS % 1000) * 1000;
+	setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof tv);
+
+	// Enlarge the receive buffer to absorb bursts of events
+	int rcvbuf_size = BBQUE_PROCLISTENER_RCVBUF_SIZE;
+	if (setsockopt(sock, SOL_SOCKET, SO_RCVBUF,
+			&rcvbuf_size, sizeof rcvbuf_size) < 0) {
+		logger->Warn("Linux proc connector receive buffer: %s",
+			strerror(errno));
+	}
+
+	// Only EXEC and EXIT events will reach the user space
+	AttachFilter();
+
 	//Socket Binding
 	sockaddr_nl addr;
+	memset(&addr, 0, sizeof addr);
 	addr.nl_family = AF_NETLINK;
 	addr.nl_pid = getpid(); //current process's pid
 	addr.nl_groups = CN_IDX_PROC;
-	bind(sock, (struct sockaddr *)&addr, sizeof addr);
-	if (errno == EPERM){
-		logger->Error("Linux Process Listener does not have the proper"
-			" permission to connect the socket");
+	if (bind(sock, (struct sockaddr *)&addr, sizeof addr) < 0) {
+		if (errno == EPERM) {
+			logger->Error("Linux Process Listener does not have the proper"
+				" permission to connect the socket");
+		}
+		else {
+			logger->Error("Linux proc connector bind failed: %s",
+				strerror(errno));
+		}
 	}
 	/*
 	 * The proc connector doesn't send any messages until a process has
@@ -129,94 +184,190 @@ ProcessListener::~ProcessListener() {
 	delete[] buf;
 }
 
+void ProcessListener::AttachFilter() {
+	/*
+	 * Classic BPF program run on each netlink message. Absolute loads
+	 * are performed in network byte order, while the connector messages
+	 * are in host byte order: constants are converted accordingly.
+	 * Messages other than proc connector ones are accepted, and discarded
+	 * later by the parsing loop.
+	 */
+	sock_filter filter[] = {
+		// Netlink message type: NLMSG_DONE
+		BPF_STMT(BPF_LD | BPF_H | BPF_ABS,
+			offsetof(nlmsghdr, nlmsg_type)),
+		BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, htons(NLMSG_DONE), 1, 0),
+		BPF_STMT(BPF_RET | BPF_K, 0xffffffff),
+		// Connector identifier: proc connector
+		BPF_STMT(BPF_LD | BPF_W | BPF_ABS,
+			NLMSG_LENGTH(0) + offsetof(cn_msg, id) + offsetof(cb_id, idx)),
+		BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, htonl(CN_IDX_PROC), 1, 0),
+		BPF_STMT(BPF_RET | BPF_K, 0xffffffff),
+		BPF_STMT(BPF_LD | BPF_W | BPF_ABS,
+			NLMSG_LENGTH(0) + offsetof(cn_msg, id) + offsetof(cb_id, val)),
+		BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, htonl(CN_VAL_PROC), 1, 0),
+		BPF_STMT(BPF_RET | BPF_K, 0xffffffff),
+		// Process event type: EXEC or EXIT only
+		BPF_STMT(BPF_LD | BPF_W | BPF_ABS,
+			NLMSG_LENGTH(0) + offsetof(cn_msg, data)
+				+ offsetof(proc_event, what)),
+		BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+			htonl(proc_event::PROC_EVENT_EXEC), 2, 0),
+		BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+			htonl(proc_event::PROC_EVENT_EXIT), 1, 0),
+		BPF_STMT(BPF_RET | BPF_K, 0),
+		BPF_STMT(BPF_RET | BPF_K, 0xffffffff)
+	};
+
+	sock_fprog fprog;
+	fprog.len    = sizeof(filter) / sizeof(filter[0]);
+	fprog.filter = filter;
+	if (setsockopt(sock, SOL_SOCKET, SO_ATTACH_FILTER,
+			&fprog, sizeof fprog) < 0) {
+		logger->Warn("Linux proc connector filter not attached: %s "
+			"(all the events will be parsed)", strerror(errno));
+		return;
+	}
+	logger->Debug("Linux proc connector filter attached");
+}
+
+void ProcessListener::HandleEvent(proc_event const * e) {
+	int pid;
+	switch (e->what){
+	case proc_event::PROC_EVENT_EXEC: {
+		pid = e->event_data.exec.process_pid;
+		std::string name(GetProcName(pid));
+		logger->Debug("Event : [ EXEC, pid: %i, name: %s ]",
+			pid, name.c_str());
+		// Keep track only of the processes to manage
+		if (name.empty() || !prm.IsToManage(name)) {
+			proc_names.erase(pid);
+			break;
+		}
+		proc_names[pid] = name;
+		prm.NotifyStart(name, pid);
+		break;
+	}
+	case proc_event::PROC_EVENT_EXIT: {
+		pid = e->event_data.exit.process_pid;
+		// Only the thread group leader exit is relevant
+		if (pid != e->event_data.exit.process_tgid)
+			break;
+		auto name_it = proc_names.find(pid);
+		if (name_it == proc_names.end())
+			break;
+		logger->Debug("Event : [ EXIT, pid: %i, name: %s, "
+				"exit code: %i ]",
+			pid, name_it->second.c_str(),
+			e->event_data.exit.exit_code);
+		prm.NotifyExit(name_it->second, pid);
+		proc_names.erase(name_it);
+		break;
+	}
+	default:
+		return;
+	}
+
+	mc.Count(metrics[0].mh);
+	++events_count;
+}
+
+void ProcessListener::UpdateRate() {
+	double elapsed_ms = rate_tmr.getElapsedTimeMs();
+	if (elapsed_ms < 1000)
+		return;
+	mc.AddSample(metrics[2].mh, events_count * 1000.0 / elapsed_ms);
+	events_count = 0;
+	rate_tmr.start();
+}
+
 void ProcessListener::Task() {
 	/*
 	 * Now we need to read the stream of messages. Just like the message we sent,
 	 * the stream of messages we receive are actually netlink messages,
 	 * and inside those netlink messages are connector messages,
 	 * and inside those are proc connector messages.
+	 *
+	 * Messages are received in batches: a single system call returns as
+	 * soon as one message is available, together with all the others
+	 * already queued (up to the batch size).
 	 */
-	msghdr msghdr;
-	sockaddr_nl addr;
-	iovec iov[1];
-	ssize_t len;
-
-	msghdr.msg_name = &addr;
-	msghdr.msg_namelen = sizeof addr;
-	msghdr.msg_iov = iov;
-	msghdr.msg_iovlen = 1;
-	msghdr.msg_control = NULL;
-	msghdr.msg_controllen = 0;
-	msghdr.msg_flags = 0;
-
-	iov[0].iov_base = buf;
-	iov[0].iov_len = buffSize;
-	/*
-	 * netlink allows arbitrary processes to send messages to each other,4
-	 * so we need to make sure the message actually comes from the kernel;
-	 * otherwise you have a potential security vulnerability.
-	 * recvmsg lets us receive the sender address as well as the data.
-	 */
+	mmsghdr msgs[BBQUE_PROCLISTENER_BATCH_SIZE];
+	sockaddr_nl addrs[BBQUE_PROCLISTENER_BATCH_SIZE];
+	iovec iovs[BBQUE_PROCLISTENER_BATCH_SIZE];
+
+	for (int i = 0; i < BBQUE_PROCLISTENER_BATCH_SIZE; ++i) {
+		iovs[i].iov_base = buf + (i * buffSize);
+		iovs[i].iov_len  = buffSize;
+		memset(&msgs[i], 0, sizeof(mmsghdr));
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rate_tmr.start();
 	while (!done) {
-		len = recvmsg (sock, &msghdr, 0);
-		if (len<=0)
+		UpdateRate();
+		for (int i = 0; i < BBQUE_PROCLISTENER_BATCH_SIZE; ++i)
+			msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_nl);
+
+		int nr_msgs = recvmmsg(sock, msgs, BBQUE_PROCLISTENER_BATCH_SIZE,
+			MSG_WAITFORONE, NULL);
+		if (nr_msgs < 0) {
+			// Receive buffer overrun: events have been lost
+			if (errno == ENOBUFS) {
+				logger->Warn("Task: receive buffer overrun, events lost");
+				mc.Count(metrics[1].mh);
+			}
+			else if ((errno != EAGAIN) && (errno != EINTR)) {
+				logger->Error("Task: receive failed: %s", strerror(errno));
+				break;
+			}
 			continue;
-		/*
-		 * So now we have a netlink message package from the kernel,
-		 * this may contain multiple individual netlink messages
-		 * (it doesn’t, but it may). So we iterate over those.
-		 */
-		for (struct nlmsghdr *_nlmsghdr = (struct nlmsghdr *)buf;
-			NLMSG_OK (_nlmsghdr, len);
-			_nlmsghdr = NLMSG_NEXT (_nlmsghdr, len)){
-			/*
-			* Ignore No-Op messages
-			*/
-			if ((_nlmsghdr->nlmsg_type == NLMSG_ERROR) ||
-				(_nlmsghdr->nlmsg_type == NLMSG_NOOP))
-				continue;
+		}
+
+		for (int i = 0; i < nr_msgs; ++i) {
 			/*
-			 * Inside each individual netlink message is a connector
-			 * message, we extract that and make sure it comes from
-			 * the proc connector system.
+			 * netlink allows arbitrary processes to send messages to
+			 * each other, so we need to make sure the message actually
+			 * comes from the kernel; otherwise you have a potential
+			 * security vulnerability.
 			 */
-			cn_msg *_cn_msg = (cn_msg *)(NLMSG_DATA (_nlmsghdr));
-			if ((_cn_msg->id.idx != CN_IDX_PROC) ||
-				(_cn_msg->id.val != CN_VAL_PROC))
+			if (addrs[i].nl_pid != 0)
 				continue;
 			/*
-			 * Now we can safely extract the proc connector message;
-			 * this is a struct proc_event that we haven’t seen before.
-			 * It’s quite a large structure definition, since it contains a
-			 * union for each of the different possible message types.
+			 * So now we have a netlink message package from the kernel,
+			 * this may contain multiple individual netlink messages
+			 * (it doesn’t, but it may). So we iterate over those.
 			 */
-			proc_event * e = (proc_event *)_cn_msg->data;
-			// Event Processing
-			switch (e->what){
-			case proc_event::PROC_EVENT_EXEC:
-				logger->Debug("Event : [ EXEC, pid: %i, name: %s ]",
-					e->event_data.exec.process_pid,
-					GetProcName(e->event_data.exec.process_pid).c_str());
-				prm.NotifyStart(
-					GetProcName(e->event_data.exec.process_pid),
-					e->event_data.exec.process_pid);
-				break;
-			case proc_event::PROC_EVENT_EXIT:
-				logger->Debug("Event : [ EXIT, pid: %i, name: %s, "
-						"exit code: %i ]",
-					e->event_data.exec.process_pid,
-					GetProcName(e->event_data.exec.process_pid).c_str(),
-					e->event_data.exit.exit_code);
-				prm.NotifyExit(
-					GetProcName(e->event_data.exec.process_pid),
-					e->event_data.exec.process_pid);
-				break;
-			default:
-				break;
+			int len = msgs[i].msg_len;
+			for (struct nlmsghdr *_nlmsghdr = (struct nlmsghdr *) iovs[i].iov_base;
+				NLMSG_OK (_nlmsghdr, len);
+				_nlmsghdr = NLMSG_NEXT (_nlmsghdr, len)){
+				/*
+				* Ignore No-Op messages
+				*/
+				if ((_nlmsghdr->nlmsg_type == NLMSG_ERROR) ||
+					(_nlmsghdr->nlmsg_type == NLMSG_NOOP))
+					continue;
+				/*
+				 * Inside each individual netlink message is a connector
+				 * message, we extract that and make sure it comes from
+				 * the proc connector system.
+				 */
+				cn_msg *_cn_msg = (cn_msg *)(NLMSG_DATA (_nlmsghdr));
+				if ((_cn_msg->id.idx != CN_IDX_PROC) ||
+					(_cn_msg->id.val != CN_VAL_PROC))
+					continue;
+				/*
+				 * Now we can safely extract the proc connector message;
+				 * this is a struct proc_event, which contains a union for
+				 * each of the different possible message types.
+				 */
+				HandleEvent((proc_event *)_cn_msg->data);
 			}
 		}
 	}
 }
 
 } // namespace bbque
-
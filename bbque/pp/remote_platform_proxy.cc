@@ -1,14 +1,53 @@
+#include <algorithm>
 
 #include "bbque/modules_factory.h"
 #include "bbque/pp/remote_platform_proxy.h"
 #include "bbque/config.h"
+#include "bbque/configuration_manager.h"
+#include "bbque/utils/timer.h"
+
+namespace po = boost::program_options;
 
 namespace bbque {
 namespace pp {
 
-RemotePlatformProxy::RemotePlatformProxy() {
+bu::MetricsCollector::MetricsCollection_t
+RemotePlatformProxy::metrics[5] = {
+	{REMOTE_PLATFORM_PROXY_NAMESPACE ".status.hits",
+	 "Remote status queries served by the cache",
+	 bu::MetricsCollector::COUNTER, 0, NULL, 0},
+	{REMOTE_PLATFORM_PROXY_NAMESPACE ".status.polls",
+	 "Remote status queries requiring a remote call",
+	 bu::MetricsCollector::COUNTER, 0, NULL, 0},
+	{REMOTE_PLATFORM_PROXY_NAMESPACE ".status.updates",
+	 "Status updates received from the remote systems",
+	 bu::MetricsCollector::COUNTER, 0, NULL, 0},
+	{REMOTE_PLATFORM_PROXY_NAMESPACE ".status.query_ms",
+	 "Remote status query time [ms]",
+	 bu::MetricsCollector::SAMPLE, 0, NULL, 0},
+	{REMOTE_PLATFORM_PROXY_NAMESPACE ".status.stale",
+	 "Remote status queries failed for stale status",
+	 bu::MetricsCollector::COUNTER, 0, NULL, 0}
+};
+
+RemotePlatformProxy::RemotePlatformProxy():
+	mc(bu::MetricsCollector::GetInstance()) {
 	logger = bu::Logger::GetLogger(REMOTE_PLATFORM_PROXY_NAMESPACE);
 	assert(logger);
+
+	ConfigurationManager & cfm(ConfigurationManager::GetInstance());
+	po::options_description opts_desc("Remote Platform Proxy options");
+	opts_desc.add_options()
+		(REMOTE_PLATFORM_PROXY_CONFIG ".status_period_ms",
+		 po::value<uint32_t>(&status_period_ms)->default_value(
+			BBQUE_RPP_STATUS_PERIOD_MS),
+		 "Period of the status updates from the remote systems "
+		 "(0 = query on demand)")
+		;
+	po::variables_map opts_vm;
+	cfm.ParseConfigurationFile(opts_desc, opts_vm);
+
+	mc.Register(metrics, 5);
 }
 
 const char* RemotePlatformProxy::GetPlatformID(int16_t system_id) const {
@@ -90,6 +129,12 @@ RemotePlatformProxy::ExitCode_t RemotePlatformProxy::MapResources(
 
 
 void RemotePlatformProxy::Exit() {
+	for (int system_id: subscribed_systems)
+		UnsubscribeStatus(system_id);
+	subscribed_systems.clear();
+	std::unique_lock<std::mutex> cache_ul(cache_mtx);
+	status_cache.clear();
+	cache_ul.unlock();
 	StopServer();
 	WaitForServerToStop();
 }
@@ -107,7 +152,68 @@ void RemotePlatformProxy::StartServer() {
 		logger->Error("Server start failed. AgentProxy plugin missing");
 		return;
 	}
-	return agent_proxy->StartServer();
+	agent_proxy->StartServer();
+	SubscribeRemoteSystems();
+}
+
+void RemotePlatformProxy::SubscribeRemoteSystems() {
+	if (status_period_ms == 0) {
+		logger->Info("Remote status updates disabled: querying on demand");
+		return;
+	}
+
+	for (auto const & sys_entry: GetPlatformDescription().GetSystemsAll()) {
+		auto const & sys(sys_entry.second);
+		if (sys.IsLocal())
+			continue;
+
+		auto ec = SubscribeStatus(sys.GetId(), {}, status_period_ms,
+			std::bind(&RemotePlatformProxy::UpdateStatusCache, this,
+				std::placeholders::_1, std::placeholders::_2));
+		if (ec != bbque::agent::ExitCode_t::OK) {
+			logger->Warn("Status updates from sys%d not available [err=%d]",
+				sys.GetId(), static_cast<int>(ec));
+			continue;
+		}
+		subscribed_systems.push_back(sys.GetId());
+	}
+	logger->Info("Subscribed to %d remote systems [T=%d ms]",
+		subscribed_systems.size(), status_period_ms);
+}
+
+void RemotePlatformProxy::UpdateStatusCache(
+		int system_id,
+		agent::StatusUpdate const & update) {
+	std::unique_lock<std::mutex> cache_ul(cache_mtx);
+	if (update.closed) {
+		status_cache.erase(system_id);
+		cache_ul.unlock();
+		logger->Warn("UpdateStatusCache: sys%d stream closed, status dropped",
+			system_id);
+		return;
+	}
+
+	auto & sys_cache(status_cache[system_id]);
+	for (auto const & entry: update.resources)
+		sys_cache.resources[entry.first] = entry.second;
+	if (update.workload_changed) {
+		sys_cache.workload = update.workload;
+		sys_cache.has_workload = true;
+	}
+	sys_cache.last_update = std::chrono::steady_clock::now();
+	cache_ul.unlock();
+
+	mc.Count(metrics[2].mh);
+	logger->Debug("UpdateStatusCache: sys%d update %d [%d resources]",
+		system_id, update.seq, update.resources.size());
+}
+
+bool RemotePlatformProxy::IsStale(SystemStatusCache const & sys_cache) const {
+	uint32_t stale_ms = std::max<uint32_t>(
+		BBQUE_RPP_STATUS_STALE_PERIODS * status_period_ms,
+		BBQUE_RPP_STATUS_STALE_MIN_MS);
+	return (std::chrono::steady_clock::now() - sys_cache.last_update) >
+		std::chrono::milliseconds(stale_ms);
 }
 
 void RemotePlatformProxy::StopServer() {
@@ -133,7 +239,34 @@ RemotePlatformProxy::GetResourceStatus(
 		logger->Error("GetResourceStatus failed. AgentProxy plugin missing");
 		return bbque::agent::ExitCode_t::PROXY_NOT_READY;
 	}
-	return agent_proxy->GetResourceStatus(resource_path, status);
+	bu::Timer query_tmr(true);
+
+	std::unique_lock<std::mutex> cache_ul(cache_mtx);
+	for (auto const & sys_entry: status_cache) {
+		auto const & sys_cache(sys_entry.second);
+		auto it = sys_cache.resources.find(resource_path);
+		if (it == sys_cache.resources.end())
+			continue;
+		if (IsStale(sys_cache)) {
+			cache_ul.unlock();
+			logger->Warn("GetResourceStatus: <%s> status from sys%d is stale",
+				resource_path.c_str(), sys_entry.first);
+			mc.Count(metrics[4].mh);
+			return bbque::agent::ExitCode_t::AGENT_DISCONNECTED;
+		}
+		status = it->second;
+		cache_ul.unlock();
+		mc.Count(metrics[0].mh);
+		mc.AddSample(metrics[3].mh, query_tmr.getElapsedTimeMs());
+		return bbque::agent::ExitCode_t::OK;
+	}
+	cache_ul.unlock();
+
+	// Not received yet: remote call (the cache is fed only by the updates)
+	auto ec = agent_proxy->GetResourceStatus(resource_path, status);
+	mc.Count(metrics[1].mh);
+	mc.AddSample(metrics[3].mh, query_tmr.getElapsedTimeMs());
+	return ec;
 }
 
 bbque::agent::ExitCode_t
@@ -153,7 +286,30 @@ RemotePlatformProxy::GetWorkloadStatus(
 		logger->Error("GetWorkloadStatus failed. AgentProxy plugin missing");
 		return bbque::agent::ExitCode_t::PROXY_NOT_READY;
 	}
-	return agent_proxy->GetWorkloadStatus(system_id, status);
+	bu::Timer query_tmr(true);
+
+	std::unique_lock<std::mutex> cache_ul(cache_mtx);
+	auto it = status_cache.find(system_id);
+	if ((it != status_cache.end()) && it->second.has_workload) {
+		if (IsStale(it->second)) {
+			cache_ul.unlock();
+			logger->Warn("GetWorkloadStatus: sys%d status is stale", system_id);
+			mc.Count(metrics[4].mh);
+			return bbque::agent::ExitCode_t::AGENT_DISCONNECTED;
+		}
+		status = it->second.workload;
+		cache_ul.unlock();
+		mc.Count(metrics[0].mh);
+		mc.AddSample(metrics[3].mh, query_tmr.getElapsedTimeMs());
+		return bbque::agent::ExitCode_t::OK;
+	}
+	cache_ul.unlock();
+
+	// Not received yet: remote call (the cache is fed only by the updates)
+	auto ec = agent_proxy->GetWorkloadStatus(system_id, status);
+	mc.Count(metrics[1].mh);
+	mc.AddSample(metrics[3].mh, query_tmr.getElapsedTimeMs());
+	return ec;
 }
 
 bbque::agent::ExitCode_t
@@ -222,6 +378,72 @@ RemotePlatformProxy::SendScheduleRequest(
 	return agent_proxy->SendScheduleRequest(system_path, request);
 }
 
+bbque::agent::ExitCode_t
+RemotePlatformProxy::SubscribeStatus(
+		int system_id,
+		std::vector<std::string> const & paths,
+		uint32_t period_ms,
+		agent::StatusUpdateCallback_t cb) {
+	if (agent_proxy == nullptr) {
+		logger->Error("SubscribeStatus failed. AgentProxy plugin missing");
+		return bbque::agent::ExitCode_t::PROXY_NOT_READY;
+	}
+	return agent_proxy->SubscribeStatus(system_id, paths, period_ms, cb);
+}
+
+bbque::agent::ExitCode_t
+RemotePlatformProxy::SendScheduleRequests(
+		int system_id,
+		std::vector<agent::ApplicationScheduleRequest> const & requests,
+		std::vector<bbque::agent::ExitCode_t> & results) {
+	if (agent_proxy == nullptr) {
+		logger->Error("SendScheduleRequests failed. AgentProxy plugin missing");
+		return bbque::agent::ExitCode_t::PROXY_NOT_READY;
+	}
+	return agent_proxy->SendScheduleRequests(system_id, requests, results);
+}
+
+bbque::agent::ExitCode_t
+RemotePlatformProxy::GetProcessingHeadroom(int system_id, float & headroom) {
+	uint64_t total = 0, busy = 0;
+
+	std::unique_lock<std::mutex> cache_ul(cache_mtx);
+	auto sys_it = status_cache.find(system_id);
+	if (sys_it == status_cache.end())
+		return bbque::agent::ExitCode_t::PROXY_NOT_READY;
+	if (IsStale(sys_it->second)) {
+		mc.Count(metrics[4].mh);
+		return bbque::agent::ExitCode_t::AGENT_DISCONNECTED;
+	}
+
+	for (auto const & r_entry: sys_it->second.resources) {
+		auto const & path(r_entry.first);
+		// Processing elements only
+		size_t pos = path.rfind('.');
+		if ((pos == std::string::npos) || (path.compare(pos + 1, 2, "pe") != 0))
+			continue;
+		auto const & status(r_entry.second);
+		uint64_t loaded = status.total * std::min(status.load, 100) / 100;
+		total += status.total;
+		busy  += std::min(std::max(status.used, loaded), status.total);
+	}
+	cache_ul.unlock();
+
+	if (total == 0)
+		return bbque::agent::ExitCode_t::PROXY_NOT_READY;
+	headroom = float(total - busy) / total;
+	return bbque::agent::ExitCode_t::OK;
+}
+
+bbque::agent::ExitCode_t
+RemotePlatformProxy::UnsubscribeStatus(int system_id) {
+	if (agent_proxy == nullptr) {
+		logger->Error("UnsubscribeStatus failed. AgentProxy plugin missing");
+		return bbque::agent::ExitCode_t::PROXY_NOT_READY;
+	}
+	return agent_proxy->UnsubscribeStatus(system_id);
+}
+
 } // namespace pp
 } // namespace bbque
 
@@ -1,5 +1,9 @@
 #include "bbque/pp/test_platform_proxy.h"
 
+#ifdef CONFIG_BBQUE_TEST_PLATFORM_SIMULATOR
+#include "bbque/pp/test_platform_simulator.h"
+#endif
+
 namespace bbque {
 namespace pp {
 
@@ -37,6 +41,17 @@ TestPlatformProxy::ExitCode_t TestPlatformProxy::LoadPlatformData() {
 	if (platformLoaded)
 		return PLATFORM_OK;
 
+#ifdef CONFIG_BBQUE_TEST_PLATFORM_SIMULATOR
+	// Synthetic platform, if configured
+	TestPlatformSimulator & sim(TestPlatformSimulator::GetInstance());
+	if (sim.RegisterPlatform()) {
+		logger->Warn("Loading SIMULATED platform data");
+		platformLoaded = true;
+		sim.StartWorkload();
+		return PLATFORM_OK;
+	}
+#endif // CONFIG_BBQUE_TEST_PLATFORM_SIMULATOR
+
 	logger->Warn("Loading TEST platform data");
 
 	const PlatformDescription *pd;
@@ -78,6 +93,10 @@ TestPlatformProxy::ExitCode_t TestPlatformProxy::LoadPlatformData() {
 
 	platformLoaded = true;
 
+#ifdef CONFIG_BBQUE_TEST_PLATFORM_SIMULATOR
+	sim.StartWorkload();
+#endif
+
 	return PLATFORM_OK;
 }
 
@@ -0,0 +1,421 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/pp/test_platform_simulator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include "bbque/application_manager.h"
+#include "bbque/configuration_manager.h"
+#include "bbque/resource_accounter.h"
+#include "bbque/resource_manager.h"
+#include "bbque/scheduler_manager.h"
+#include "bbque/synchronization_manager.h"
+#include "bbque/app/recipe.h"
+#include "bbque/app/working_mode.h"
+#include "bbque/utils/timer.h"
+
+#define MODULE_CONFIG "Simulator"
+
+namespace po = boost::program_options;
+namespace br = bbque::res;
+
+namespace bbque {
+namespace pp {
+
+
+TestPlatformSimulator & TestPlatformSimulator::GetInstance() {
+	static TestPlatformSimulator instance;
+	return instance;
+}
+
+TestPlatformSimulator::TestPlatformSimulator() {
+	Worker::Setup(BBQUE_MODULE_NAME("pp.sim"), TEST_PP_SIM_NAMESPACE);
+
+	ConfigurationManager & cm(ConfigurationManager::GetInstance());
+	po::options_description opts_desc("Platform and workload simulator");
+	opts_desc.add_options()
+		(MODULE_CONFIG".systems",
+		 po::value<uint16_t>(&nr_systems)->default_value(1),
+		 "Number of systems")
+		(MODULE_CONFIG".cpus",
+		 po::value<uint16_t>(&nr_cpus)->default_value(0),
+		 "Number of CPUs per system (0: platform from the TPD file)")
+		(MODULE_CONFIG".pes",
+		 po::value<uint16_t>(&nr_pes)->default_value(4),
+		 "Number of processing elements per CPU")
+		(MODULE_CONFIG".mem_mb",
+		 po::value<uint32_t>(&mem_mb)->default_value(1024),
+		 "Memory per CPU [MB]")
+		(MODULE_CONFIG".excs",
+		 po::value<std::string>(&excs_steps)->default_value(""),
+		 "Number of EXCs of each step, comma separated (empty: no workload)")
+		(MODULE_CONFIG".recipes",
+		 po::value<uint16_t>(&nr_recipes)->default_value(8),
+		 "Number of recipes")
+		(MODULE_CONFIG".awms",
+		 po::value<uint16_t>(&nr_awms)->default_value(4),
+		 "Number of AWMs per recipe")
+		(MODULE_CONFIG".max_quota",
+		 po::value<uint32_t>(&max_quota)->default_value(400),
+		 "Maximum CPU quota of an AWM")
+		(MODULE_CONFIG".rounds",
+		 po::value<uint16_t>(&nr_rounds)->default_value(10),
+		 "Number of optimizations per step")
+		(MODULE_CONFIG".churn",
+		 po::value<uint16_t>(&churn_pct)->default_value(10),
+		 "EXCs replaced at each round [%]")
+		(MODULE_CONFIG".seed",
+		 po::value<uint32_t>(&seed)->default_value(0),
+		 "Seed of the random generator")
+		(MODULE_CONFIG".report",
+		 po::value<std::string>(&report_file)->default_value(""),
+		 "CSV file to save the report in")
+		(MODULE_CONFIG".exit",
+		 po::value<bool>(&exit_at_end)->default_value(false),
+		 "Terminate the daemon at the end of the simulation");
+	po::variables_map opts_vm;
+	cm.ParseConfigurationFile(opts_desc, opts_vm);
+
+	rng.seed(seed);
+	churn_pct = std::min<uint16_t>(churn_pct, 100);
+	nr_awms   = std::max<uint16_t>(nr_awms, 1);
+}
+
+TestPlatformSimulator::~TestPlatformSimulator() {
+}
+
+
+bool TestPlatformSimulator::RegisterPlatform() {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+	if (nr_cpus == 0)
+		return false;
+
+	logger->Notice("Platform: %d systems x %d CPUs x %d PEs, %d MB per CPU",
+		nr_systems, nr_cpus, nr_pes, mem_mb);
+
+	for (uint16_t sys_id = 0; sys_id < nr_systems; ++sys_id) {
+		std::string sys_path("sys" + std::to_string(sys_id));
+		uint32_t pe_id = 0;
+		for (uint16_t cpu_id = 0; cpu_id < nr_cpus; ++cpu_id) {
+			std::string cpu_path(sys_path + ".cpu" + std::to_string(cpu_id));
+			for (uint16_t i = 0; i < nr_pes; ++i, ++pe_id) {
+				std::string pe_path(cpu_path + ".pe" + std::to_string(pe_id));
+				if (ra.RegisterResource(pe_path, "", 100) == nullptr)
+					return false;
+			}
+			std::string mem_path(sys_path + ".mem" + std::to_string(cpu_id));
+			if (ra.RegisterResource(mem_path, "",
+					static_cast<uint64_t>(mem_mb) << 20) == nullptr)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+
+void TestPlatformSimulator::StartWorkload() {
+	if (excs_steps.empty()) {
+		logger->Debug("StartWorkload: no workload to simulate");
+		return;
+	}
+	Worker::Start();
+}
+
+
+bool TestPlatformSimulator::CreateRecipes() {
+	ApplicationManager & am(ApplicationManager::GetInstance());
+	std::uniform_int_distribution<uint32_t> quota_dist(
+		10, std::max<uint32_t>(max_quota / 10, 10));
+
+	for (uint16_t i = 0; i < nr_recipes; ++i) {
+		std::string name("sim" + std::to_string(i));
+		auto precipe = std::make_shared<ba::Recipe>(name);
+		uint32_t quota_max = 10 * quota_dist(rng);
+
+		// AWMs with increasing CPU quota, memory and value
+		for (uint16_t awm_id = 0; awm_id < nr_awms; ++awm_id) {
+			auto pawm = precipe->AddWorkingMode(
+				awm_id, "awm" + std::to_string(awm_id),
+				100 * (awm_id + 1) / nr_awms);
+			if (!pawm)
+				return false;
+			pawm->AddResourceRequest("sys.cpu.pe",
+				std::max<uint32_t>(quota_max * (awm_id + 1) / nr_awms, 1));
+			pawm->AddResourceRequest("sys.mem",
+				static_cast<uint64_t>(awm_id + 1) << 24);
+		}
+
+		am.RegisterRecipe(precipe);
+		recipes.emplace_back(name, quota_max);
+		logger->Debug("CreateRecipes: <%s> %d AWMs, max CPU quota: %d",
+			name.c_str(), nr_awms, quota_max);
+	}
+
+	return !recipes.empty();
+}
+
+
+bool TestPlatformSimulator::SpawnEXC() {
+	ApplicationManager & am(ApplicationManager::GetInstance());
+	std::uniform_int_distribution<size_t> recipe_dist(0, recipes.size() - 1);
+	std::uniform_int_distribution<int> prio_dist(0, BBQUE_APP_PRIO_LEVELS - 1);
+	std::uniform_real_distribution<float> ctime_dist(10.0, 100.0);
+	std::uniform_real_distribution<float> goal_dist(1.0, 2.0);
+
+	auto const & recipe(recipes[recipe_dist(rng)]);
+	uint32_t pid = next_pid++;
+	std::string name("sim" + std::to_string(pid - TEST_PP_SIM_PID_BASE));
+
+	ba::AppPtr_t papp = am.CreateEXC(name, pid, 0, recipe.first,
+		RTLIB_LANG_CPP, prio_dist(rng), false, true);
+	if (!papp) {
+		logger->Error("SpawnEXC: [%s] creation FAILED", name.c_str());
+		return false;
+	}
+	am.EnableEXC(papp);
+
+	SimEXC_t & exc(excs[papp->Uid()]);
+	exc.papp = papp;
+	exc.quota_ref     = recipe.second;
+	exc.ctime_ref_ms  = ctime_dist(rng);
+	exc.ctime_goal_ms = exc.ctime_ref_ms * goal_dist(rng);
+	return true;
+}
+
+
+void TestPlatformSimulator::TerminateEXC(ba::AppPtr_t papp) {
+	ApplicationManager & am(ApplicationManager::GetInstance());
+	am.DisableEXC(papp, true);
+	am.DestroyEXC(papp);
+	excs.erase(papp->Uid());
+}
+
+
+void TestPlatformSimulator::Churn() {
+	uint32_t nr_churn = excs.size() * churn_pct / 100;
+
+	for (uint32_t i = 0; (i < nr_churn) && !excs.empty(); ++i) {
+		std::uniform_int_distribution<size_t> exc_dist(0, excs.size() - 1);
+		auto exc_it = excs.begin();
+		std::advance(exc_it, exc_dist(rng));
+		TerminateEXC(exc_it->second.papp);
+	}
+
+	for (uint32_t i = 0; i < nr_churn; ++i)
+		SpawnEXC();
+}
+
+
+void TestPlatformSimulator::UpdateRuntimeProfiles() {
+	ApplicationManager & am(ApplicationManager::GetInstance());
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+
+	for (auto & exc_entry: excs) {
+		SimEXC_t & exc(exc_entry.second);
+		if (!exc.papp->Running() || !exc.papp->CurrentAWM())
+			continue;
+
+		uint64_t quota = ra.GetAssignedAmount(
+			exc.papp->CurrentAWM()->GetResourceBinding(),
+			exc.papp, 0, br::ResourceType::PROC_ELEMENT);
+		if (quota == 0)
+			continue;
+
+		// Cycle time inversely proportional to the CPU quota, and goal gap
+		// computed as the RTLib does
+		float ctime_ms = exc.ctime_ref_ms * exc.quota_ref / quota;
+		float ggap = 100.0 * (exc.ctime_goal_ms / ctime_ms - 1.0);
+		ggap = std::max<float>(ggap, -33.0);
+		ggap = std::min<float>(ggap, 100.0);
+
+		am.SetRuntimeProfile(exc.papp->Pid(), exc.papp->ExcId(),
+			static_cast<int>(ggap), quota, static_cast<int>(ctime_ms));
+	}
+}
+
+
+void TestPlatformSimulator::Optimize(double & sched_us, double & sync_us) {
+	ApplicationManager & am(ApplicationManager::GetInstance());
+	ResourceManager & rm(ResourceManager::GetInstance());
+	SchedulerManager & sm(SchedulerManager::GetInstance());
+	SynchronizationManager & ym(SynchronizationManager::GetInstance());
+	bu::Timer opt_tmr;
+
+	sched_us = 0;
+	sync_us  = 0;
+
+	// No optimizations triggered by the RM events in the meanwhile
+	rm.AcquireReady();
+
+	opt_tmr.start();
+	if (sm.Schedule() != SchedulerManager::DONE) {
+		logger->Warn("Optimize: scheduling FAILED");
+		rm.ReleaseReady();
+		return;
+	}
+	sched_us = opt_tmr.getElapsedTimeUs();
+
+	if (am.HasApplications(ba::ApplicationStatusIF::SYNC)) {
+		opt_tmr.start();
+		if (ym.SyncSchedule() != SynchronizationManager::OK)
+			logger->Warn("Optimize: synchronization FAILED");
+		sync_us = opt_tmr.getElapsedTimeUs();
+	}
+
+	rm.ReleaseReady();
+}
+
+
+void TestPlatformSimulator::CollectQuality(StepReport_t & report) {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+	uint32_t nr_running = 0;
+	double awm_value = 0;
+
+	for (auto const & exc_entry: excs) {
+		auto const & papp(exc_entry.second.papp);
+		if (!papp->Running() || !papp->CurrentAWM())
+			continue;
+		++nr_running;
+		awm_value += papp->CurrentAWM()->Value();
+	}
+
+	report.nr_excs = excs.size();
+	if (!excs.empty())
+		report.running_pct = 100.0 * nr_running / excs.size();
+	if (nr_running > 0)
+		report.awm_value = awm_value / nr_running;
+
+	uint64_t cpu_total = ra.Total("sys.cpu.pe");
+	if (cpu_total > 0)
+		report.cpu_usage_pct = 100.0 * ra.Used("sys.cpu.pe") / cpu_total;
+	report.rss_kb = GetResidentMemory();
+}
+
+
+uint64_t TestPlatformSimulator::GetResidentMemory() const {
+	std::ifstream status_fd("/proc/self/status");
+	std::string line;
+	while (std::getline(status_fd, line)) {
+		if (line.compare(0, 6, "VmRSS:") != 0)
+			continue;
+		return std::strtoull(line.c_str() + 6, nullptr, 10);
+	}
+	return 0;
+}
+
+
+void TestPlatformSimulator::Task() {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+	SchedulerManager & sm(SchedulerManager::GetInstance());
+	double sched_us, sync_us;
+
+	logger->Debug("Task: waiting for platform to be ready...");
+	ra.WaitForPlatformReady();
+
+	if (!CreateRecipes()) {
+		logger->Error("Task: recipes generation FAILED");
+		return;
+	}
+	logger->Notice("Task: simulation START, policy [%s], steps [%s]",
+		sm.GetPolicyName(), excs_steps.c_str());
+
+	std::istringstream steps_ss(excs_steps);
+	std::string step_str;
+	while (!done && std::getline(steps_ss, step_str, ',')) {
+		uint32_t nr_excs = std::strtoul(step_str.c_str(), nullptr, 10);
+		StepReport_t report;
+
+		while (excs.size() < nr_excs) {
+			if (!SpawnEXC())
+				break;
+		}
+
+		for (uint16_t round = 0; !done && (round < nr_rounds); ++round) {
+			if (round > 0) {
+				Churn();
+				UpdateRuntimeProfiles();
+			}
+			Optimize(sched_us, sync_us);
+			report.sched_mean_us += sched_us / nr_rounds;
+			report.sync_mean_us  += sync_us  / nr_rounds;
+			report.sched_max_us = std::max(report.sched_max_us, sched_us);
+			report.sync_max_us  = std::max(report.sync_max_us, sync_us);
+		}
+
+		CollectQuality(report);
+		reports.push_back(report);
+		logger->Notice("Task: step [%5d EXCs] sched: %9.1f us, sync: %9.1f us, "
+			"running: %5.1f%%, AWM value: %4.2f, CPU: %5.1f%%, RSS: %lu KB",
+			report.nr_excs, report.sched_mean_us, report.sync_mean_us,
+			report.running_pct, report.awm_value, report.cpu_usage_pct,
+			report.rss_kb);
+	}
+
+	// Release all the resources
+	while (!excs.empty())
+		TerminateEXC(excs.begin()->second.papp);
+	Optimize(sched_us, sync_us);
+
+	Report();
+
+	if (exit_at_end) {
+		logger->Notice("Task: simulation completed, terminating...");
+		ResourceManager::GetInstance().NotifyEvent(ResourceManager::BBQ_EXIT);
+	}
+}
+
+
+void TestPlatformSimulator::Report() {
+	SchedulerManager & sm(SchedulerManager::GetInstance());
+	std::ofstream report_fd;
+
+	if (!report_file.empty()) {
+		report_fd.open(report_file);
+		report_fd << "policy,excs,sched_mean_us,sched_max_us,sync_mean_us,"
+			"sync_max_us,running_pct,awm_value,cpu_usage_pct,rss_kb\n";
+	}
+
+	logger->Notice("Report: policy [%s]", sm.GetPolicyName());
+	logger->Notice("Report: %6s %10s %10s %10s %10s %7s %5s %7s %9s",
+		"EXCs", "sched[us]", "max", "sync[us]", "max",
+		"run[%]", "AWM", "CPU[%]", "RSS[KB]");
+	for (auto const & r: reports) {
+		logger->Notice("Report: %6d %10.1f %10.1f %10.1f %10.1f %7.1f %5.2f "
+			"%7.1f %9lu",
+			r.nr_excs, r.sched_mean_us, r.sched_max_us,
+			r.sync_mean_us, r.sync_max_us,
+			r.running_pct, r.awm_value, r.cpu_usage_pct, r.rss_kb);
+		if (!report_fd.is_open())
+			continue;
+		report_fd << sm.GetPolicyName() << "," << r.nr_excs << ","
+			<< r.sched_mean_us << "," << r.sched_max_us << ","
+			<< r.sync_mean_us << "," << r.sync_max_us << ","
+			<< r.running_pct << "," << r.awm_value << ","
+			<< r.cpu_usage_pct << "," << r.rss_kb << "\n";
+	}
+
+	if (report_fd.is_open())
+		logger->Info("Report: saved in <%s>", report_file.c_str());
+}
+
+} // namespace pp
+
+} // namespace bbque
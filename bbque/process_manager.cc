@@ -172,6 +172,8 @@ void ProcessManager::Add(std::string const & name) {
 	auto it = managed_procs.find(name);
 	if (it == managed_procs.end()) {
 		managed_procs.emplace(name, ProcessManager::ProcessInstancesInfo());
+		std::unique_lock<std::mutex> names_lock(names_mutex);
+		managed_names.insert(name);
 		logger->Debug("Add: processes with name '%s' in the managed map", name.c_str());
 	}
 	else
@@ -182,16 +184,16 @@ void ProcessManager::Add(std::string const & name) {
 void ProcessManager::Remove(std::string const & name) {
 	std::unique_lock<std::mutex> u_lock(proc_mutex);
 	managed_procs.erase(name);
+	std::unique_lock<std::mutex> names_lock(names_mutex);
+	managed_names.erase(name);
 	logger->Debug("Remove: processes with name '%s' no longer in the managed map",
 		name.c_str());
 }
 
 
 bool ProcessManager::IsToManage(std::string const & name) const {
-	std::unique_lock<std::mutex> u_lock(proc_mutex);
-	if (managed_procs.find(name) == managed_procs.end())
-		return false;
-	return true;
+	std::unique_lock<std::mutex> names_lock(names_mutex);
+	return managed_names.count(name) != 0;
 }
 
 
@@ -485,13 +487,14 @@ ProcessManager::ExitCode_t ProcessManager::Unschedule(ProcPtr_t proc) {
 
 ProcessManager::ExitCode_t ProcessManager::SyncCommit(ProcPtr_t proc) {
 	ProcessManager::ExitCode_t ret = SUCCESS;
+	auto const snap = proc->GetSchedulingSnapshot();
 	// SYNC -> RUNNING
-	if (proc->Synching() && !proc->Blocking() && !proc->Disabled()) {
+	if (snap.Synching() && !snap.Blocking() && !snap.Disabled()) {
 		logger->Debug("SyncCommit: [%s] changing to RUNNING...", proc->StrId());
 		ret = ChangeState(proc, Schedulable::RUNNING, Schedulable::SYNC_NONE);
 	}
 	// SYNC (BLOCKED) -> READY
-	else if (proc->Blocking()) {
+	else if (snap.Blocking()) {
 		ret = ChangeState(proc,
 			app::Schedulable::READY, app::Schedulable::SYNC_NONE);
 		if (ret != SUCCESS) {
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Processing elements availability: per-path queries vs bitset index
+ *
+ * A resource tree of 4 CPUs, with a third of the processing elements free,
+ * a third partially and a third fully reserved. The two queries of the
+ * ResourceAccounter::GetFreePEs() variants are answered:
+ * - per path: a tree lookup of each processing element, summing up the
+ *   availability of the matching resources, as the policies did;
+ * - indexed: the OR of the free/partial/offline bitsets of the binding
+ *   domains, built as InitPEAvailability() does, and scanned as
+ *   GetPEAvailability() does.
+ * The cases are the first 4 free PEs of a CPU, and the free PEs of the
+ * node in a mask of every other PE.
+ *
+ * Usage: bbque-res-bench-pe [queries]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "bbque/resource_accounter.h"
+#include "bbque/res/bitset.h"
+#include "bbque/res/resource_path.h"
+#include "bbque/res/resource_tree.h"
+
+namespace br = bbque::res;
+
+#define NR_CPUS 4
+#define VIEW    7
+
+using Clock = std::chrono::steady_clock;
+
+namespace bbque {
+
+// The resource descriptors get the accounter to resolve the default view
+// (token 0) only: the views are always addressed by token here, hence the
+// returned instance is never accessed
+ResourceAccounter & ResourceAccounter::GetInstance() {
+	static std::aligned_storage<sizeof(ResourceAccounter),
+		alignof(ResourceAccounter)>::type unused;
+	return *reinterpret_cast<ResourceAccounter *>(&unused);
+}
+
+} // namespace bbque
+
+struct PEAvailability {
+	br::ResourceBitset free;
+	br::ResourceBitset partial;
+	br::ResourceBitset offline;
+};
+
+struct Platform {
+	br::ResourceTree tree;
+	/** Processing element paths, by ID */
+	std::vector<br::ResourcePathPtr_t> pe_paths;
+	/** Availability index, by binding domain */
+	std::map<std::string, PEAvailability> pe_avail_map;
+};
+
+static void Build(Platform & pf, uint32_t nr_pes) {
+	for (uint32_t pe_id = 0; pe_id < nr_pes; ++pe_id) {
+		std::string domain("sys0.cpu" + std::to_string(pe_id * NR_CPUS / nr_pes));
+		std::string pe_path(domain + ".pe" + std::to_string(pe_id));
+		auto r_path(std::make_shared<br::ResourcePath>(pe_path));
+		auto & rsrc(pf.tree.insert(*r_path));
+		rsrc = std::make_shared<br::Resource>(rsrc->Type(), rsrc->ID(), 100);
+		rsrc->SetPath(pe_path);
+		if ((pe_id % 3) != 0)
+			rsrc->Reserve(100 - (pe_id % 2) * 50);
+		pf.pe_paths.push_back(r_path);
+
+		auto & pe_avail(pf.pe_avail_map[domain]);
+		uint64_t available = rsrc->Available(nullptr, VIEW);
+		if (available == rsrc->Total())
+			pe_avail.free.Set(pe_id);
+		else if (available > 0)
+			pe_avail.partial.Set(pe_id);
+	}
+}
+
+/** A processing element is free if all the matching resources are */
+static bool IsFreePerPath(Platform & pf, BBQUE_RID_TYPE pe_id) {
+	uint64_t available = 0;
+	uint64_t total = 0;
+	for (auto & rsrc: pf.tree.find_list(*pf.pe_paths[pe_id], RT_MATCH_FIRST)) {
+		available += rsrc->Available(nullptr, VIEW);
+		total     += rsrc->Total();
+	}
+	return (available == total);
+}
+
+static PEAvailability GetIndexed(Platform & pf, std::string const & domain) {
+	PEAvailability pe_avail;
+	for (auto it = pf.pe_avail_map.lower_bound(domain);
+			(it != pf.pe_avail_map.end()) &&
+			(it->first.compare(0, domain.size(), domain) == 0);
+			++it) {
+		if ((it->first.size() > domain.size()) &&
+				(it->first[domain.size()] != '.'))
+			continue;
+		pe_avail.free    |= it->second.free;
+		pe_avail.partial |= it->second.partial;
+		pe_avail.offline |= it->second.offline;
+	}
+	return pe_avail;
+}
+
+static double PerQueryUs(Clock::time_point start, uint32_t queries) {
+	return std::chrono::duration<double, std::micro>(
+		Clock::now() - start).count() / queries;
+}
+
+static void RunCase(uint32_t nr_pes, uint32_t queries) {
+	Platform pf;
+	Build(pf, nr_pes);
+	uint32_t pes_per_cpu = nr_pes / NR_CPUS;
+	uint32_t found = 0;
+
+	// First 4 free processing elements of sys0.cpu1
+	auto start = Clock::now();
+	for (uint32_t q = 0; q < queries; ++q) {
+		br::ResourceBitset pes;
+		for (uint32_t pe_id = pes_per_cpu;
+				(pe_id < 2 * pes_per_cpu) && (pes.Count() < 4); ++pe_id)
+			if (IsFreePerPath(pf, pe_id))
+				pes.Set(pe_id);
+		found += pes.Count();
+	}
+	double first_path_us = PerQueryUs(start, queries);
+
+	start = Clock::now();
+	for (uint32_t q = 0; q < queries; ++q)
+		found -= GetIndexed(pf, "sys0.cpu1").free.FirstN(4).Count();
+	double first_index_us = PerQueryUs(start, queries);
+
+	// Free processing elements of the node in a mask
+	br::ResourceBitset mask;
+	for (uint32_t pe_id = 0; pe_id < nr_pes; pe_id += 2)
+		mask.Set(pe_id);
+
+	start = Clock::now();
+	for (uint32_t q = 0; q < queries; ++q) {
+		br::ResourceBitset pes;
+		for (BBQUE_RID_TYPE pe_id = mask.FirstSet(); pe_id != R_ID_NONE;
+				pe_id = mask.NextSet(pe_id))
+			if (IsFreePerPath(pf, pe_id))
+				pes.Set(pe_id);
+		found += pes.Count();
+	}
+	double mask_path_us = PerQueryUs(start, queries);
+
+	start = Clock::now();
+	for (uint32_t q = 0; q < queries; ++q)
+		found -= (GetIndexed(pf, "sys0").free & mask).Count();
+	double mask_index_us = PerQueryUs(start, queries);
+
+	// Same answers from both the queries
+	if (found != 0) {
+		fprintf(stderr, "Per-path and indexed queries differ\n");
+		exit(EXIT_FAILURE);
+	}
+	printf("%6u %14.3f %13.3f %14.3f %13.3f\n", nr_pes,
+		first_path_us, first_index_us, mask_path_us, mask_index_us);
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t queries = (argc > 1) ? atoi(argv[1]) : 100000;
+
+	printf("%u queries per case, times per query [us]\n", queries);
+	printf("%6s %14s %13s %14s %13s\n", "PEs", "first-4 path",
+		"first-4 index", "mask path", "mask index");
+	for (uint32_t nr_pes = 2 * NR_CPUS; nr_pes <= BBQUE_MAX_R_ID_NUM + 1;
+			nr_pes *= 2)
+		RunCase(nr_pes, queries);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Binding of the working modes: materialized bindings vs candidates
+ *
+ * A platform of N CPU clusters, with 16 processing elements and a memory
+ * node each, and a set of EXCs with 8 AWMs requesting processing elements
+ * and memory. In a scheduling round, a policy evaluates every AWM on every
+ * cluster:
+ * - bind: a new assignment map per cluster, built by the ResourceBinder,
+ *   as WorkingMode::BindResource() does;
+ * - candidate: a BindingCandidate over the binding domains of the AWM,
+ *   whose resource lists are built at the first round only.
+ * Both the cases sum up the same metrics, from the amount requested and
+ * the availability of the bound resources, and the resource lists of each
+ * binding are checked to be the same.
+ *
+ * Usage: bbque-res-bench-binding [rounds]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "bbque/resource_accounter.h"
+#include "bbque/res/binder.h"
+#include "bbque/res/binding_candidate.h"
+
+namespace br = bbque::res;
+
+#define NR_PES_PER_CLUSTER 16
+#define NR_EXCS            20
+#define NR_AWMS            8
+
+using Clock = std::chrono::steady_clock;
+
+struct AWM {
+	br::ResourceAssignmentMap_t requests;
+	std::vector<br::ResourceAssignmentMapPtr_t> sched_bindings;
+	br::BindingDomainsPtr_t domains;
+};
+
+/** WorkingMode::BindResource(CPU, R_ID_ANY, cluster_id) of a new binding */
+static br::ResourceAssignmentMapPtr_t Bind(AWM & wm, BBQUE_RID_TYPE cluster_id) {
+	auto out_map(std::make_shared<br::ResourceAssignmentMap_t>());
+	for (auto const & r_entry: wm.requests)
+		out_map->emplace(r_entry.first, r_entry.second);
+	br::ResourceBinder::Bind(wm.requests, br::ResourceType::CPU, R_ID_ANY,
+		cluster_id, out_map);
+	wm.sched_bindings.push_back(out_map);
+	return out_map;
+}
+
+static void Build(bbque::ResourceAccounter & ra, uint32_t nr_clusters,
+		std::vector<AWM> & awms) {
+	ra.Clear();
+	for (uint32_t c = 0; c < nr_clusters; ++c) {
+		std::string cluster("sys0.cpu" + std::to_string(c));
+		for (uint32_t p = 0; p < NR_PES_PER_CLUSTER; ++p)
+			ra.RegisterResource(cluster + ".pe" + std::to_string(p), 100);
+		ra.RegisterResource(cluster + ".mem0", 1024);
+	}
+
+	awms.assign(NR_EXCS * NR_AWMS, AWM());
+	for (size_t i = 0; i < awms.size(); ++i) {
+		awms[i].requests.emplace(ra.GetPath("sys0.cpu.pe"),
+			std::make_shared<br::ResourceAssignment>(100 + 50 * (i % NR_AWMS)));
+		awms[i].requests.emplace(ra.GetPath("sys0.cpu.mem"),
+			std::make_shared<br::ResourceAssignment>(128));
+	}
+}
+
+/**
+ * Same resource lists of the materialized binding and of the candidate.
+ * The binding map keeps the requests as well, added as missing ones before
+ * the binding: only the bound entries are compared.
+ */
+static bool Check(AWM & wm, uint32_t nr_clusters) {
+	auto domains(std::make_shared<br::BindingDomains>(
+		wm.requests, br::ResourceType::CPU));
+	for (uint32_t c = 0; c < nr_clusters; ++c) {
+		auto out_map(Bind(wm, c));
+		br::BindingCandidate candidate(domains, c);
+		for (size_t i = 0; i < candidate.Size(); ++i) {
+			bool found = false;
+			for (auto const & r_entry: *out_map)
+				found |= (r_entry.second->GetResourcesList() ==
+						candidate.Resources(i)) &&
+					(r_entry.second->GetAmount() == candidate.Amount(i));
+			if (!found)
+				return false;
+		}
+	}
+	wm.sched_bindings.clear();
+	return true;
+}
+
+static double PerRoundUs(Clock::time_point start, uint32_t rounds) {
+	return std::chrono::duration<double, std::micro>(
+		Clock::now() - start).count() / rounds;
+}
+
+static void RunCase(uint32_t nr_clusters, uint32_t rounds) {
+	bbque::ResourceAccounter & ra(bbque::ResourceAccounter::GetInstance());
+	std::vector<AWM> awms;
+	Build(ra, nr_clusters, awms);
+
+	if (!Check(awms[NR_AWMS - 1], nr_clusters)) {
+		fprintf(stderr, "Bindings and candidates differ [%u clusters]\n",
+			nr_clusters);
+		exit(EXIT_FAILURE);
+	}
+
+	double bind_metrics = 0;
+	auto start = Clock::now();
+	for (uint32_t round = 0; round < rounds; ++round) {
+		for (auto & wm: awms) {
+			for (uint32_t c = 0; c < nr_clusters; ++c) {
+				for (auto & r_entry: *Bind(wm, c)) {
+					if (wm.requests.count(r_entry.first))
+						continue;
+					bind_metrics += r_entry.second->GetAmount() /
+						(1.0 + ra.Available(r_entry.second->GetResourcesList()));
+				}
+			}
+			wm.sched_bindings.clear();
+		}
+	}
+	double bind_us = PerRoundUs(start, rounds);
+
+	double cand_metrics = 0;
+	start = Clock::now();
+	for (uint32_t round = 0; round < rounds; ++round) {
+		for (auto & wm: awms) {
+			if (!wm.domains)
+				wm.domains = std::make_shared<br::BindingDomains>(
+					wm.requests, br::ResourceType::CPU);
+			for (uint32_t c = 0; c < nr_clusters; ++c) {
+				br::BindingCandidate candidate(wm.domains, c);
+				for (size_t i = 0; i < candidate.Size(); ++i)
+					cand_metrics += candidate.Amount(i) /
+						(1.0 + candidate.Available(i));
+			}
+		}
+	}
+	double cand_us = PerRoundUs(start, rounds);
+
+	if (std::abs(bind_metrics - cand_metrics) > 1e-9 * bind_metrics) {
+		fprintf(stderr, "Metrics differ [%u clusters]: %f vs %f\n",
+			nr_clusters, bind_metrics, cand_metrics);
+		exit(EXIT_FAILURE);
+	}
+	printf("%8u %14.1f %14.1f %8.1fx\n", nr_clusters, bind_us, cand_us,
+		bind_us / cand_us);
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t rounds = (argc > 1) ? atoi(argv[1]) : 50;
+
+	printf("%u EXCs x %u AWMs, %u PEs per cluster, %u rounds, "
+		"times per round [us]\n", NR_EXCS, NR_AWMS, NR_PES_PER_CLUSTER, rounds);
+	printf("%8s %14s %14s %9s\n", "clusters", "bind", "candidate", "speedup");
+	for (uint32_t nr_clusters: { 1, 2, 4, 8, 16 })
+		RunCase(nr_clusters, rounds);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_RESOURCE_ACCOUNTER_H_
+#define BBQUE_RESOURCE_ACCOUNTER_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "bbque/res/resource_path.h"
+#include "bbque/res/resource_tree.h"
+#include "bbque/res/resources.h"
+
+namespace br = bbque::res;
+
+namespace bbque {
+
+/**
+ * @class ResourceAccounter
+ *
+ * The resource accounter of the binding benchmark: it replaces the daemon
+ * one in the build of the binding code, with the resource tree, the
+ * resource path registry and the binding domain IDs only. The resources
+ * are registered by the benchmark itself.
+ */
+class ResourceAccounter {
+
+public:
+
+	static ResourceAccounter & GetInstance() {
+		static ResourceAccounter instance;
+		return instance;
+	}
+
+	/** Register a resource, with its total amount */
+	void RegisterResource(std::string const & path_str, uint64_t amount) {
+		br::ResourcePath r_path(path_str);
+		auto & rsrc(resources.insert(r_path));
+		rsrc->SetTotal(amount);
+		rsrc->SetPath(path_str);
+		for (auto const & rid: r_path.GetIdentifiers())
+			r_ids_per_type[rid->Type()].insert(rid->ID());
+	}
+
+	/** Remove all the resources */
+	void Clear() {
+		resources.clear();
+		r_ids_per_type.clear();
+	}
+
+	inline br::RViewToken_t GetSystemView() const {
+		return sys_view_token;
+	}
+
+	inline std::map<br::ResourceType, std::set<BBQUE_RID_TYPE>> const & GetTypes() const {
+		return r_ids_per_type;
+	}
+
+	br::ResourcePtrList_t GetResources(br::ResourcePathPtr_t resource_path_ptr) const {
+		if (resource_path_ptr->IsTemplate())
+			return resources.find_list(*resource_path_ptr, RT_MATCH_TYPE);
+		return resources.find_list(*resource_path_ptr, RT_MATCH_MIXED);
+	}
+
+	br::ResourcePathPtr_t const GetPath(std::string const & path_str) {
+		std::unique_lock<std::mutex> paths_ul(paths_mtx);
+		auto it = r_paths.find(path_str);
+		if (it != r_paths.end())
+			return it->second;
+		auto r_path(std::make_shared<br::ResourcePath>(path_str));
+		r_paths.emplace(path_str, r_path);
+		return r_path;
+	}
+
+	uint64_t Available(
+			br::ResourcePtrList_t & rsrc_list,
+			br::RViewToken_t status_view = 0,
+			SchedPtr_t papp = SchedPtr_t()) const {
+		uint64_t available = 0;
+		for (auto & rsrc: rsrc_list)
+			available += rsrc->Available(papp, status_view);
+		return available;
+	}
+
+private:
+
+	mutable br::ResourceTree resources;
+
+	std::map<br::ResourceType, std::set<BBQUE_RID_TYPE>> r_ids_per_type;
+
+	std::map<std::string, br::ResourcePathPtr_t> r_paths;
+
+	std::mutex paths_mtx;
+
+	br::RViewToken_t sys_view_token = 0;
+
+	ResourceAccounter() {}
+
+};
+
+} // namespace bbque
+
+#endif // BBQUE_RESOURCE_ACCOUNTER_H_
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/res/binding_candidate.h"
+
+#include "bbque/resource_accounter.h"
+
+namespace bbque { namespace res {
+
+
+BindingDomains::BindingDomains(
+		ResourceAssignmentMap_t const & requests_map,
+		ResourceType r_type):
+	r_type(r_type) {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+
+	auto const & types(ra.GetTypes());
+	auto const ids_it = types.find(r_type);
+
+	requests.reserve(requests_map.size());
+	for (auto const & r_entry: requests_map) {
+		requests.push_back({r_entry.first, r_entry.second, r_entry.first, false, {}});
+		Request & req(requests.back());
+		if ((ids_it == types.end()) || !req.path->IncludesType(r_type))
+			continue;
+		req.bound = true;
+
+		// The same lists that the binding would set: the path IDs are
+		// replaced in a copy, since the request path is shared
+		auto out_path = std::make_shared<ResourcePath>(req.path->ToString());
+		for (BBQUE_RID_TYPE domain_id: ids_it->second) {
+			if (domain_id < 0)
+				continue;
+			if (out_path->ReplaceID(r_type, R_ID_ANY, domain_id) != ResourcePath::OK)
+				break;
+			if (req.domains.size() <= (size_t) domain_id)
+				req.domains.resize(domain_id + 1);
+			req.domains[domain_id] = ra.GetResources(out_path);
+		}
+		out_path->ReplaceID(r_type, R_ID_ANY, R_ID_ANY);
+		req.domain_path = ra.GetPath(out_path->ToString());
+	}
+}
+
+
+ResourcePtrList_t const & BindingDomains::Resources(
+		Request const & req,
+		BBQUE_RID_TYPE domain_id) const {
+	if (!req.bound)
+		return req.assign->GetResourcesList();
+	if ((domain_id < 0) || ((size_t) domain_id >= req.domains.size()))
+		return no_resources;
+	return req.domains[domain_id];
+}
+
+
+uint64_t BindingCandidate::Available(
+		size_t i,
+		RViewToken_t status_view,
+		SchedPtr_t papp) const {
+	uint64_t value = 0;
+	for (auto const & rsrc: Resources(i))
+		value += rsrc->Available(papp, status_view);
+	return value;
+}
+
+
+bool BindingCandidate::Satisfiable(
+		RViewToken_t status_view,
+		SchedPtr_t papp) const {
+	for (size_t i = 0; i < Size(); ++i) {
+		if (Available(i, status_view, papp) < Amount(i))
+			return false;
+	}
+	return true;
+}
+
+
+bool BindingCandidate::Empty() const {
+	bool bound = false;
+	for (size_t i = 0; i < Size(); ++i) {
+		if (!IsBound(i))
+			continue;
+		if (!Resources(i).empty())
+			return false;
+		bound = true;
+	}
+	return bound;
+}
+
+} // namespace res
+
+} // namespace bbque
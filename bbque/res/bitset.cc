@@ -16,6 +16,7 @@
  */
 
 #include <cstring>
+#include <string>
 
 #include "bbque/res/bitset.h"
 #include "bbque/utils/utility.h"
@@ -28,7 +29,8 @@ ResourceBitset::ResourceBitset():
 	first_set(R_ID_NONE),
 	last_set(R_ID_NONE),
 	count(0),
-	none(true) {
+	none(true),
+	cg_dirty(false) {
 }
 
 ResourceBitset::~ResourceBitset() {}
@@ -38,23 +40,37 @@ ResourceBitset::~ResourceBitset() {}
  ******************************/
 
 ResourceBitset ResourceBitset::operator|= (const ResourceBitset & rbs) {
-	int _bit = rbs.FirstSet();
-	while ((_bit >= 0) && (_bit <= rbs.LastSet())) {
-		if (rbs.Test(_bit)) Set(_bit);
-		_bit++;
-	}
+	bit_set |= rbs.bit_set;
+	Update();
 	return *this;
 }
 
 ResourceBitset ResourceBitset::operator&= (const ResourceBitset & rbs) {
-	Reset();
-	return (*this |= rbs);
+	bit_set &= rbs.bit_set;
+	Update();
+	return *this;
+}
+
+ResourceBitset ResourceBitset::operator-= (const ResourceBitset & rbs) {
+	bit_set &= ~rbs.bit_set;
+	Update();
+	return *this;
+}
+
+ResourceBitset ResourceBitset::operator| (const ResourceBitset & rbs) const {
+	ResourceBitset result(*this);
+	return (result |= rbs);
+}
+
+ResourceBitset ResourceBitset::operator& (const ResourceBitset & rbs) const {
+	ResourceBitset result(*this);
+	return (result &= rbs);
 }
 
 /**/
 
 ResourceBitset::ExitCode_t ResourceBitset::Set(BBQUE_RID_TYPE pos) {
-	char buff[4] = "";
+	char buff[8] = "";
 
 	// Boundary check
 	if (pos > BBQUE_MAX_R_ID_NUM)
@@ -64,18 +80,24 @@ ResourceBitset::ExitCode_t ResourceBitset::Set(BBQUE_RID_TYPE pos) {
 		return OK;
 	bit_set.set(pos);
 
+	// The CG string lists the IDs in ascending order
+	if ((count > 0) && (pos < last_set))
+		cg_dirty = true;
+
 	// Track set boundaries
 	if (pos > last_set)
 		last_set  = pos;
 	if ((pos < first_set) || (first_set < 0))
 		first_set = pos;
 
-	// Update CG string
-	if (count > 0)
-		snprintf(buff, 4, ",%d", pos);
-	else
-		snprintf(buff, 4, "%d", pos);
-	cg_str.append(buff);
+	// Update CG string, unless it must be rebuilt anyway
+	if (!cg_dirty) {
+		if (count > 0)
+			snprintf(buff, sizeof(buff), ",%d", pos);
+		else
+			snprintf(buff, sizeof(buff), "%d", pos);
+		cg_str.append(buff);
+	}
 
 	++count;
 	if (none) none = false;
@@ -87,10 +109,82 @@ ResourceBitset::ExitCode_t ResourceBitset::Reset() {
 	first_set = last_set = R_ID_NONE;
 	none  = true;
 	count = 0;
+	cg_str.clear();
+	cg_dirty = false;
 	return OK;
 }
 
+ResourceBitset::ExitCode_t ResourceBitset::Reset(BBQUE_RID_TYPE pos) {
+	// Boundary check
+	if ((pos < 0) || (pos > BBQUE_MAX_R_ID_NUM))
+		return OUT_OF_RANGE;
+	if (!bit_set.test(pos))
+		return OK;
+	bit_set.reset(pos);
+	cg_dirty = true;
 
+	// Track set boundaries
+	--count;
+	none = (count == 0);
+	if (none) {
+		first_set = last_set = R_ID_NONE;
+		return OK;
+	}
+	if (pos == first_set)
+		first_set = NextSet(pos);
+	if (pos == last_set) {
+		while (!bit_set.test(--last_set));
+	}
+	return OK;
+}
+
+BBQUE_RID_TYPE ResourceBitset::NextSet(BBQUE_RID_TYPE pos) const {
+	size_t next;
+#ifdef __GLIBCXX__
+	// Word-wide scan
+	if (pos < 0)
+		next = bit_set._Find_first();
+	else
+		next = bit_set._Find_next(pos);
+#else
+	next = (pos < 0) ? 0 : pos + 1;
+	while ((next < bit_set.size()) && !bit_set.test(next))
+		++next;
+#endif
+	if (next >= bit_set.size())
+		return R_ID_NONE;
+	return next;
+}
+
+ResourceBitset ResourceBitset::FirstN(BBQUE_RID_TYPE num) const {
+	ResourceBitset result;
+	if (num >= count)
+		return *this;
+	for (BBQUE_RID_TYPE pos = NextSet(R_ID_NONE);
+			(pos != R_ID_NONE) && (result.Count() < num);
+			pos = NextSet(pos))
+		result.Set(pos);
+	return result;
+}
+
+void ResourceBitset::Update() {
+	count = bit_set.count();
+	none  = (count == 0);
+	cg_dirty = true;
+	first_set = last_set = NextSet(R_ID_NONE);
+	for (BBQUE_RID_TYPE pos = first_set; pos != R_ID_NONE; pos = NextSet(pos))
+		last_set = pos;
+}
+
+void ResourceBitset::BuildStringCG() const {
+	cg_str.clear();
+	for (BBQUE_RID_TYPE pos = first_set; pos != R_ID_NONE; pos = NextSet(pos)) {
+		if (pos != first_set)
+			cg_str.push_back(',');
+		cg_str.append(std::to_string(pos));
+	}
+	cg_dirty = false;
+}
 
 } // namespace res
 
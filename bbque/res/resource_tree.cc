@@ -30,15 +30,32 @@ namespace bu = bbque::utils;
 
 namespace bbque { namespace res {
 
+bu::MetricsCollector::MetricsCollection_t
+ResourceTree::metrics[RT_METRICS_COUNT] = {
+	{RESOURCE_TREE_NAMESPACE ".idx.hit_perc",
+	 "Resolution index hit rate [%]",
+	 bu::MetricsCollector::SAMPLE, 0, NULL, 0},
+	{RESOURCE_TREE_NAMESPACE ".idx.hits",
+	 "Resolution index hits",
+	 bu::MetricsCollector::COUNTER, 0, NULL, 0},
+	{RESOURCE_TREE_NAMESPACE ".idx.misses",
+	 "Resolution index misses",
+	 bu::MetricsCollector::COUNTER, 0, NULL, 0}
+};
+
 
 ResourceTree::ResourceTree():
 	max_depth(0),
-	count(0) {
+	count(0),
+	mc(bu::MetricsCollector::GetInstance()) {
 
 	// Get a logger
 	logger = bu::Logger::GetLogger(RESOURCE_TREE_NAMESPACE);
 	assert(logger);
 
+	// Register the index metrics
+	mc.Register(metrics, RT_METRICS_COUNT);
+
 	// Initialize the root node
 	std::string root_name("bbque");
 	root = std::make_shared<ResourceNode>(
@@ -47,19 +64,68 @@ ResourceTree::ResourceTree():
 
 ResourcePtrList_t
 ResourceTree::find_list(ResourcePath & rsrc_path, uint16_t match_flags) const {
+	auto const & matchings(find_shared(rsrc_path, match_flags));
+	return ResourcePtrList_t(matchings->begin(), matchings->end());
+}
+
+ResourceTree::ResourcePtrVectorPtr_t
+ResourceTree::find_shared(ResourcePath & rsrc_path, uint16_t match_flags) const {
+	match_flags = normalize_flags(match_flags);
+	IndexKey_t key(rsrc_path.ToString(), match_flags);
+
+	// Memoized search result
+	std::unique_lock<std::mutex> index_ul(index_mtx);
+	auto it = index.find(key);
+	if (it != index.end()) {
+		++index_hits;
+		return it->second;
+	}
+	uint32_t gen = index_gen;
+	index_ul.unlock();
+
+	// Search in the tree
 	ResourcePtrList_t matchings;
 	auto head_path(rsrc_path.Begin());
 	auto const & end_path(rsrc_path.End());
+	std::unique_lock<std::mutex> tree_ul(tree_mtx);
+	find_node(root, head_path, end_path, match_flags, matchings);
+	tree_ul.unlock();
+
+	auto result = std::make_shared<const ResourcePtrVector_t>(
+		matchings.begin(), matchings.end());
+	index_ul.lock();
+	++index_misses;
+	if (gen == index_gen)
+		index[key] = result;
+	return result;
+}
 
-	// match_flags = "11x" is a not valid configuration
-	if (match_flags & RT_MATCH_TYPE & RT_MATCH_MIXED)
-		match_flags = RT_MATCH_MIXED;
+void ResourceTree::invalidate_index() const {
+	std::unique_lock<std::mutex> index_ul(index_mtx);
+	logger->Debug("invalidate_index: dropping %d search results",
+		index.size());
+	index.clear();
+	++index_gen;
+}
 
-	find_node(root, head_path, end_path, match_flags, matchings);
-	return matchings;
+void ResourceTree::update_index_metrics() const {
+	std::unique_lock<std::mutex> index_ul(index_mtx);
+	uint32_t hits   = index_hits;
+	uint32_t misses = index_misses;
+	index_hits   = 0;
+	index_misses = 0;
+	index_ul.unlock();
+
+	if ((hits + misses) == 0)
+		return;
+	mc.Count(metrics[RT_IDX_HITS].mh, hits);
+	mc.Count(metrics[RT_IDX_MISSES].mh, misses);
+	mc.AddSample(metrics[RT_IDX_HIT_PERC].mh,
+		100.0 * hits / (hits + misses));
 }
 
 ResourcePtr_t & ResourceTree::insert(ResourcePath const & rsrc_path) {
+	std::unique_lock<std::mutex> tree_ul(tree_mtx);
 
 	// Seeking on the last matching resource path level (tree node)
 	ResourceNodePtr_t curr_node = root;
@@ -108,6 +174,9 @@ ResourcePtr_t & ResourceTree::insert(ResourcePath const & rsrc_path) {
 
 	++count;
 	logger->Debug("insert: count = %d, depth: %d", count, max_depth);
+	tree_ul.unlock();
+
+	invalidate_index();
 	return curr_node->data;
 }
 
@@ -344,4 +344,36 @@ double Resource::GetPowerInfo(PowerManager::InfoType i_type, ValueType v_type) {
 
 #endif // CONFIG_BBQUE_PM
 
+#ifdef CONFIG_BBQUE_CONTENTION_MONITOR
+
+void Resource::EnableContentionProfile(uint samples_window) {
+	std::unique_lock<std::mutex> ul(ct_profile.mux);
+	ct_profile.values.resize(size_t(ContentionInfoType::COUNT));
+	for (auto & value: ct_profile.values)
+		value = std::make_shared<bu::EMA>(samples_window);
+}
+
+void Resource::UpdateContentionInfo(ContentionInfoType i_type, double sample) {
+	std::unique_lock<std::mutex> ul(ct_profile.mux);
+	if (ct_profile.values.empty())
+		return;
+	ct_profile.values[int(i_type)]->update(sample);
+}
+
+double Resource::GetContentionInfo(ContentionInfoType i_type, ValueType v_type) {
+	std::unique_lock<std::mutex> ul(ct_profile.mux);
+	if (ct_profile.values.empty())
+		return 0.0;
+	// Instant or mean value?
+	switch (v_type) {
+	case INSTANT:
+		return ct_profile.values[int(i_type)]->last_value();
+	case MEAN:
+		return ct_profile.values[int(i_type)]->get();
+	}
+	return 0.0;
+}
+
+#endif // CONFIG_BBQUE_CONTENTION_MONITOR
+
 }}
@@ -109,6 +109,8 @@ void ResourceAccounter::SetPlatformReady() {
 		status_cv.wait(status_ul);
 	}
 	status = State::READY;
+	RefreshPEAvailability();
+	PublishSnapshot();
 	status_cv.notify_all();
 	PrintCountPerType();
 }
@@ -119,6 +121,7 @@ void ResourceAccounter::SetPlatformNotReady() {
 		status_cv.wait(status_ul);
 	}
 	status = State::NOT_READY;
+	resources.invalidate_index();
 	status_cv.notify_all();
 }
 
@@ -196,6 +199,40 @@ void ResourceAccounter::PrintStatusReport(
 	PRINT_NOTICE_IF_VERBOSE(verbose, RA_DIV1);
 }
 
+void ResourceAccounter::PrintStatusReport(
+		ResourceSnapshotPtr_t snapshot, bool verbose) const {
+	char rsrc_text_row[] = RA_DIV3;
+	if (!snapshot)
+		return;
+
+	PRINT_NOTICE_IF_VERBOSE(verbose, "Report on snapshot:");
+	PRINT_NOTICE_IF_VERBOSE(verbose, RA_DIV1);
+	PRINT_NOTICE_IF_VERBOSE(verbose, RA_HEAD);
+	PRINT_NOTICE_IF_VERBOSE(verbose, RA_DIV2);
+
+	// The amounts of the committed view, as published: no per-application
+	// details, since the views may be changing
+	for (auto const & entry: snapshot->entries) {
+		auto const & rsrc(entry.second);
+		uint8_t len = 0;
+		bool percent = (rsrc.rsrc->Type() == br::ResourceType::PROC_ELEMENT);
+		char model[] = "   ";
+		strncpy(model, rsrc.rsrc->Model().c_str(), 3);
+
+		len += sprintf(rsrc_text_row + len, "| %-26s %c | %3s | %9s | ",
+				entry.first.c_str(),
+				rsrc.offline ? 'O' : 'I', model,
+				bu::GetValueUnitStr(rsrc.used, percent).c_str());
+		len += sprintf(rsrc_text_row + len, "%10s | ",
+				bu::GetValueUnitStr(rsrc.unreserved, percent).c_str());
+		len += sprintf(rsrc_text_row + len, "%10s |",
+				bu::GetValueUnitStr(rsrc.total, percent).c_str());
+		PRINT_NOTICE_IF_VERBOSE(verbose, rsrc_text_row);
+	}
+
+	PRINT_NOTICE_IF_VERBOSE(verbose, RA_DIV1);
+}
+
 void ResourceAccounter::PrintAppDetails(
 		br::ResourcePtr_t resource_ptr,
 		bool percent,
@@ -296,12 +333,12 @@ br::ResourcePtr_t ResourceAccounter::GetResource(std::string const & strpath) {
 
 br::ResourcePtr_t ResourceAccounter::GetResource(
 		ResourcePathPtr_t resource_path_ptr) const {
-	br::ResourcePtrList_t matchings(
-			resources.find_list(
+	auto const & matchings(
+			resources.find_shared(
 				*resource_path_ptr, RT_MATCH_FIRST | RT_MATCH_MIXED));
-	if (matchings.empty())
+	if (matchings->empty())
 		return nullptr;
-	return matchings.front();
+	return matchings->front();
 }
 
 
@@ -331,12 +368,13 @@ bool ResourceAccounter::ExistResource(std::string const & strpath) {
 }
 
 bool ResourceAccounter::ExistResource(ResourcePathPtr_t resource_path_ptr) const {
-	br::ResourcePtrList_t matchings(
-		resources.find_list(*resource_path_ptr, RT_MATCH_TYPE | RT_MATCH_FIRST));
-	return !matchings.empty();
+	auto const & matchings(
+		resources.find_shared(*resource_path_ptr, RT_MATCH_TYPE | RT_MATCH_FIRST));
+	return !matchings->empty();
 }
 
 ResourcePathPtr_t const ResourceAccounter::GetPath(std::string const & strpath) {
+	std::unique_lock<std::mutex> register_ul(register_mtx);
 	auto rp_it = r_paths.find(strpath);
 	if (rp_it == r_paths.end()) {
 		// Create a new resource path object
@@ -669,6 +707,7 @@ br::ResourcePtr_t ResourceAccounter::RegisterResource(
 			strpath.c_str(), resource_ptr->Total(), units.c_str());
 
 	// Insert the path in the paths set
+	std::unique_lock<std::mutex> register_ul(register_mtx);
 	resource_set.emplace(resource_ptr);
 	r_paths.emplace(strpath, resource_path_ptr);
 	path_max_len = std::max((int) path_max_len, (int) strpath.length());
@@ -732,10 +771,13 @@ ResourceAccounter::ExitCode_t ResourceAccounter::UpdateResource(
 
 	// Setup reserved amount of resource, considering the units
 	reserved = resource_ptr->Total() - availability;
-	ReserveResources(resource_path_ptr, reserved);
+	_ReserveResources(resource_path_ptr, reserved);
 	resource_ptr->SetOnline();
+	resources.invalidate_index();
+	RefreshPEAvailability();
 
 	// Back to READY
+	PublishSnapshot();
 	SetState(State::READY);
 
 	return RA_SUCCESS;
@@ -745,6 +787,15 @@ ResourceAccounter::ExitCode_t ResourceAccounter::UpdateResource(
 ResourceAccounter::ExitCode_t  ResourceAccounter::ReserveResources(
 		ResourcePathPtr_t resource_path_ptr,
 		uint64_t amount) {
+	ExitCode_t result = _ReserveResources(resource_path_ptr, amount);
+	RefreshPEAvailability();
+	PublishSnapshot();
+	return result;
+}
+
+ResourceAccounter::ExitCode_t  ResourceAccounter::_ReserveResources(
+		ResourcePathPtr_t resource_path_ptr,
+		uint64_t amount) {
 	br::Resource::ExitCode_t rresult;
 	auto const & resources_list(resources.find_list(*resource_path_ptr, RT_MATCH_MIXED));
 	logger->Info("Reserving [%" PRIu64 "] for [%s] resources...",
@@ -821,6 +872,9 @@ ResourceAccounter::ExitCode_t  ResourceAccounter::OfflineResources(
 		logger->Debug("OfflineResources: setting on %s",
 			resource_ptr->Path().c_str());
 	}
+	resources.invalidate_index();
+	RefreshPEAvailability();
+	PublishSnapshot();
 
 	return RA_SUCCESS;
 }
@@ -840,6 +894,9 @@ ResourceAccounter::ExitCode_t  ResourceAccounter::OnlineResources(
 		logger->Debug("OnlineResources: setting on %s",
 			resource_ptr->Path().c_str());
 	}
+	resources.invalidate_index();
+	RefreshPEAvailability();
+	PublishSnapshot();
 
 	return RA_SUCCESS;
 }
@@ -869,6 +926,7 @@ ResourceAccounter::ExitCode_t ResourceAccounter::_GetView(
 	logger->Debug("GetView: new resource state view token = %ld", token);
 
 	// Allocate a new view for the applications resource assignments
+	std::unique_lock<std::mutex> status_ul(status_mtx);
 	assign_per_views.emplace(token, std::make_shared<AppAssignmentsMap_t>());
 	//Allocate a new view for the set of resources allocated
 	rsrc_per_views.emplace(token, std::make_shared<ResourceSet_t>());
@@ -889,9 +947,13 @@ ResourceAccounter::ExitCode_t ResourceAccounter::_PutView(
 		return RA_ERR_UNAUTH_VIEW;
 	}
 
-	// Get the resource set using the referenced view
+	// Get the resource set using the referenced view. The views and their
+	// availability index are released together, under status_mtx, so that
+	// GetPEAvailability() cannot index a view being released.
+	std::unique_lock<std::mutex> status_ul(status_mtx);
 	ResourceViewsMap_t::iterator rviews_it(rsrc_per_views.find(status_view));
 	if (rviews_it == rsrc_per_views.end()) {
+		status_ul.unlock();
 		logger->Warn("PutView: cannot find resource view token %ld", status_view);
 		return RA_ERR_MISS_VIEW;
 	}
@@ -904,6 +966,10 @@ ResourceAccounter::ExitCode_t ResourceAccounter::_PutView(
 	// set of this view
 	assign_per_views.erase(status_view);
 	rsrc_per_views.erase(status_view);
+	std::unique_lock<std::mutex> pe_avail_ul(pe_avail_mtx);
+	pe_avail_per_views.erase(status_view);
+	pe_avail_ul.unlock();
+	status_ul.unlock();
 
 	logger->Debug("PutView: [%ld] cleared view", status_view);
 	logger->Debug("PutView: [%ld] currently managed {resource sets = %ld, "
@@ -945,6 +1011,9 @@ br::RViewToken_t ResourceAccounter::_SetView(br::RViewToken_t status_view) {
 	// Put the old view
 	_PutView(old_sys_status_view);
 
+	// Make the new system view visible to the snapshot readers
+	PublishSnapshot();
+
 	logger->Info("SetView: [%ld] is the new system state view.", sys_view_token);
 	logger->Debug("SetView: [%ld] currently managed {resource sets = %ld,"
 			" assign_map = %d}",
@@ -963,6 +1032,172 @@ void ResourceAccounter::SetScheduledView(br::RViewToken_t svt) {
 }
 
 
+void ResourceAccounter::PublishSnapshot() {
+	std::unique_lock<std::mutex> snapshot_ul(snapshot_mtx);
+	auto snapshot = std::make_shared<ResourceSnapshot>();
+	snapshot->epoch = ++snapshot_epoch;
+	snapshot->view  = sys_view_token;
+
+	for (auto & resource_ptr: resource_set) {
+		snapshot->entries.emplace(
+			resource_ptr->Path(),
+			ResourceSnapshot::Entry({
+				resource_ptr,
+				GetPath(resource_ptr->Path()),
+				resource_ptr->Used(sys_view_token),
+				resource_ptr->Unreserved(),
+				resource_ptr->Total(),
+				resource_ptr->IsOffline()}));
+	}
+
+	std::atomic_store(&sys_snapshot,
+		ResourceSnapshotPtr_t(std::move(snapshot)));
+	snapshot_cv.notify_all();
+	logger->Debug("PublishSnapshot: [%ld] epoch=%d resources=%d",
+		sys_view_token, snapshot_epoch, resource_set.size());
+}
+
+ResourceSnapshotPtr_t ResourceAccounter::WaitForSnapshot() {
+	std::unique_lock<std::mutex> snapshot_ul(snapshot_mtx);
+	while (!std::atomic_load(&sys_snapshot))
+		snapshot_cv.wait(snapshot_ul);
+	return std::atomic_load(&sys_snapshot);
+}
+
+/************************************************************************
+ *                   PROCESSING ELEMENTS AVAILABILITY                   *
+ ************************************************************************/
+
+/** The binding domain path of a processing element, i.e. its parent */
+static inline std::string GetBindingDomain(br::ResourcePtr_t const & rsrc) {
+	std::string const & pe_path(rsrc->Path());
+	return pe_path.substr(0, pe_path.find_last_of('.'));
+}
+
+void ResourceAccounter::SetPEAvailability(
+		PEAvailability_t & pe_avail,
+		br::ResourcePtr_t const & rsrc,
+		br::RViewToken_t status_view) {
+	BBQUE_RID_TYPE pe_id = rsrc->ID();
+	pe_avail.free.Reset(pe_id);
+	pe_avail.partial.Reset(pe_id);
+	pe_avail.offline.Reset(pe_id);
+
+	if (rsrc->IsOffline()) {
+		pe_avail.offline.Set(pe_id);
+		return;
+	}
+
+	uint64_t available = rsrc->Available(nullptr, status_view);
+	if (available == 0)
+		return;
+	if (available == rsrc->Total())
+		pe_avail.free.Set(pe_id);
+	else
+		pe_avail.partial.Set(pe_id);
+}
+
+ResourceAccounter::PEAvailabilityMap_t &
+ResourceAccounter::InitPEAvailability(br::RViewToken_t status_view) {
+	auto & pe_avail_map(pe_avail_per_views[status_view]);
+	pe_avail_map.clear();
+
+	for (auto & rsrc: resource_set) {
+		if (rsrc->Type() != br::ResourceType::PROC_ELEMENT)
+			continue;
+		SetPEAvailability(pe_avail_map[GetBindingDomain(rsrc)], rsrc, status_view);
+	}
+	logger->Debug("InitPEAvailability: [%ld] %d binding domains",
+		status_view, pe_avail_map.size());
+	return pe_avail_map;
+}
+
+void ResourceAccounter::RefreshPEAvailability() {
+	// Rebuilt at the next query
+	std::unique_lock<std::mutex> pe_avail_ul(pe_avail_mtx);
+	pe_avail_per_views.clear();
+}
+
+void ResourceAccounter::UpdatePEAvailability(
+		br::ResourcePtr_t const & rsrc,
+		br::RViewToken_t status_view) {
+	if (rsrc->Type() != br::ResourceType::PROC_ELEMENT)
+		return;
+	if (status_view == 0)
+		status_view = sys_view_token;
+
+	std::unique_lock<std::mutex> pe_avail_ul(pe_avail_mtx);
+	auto view_it = pe_avail_per_views.find(status_view);
+	if (view_it == pe_avail_per_views.end())
+		return;
+	SetPEAvailability(view_it->second[GetBindingDomain(rsrc)], rsrc, status_view);
+}
+
+ResourceAccounter::PEAvailability_t ResourceAccounter::GetPEAvailability(
+		std::string const & domain,
+		br::RViewToken_t status_view) {
+	PEAvailability_t pe_avail;
+	if (status_view == 0)
+		status_view = sys_view_token;
+
+	// The view must not be released while it is checked and indexed
+	std::unique_lock<std::mutex> status_ul(status_mtx);
+	if (rsrc_per_views.find(status_view) == rsrc_per_views.end()) {
+		status_ul.unlock();
+		logger->Warn("GetPEAvailability: [%ld] unknown view", status_view);
+		return pe_avail;
+	}
+
+	// The view is indexed at the first query, and then kept updated by the
+	// resource booking
+	std::unique_lock<std::mutex> pe_avail_ul(pe_avail_mtx);
+	auto view_it = pe_avail_per_views.find(status_view);
+	auto & pe_avail_map((view_it != pe_avail_per_views.end()) ?
+		view_it->second : InitPEAvailability(status_view));
+
+	// The domain itself, or all the domains it includes (e.g. "sys0" for
+	// "sys0.cpu0", "sys0.cpu1", ...)
+	for (auto it = pe_avail_map.lower_bound(domain);
+			(it != pe_avail_map.end()) &&
+			(it->first.compare(0, domain.size(), domain) == 0);
+			++it) {
+		if ((it->first.size() > domain.size()) &&
+				(it->first[domain.size()] != '.'))
+			continue;
+		pe_avail.free    |= it->second.free;
+		pe_avail.partial |= it->second.partial;
+		pe_avail.offline |= it->second.offline;
+	}
+	return pe_avail;
+}
+
+br::ResourceBitset ResourceAccounter::GetFreePEs(
+		std::string const & domain,
+		BBQUE_RID_TYPE num,
+		br::RViewToken_t status_view) {
+	return GetPEAvailability(domain, status_view).free.FirstN(num);
+}
+
+br::ResourceBitset ResourceAccounter::GetFreePEs(
+		std::string const & domain,
+		br::ResourceBitset const & mask,
+		br::RViewToken_t status_view) {
+	return GetPEAvailability(domain, status_view).free & mask;
+}
+
+br::ResourceBitset ResourceAccounter::GetPartiallyUsedPEs(
+		std::string const & domain,
+		br::RViewToken_t status_view) {
+	return GetPEAvailability(domain, status_view).partial;
+}
+
+br::ResourceBitset ResourceAccounter::GetOfflinePEs(
+		std::string const & domain,
+		br::RViewToken_t status_view) {
+	return GetPEAvailability(domain, status_view).offline;
+}
+
+
 /************************************************************************
  *                   SYNCHRONIZATION SUPPORT                            *
  ************************************************************************/
@@ -1095,6 +1330,9 @@ ResourceAccounter::ExitCode_t ResourceAccounter::SyncCommit() {
 	SyncFinalize();
 	logger->Info("SyncCommit [%d]: session committed", sync_ssn.count);
 
+	// Resolution index lookups of the scheduling run
+	resources.update_index_metrics();
+
 	// Log the status report
 	PrintStatusReport();
 	return result;
@@ -1384,6 +1622,7 @@ inline void ResourceAccounter::SchedResourceBooking(
 		requested -= rsrc->Acquire(papp, requested, status_view);
 	else
 		requested -= rsrc->Acquire(papp, available, status_view);
+	UpdatePEAvailability(rsrc, status_view);
 }
 
 inline void ResourceAccounter::SyncResourceBooking(
@@ -1401,6 +1640,7 @@ inline void ResourceAccounter::SyncResourceBooking(
 	// Acquire the resource according to the amount assigned by the
 	// scheduler
 	requested -= rsrc->Acquire(papp, sched_usage, sync_ssn.view);
+	UpdatePEAvailability(rsrc, sync_ssn.view);
 	logger->Debug("SyncResourceBooking: [%s] acquires %s (%d left) in view=[%ld]",
 			papp->StrId(), rsrc->Name().c_str(), requested, sch_view_token);
 }
@@ -1451,6 +1691,7 @@ ResourceAccounter::ExitCode_t ResourceAccounter::UndoResourceBooking(
 
 		// Release the quantity hold by the Application/EXC
 		usage_freed += rsrc->Release(papp, status_view);
+		UpdatePEAvailability(rsrc, status_view);
 
 		// If no more applications are using this resource, remove it from
 		// the set of resources referenced in the resource state view
@@ -1511,7 +1752,7 @@ int ResourceAccounter::SetResourceTotalHandler(char * r_path, char * value) {
 
 	logger->Info("SetResourceTotalHandler: "
 			"set quota %" PRIu64 " to [%s]", amount, r_path);
-	PrintStatusReport(0, true);
+	PrintStatusReport(GetSnapshot(), true);
 
 	return 0;
 }
@@ -1520,10 +1761,19 @@ int ResourceAccounter::ResourceDegradationHandler(int argc, char * argv[]) {
 	int index = 1;
 	argc--;
 
+	// The resources are looked up in the snapshot, to not wait for a
+	// synchronization in progress
+	auto snapshot(GetSnapshot());
+	if (!snapshot) {
+		logger->Error("Resource degradation: platform not ready yet");
+		return 1;
+	}
+
 	// Parsing the "<resource> <degradation_value>" pairs
 	while (argc) {
-		auto rsrc(GetResource(argv[index]));
-		if (rsrc != nullptr) {
+		auto entry(snapshot->Find(argv[index]));
+		if (entry != nullptr) {
+			auto const & rsrc(entry->rsrc);
 			if (IsNumber(argv[index+1])) {
 				rsrc->UpdateDegradationPerc(atoi(argv[index+1]));
 				logger->Warn("Resource degradation: <%s> = %2d%% [mean=%.2f]",
@@ -26,6 +26,10 @@
 #include "bbque/power_monitor.h"
 #endif
 
+#ifdef CONFIG_BBQUE_CONTENTION_MONITOR
+#include "bbque/contention_monitor.h"
+#endif
+
 #define RESOURCE_MANAGER_NAMESPACE "bq.rm"
 #define MODULE_NAMESPACE RESOURCE_MANAGER_NAMESPACE
 
@@ -187,6 +191,16 @@ ResourceManager::Setup() {
 	logger = bu::Logger::GetLogger(RESOURCE_MANAGER_NAMESPACE);
 	assert(logger);
 
+	//---------- Start-up trace (time spent in each phase)
+	Timer phase_tmr(true);
+	auto trace_phase = [&](const char * phase) {
+		logger->Notice("Startup trace: %-18s %10.3f [ms]",
+			phase, phase_tmr.getElapsedTimeMs());
+		phase_tmr.start();
+	};
+	logger->Notice("Startup trace: %-18s %10.3f [ms]",
+		"modules init", bbque_tmr.getElapsedTimeMs());
+
 	//---------- Loading configuration
 	ConfigurationManager & cm = ConfigurationManager::GetInstance();
 	po::options_description opts_desc("Resource Manager Options");
@@ -199,6 +213,7 @@ ResourceManager::Setup() {
 		;
 	po::variables_map opts_vm;
 	cm.ParseConfigurationFile(opts_desc, opts_vm);
+	trace_phase("configuration");
 
 	//---------- Dump list of registered plugins
 	const bp::PluginManager::RegistrationMap & rm = pm.GetRegistrationMap();
@@ -213,28 +228,39 @@ ResourceManager::Setup() {
 		logger->Fatal("Platform Configuration Loader FAILED!");
 		return SETUP_FAILED;
 	}
+	trace_phase("platform config");
 
 	result = plm.LoadPlatformData();
 	if (result != PlatformManager::PLATFORM_OK) {
 		logger->Fatal("Platform Integration Layer initialization FAILED!");
 		return SETUP_FAILED;
 	}
+	trace_phase("platform data");
 
 	// -------- Binding Manager initialization for the scheduling policy
 	if (bdm.LoadBindingDomains() != BindingManager::OK) {
 		logger->Fatal("Binding Manager initialization FAILED!");
 		return SETUP_FAILED;
 	}
+	trace_phase("binding domains");
 
 #ifdef CONFIG_BBQUE_WM
 	//----------- Start the Power Monitor
 	PowerMonitor & wm(PowerMonitor::GetInstance());
 	wm.Start();
+#endif
+#ifdef CONFIG_BBQUE_CONTENTION_MONITOR
+	//----------- Start the hardware counters Contention Monitor
+	ContentionMonitor & hm(ContentionMonitor::GetInstance());
+	hm.Start();
 #endif
 	//---------- Start bbque services
 	plm.Start();
 	if (opt_interval)
 		optimize_dfr.SetPeriodic(milliseconds(opt_interval));
+	trace_phase("services start");
+	logger->Notice("Startup trace: %-18s %10.3f [ms]",
+		"total", bbque_tmr.getElapsedTimeMs());
 
 	return OK;
 }
@@ -283,6 +309,19 @@ void ResourceManager::WaitForReady() {
 	}
 }
 
+void ResourceManager::AcquireReady() {
+	std::unique_lock<std::mutex> status_ul(status_mtx);
+	while (!is_ready) {
+		logger->Debug("AcquireReady: an optimization is in progress...");
+		status_cv.wait(status_ul);
+	}
+	is_ready = false;
+}
+
+void ResourceManager::ReleaseReady() {
+	SetReady(true);
+}
+
 void ResourceManager::SetReady(bool value) {
 	logger->Debug("SetReady: %s", value ? "true": "false");
 	std::unique_lock<std::mutex> status_ul(status_mtx);
@@ -328,7 +367,8 @@ void ResourceManager::Optimize() {
 	double period;
 	bool active_apps = true;
 
-	SetReady(false);
+	// Wait for the optimizations run outside the RM, if any
+	AcquireReady();
 
 	// If the optimization has been triggered by a platform event (BBQ_PLAT) the policy must be
 	// executed anyway. To the contrary, if it is an application event (BBQ_OPTS) check if
@@ -15,6 +15,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <future>
+
 #include "bbque/resource_partition_validator.h"
 #include "bbque/utils/assert.h"
 
@@ -40,6 +42,20 @@ void ResourcePartitionValidator::RegisterSkimmer(
 	logger->Notice("RegisterSkimmer: skimmer with priority=%i", priority);
 	skimmers.insert(
 		std::pair<int,PartitionSkimmerPtr_t> (priority, skimmer));
+	skimmers_mtx.emplace(skimmer.get(), std::make_shared<std::mutex>());
+	NextEpoch();
+}
+
+
+void ResourcePartitionValidator::NextEpoch() const noexcept {
+	std::lock_guard<std::mutex> cache_guard(cache_lock);
+	++availability_epoch;
+	cache.clear();
+}
+
+void ResourcePartitionValidator::InvalidatePartitions() noexcept {
+	logger->Debug("InvalidatePartitions: dropping the cached partitions");
+	NextEpoch();
 }
 
 
@@ -49,31 +65,124 @@ ResourcePartitionValidator::LoadPartitions(
 		std::list<Partition> &partitions,
 		uint32_t hw_cluster_id) {
 
-	logger->Debug("LoadPartitions: initial size=%d", partitions.size());
+	// Same task-graph requirements and resource availability: same
+	// partitions as the last skimming
+	std::unique_lock<std::mutex> cache_ul(cache_lock);
+	CacheKey_t key(tg.Hash(), hw_cluster_id, availability_epoch);
+	auto it = cache.find(key);
+	if (it != cache.end()) {
+		auto const & entry(it->second);
+		std::list<Partition> cached(entry.partitions);
+		partitions.swap(cached);
+		this->failed_skimmer = entry.failed_skimmer;
+		logger->Debug("LoadPartitions: cached partitions=%d [cluster=%d]",
+			partitions.size(), hw_cluster_id);
+		return entry.result;
+	}
+	cache_ul.unlock();
+
+	PartitionSkimmer::SkimmerType_t failed = PartitionSkimmer::SKT_NONE;
+	ExitCode_t result = Skim(tg, partitions, hw_cluster_id, failed);
+	this->failed_skimmer = failed;
+
+	// Discard the outcome if the availability changed in the meanwhile
+	cache_ul.lock();
+	if (std::get<2>(key) == availability_epoch)
+		cache.emplace(key, CacheEntry_t{ result, failed, partitions });
+
+	return result;
+}
+
+void ResourcePartitionValidator::LoadPartitions(
+		const TaskGraph &tg,
+		std::vector<uint32_t> const & hw_cluster_ids,
+		std::map<uint32_t, std::list<Partition>> & partitions,
+		std::map<uint32_t, ExitCode_t> & results) {
+
+	std::size_t tg_hash = tg.Hash();
+	std::vector<std::future<void>> pending;
+
+	for (auto hw_cluster_id: hw_cluster_ids) {
+		auto & cluster_partitions(partitions[hw_cluster_id]);
+		auto & cluster_result(results[hw_cluster_id]);
+
+		std::unique_lock<std::mutex> cache_ul(cache_lock);
+		CacheKey_t key(tg_hash, hw_cluster_id, availability_epoch);
+		auto it = cache.find(key);
+		if (it != cache.end()) {
+			std::list<Partition> cached(it->second.partitions);
+			cluster_partitions.swap(cached);
+			cluster_result = it->second.result;
+			continue;
+		}
+		cache_ul.unlock();
+
+		// Independent clusters: skim in parallel
+		pending.push_back(std::async(std::launch::async,
+			[this, &tg, key, &cluster_partitions, &cluster_result]() {
+				PartitionSkimmer::SkimmerType_t failed =
+					PartitionSkimmer::SKT_NONE;
+				cluster_result = Skim(tg, cluster_partitions,
+					std::get<1>(key), failed);
+
+				std::lock_guard<std::mutex> cache_guard(cache_lock);
+				if (std::get<2>(key) == availability_epoch)
+					cache.emplace(key, CacheEntry_t{
+						cluster_result, failed, cluster_partitions });
+			}));
+	}
+
+	for (auto & p: pending)
+		p.get();
+	logger->Debug("LoadPartitions: %d clusters [%d skimmed]",
+		hw_cluster_ids.size(), pending.size());
+}
+
+ResourcePartitionValidator::ExitCode_t
+ResourcePartitionValidator::Skim(
+		const TaskGraph &tg,
+		std::list<Partition> &partitions,
+		uint32_t hw_cluster_id,
+		PartitionSkimmer::SkimmerType_t & failed) {
+
+	logger->Debug("Skim: initial size=%d [cluster=%d]",
+		partitions.size(), hw_cluster_id);
 	PartitionSkimmer::SkimmerType_t skimmer_type = PartitionSkimmer::SkimmerType_t::SKT_NONE;
 
+	// Copy the skimmers (and their locks), to not block the registration
+	// and the other skimmings
+	std::vector<std::pair<int, PartitionSkimmerPtr_t>> chain;
+	std::vector<std::shared_ptr<std::mutex>> chain_mtx;
 	skimmers_lock.lock();
 	if ( skimmers.empty() ) {
 		skimmers_lock.unlock();
-		logger->Warn("LoadPartitions: no skimmers registered, no action performed.");
+		logger->Warn("Skim: no skimmers registered, no action performed.");
 		return PMV_OK;
 	}
 
 	// I get the skimmers in the reverse order, in order to execute the one with highest
 	// priority
 	for (auto s = skimmers.rbegin(); s != skimmers.rend(); ++s) {
-		int priority = s->first;
-		PartitionSkimmerPtr_t skimmer = s->second;
+		chain.push_back(*s);
+		chain_mtx.push_back(skimmers_mtx.at(s->second.get()));
+	}
+	skimmers_lock.unlock();
+
+	for (size_t i = 0; i < chain.size(); ++i) {
+		int priority = chain[i].first;
+		PartitionSkimmerPtr_t skimmer = chain[i].second;
 		skimmer_type = skimmer->GetType();
-		logger->Debug("LoadPartitions: executing skimmer [type=%d] [priority=%d]",
+		logger->Debug("Skim: executing skimmer [type=%d] [priority=%d]",
 			(int)skimmer_type, priority);
 
+		std::unique_lock<std::mutex> skimmer_ul(*chain_mtx[i], std::defer_lock);
+		if (!skimmer->IsReentrant())
+			skimmer_ul.lock();
 		PartitionSkimmer::ExitCode_t ret = skimmer->Skim(tg, partitions, hw_cluster_id);
 		if (ret != PartitionSkimmer::SK_OK) {
-			logger->Error("LoadPartitions: skimmer %d [priority=%d] FAILED [err=%d]",
+			logger->Error("Skim: skimmer %d [priority=%d] FAILED [err=%d]",
 				(int)skimmer_type, priority, ret);
-			this->failed_skimmer = skimmer_type;
-			skimmers_lock.unlock();
+			failed = skimmer_type;
 			return PMV_SKIMMER_FAIL;
 		}
 
@@ -82,11 +191,9 @@ ResourcePartitionValidator::LoadPartitions(
 		}
 	}
 
-	skimmers_lock.unlock();
-
-	this->failed_skimmer = PartitionSkimmer::SKT_NONE;
+	failed = PartitionSkimmer::SKT_NONE;
 	if ( partitions.empty() ) {
-		logger->Warn("LoadPartitions: skimmer %d: "
+		logger->Warn("Skim: skimmer %d: "
 			"no feasible partitions", (int)skimmer_type);
 		return PMV_NO_PARTITION;  // No feasible solution found
 	}
@@ -99,6 +206,7 @@ ResourcePartitionValidator::PropagatePartition(
 		TaskGraph &tg, const Partition &partition) const noexcept {
 
 	logger->Info("PropagatePartition: setting partition id=%d", partition.GetId());
+	NextEpoch();
 	// We have to ensure that no skimmer failed for any reasons before this call.
 	bbque_assert(failed_skimmer == PartitionSkimmer::SKT_NONE);
 	std::lock_guard<std::mutex> curr_lock(skimmers_lock);
@@ -123,6 +231,7 @@ ResourcePartitionValidator::RemovePartition(
 		const Partition &partition) const noexcept {
 
 	logger->Info("RemovePartition: removing partition id=%d", partition.GetId());
+	NextEpoch();
 	// We have to ensure that no skimmer failed for any reasons before this call.
 //	bbque_assert(failed_skimmer == PartitionSkimmer::SKT_NONE);
 	if (failed_skimmer != PartitionSkimmer::SKT_NONE) {
@@ -22,6 +22,13 @@
 #include "bbque/modules_factory.h"
 #include "bbque/system.h"
 
+#ifdef CONFIG_BBQUE_PM_POWERCAP
+#include "bbque/energy_accounter.h"
+#endif
+#ifdef CONFIG_BBQUE_DIST_MODE
+#include "bbque/placement_manager.h"
+#endif
+
 #include "bbque/utils/utility.h"
 
 // The prefix for configuration file attributes
@@ -177,6 +184,16 @@ SchedulerManager::Schedule() {
 	// Check if there are some dead applications to remove
 	am.CheckActiveEXCs();
 
+#ifdef CONFIG_BBQUE_PM_POWERCAP
+	// Energy consumed by the EXCs during the last scheduling period
+	EnergyAccounter::GetInstance().Update();
+#endif
+
+#ifdef CONFIG_BBQUE_DIST_MODE
+	// Cross-node placement, according to the headroom of each node
+	PlacementManager::GetInstance().Run();
+#endif
+
 	SetState(State_t::SCHEDULING);  // --> Applications from now in a not consistent state
 	++sched_count;
 
@@ -197,6 +214,11 @@ SchedulerManager::Schedule() {
 		return FAILED;
 	}
 
+#ifdef CONFIG_BBQUE_DIST_MODE
+	// The offloaded EXCs must not run locally
+	PlacementManager::GetInstance().ReleaseOffloaded(sched_view_id);
+#endif
+
 	// Clear the next AWM from the RUNNING Apps/EXC
 	CommitRunningApplications();
 
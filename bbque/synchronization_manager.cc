@@ -523,12 +523,13 @@ SynchronizationManager::Sync_PostChange(ApplicationStatusIF::SyncState_t syncSta
 
 
 void SynchronizationManager::SyncCommit(AppPtr_t papp) {
+	auto const snap = papp->GetSchedulingSnapshot();
 	logger->Debug("SyncCommit: [%s] is in %s/%s", papp->StrId(),
-			papp->StateStr(papp->State()),
-			papp->SyncStateStr(papp->SyncState()));
+			papp->StateStr(snap.state),
+			papp->SyncStateStr(snap.syncState));
 
 	// Acquiring the resources for RUNNING Applications
-	if (!papp->Blocking() && !papp->Disabled()) {
+	if (!snap.Blocking() && !snap.Disabled()) {
 		auto ra_result = ra.SyncAcquireResources(papp);
 		if (ra_result != ResourceAccounter::RA_SUCCESS) {
 			logger->Error("SyncCommit: [%s] failed (ret=%d)",
@@ -902,12 +903,13 @@ SynchronizationManager::Sync_PlatformForProcesses() {
 }
 
 void SynchronizationManager::SyncCommit(ProcPtr_t proc) {
+	auto const snap = proc->GetSchedulingSnapshot();
 	logger->Debug("SyncCommit: [%s] is in %s/%s", proc->StrId(),
-			proc->StateStr(proc->State()),
-			proc->SyncStateStr(proc->SyncState()));
+			proc->StateStr(snap.state),
+			proc->SyncStateStr(snap.syncState));
 
 	// Acquiring the resources for RUNNING Applications
-	if (!proc->Blocking() && !proc->Disabled()) {
+	if (!snap.Blocking() && !snap.Disabled()) {
 		auto ra_result = ra.SyncAcquireResources(proc);
 		if (ra_result != ResourceAccounter::RA_SUCCESS) {
 			logger->Error("SyncCommit: failed for [%s] (ret=%d)",
@@ -17,8 +17,12 @@
 
 #include "bbque/utils/cgroups.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <cstring>
+#include <fcntl.h>
 #include <linux/version.h>
+#include <unistd.h>
 #include <vector>
 
 namespace bbque { namespace utils {
@@ -347,6 +351,106 @@ CGroups::CGResult CGroups::Delete(const char *cgroup_path) {
 	return CGResult::OK;
 }
 
+void CGroups::SetMountPoint(CGC id, const char *mount_point) {
+	free(mounts[id]);
+	mounts[id] = (mount_point != nullptr) ? strdup(mount_point) : nullptr;
+}
+
+CGroups::CGResult CGroups::WriteAttribute(
+		CGC id,
+		const char *cgroup_path,
+		const char *attribute,
+		std::string const &value) {
+	std::string filepath(mounts[id]);
+	filepath += cgroup_path;
+	filepath += "/";
+	filepath += attribute;
+
+	int fd = ::open(filepath.c_str(), O_WRONLY | O_TRUNC);
+	if (fd < 0) {
+		logger->Error("CGroups::WriteAttribute [%s] open FAILED (Error: %d, %s)",
+				filepath.c_str(), errno, strerror(errno));
+		return CGResult::WRITE_FAILED;
+	}
+	ssize_t len = ::write(fd, value.c_str(), value.size());
+	int error = errno;
+	::close(fd);
+	if (len != static_cast<ssize_t>(value.size())) {
+		logger->Error("CGroups::WriteAttribute [%s] <- [%s] FAILED (Error: %d, %s)",
+				filepath.c_str(), value.c_str(), error, strerror(error));
+		return CGResult::WRITE_FAILED;
+	}
+	return CGResult::OK;
+}
+
+CGroups::CGResult CGroups::WriteCgroupDiff(
+		const char *cgroup_path,
+		const CGSetup &cgroup_data,
+		CGSetup &cgroup_cache,
+		uint8_t *nr_writes) {
+	CGResult result = CGResult::OK;
+	uint8_t count = 0;
+
+	auto update = [&](CGC id, const char *attribute,
+			std::string const &value, std::string &cached) {
+		if (!mounts[id] || value.empty() || (value == cached))
+			return;
+		++count;
+		if (WriteAttribute(id, cgroup_path, attribute, value) != CGResult::OK) {
+			// Written at the next update
+			cached.clear();
+			result = CGResult::WRITE_FAILED;
+			return;
+		}
+		cached = value;
+	};
+
+	update(CGC::CPUSET, "cpuset.mems",
+			cgroup_data.cpuset.mems, cgroup_cache.cpuset.mems);
+	update(CGC::CPUSET, "cpuset.cpus",
+			cgroup_data.cpuset.cpus, cgroup_cache.cpuset.cpus);
+
+	// A shorter period with the previous quota could exceed the bandwidth
+	// of the parent: in such case, the quota is updated first
+	bool quota_first = false;
+	if (!cgroup_cache.cpu.cfs_period_us.empty() &&
+			!cgroup_data.cpu.cfs_period_us.empty())
+		quota_first = (std::stoul(cgroup_data.cpu.cfs_period_us) <
+				std::stoul(cgroup_cache.cpu.cfs_period_us));
+	if (quota_first)
+		update(CGC::CPU, "cpu.cfs_quota_us",
+				cgroup_data.cpu.cfs_quota_us, cgroup_cache.cpu.cfs_quota_us);
+	update(CGC::CPU, "cpu.cfs_period_us",
+			cgroup_data.cpu.cfs_period_us, cgroup_cache.cpu.cfs_period_us);
+	update(CGC::CPU, "cpu.cfs_quota_us",
+			cgroup_data.cpu.cfs_quota_us, cgroup_cache.cpu.cfs_quota_us);
+
+	update(CGC::MEMORY, "memory.limit_in_bytes",
+			cgroup_data.memory.limit_in_bytes,
+			cgroup_cache.memory.limit_in_bytes);
+
+	if (nr_writes)
+		*nr_writes = count;
+	return result;
+}
+
+CGroups::CGResult CGroups::AttachTask(const char *cgroup_path, int pid) {
+	std::string pid_str(std::to_string(pid));
+	std::vector<std::string> attached;
+
+	for (int id : controllers_IDs) {
+		// Co-mounted controllers share the hierarchy
+		if (!mounts[id] || (std::find(attached.begin(), attached.end(),
+				mounts[id]) != attached.end()))
+			continue;
+		if (WriteAttribute(static_cast<CGC>(id), cgroup_path,
+				"cgroup.procs", pid_str) != CGResult::OK)
+			return CGResult::ATTACH_FAILED;
+		attached.push_back(mounts[id]);
+	}
+	return CGResult::OK;
+}
+
 } /* utils */
 
 } /* bbque */
@@ -31,7 +31,9 @@
 
 namespace bbque { namespace utils {
 
-Perf::Perf() :
+Perf::Perf(int cpu, bool grouped) :
+	cpu_id(cpu),
+	grouped(grouped),
 	opened(false) {
 
 }
@@ -51,34 +53,79 @@ Perf::~Perf() {
 	pGroupLeader.reset();
 
 	// clean-up the registered counters list
+	groups.clear();
 	counters.clear();
 }
 
 int Perf::EventOpen(struct perf_event_attr *attr,
 		pid_t pid, int cpu, int group_fd,
-		unsigned long flags) {
+		unsigned long flags, bool quiet) {
 	int result;
 
 	attr->size = sizeof(*attr);
 	result = syscall(__NR_perf_event_open, attr, pid, cpu,
 			group_fd, flags);
 	if (result == -1) {
+		// The caller has a fallback
+		if (quiet)
+			return result;
 		fprintf(stderr, FE("Opening PERF counters FAILED "
 					"(Error: %s)\n"), strerror(errno));
 	} else {
 		opened = true;
 	}
 
-	assert(result >= 0);
+	// System-wide counters could be not available, e.g., because of
+	// perf_event_paranoid settings: let the caller deal with it
+	assert(cpu >= 0 || result >= 0);
 	return result;
 }
 
+int Perf::OpenCounter(pRegisteredCounter_t prc) {
+	pid_t pid = (cpu_id < 0) ? gettid() : -1;
+	int fd;
+
+	if (grouped) {
+		prc->attr.read_format |= PERF_FORMAT_GROUP;
+
+		// Join the current group, if not full yet
+		if ((last_leader != -1) &&
+				((BBQUE_PERF_GROUP_SIZE_MAX == 0) ||
+				 (groups[last_leader].size() < BBQUE_PERF_GROUP_SIZE_MAX))) {
+			// Members follow the leader enabling state
+			prc->attr.disabled = 0;
+			fd = EventOpen(&(prc->attr), pid, cpu_id, last_leader, 0, true);
+			if (fd >= 0) {
+				prc->leader = last_leader;
+				groups[last_leader].push_back(prc);
+				return fd;
+			}
+			prc->attr.disabled = 1;
+		}
+
+		// Start a new group
+		fd = EventOpen(&(prc->attr), pid, cpu_id, -1, 0, true);
+		if (fd >= 0) {
+			prc->leader = fd;
+			last_leader = fd;
+			groups[fd].push_back(prc);
+			return fd;
+		}
+
+		// Group reads not supported (e.g. inherited counters on old
+		// kernels): fall back to a standalone counter
+		prc->attr.read_format &= ~PERF_FORMAT_GROUP;
+	}
+
+	return EventOpen(&(prc->attr), pid, cpu_id, -1, 0);
+}
+
 int Perf::AddCounter(perf_type_id type,
 		uint64_t config, bool exclude_kernel) {
 	pRegisteredCounter_t prc(new RegisteredCounter());
 
 	// Set default counter options
-	prc->attr.inherit = 1;
+	prc->attr.inherit = (cpu_id < 0) ? 1 : 0;
 	prc->attr.disabled = 1;
 	//prc->attr.exclude_idle = 1;
 
@@ -97,8 +144,9 @@ int Perf::AddCounter(perf_type_id type,
 	prc->attr.config = config;
 
 	// Add a new event counter
-	prc->fd = EventOpen(&(prc->attr), gettid(), -1, -1, 0);
-	//prc->fd = EventOpen(&(prc->attr), gettid(), -1, GroupLeader(), 0);
+	prc->fd = OpenCounter(prc);
+	if (prc->fd < 0)
+		return -1;
 
 	// Keep track of GroupLeader
 	if (!IsGroupLeaderDefined()) {
@@ -107,8 +155,8 @@ int Perf::AddCounter(perf_type_id type,
 
 	counters[prc->fd] = prc;
 
-	fprintf(stderr, FI("Added new PERF counter [%02d:%d:%02lu]\n"),
-			prc->fd, type, config);
+	fprintf(stderr, FI("Added new PERF counter [%02d:%d:%02lu] (leader: %d)\n"),
+			prc->fd, type, config, prc->leader);
 
 	return prc->fd;
 }
@@ -120,6 +168,17 @@ int Perf::Enable() {
 		return -1;
 	}
 
+	// System-wide counters are not bound to the calling task
+	if (cpu_id >= 0) {
+		for (auto & group: groups)
+			ioctl(group.first, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		for (auto & entry: counters) {
+			if (entry.second->leader == -1)
+				ioctl(entry.first, PERF_EVENT_IOC_ENABLE, 0);
+		}
+		return 0;
+	}
+
 	prctl(PR_TASK_PERF_EVENTS_ENABLE);
 
 	return 0;
@@ -132,6 +191,16 @@ int Perf::Disable() {
 		return 0;
 	}
 
+	if (cpu_id >= 0) {
+		for (auto & group: groups)
+			ioctl(group.first, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		for (auto & entry: counters) {
+			if (entry.second->leader == -1)
+				ioctl(entry.first, PERF_EVENT_IOC_DISABLE, 0);
+		}
+		return 0;
+	}
+
 	prctl(PR_TASK_PERF_EVENTS_DISABLE);
 
 	return 0;
@@ -153,11 +222,60 @@ int Perf::ReadCounter(int fd, void *buf, size_t n) {
 #define UPDATE_DELTA(COUNTER)\
 	prc->delta.COUNTER = prc->count.COUNTER - old_count.COUNTER
 
-uint64_t Perf::Update(int id, bool delta) {
-	pRegisteredCounter_t prc = counters[id];
+int Perf::ReadSingle(pRegisteredCounter_t prc) {
 	ReadFormat_t old_count = prc->count;
 	ssize_t bytes;
 
+	// Reading counters
+	bytes = ReadCounter(prc->fd, &(prc->count), sizeof(prc->count));
+	assert(bytes == sizeof(prc->count));
+	if (bytes != sizeof(prc->count))
+		return -1;
+
+	// Update deltas since last update
+	UPDATE_DELTA(value);
+	UPDATE_DELTA(time_enabled);
+	UPDATE_DELTA(time_running);
+
+	return bytes;
+}
+
+int Perf::ReadGroup(int leader) {
+	auto & group(groups[leader]);
+	size_t nr = group.size();
+	ssize_t bytes;
+
+	if (group_buf.size() < (3 + nr))
+		group_buf.resize(3 + nr);
+
+	// A single read returns the values of all the group members, in the
+	// order they have been added, and the times of the group
+	bytes = read(leader, group_buf.data(), (3 + nr) * sizeof(uint64_t));
+	if (bytes < (ssize_t) (3 * sizeof(uint64_t)))
+		return -1;
+	if (group_buf[0] < nr)
+		nr = group_buf[0];
+
+	for (size_t i = 0; i < nr; ++i) {
+		pRegisteredCounter_t prc = group[i];
+		ReadFormat_t old_count = prc->count;
+		prc->count.value        = group_buf[3 + i];
+		prc->count.time_enabled = group_buf[1];
+		prc->count.time_running = group_buf[2];
+
+		// Update deltas since last update
+		UPDATE_DELTA(value);
+		UPDATE_DELTA(time_enabled);
+		UPDATE_DELTA(time_running);
+	}
+
+	return bytes;
+}
+
+uint64_t Perf::Update(int id, bool delta) {
+	pRegisteredCounter_t prc = counters[id];
+	int bytes;
+
 	if (!opened || !prc) {
 		fprintf(stderr, FE("Reading PERF counter FAILED "
 					"(Error: Counters not opened or invalid counter [%d])\n"),
@@ -165,21 +283,46 @@ uint64_t Perf::Update(int id, bool delta) {
 		return 0;
 	}
 
-	// Reading counters
-	bytes = ReadCounter(id, &(prc->count), sizeof(prc->count));
-	assert(bytes == sizeof(prc->count));
+	// Reading counters (the whole group, for grouped ones)
+	if (prc->leader != -1)
+		bytes = ReadGroup(prc->leader);
+	else
+		bytes = ReadSingle(prc);
 	(void)bytes; // quite compilation warning on RELEASE build
 
-	// Update deltas since last update
-	UPDATE_DELTA(value);
-	UPDATE_DELTA(time_enabled);
-	UPDATE_DELTA(time_running);
-
 	if (delta)
 		return (prc->delta).value;
 	return (prc->count).value;
 }
 
+int Perf::UpdateAll() {
+	int reads = 0;
+
+	if (!opened) {
+		fprintf(stderr, FE("Reading PERF counters FAILED "
+					"(Error: Counters not opened)\n"));
+		return -1;
+	}
+
+	// One system call per group...
+	for (auto & group: groups) {
+		if (ReadGroup(group.first) < 0)
+			return -1;
+		++reads;
+	}
+
+	// ...and one per standalone counter
+	for (auto & entry: counters) {
+		if (entry.second->leader != -1)
+			continue;
+		if (ReadSingle(entry.second) < 0)
+			return -1;
+		++reads;
+	}
+
+	return reads;
+}
+
 uint64_t Perf::Read(int id, bool delta) {
 	pRegisteredCounter_t prc = counters[id];
 	if (delta)
@@ -38,6 +38,7 @@
 #include "bbque/rtlib.h"
 #include "bbque/app/application_conf.h"
 #include "bbque/app/recipe.h"
+#include "bbque/app/working_mode_index.h"
 #include "bbque/utils/logging/logger.h"
 #include "bbque/utils/utility.h"
 
@@ -50,6 +51,7 @@ namespace bu = bbque::utils;
 namespace bbque {
 
 class ApplicationManager;
+class ExcQueue;
 
 namespace res {
 class Resource;
@@ -119,9 +121,31 @@ struct RuntimeProfiling_t {
 class Application: public ApplicationConfIF {
 
 friend class bbque::ApplicationManager;
+friend class bbque::ExcQueue;
 
 public:
 
+	/**
+	 * @enum QueueType_t
+	 * @brief The types of ApplicationManager queues an EXC is linked into
+	 *
+	 * An EXC can be linked into at most one queue for each type.
+	 */
+	enum QueueType_t {
+		/** All the EXCs */
+		QUEUE_ALL = 0,
+		/** Priority level queues */
+		QUEUE_PRIO,
+		/** Scheduling state queues */
+		QUEUE_STATE,
+		/** Synchronization state queues */
+		QUEUE_SYNC,
+		/** Programming language queues */
+		QUEUE_LANG,
+
+		QUEUE_TYPE_COUNT
+	};
+
 	/**
 	 * @brief Constructor with parameters name and priority class
 	 * @param name Application name
@@ -216,17 +240,22 @@ public:
 	/**
 	 * @see ApplicationStatusIF
 	 */
-	inline AwmPtrList_t const & WorkingModes() noexcept { return awms.enabled_list; }
+	inline AwmPtrList_t const & WorkingModes() noexcept { return awms.index.Enabled(); }
 
 	/**
 	 * @see ApplicationStatusIF
 	 */
-	inline AwmPtr_t const & LowValueAWM() noexcept { return awms.enabled_list.front(); }
+	inline AwmPtrList_t const & ParetoWorkingModes() noexcept { return awms.index.Pareto(); }
 
 	/**
 	 * @see ApplicationStatusIF
 	 */
-	inline AwmPtr_t const & HighValueAWM() noexcept { return awms.enabled_list.back(); }
+	inline AwmPtr_t const & LowValueAWM() noexcept { return awms.index.Enabled().front(); }
+
+	/**
+	 * @see ApplicationStatusIF
+	 */
+	inline AwmPtr_t const & HighValueAWM() noexcept { return awms.index.Enabled().back(); }
 
 	/**
 	 * @see ApplicationStatusIF
@@ -452,6 +481,22 @@ private:
 	/** True if this is an application container */
 	bool container;
 
+	/**
+	 * @struct QueueHook_t
+	 * @brief Intrusive links into an ApplicationManager queue
+	 */
+	struct QueueHook_t {
+		/** Next EXC in the queue (kept alive while linked) */
+		std::shared_ptr<Application> next;
+		/** Previous EXC in the queue */
+		Application * prev = nullptr;
+		/** Index of the queue currently linking the EXC (-1 if none) */
+		int16_t queue = -1;
+	};
+
+	/** The links into the ApplicationManager queues, one per queue type */
+	QueueHook_t queue_hooks[QUEUE_TYPE_COUNT];
+
 	/**
 	 * @brief Store profiling information collected at runtime
 	 */
@@ -499,10 +544,12 @@ private:
 	struct WorkingModesInfo {
 		/** Vector of all the working modes */
 		AwmPtrVect_t recipe_vect;
-		/** List of pointers to enabled working modes */
-		AwmPtrList_t enabled_list;
+		/** Enabled working modes, sorted by value, and their Pareto frontier */
+		WorkingModeIndex index;
 		/** A bitset to keep track of the enabled working modes */
 		std::bitset<MAX_NUM_AWM> enabled_bset;
+		/** The working modes violating a resource constraint */
+		std::bitset<MAX_NUM_AWM> out_of_bounds;
 		/** Lower bound AWM ID*/
 		uint8_t low_id;
 		/** Upper bound AWM ID*/
@@ -625,8 +672,9 @@ private:
 	 * This is needed whenever a constraint has been asserted or removed.
 	 * The bitmap of the enabled is scanned, each set bit is related to the ID
 	 * of the AWM to consider enabled. If the resources required by the AWM
-	 * do not violate any resource constraint, the AWM is inserted into the
-	 * list. Finally the list is ordered by "AWM value".
+	 * do not violate any resource constraint (out_of_bounds bitmap), the AWM
+	 * is enabled in the index, which keeps the list ordered by "AWM value"
+	 * and updates the Pareto frontier.
 	 */
 	void RebuildEnabledWorkingModes();
 
@@ -636,7 +684,7 @@ private:
 	 * When the list of enabled working modes changes, due to constraint
 	 * assertions, a couple of operations are required:
 	 * 1) we must signal if the currently scheduled AWM has been invalidated.
-	 * 2) the list must be re-ordered by AWM value
+	 * 2) the index must refresh the enabled list and the Pareto frontier
 	 * This is what this method does.
 	 */
 	void FinalizeEnabledWorkingModes();
@@ -656,9 +704,10 @@ private:
 	 *
 	 * Whenever a resource constraint is set or removed, the method is called
 	 * in order to check if there are some working mode to disable or
-	 * re-enable.  The method rebuilds the list of enabled working modes by
-	 * checking if there are some working modes requiring a resource usage
-	 * which is out of the bounds set by a resource constraint assertion.
+	 * re-enable.  The method updates the bitmap of the working modes
+	 * requiring a resource usage which is out of the bounds set by a
+	 * resource constraint assertion, and then rebuilds the list of enabled
+	 * working modes.
 	 */
 	void UpdateEnabledWorkingModes();
 
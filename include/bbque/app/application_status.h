@@ -19,8 +19,8 @@
 #define BBQUE_APPLICATION_STATUS_IF_H_
 
 #include <cassert>
-#include <list>
 #include <string>
+#include <vector>
 
 #include "bbque/config.h"
 #include "bbque/app/schedulable.h"
@@ -39,8 +39,8 @@ typedef std::shared_ptr<ApplicationStatusIF> AppSPtr_t;
 /** The application UID type */
 typedef BBQUE_UID_TYPE AppUid_t;
 
-/** List of WorkingMode pointers */
-typedef std::list<AwmPtr_t> AwmPtrList_t;
+/** List of WorkingMode pointers (contiguous) */
+typedef std::vector<AwmPtr_t> AwmPtrList_t;
 
 /**
  * @brief Provide interfaces to query application information
@@ -122,6 +122,15 @@ public:
 	 */
 	virtual AwmPtrList_t const & WorkingModes() = 0;
 
+	/**
+	 * @brief The enabled working modes not dominated by another one, i.e.
+	 * there is no enabled working mode with a value not lower, requesting
+	 * no more of any resource
+	 * @return The schedulable working modes of the Pareto frontier, sorted
+	 * by value
+	 */
+	virtual AwmPtrList_t const & ParetoWorkingModes() = 0;
+
 	/**
 	 * @brief The working mode with the lowest value
 	 * @return A pointer to the working mode descriptor having the lowest
@@ -18,6 +18,7 @@
 #ifndef BBQUE_SCHEDULABLE_H_
 #define BBQUE_SCHEDULABLE_H_
 
+#include <atomic>
 #include <cassert>
 #include <memory>
 
@@ -130,7 +131,8 @@ public:
 		SyncState_t syncState;    /** The current synchronization state */
 		AwmPtr_t awm;             /** The current application working mode */
 		AwmPtr_t next_awm;        /** The next scheduled application working mode */
-		uint64_t count = 0;       /** How many times the application has been scheduled */
+		std::atomic<uint64_t> count{0}; /** How many times the application has been scheduled */
+		std::atomic<uint64_t> snapshot{0}; /** The packed SchedulingSnapshot_t */
 		bool remote = false;      /** Set true if scheduled on a remote node */
 
 		/**
@@ -149,6 +151,41 @@ public:
 		};
 	};
 
+	/**
+	 * @struct SchedulingSnapshot_t
+	 *
+	 * A consistent copy of the scheduling state, which can be read without
+	 * locking the scheduling info (see GetSchedulingSnapshot()).
+	 *
+	 * The working modes are identified by their ID: the descriptors
+	 * (CurrentAWM(), NextAWM()) are still read under the mutex, since
+	 * their lifetime is bound to the shared pointers in the scheduling
+	 * info.
+	 */
+	struct SchedulingSnapshot_t {
+		State_t state;            /** The current scheduled state */
+		State_t preSyncState;     /** The state before a sync has been required */
+		SyncState_t syncState;    /** The current synchronization state */
+		bool has_awm;             /** A current working mode is set */
+		bool has_next_awm;        /** A next working mode is set */
+		int8_t awm_id;            /** The current working mode ID */
+		int8_t next_awm_id;       /** The next working mode ID */
+
+		inline bool Disabled() const { return syncState == DISABLED; }
+		inline bool Finished() const { return state == FINISHED; }
+		inline bool Active() const {
+			return (state == READY) || (state == RUNNING);
+		}
+		inline bool Running() const { return state == RUNNING; }
+		inline bool Synching() const { return state == SYNC; }
+		inline bool Starting() const {
+			return Synching() && (syncState == STARTING);
+		}
+		inline bool Blocking() const {
+			return Synching() && (syncState == BLOCKED);
+		}
+	};
+
 #ifdef CONFIG_BBQUE_CGROUPS_DISTRIBUTED_ACTUATION
 	struct CGroupSetupData_t {
 		unsigned long cpu_ids;
@@ -213,6 +250,20 @@ public:
 	virtual Type GetType() const noexcept { return type; }
 
 
+	/**
+	 * @brief Get a consistent copy of the scheduling state
+	 *
+	 * This does not lock the scheduling info: it is meant for the
+	 * components checking the state of many EXCs at each scheduling
+	 * round (e.g. the policies), without contending with the state
+	 * transitions.
+	 *
+	 * The state accessors below read the same copy, i.e. they do not lock
+	 * the scheduling info either. Multiple checks on the same EXC should
+	 * use a single snapshot, to be consistent with each other.
+	 */
+	SchedulingSnapshot_t GetSchedulingSnapshot() const noexcept;
+
 	/**
 	 * @brief Get the schedule state
 	 * @return The current scheduled state
@@ -391,6 +442,14 @@ protected:
 	/** A string id with information for logging */
 	char str_id[SCHEDULABLE_ID_MAX_LEN];
 
+	/**
+	 * @brief Publish the scheduling state to the lock-free readers
+	 *
+	 * To be called, with the scheduling info mutex held, once the state,
+	 * synchronization state or working modes have been updated.
+	 */
+	void UpdateSchedulingSnapshot() noexcept;
+
 	/**
 	 * @brief Update the application state and synchronization state
 	 *
@@ -19,8 +19,10 @@
 #define BBQUE_WORKING_MODE_H_
 
 #include <map>
+#include <memory>
 
 #include "bbque/app/working_mode_status.h"
+#include "bbque/res/binding_candidate.h"
 #include "bbque/res/bitset.h"
 #include "bbque/res/resource_assignment.h"
 #include "bbque/utils/logging/logger.h"
@@ -298,6 +300,7 @@ public:
 
 	inline void ClearResourceRequests() {
 		resources.requested.clear();
+		std::atomic_store(&resources.binding_domains, br::BindingDomainsPtr_t());
 	}
 
 /******************************************************************************
@@ -356,6 +359,37 @@ public:
 			br::ResourceBitset const & filter_mask,
 			int32_t prev_refn = -1);
 
+	/**
+	 * @brief Get a candidate binding into a binding domain
+	 *
+	 * The candidate allows the evaluation of a binding, e.g., the
+	 * availability of the resources in the domain, without building the
+	 * map of bound resource assignments. The resources to which the
+	 * requests can be bound are retrieved once, at the first call for a
+	 * type of resource, and then shared by all the candidates.
+	 *
+	 * @param r_type The type of resource to bind
+	 * @param out_id System resource name ID
+	 *
+	 * @return The candidate, equivalent to a binding of all the requests
+	 * from any ID of the given type (R_ID_ANY) to out_id
+	 */
+	br::BindingCandidate GetBindingCandidate(
+			br::ResourceType r_type, BBQUE_RID_TYPE out_id);
+
+	/**
+	 * @brief Bind resource assignments as in a candidate binding
+	 *
+	 * @param candidate The candidate (selected by the policy)
+	 * @param prev_refn  Reference number of an already started binding
+	 *
+	 * @return The reference number of the binding performed, for continuing
+	 * with further binding actions
+	 */
+	int32_t BindResource(
+			br::BindingCandidate const & candidate,
+			int32_t prev_refn = -1);
+
 	/**
 	 * @brief Add missing resource requests to a resource assignment map
 	 *
@@ -502,6 +536,10 @@ public:
 		uint32_t mem_time;
 		uint32_t mem_time_tot;
 		uint32_t sync_time;
+		/** Cycle time quantiles {p50, p95, p99} [us] */
+		uint32_t ctime_quantiles_us[3] = {0, 0, 0};
+		/** onRun time quantiles {p50, p95, p99} [us] */
+		uint32_t rtime_quantiles_us[3] = {0, 0, 0};
 	};
 
 	/**
@@ -535,6 +573,21 @@ public:
 		logger->Debug("Synchronization time: %d", rt_prof.sync_time);
 	}
 
+	/**
+	 * @brief Set the cycle and onRun time quantiles (tail latency)
+	 * @param ctime_q Cycle time {p50, p95, p99} [us] coming from RTLib
+	 * @param rtime_q onRun time {p50, p95, p99} [us] coming from RTLib
+	 */
+	inline void SetRuntimeProfQuantiles(
+			uint32_t const ctime_q[3], uint32_t const rtime_q[3]) {
+		std::copy(ctime_q, ctime_q + 3, rt_prof.ctime_quantiles_us);
+		std::copy(rtime_q, rtime_q + 3, rt_prof.rtime_quantiles_us);
+		logger->Debug("Cycle time quantiles: {p50=%d, p95=%d, p99=%d} us",
+			ctime_q[0], ctime_q[1], ctime_q[2]);
+		logger->Debug("onRun time quantiles: {p50=%d, p95=%d, p99=%d} us",
+			rtime_q[0], rtime_q[1], rtime_q[2]);
+	}
+
 	/**
 	 * @brief Get the collection runtime profiling data
 	 */
@@ -699,6 +752,12 @@ private:
 		 * synchronize
 		 */
 		size_t sync_refn;
+		/**
+		 * The resources to which the requests can be bound, per binding
+		 * domain, shared by the binding candidates (concurrently
+		 * accessed by the policies evaluating the candidates)
+		 */
+		br::BindingDomainsPtr_t binding_domains;
 		/**
 		 *Info regarding bindings per resource
 		 */
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_WORKING_MODE_INDEX_H_
+#define BBQUE_WORKING_MODE_INDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "bbque/app/recipe.h"
+
+namespace bbque { namespace app {
+
+/**
+ * @class WorkingModeIndex
+ *
+ * The enabled working modes of an application, sorted by value, and the
+ * Pareto frontier of the enabled ones.
+ *
+ * A working mode is dominated by another one if this one has a value not
+ * lower and requests no more of any resource, being better in at least one
+ * of them. The resource requests and the values of the recipe working modes
+ * do not change, hence the dominance relations and the order by value are
+ * computed once, by Init(). Enabling or disabling a working mode only
+ * updates the number of enabled working modes dominating the other ones:
+ * the arrays are then refreshed by Commit(), in linear time and without
+ * sorting.
+ */
+class WorkingModeIndex {
+
+public:
+
+	/**
+	 * @brief Build the index of a set of working modes, all disabled
+	 *
+	 * @param awms The working modes, indexed by ID (null entries are
+	 * skipped)
+	 */
+	void Init(AwmPtrVect_t const & awms);
+
+	/**
+	 * @brief Enable or disable a working mode
+	 *
+	 * The arrays are not updated until the next Commit().
+	 *
+	 * @param id The working mode ID
+	 * @param enabled true to enable it, false to disable it
+	 *
+	 * @return true if the state of the working mode has changed
+	 */
+	bool SetEnabled(uint8_t id, bool enabled);
+
+	/**
+	 * @brief Refresh the arrays of enabled working modes and of the Pareto
+	 * frontier, after a set of SetEnabled() calls
+	 */
+	void Commit();
+
+	/**
+	 * @brief Check if a working mode is enabled
+	 */
+	inline bool IsEnabled(uint8_t id) const {
+		return (id < nodes.size()) && nodes[id].enabled;
+	}
+
+	/**
+	 * @brief The enabled working modes, sorted by increasing value
+	 */
+	inline AwmPtrVect_t const & Enabled() const {
+		return enabled;
+	}
+
+	/**
+	 * @brief The enabled working modes not dominated by another enabled
+	 * working mode, sorted by increasing value
+	 */
+	inline AwmPtrVect_t const & Pareto() const {
+		return pareto;
+	}
+
+	/**
+	 * @brief Disable all the working modes and release them
+	 */
+	void Clear();
+
+private:
+
+	/**
+	 * @brief Index entry of a working mode
+	 */
+	struct Node {
+		/** The working mode descriptor */
+		AwmPtr_t awm;
+		/** Whether the working mode is enabled */
+		bool enabled = false;
+		/** The number of enabled working modes dominating this one */
+		uint16_t dominators = 0;
+		/** The IDs of the working modes dominated by this one */
+		std::vector<uint8_t> dominated;
+	};
+
+	/** The index entries, by working mode ID */
+	std::vector<Node> nodes;
+
+	/** The working mode IDs, sorted by increasing value */
+	std::vector<uint8_t> value_order;
+
+	/** The enabled working modes, sorted by increasing value */
+	AwmPtrVect_t enabled;
+
+	/** The Pareto frontier of the enabled working modes */
+	AwmPtrVect_t pareto;
+
+};
+
+} // namespace app
+
+} // namespace bbque
+
+#endif // BBQUE_WORKING_MODE_INDEX_H_
@@ -161,6 +161,16 @@ public:
 	 */
 	void CheckActiveEXCs();
 
+	/**
+	 * @brief Register a recipe built at run-time
+	 *
+	 * The recipe is validated and made available to the EXCs created
+	 * thereafter with its name, as if it was loaded by the recipe loader.
+	 *
+	 * @param recipe The recipe object
+	 */
+	void RegisterRecipe(RecipePtr_t recipe);
+
 
 /*******************************************************************************
  *     Thread-Safe Queue Access Functions
@@ -542,7 +552,8 @@ private:
 	 * Map of all the applications instances which entered the
 	 * resource manager starting from its boot. The map key is the UID of the
 	 * application instance. The value is the application descriptor of the
-	 * instance.
+	 * instance. This is the lookup table of the EXCs, while the queues below
+	 * are intrusive lists linking the same descriptors.
 	 */
 	AppsUidMap_t uids;
 
@@ -552,9 +563,9 @@ private:
 	std::recursive_mutex uids_mtx;
 
 	/**
-	 * Array of iterator retainers for "in loop erase" support on UID map
+	 * Queue of all the EXCs, for "in loop erase" safe visits
 	 */
-	AppsUidMapItRetainer_t uids_ret;
+	ExcQueue uids_q;
 
 
 	/**
@@ -581,55 +592,37 @@ private:
 	 * ones. Each position in the vector points to a set of maps grouping active
 	 * applications by priority.
 	 */
-	AppsUidMap_t prio_vec[BBQUE_APP_PRIO_LEVELS];
+	ExcQueue prio_vec[BBQUE_APP_PRIO_LEVELS];
 
 	/**
 	 * Array of mutexes protecting the priority queues
 	 */
 	std::mutex prio_mtx[BBQUE_APP_PRIO_LEVELS];
 
-	/**
-	 * Array of iterator retainers for "in loop erase" support on priority
-	 * queues
-	 */
-	AppsUidMapItRetainer_t prio_ret[BBQUE_APP_PRIO_LEVELS];
-
 
 	/**
 	 * Array grouping the applications by status (@see ScheduleFlag).
 	 * Each position points to a set of maps pointing applications
 	 */
-	AppsUidMap_t status_vec[ApplicationStatusIF::STATE_COUNT];
+	ExcQueue status_vec[ApplicationStatusIF::STATE_COUNT];
 
 	/**
 	 * Array of mutexes protecting the status queues.
 	 */
 	std::mutex status_mtx[ApplicationStatusIF::STATE_COUNT];
 
-	/**
-	 * Array of iterator retainers for "in loop erase" support on STATUS
-	 * queues
-	 */
-	AppsUidMapItRetainer_t status_ret[ApplicationStatusIF::STATE_COUNT];
-
 	/**
 	 * Array grouping the applications by programming language (@see
 	 * RTLIB_ProgrammingLanguage_t). Each position points to a set of maps
 	 * pointing applications
 	 */
-	AppsUidMap_t lang_vec[RTLIB_LANG_COUNT];
+	ExcQueue lang_vec[RTLIB_LANG_COUNT];
 
 	/**
 	 * Array of mutexes protecting the programming language queue
 	 */
 	std::mutex lang_mtx[RTLIB_LANG_COUNT];
 
-	/**
-	 * Array of iterator retainers for "in loop erase" support on STATUS
-	 * queues
-	 */
-	AppsUidMapItRetainer_t lang_ret[RTLIB_LANG_COUNT];
-
 	/**
 	 * @brief Applications grouping based on next state to be scheduled.
 	 *
@@ -638,19 +631,13 @@ private:
 	 * correposnding scheduled status. This view on applicaitons could be
 	 * exploited by the synchronization module to update applications.
 	 */
-	AppsUidMap_t sync_vec[ApplicationStatusIF::SYNC_STATE_COUNT];
+	ExcQueue sync_vec[ApplicationStatusIF::SYNC_STATE_COUNT];
 
 	/**
 	 * Array of mutexes protecting the synchronization queues.
 	 */
 	std::mutex sync_mtx[ApplicationStatusIF::SYNC_STATE_COUNT];
 
-	/**
-	 * Array of iterator retainers for "in loop erase" support on SYNC
-	 * queues
-	 */
-	AppsUidMapItRetainer_t sync_ret[ApplicationStatusIF::SYNC_STATE_COUNT];
-
 	/**
 	 * @brief EXC cleaner deferrable
 	 *
@@ -687,12 +674,6 @@ private:
 	 */
 	ExitCode_t AppsRemove(AppPtr_t papp);
 
-	/**
-	 * @brief In-Loop-Erase-Safe update of iterators on applications
-	 * containers
-	 */
-	void UpdateIterators(AppsUidMapItRetainer_t & ret, AppPtr_t papp);
-
 
 	/**
 	 * @brief Change the status of an application/EXC
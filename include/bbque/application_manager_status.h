@@ -66,12 +66,105 @@ class AppsUidMapIt;
  */
 typedef std::list<struct AppsUidMapIt*> AppsUidMapItRetainer_t;
 
+/**
+ * @class ExcQueue
+ * @brief Intrusive queue of EXC descriptors
+ *
+ * The queue does not allocate memory: the links are stored into the EXC
+ * descriptors themselves (one set of links for each queue type), so that
+ * moving an EXC from a queue to another one (e.g. on a state transition) is a
+ * constant time operation. The EXCs are visited in insertion order.
+ *
+ * The queue is not thread-safe: concurrent accesses must be serialized by
+ * the owner.
+ */
+class ExcQueue {
+
+public:
+
+	ExcQueue() {};
+
+	~ExcQueue() {
+		Clear();
+	};
+
+	/**
+	 * @brief Set the type and the identifier of the queue
+	 *
+	 * @param type The queue type, i.e. the set of EXC links to use
+	 * @param id The identifier of the queue among the ones of the same type
+	 */
+	void Init(app::Application::QueueType_t type, int16_t id);
+
+	/**
+	 * @brief Append an EXC to the queue
+	 *
+	 * @return false if the EXC is already linked into a queue of the same
+	 * type, true otherwise
+	 */
+	bool Insert(AppPtr_t const & papp);
+
+	/**
+	 * @brief Unlink an EXC from the queue
+	 *
+	 * The ILES iterators currently pointing to the EXC are moved to the next
+	 * element.
+	 *
+	 * @return false if the EXC is not linked into this queue, true otherwise
+	 */
+	bool Remove(AppPtr_t const & papp);
+
+	/**
+	 * @brief Check if the EXC is linked into this queue
+	 */
+	bool Contains(AppPtr_t const & papp) const;
+
+	/**
+	 * @brief Unlink all the EXCs
+	 */
+	void Clear();
+
+	inline bool Empty() const {
+		return (count == 0);
+	};
+
+	inline size_t Size() const {
+		return count;
+	};
+
+private:
+
+	/** The type of queue (@see Application::QueueType_t) */
+	app::Application::QueueType_t type = app::Application::QUEUE_ALL;
+
+	/** The identifier of the queue */
+	int16_t id = 0;
+
+	/** First EXC of the queue */
+	AppPtr_t head;
+
+	/** Last EXC of the queue */
+	app::Application * tail = nullptr;
+
+	/** Number of EXCs linked */
+	size_t count = 0;
+
+	/** The ILES iterators currently visiting the queue */
+	AppsUidMapItRetainer_t ret;
+
+	/** The EXC following the specified one in the queue */
+	AppPtr_t const & Next(AppPtr_t const & papp) const;
+
+	friend class AppsUidMapIt;
+	friend class ApplicationManager;
+};
+
 /**
  * @class AppsUidMapIt
- * @brief "In Loop Erase Safe" ILES iterator on an AppsUidMap_t maps
+ * @brief "In Loop Erase Safe" ILES iterator on an EXC queue
  *
  * This is an iterator wrapper object which is used to implement safe iterations on
- * mutable maps, where an erase could occours on a thread while another thread
+ * mutable queues, where an erase could occours on a thread while another thread
  * is visiting the elements of the same container container.
  * A proper usage of such an ILES interator requires to visit the container
  * elements using a pair of provided functions "GetFirst" and "GetNext".
@@ -87,11 +180,11 @@ public:
 
 private:
 
-	/** The map to visit */
-	AppsUidMap_t *map = NULL;
+	/** The queue to visit */
+	ExcQueue *queue = NULL;
 
-	/** An interator on a UIDs map */
-	AppsUidMap_t::iterator it;
+	/** The EXC currently pointed */
+	AppPtr_t curr;
 
 	/** A flag to track iterator validity */
 	bool updated = false;
@@ -99,12 +192,13 @@ private:
 	/** The retantion list on which this has been inserted */
 	AppsUidMapItRetainer_t *ret = NULL;
 
-	void Init(AppsUidMap_t & m, AppsUidMapItRetainer_t & rl) {
-		map = &m;
-		ret = &rl;
-		it = map->begin();
+	void Init(ExcQueue & q) {
+		queue = &q;
+		curr = queue->head;
+		updated = false;
 	}
 	void Retain() {
+		ret = &(queue->ret);
 		ret->push_front(this);
 	};
 	void Release() {
@@ -112,20 +206,21 @@ private:
 		ret = NULL;
 	};
 	void Update() {
-		++it; updated = true;
+		curr = queue->Next(curr); updated = true;
 	};
 	void operator++(int) {
-		if (!updated) ++it;
+		if (!updated) curr = queue->Next(curr);
 		updated = false;
 	};
 	bool End() {
-		return (it == map->end());
+		return (curr == nullptr);
 	};
 	AppPtr_t Get() {
-		return (*it).second;
+		return curr;
 	};
 
 	friend class ApplicationManager;
+	friend class ExcQueue;
 };
 
 
@@ -278,6 +278,14 @@ private:
 
 	RTLIB_ExitCode_t Prof_GetRuntimeDataRecv(pcmdSn_t pcs);
 
+	/**
+	 * @brief Store the cycle and onRun time quantiles into the runtime
+	 * profile of the AWM currently assigned to the application
+	 */
+	void SetRuntimeProfQuantiles(ba::AppPtr_t papp,
+		bl::rpc_msg_quantiles_t const & ctime_q,
+		bl::rpc_msg_quantiles_t const & rtime_q);
+
 
 /*******************************************************************************
  * Synchronization Protocol
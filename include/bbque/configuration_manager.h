@@ -21,6 +21,9 @@
 #include "bbque/config.h"
 #include "bbque/barbeque.h"
 
+#include <memory>
+#include <mutex>
+
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/parsers.hpp>
 #include <boost/program_options/variables_map.hpp>
@@ -63,6 +66,11 @@ public:
 
 	/**
 	 * @brief   Parse configuration file
+	 *
+	 * The configuration file is read and tokenized only once, at the first
+	 * call. Each following call just looks up, in the cached set of parsed
+	 * options, the ones described by the module.
+	 *
 	 * @param   opts_desc the description of supported configuration parameters
 	 * @param   opts the map of configuration parameters values returned
 	 */
@@ -227,6 +235,28 @@ private:
 	 * daemon run directory
 	 */
 	std::string daemon_rundir;
+
+	/**
+	 * Empty description used to tokenize the whole configuration file
+	 */
+	options_description conf_file_desc;
+
+	/**
+	 * The (cached) options parsed from the configuration file
+	 */
+	std::unique_ptr<boost::program_options::parsed_options> conf_file_opts;
+
+	/**
+	 * Serialize the accesses to the cached configuration file options
+	 */
+	std::mutex conf_file_mtx;
+
+	/**
+	 * @brief   Read and tokenize the configuration file, if not done yet
+	 *
+	 * The caller must hold the conf_file_mtx lock.
+	 */
+	void LoadConfigurationFile();
 };
 
 } // namespace bbque
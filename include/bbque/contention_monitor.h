@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_CONTENTION_MONITOR_H_
+#define BBQUE_CONTENTION_MONITOR_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "bbque/config.h"
+#include "bbque/configuration_manager.h"
+#include "bbque/res/resources.h"
+#include "bbque/res/resource_path.h"
+#include "bbque/utils/perf.h"
+#include "bbque/utils/worker.h"
+#include "bbque/utils/logging/logger.h"
+
+#define CONTENTION_MONITOR_NAMESPACE "bq.hm"
+
+#define HM_DEFAULT_PERIOD_MS    2000
+#define HM_DEFAULT_SAMPLES_WIN     5
+
+namespace bu = bbque::utils;
+namespace br = bbque::res;
+
+namespace bbque {
+
+/**
+ * @class ContentionMonitor
+ *
+ * @brief Periodic sampling of hardware performance counters on the
+ * processing elements managed by the daemon
+ *
+ * For each registered processing element, a set of system-wide performance
+ * counters (cycles, instructions, last-level cache misses and back-end
+ * stalls) is opened on the corresponding CPU. At each (low frequency) period
+ * the counters are read, and the derived contention metrics (IPC, LLC MPKI
+ * and percentage of stalled cycles) are attached to the resource descriptor,
+ * beside the power profile information. Scheduling policies can then query
+ * them through the System interface.
+ */
+class ContentionMonitor: public bu::Worker {
+
+public:
+
+	/**
+	 * @enum ExitCode_t
+	 * @brief Class specific return codes
+	 */
+	enum class ExitCode_t {
+		OK = 0,           /** Successful call */
+		ERR_RSRC_MISSING, /** Not valid resource specified */
+		ERR_PERF_OPEN     /** Performance counters not available */
+	};
+
+	/** Contention Monitor instance */
+	static ContentionMonitor & GetInstance();
+
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~ContentionMonitor();
+
+	/**
+	 * @brief Register a processing element for contention monitoring
+	 *
+	 * @param rp_str Resource path of the processing element
+	 * @param cpu_id The (operating system) CPU number of the processing
+	 * element
+	 *
+	 * @return ERR_RSRC_MISSING if the resource path does not reference any
+	 * resource, ERR_PERF_OPEN if no counters can be opened on the CPU, OK
+	 * otherwise
+	 */
+	ExitCode_t Register(std::string const & rp_str, int cpu_id);
+
+	/**
+	 * @brief Start the periodic sampling of the performance counters
+	 *
+	 * @param period_ms Period of sampling in milliseconds
+	 */
+	void Start(uint32_t period_ms = 0);
+
+	/**
+	 * @brief Stop the periodic sampling of the performance counters
+	 */
+	void Stop();
+
+	/**
+	 * @brief Return the length of the sampling period (in milliseconds)
+	 */
+	inline uint32_t GetPeriodLengthMs() const {
+		return period_ms;
+	}
+
+private:
+
+	/**
+	 * @struct CPUCounters
+	 * @brief The set of counters opened on a single CPU
+	 */
+	struct CPUCounters {
+		/** The resource descriptor of the processing element */
+		br::ResourcePtr_t rsrc;
+		/** The system-wide counters of the CPU */
+		std::unique_ptr<bu::Perf> perf;
+		/** Counters identifiers (-1 if not available) */
+		int cycles       = -1;
+		int instructions = -1;
+		int llc_misses   = -1;
+		int stalls       = -1;
+	};
+
+	/**
+	 * @brief Configuration manager instance
+	 */
+	ConfigurationManager & cfm;
+
+	/**
+	 * @brief Registered processing elements
+	 */
+	std::vector<std::shared_ptr<CPUCounters>> cpus;
+
+	/**
+	 * @brief Protect the list of registered processing elements
+	 */
+	std::mutex cpus_mtx;
+
+	/**
+	 * @brief Sampling period (milliseconds)
+	 */
+	uint32_t period_ms;
+
+	/**
+	 * @brief Number of samples for the exponential mean computation
+	 */
+	uint16_t samples_window;
+
+	/**
+	 * @brief True if the sampling has been started
+	 */
+	bool started = false;
+
+	/**
+	 * @brief Constructor
+	 */
+	ContentionMonitor();
+
+	/**
+	 * @brief Periodic task
+	 */
+	virtual void Task();
+
+	/**
+	 * @brief Read the counters of all the registered CPUs and update the
+	 * contention profile of the resources
+	 */
+	void SampleCounters();
+
+	/**
+	 * @brief Counter value scaled according to the multiplexing ratio
+	 *
+	 * @param perf The counters of a CPU
+	 * @param id The counter identifier
+	 *
+	 * @return The (estimated) count since the last update
+	 */
+	double ReadScaled(bu::Perf & perf, int id);
+
+};
+
+} // namespace bbque
+
+#endif // BBQUE_CONTENTION_MONITOR_H_
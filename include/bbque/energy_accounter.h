@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_ENERGY_ACCOUNTER_H_
+#define BBQUE_ENERGY_ACCOUNTER_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "bbque/application_manager.h"
+#include "bbque/pm/power_manager.h"
+#include "bbque/res/resource_path.h"
+#include "bbque/utils/logging/logger.h"
+
+#define ENERGY_ACCOUNTER_NAMESPACE "bq.ea"
+
+/** Default root of the procfs tree */
+#define BBQUE_PROCFS_ROOT "/proc"
+
+namespace ba = bbque::app;
+namespace br = bbque::res;
+namespace bu = bbque::utils;
+
+namespace bbque {
+
+/**
+ * @class EnergyAccounter
+ *
+ * @brief Attribution of the measured CPU energy consumption to the EXCs
+ *
+ * At each update (i.e., each scheduling period), the energy consumed by the
+ * CPUs since the previous update is split among the RUNNING EXCs, in
+ * proportion to their share of the CPU time spent by the whole system (the
+ * remaining part is due to the unmanaged workload). EXCs of the same
+ * process equally share the CPU time of the process.
+ *
+ * The CPU times are read from the procfs tree, whose root is configurable
+ * (PowerManager.procfs_root).
+ */
+class EnergyAccounter {
+
+public:
+
+	/**
+	 * @brief Get the EnergyAccounter instance
+	 */
+	static EnergyAccounter & GetInstance();
+
+	/**
+	 * @brief Attribute the energy consumed since the previous update
+	 */
+	void Update();
+
+	/**
+	 * @brief The energy attributed to an EXC
+	 *
+	 * @param uid The EXC unique identifier
+	 *
+	 * @return The energy [uJ]
+	 */
+	uint64_t GetEnergy(ba::AppUid_t uid);
+
+private:
+
+	ApplicationManager & am;
+
+	PowerManager & pm;
+
+	std::unique_ptr<bu::Logger> logger;
+
+	/** Root of the procfs tree */
+	std::string procfs_root;
+
+	/** The CPUs to account the energy consumption of */
+	br::ResourcePathPtr_t cpu_path;
+
+	/** Values at the previous update */
+	bool initialized = false;
+
+	uint64_t last_energy_uj = 0;
+
+	uint64_t last_busy_ticks = 0;
+
+	/** CPU time of each process at the previous update */
+	std::map<ba::AppPid_t, uint64_t> proc_ticks;
+
+	/** Energy attributed to each EXC [uJ] */
+	std::map<ba::AppUid_t, uint64_t> exc_energy;
+
+	std::mutex ea_mtx;
+
+
+	EnergyAccounter();
+
+	/**
+	 * @brief The CPU time spent by the whole system (not idle)
+	 */
+	bool ReadSystemTicks(uint64_t & ticks) const;
+
+	/**
+	 * @brief The CPU time spent by a process (user and system)
+	 */
+	bool ReadProcessTicks(ba::AppPid_t pid, uint64_t & ticks) const;
+
+	/**
+	 * @brief Forget the EXCs and processes no longer registered
+	 */
+	void Prune();
+};
+
+} // namespace bbque
+
+#endif // BBQUE_ENERGY_ACCOUNTER_H_
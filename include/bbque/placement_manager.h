@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_PLACEMENT_MANAGER_H_
+#define BBQUE_PLACEMENT_MANAGER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "bbque/config.h"
+#include "bbque/application_manager.h"
+#include "bbque/placement_policy.h"
+#include "bbque/plugins/agent_proxy_types.h"
+#include "bbque/utils/metrics_collector.h"
+#include "bbque/utils/worker.h"
+
+#define PLACEMENT_MANAGER_NAMESPACE "bq.plc"
+#define PLACEMENT_MANAGER_CONFIG    "PlacementManager"
+
+/** Minimum processing headroom [%] before offloading EXCs */
+#define BBQUE_PLC_HEADROOM_MIN_PERC      20
+/** Hysteresis band [%] around the headroom threshold */
+#define BBQUE_PLC_HYSTERESIS_PERC        10
+/** Estimated processing demand [%] of an EXC */
+#define BBQUE_PLC_EXC_DEMAND_PERC        10
+/** Period of the placement rebalancing */
+#define BBQUE_PLC_REBALANCE_PERIOD_MS  5000
+/** Minimum time an EXC stays on a node before being moved again */
+#define BBQUE_PLC_MIN_RESIDENCE_MS    10000
+
+namespace bu = bbque::utils;
+namespace ba = bbque::app;
+namespace br = bbque::res;
+
+namespace bbque {
+
+namespace pp {
+class RemotePlatformProxy;
+}
+
+/**
+ * @class PlacementManager
+ *
+ * @brief Cross-node placement of the EXCs in distributed mode
+ *
+ * Before the local scheduling policy runs, the processing headroom of each
+ * node is estimated: the local one from the committed resource snapshot and
+ * the READY EXCs still to schedule, the remote ones from the status cached
+ * by the RemotePlatformProxy. If the local headroom is below a threshold,
+ * READY EXCs are offloaded to the nodes with the largest headroom (see
+ * PlacementPolicy). Periodically, the placements are reconsidered, so that
+ * EXCs are recalled when the local node has room again, or when the hosting
+ * node gets overloaded.
+ *
+ * The scheduling requests are sent by the worker thread, in a single batch
+ * per node, so that the scheduling run never waits for the other nodes.
+ * Until the reply, the EXC is considered offloaded. A rejected EXC is
+ * scheduled locally again, by triggering a new optimization.
+ *
+ * The offloaded EXCs are not scheduled locally: the policies skip them, and
+ * the schedule requests still issued for them are aborted by
+ * ReleaseOffloaded() before the commit.
+ *
+ * A hysteresis band around the threshold, and a minimum residence time on
+ * each node, prevent the EXCs from bouncing between nodes.
+ *
+ * The same module accepts or rejects the requests coming from the other
+ * nodes, according to the local headroom.
+ */
+class PlacementManager: public bu::Worker {
+
+public:
+
+	/**
+	 * @enum ExitCode_t
+	 * @brief Class specific return codes
+	 */
+	enum class ExitCode_t {
+		OK = 0,   /** Placement stage completed */
+		SKIPPED,  /** Placement disabled or no remote nodes */
+		ERR_PROXY /** Remote platform proxy not available */
+	};
+
+	/** Placement Manager instance */
+	static PlacementManager & GetInstance();
+
+	virtual ~PlacementManager();
+
+	/**
+	 * @brief Run the placement stage
+	 *
+	 * To call before the local scheduling policy. The requests to the
+	 * other nodes are only queued here.
+	 */
+	ExitCode_t Run();
+
+	/**
+	 * @brief Abort the local scheduling of the offloaded EXCs
+	 *
+	 * To call after the local scheduling policy, before the commit, to
+	 * release the resources booked for the offloaded EXCs by policies not
+	 * checking the placements.
+	 *
+	 * @param status_view The scheduled resource state view
+	 */
+	void ReleaseOffloaded(br::RViewToken_t status_view);
+
+	/**
+	 * @brief The node an EXC has been offloaded to
+	 *
+	 * @param uid The EXC unique identifier
+	 * @return The system id of the hosting node (also if the request is
+	 * still pending), or -1 if the EXC runs on the local one
+	 */
+	int GetPlacement(ba::AppUid_t uid) const;
+
+	/**
+	 * @brief Check if an EXC has been offloaded to a remote node
+	 */
+	inline bool IsOffloaded(ba::AppUid_t uid) const {
+		return GetPlacement(uid) >= 0;
+	}
+
+	/**
+	 * @brief Handle a scheduling request from a remote node
+	 *
+	 * @param sender_id The requesting node
+	 * @param request The scheduling request (a negative AWM id releases an
+	 * EXC previously accepted)
+	 * @return true if the request has been accepted
+	 */
+	bool AcceptRemote(uint32_t sender_id,
+			agent::ApplicationScheduleRequest const & request);
+
+private:
+
+	typedef std::chrono::steady_clock::time_point TimePoint_t;
+
+	typedef std::map<int, std::vector<agent::ApplicationScheduleRequest>>
+		RequestBatches_t;
+
+	/**
+	 * @struct Placement_t
+	 * @brief An EXC offloaded to a remote node
+	 */
+	struct Placement_t {
+		/** The hosting node */
+		int system_id;
+		/** When the EXC has been moved */
+		TimePoint_t since;
+	};
+
+	ApplicationManager & am;
+
+	/** The metrics collector */
+	bu::MetricsCollector & mc;
+
+	/** Placement stage metrics */
+	static bu::MetricsCollector::MetricsCollection_t metrics[4];
+
+	/** Enable the placement stage */
+	bool enabled;
+
+	/** The placement decisions */
+	std::unique_ptr<PlacementPolicy> policy;
+
+	uint32_t rebalance_period_ms;
+	uint32_t min_residence_ms;
+
+	/** Last rebalancing of the placements */
+	TimePoint_t last_rebalance;
+
+	/** The EXCs offloaded to remote nodes */
+	std::map<ba::AppUid_t, Placement_t> placements;
+
+	/** The EXCs whose offloading request is waiting for the reply */
+	std::map<ba::AppUid_t, int> pending;
+
+	/** The EXCs accepted from remote nodes. Key: (node, EXC uid) */
+	std::map<std::pair<uint32_t, uint32_t>, TimePoint_t> hosted;
+
+	/** Protect the placements and the hosted EXCs */
+	mutable std::mutex placement_mtx;
+
+	/** The requests to send, protected by the worker status mutex */
+	RequestBatches_t outbox;
+
+	PlacementManager();
+
+	/**
+	 * @brief The worker thread, sending the queued requests
+	 */
+	void Task() override;
+
+	/**
+	 * @brief Free fraction of the local processing elements, from the
+	 * committed resource snapshot
+	 */
+	float LocalFreeFraction() const;
+
+	/**
+	 * @brief Projected processing headroom of the local node
+	 *
+	 * The placement mutex must be held.
+	 */
+	float LocalHeadroom() const;
+
+	/**
+	 * @brief Processing headroom of the remote nodes
+	 *
+	 * Nodes whose status is not available are not included.
+	 */
+	std::map<int, float> RemoteHeadrooms(pp::RemotePlatformProxy & rpp) const;
+
+	/**
+	 * @brief Send the batches of requests and update the placements
+	 * according to the replies
+	 */
+	void SendRequests(pp::RemotePlatformProxy & rpp,
+			RequestBatches_t const & batches);
+
+	/**
+	 * @brief Check if an EXC has been (or is being) offloaded
+	 *
+	 * The placement mutex must be held.
+	 */
+	inline bool IsPlaced(ba::AppUid_t uid) const {
+		return placements.count(uid) || pending.count(uid);
+	}
+
+	/**
+	 * @brief Milliseconds elapsed since a given time
+	 */
+	static inline uint64_t ElapsedMs(TimePoint_t since) {
+		return std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now() - since).count();
+	}
+};
+
+} // namespace bbque
+
+#endif // BBQUE_PLACEMENT_MANAGER_H_
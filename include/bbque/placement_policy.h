@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_PLACEMENT_POLICY_H_
+#define BBQUE_PLACEMENT_POLICY_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+
+namespace bbque {
+
+/**
+ * @class PlacementPolicy
+ *
+ * @brief The placement decisions of the PlacementManager
+ *
+ * All the headrooms are fractions in [0, 1] of the processing capacity of
+ * a node. The local one is a projection: the free capacity, minus the
+ * demand of the READY EXCs still to schedule locally and of the EXCs
+ * hosted for the other nodes. Therefore, offloading an EXC raises the
+ * projection of the next placement stage by the same amount, and the
+ * offloading stops as soon as the projection is back over the threshold.
+ *
+ * No state is kept here, so that the decisions can be checked without a
+ * running daemon.
+ */
+class PlacementPolicy {
+
+public:
+
+	/**
+	 * @param headroom_min Minimum headroom before offloading
+	 * @param hysteresis Band around the threshold
+	 * @param exc_demand Estimated demand of an EXC
+	 */
+	PlacementPolicy(float headroom_min, float hysteresis, float exc_demand):
+		headroom_min(headroom_min),
+		hysteresis(hysteresis),
+		exc_demand(exc_demand) {
+	}
+
+	/**
+	 * @brief Projected headroom of the local node
+	 *
+	 * @param free Free fraction of the local processing elements
+	 * @param ready READY EXCs neither offloaded nor being offloaded
+	 * @param hosted EXCs accepted from the other nodes
+	 *
+	 * @return The projection, negative if the demand exceeds the capacity
+	 */
+	inline float LocalHeadroom(float free, uint32_t ready, uint32_t hosted) const {
+		return free - (ready + hosted) * exc_demand;
+	}
+
+	/**
+	 * @brief Check if the local node must offload EXCs
+	 */
+	inline bool MustOffload(float local) const {
+		return local < headroom_min;
+	}
+
+	/**
+	 * @brief Select the node to offload an EXC to
+	 *
+	 * On success, the local and the remote headroom are updated with the
+	 * demand of the EXC moved.
+	 *
+	 * @return The system id of the selected node, or -1 if none can host
+	 * the EXC keeping its headroom over the threshold
+	 */
+	int SelectTarget(float & local, std::map<int, float> & remote) const {
+		auto best = std::max_element(remote.begin(), remote.end(),
+			[](std::pair<const int, float> const & a,
+			   std::pair<const int, float> const & b) {
+				return a.second < b.second;
+			});
+		if ((best == remote.end())
+				|| ((best->second - exc_demand) < (headroom_min + hysteresis))
+				|| (best->second < (local + hysteresis)))
+			return -1;
+		best->second -= exc_demand;
+		local += exc_demand;
+		return best->first;
+	}
+
+	/**
+	 * @brief Check if an offloaded EXC should come back
+	 *
+	 * This happens if the local node has room again, or the hosting one is
+	 * overloaded, out of the hysteresis band.
+	 */
+	inline bool MustRecall(float local, float remote) const {
+		return ((local - exc_demand) >= (headroom_min + hysteresis))
+			|| (remote < (headroom_min - hysteresis));
+	}
+
+	/**
+	 * @brief Check if an EXC from another node can be hosted
+	 */
+	inline bool CanHost(float local) const {
+		return (local - exc_demand) >= (headroom_min + hysteresis);
+	}
+
+	inline float ExcDemand() const {
+		return exc_demand;
+	}
+
+private:
+
+	float headroom_min;
+	float hysteresis;
+	float exc_demand;
+};
+
+} // namespace bbque
+
+#endif // BBQUE_PLACEMENT_POLICY_H_
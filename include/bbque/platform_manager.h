@@ -112,7 +112,7 @@ public:
 	 * @brief Get a reference to the remote platform proxy
 	 * @return A PlatformProxy reference
 	 */
-	inline PlatformProxy const & GetRemotePlatformProxy() {
+	inline pp::RemotePlatformProxy & GetRemotePlatformProxy() {
 		return *rpp;
 	}
 #endif
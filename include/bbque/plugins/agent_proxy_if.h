@@ -18,6 +18,9 @@
 #ifndef BBQUE_AGENT_PROXY_IF_H
 #define BBQUE_AGENT_PROXY_IF_H
 
+#include <string>
+#include <vector>
+
 #include "bbque/pp/platform_description.h"
 #include "bbque/plugins/agent_proxy_types.h"
 
@@ -97,6 +100,39 @@ public:
 	virtual ExitCode_t GetChannelStatus(
 		int system_id, agent::ChannelStatus & status) = 0;
 
+	/**
+	 * @brief Subscribe to the periodic status updates of a remote system
+	 *
+	 * Only the changes are pushed by the remote system, batched at each
+	 * period, so that the status can be tracked without polling.
+	 *
+	 * @param system_id The remote system
+	 * @param paths The resources to track (all, if empty)
+	 * @param period_ms The period of the updates
+	 * @param cb Function called at each update received
+	 * @return REQUEST_REJECTED if the subscription is not supported
+	 */
+	virtual ExitCode_t SubscribeStatus(
+			int system_id,
+			std::vector<std::string> const & paths,
+			uint32_t period_ms,
+			agent::StatusUpdateCallback_t cb) {
+		(void) system_id;
+		(void) paths;
+		(void) period_ms;
+		(void) cb;
+		return ExitCode_t::REQUEST_REJECTED;
+	}
+
+	/**
+	 * @brief Stop receiving the status updates of a remote system
+	 * @param system_id The remote system
+	 */
+	virtual ExitCode_t UnsubscribeStatus(int system_id) {
+		(void) system_id;
+		return ExitCode_t::REQUEST_REJECTED;
+	}
+
 
 	// ------------- Multi-remote management functions ------------------
 
@@ -135,6 +171,24 @@ public:
 		std::string const & path,
 		agent::ApplicationScheduleRequest const & request) = 0;
 
+	/**
+	 * @brief Send a batch of scheduling requests to a remote system
+	 *
+	 * @param system_id The remote system
+	 * @param requests The scheduling requests (a negative AWM id
+	 * releases an application previously accepted)
+	 * @param results The outcome of each request (same order)
+	 * @return REQUEST_REJECTED if the batching is not supported
+	 */
+	virtual ExitCode_t SendScheduleRequests(
+			int system_id,
+			std::vector<agent::ApplicationScheduleRequest> const & requests,
+			std::vector<ExitCode_t> & results) {
+		(void) system_id;
+		results.assign(requests.size(), ExitCode_t::REQUEST_REJECTED);
+		return ExitCode_t::REQUEST_REJECTED;
+	}
+
 };
 
 } // namespace plugins
@@ -20,6 +20,7 @@
 
 #include <ctype.h>
 #include <bitset>
+#include <functional>
 #include <map>
 #include <string>
 
@@ -62,6 +63,29 @@ struct WorkloadStatus {
 	uint32_t nr_running;
 };
 
+/**
+ * @struct StatusUpdate
+ * @brief Batch of status changes pushed by a remote system
+ */
+struct StatusUpdate {
+	/** Sequence number of the update */
+	uint64_t seq;
+	/** Status of the resources changed since the previous update */
+	std::map<std::string, ResourceStatus> resources;
+	/** True if the workload status has changed */
+	bool workload_changed;
+	WorkloadStatus workload;
+	/** True if the stream has been closed: the status received so far is
+	 * not valid anymore */
+	bool closed = false;
+};
+
+/**
+ * @brief Function called for each status update received from a remote
+ * system (identified by the first argument)
+ */
+using StatusUpdateCallback_t = std::function<void(int, StatusUpdate const &)>;
+
 /**
  * @struct ChannelStatus
  */
@@ -74,7 +98,7 @@ struct ChannelStatus {
  * @struct ApplicationScheduleRequest
  */
 struct ApplicationScheduleRequest {
-	int16_t app_id;
+	uint32_t app_id;
 	std::string app_name;
 	int16_t awm_id;
 	struct {
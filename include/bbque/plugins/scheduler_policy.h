@@ -18,11 +18,16 @@
 #ifndef BBQUE_SCHEDULER_POLICY_H_
 #define BBQUE_SCHEDULER_POLICY_H_
 
+#include "bbque/config.h"
 #include "bbque/system.h"
 #include "bbque/app/application_conf.h"
 #include "bbque/app/working_mode.h"
 #include "bbque/res/resources.h"
 
+#ifdef CONFIG_BBQUE_DIST_MODE
+#include "bbque/placement_manager.h"
+#endif
+
 // The prefix for logging statements category
 #define SCHEDULER_POLICY_NAMESPACE "bq.sp"
 // The prefix for configuration file attributes
@@ -98,6 +103,10 @@ public:
 		 * A number through which reference the current scheduling binding
 		 * in the set stored in the AWM descriptor */
 		size_t bind_refn = 0;
+		/**
+		 * The candidate bindings under evaluation, one per binding type,
+		 * not bound yet (see WorkingMode::GetBindingCandidate) */
+		std::vector<br::BindingCandidate> candidates;
 		/** Identifier string */
 		char str_id[40];
 
@@ -271,8 +280,23 @@ protected:
 		return slots;
 	}
 
+	/**
+	 * @brief Check if a READY application has been offloaded to a remote
+	 * node, and thus it must not be scheduled locally
+	 */
+	inline bool IsOffloaded(bbque::app::AppCPtr_t papp) const {
+#ifdef CONFIG_BBQUE_DIST_MODE
+		return PlacementManager::GetInstance().IsOffloaded(papp->Uid());
+#else
+		(void) papp;
+		return false;
+#endif
+	}
+
 	/**
 	 * @brief Execute a function over all the active applications
+	 *
+	 * The READY applications offloaded to remote nodes are skipped.
 	 */
 	inline ExitCode_t ForEachReadyAndRunningDo(
 			std::function<
@@ -282,6 +306,8 @@ protected:
 
 		app_ptr = sys->GetFirstReady(app_it);
 		for (; app_ptr; app_ptr = sys->GetNextReady(app_it)) {
+			if (IsOffloaded(app_ptr))
+				continue;
 			do_func(app_ptr);
 		}
 		app_ptr = sys->GetFirstRunning(app_it);
@@ -20,9 +20,15 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
+#include "bbque/config.h"
 #include "bbque/pm/models/model.h"
+#ifdef CONFIG_BBQUE_PM_ONLINE_MODELS
+#include "bbque/pm/models/model_online.h"
+#endif
 #include "bbque/pm/models/system_model.h"
 #include "bbque/utils/logging/logger.h"
 
@@ -34,6 +40,9 @@ namespace bbque  { namespace pm {
 typedef std::shared_ptr<Model> ModelPtr_t;
 typedef std::map<std::string, ModelPtr_t> ModelsMap_t;
 typedef std::shared_ptr<SystemModel> SystemModelPtr_t;
+#ifdef CONFIG_BBQUE_PM_ONLINE_MODELS
+typedef std::shared_ptr<OnlineModel> OnlineModelPtr_t;
+#endif
 
 /**
  * @class ModelManager
@@ -90,6 +99,57 @@ public:
 	 */
 	void Register(ModelPtr_t model);
 
+#ifdef CONFIG_BBQUE_PM_ONLINE_MODELS
+
+	/**
+	 * @brief Update the online model of a resource with a new sample
+	 *
+	 * The model is created at the first sample, restoring the state saved
+	 * by a previous run, and registered with the resource path as id.
+	 *
+	 * @param r_path The resource path string
+	 * @param sample The power monitor sample
+	 */
+	void Update(std::string const & r_path, OnlineModel::Sample const & sample);
+
+	/**
+	 * @brief Get the model of a specific resource
+	 *
+	 * @param r_path The resource path string
+	 * @param id The model string id, used if the online model of the
+	 * resource is not trained yet
+	 *
+	 * @return A shared pointer to the model object
+	 */
+	ModelPtr_t GetResourceModel(
+		std::string const & r_path, std::string const & id);
+
+	/**
+	 * @brief Get the model of a set of resources (e.g., a binding domain)
+	 *
+	 * The online models are trained per resource: if the set has no model
+	 * of its own, the model is the group of the ones of its resources.
+	 *
+	 * @param r_path The path string of the set (e.g., "sys0.cpu0.pe")
+	 * @param r_paths The path strings of the resources in the set
+	 * @param id The model string id, used if any of the online models of
+	 * the resources is not trained yet
+	 *
+	 * @return A shared pointer to the model object
+	 */
+	ModelPtr_t GetResourceModel(
+		std::string const & r_path,
+		std::vector<std::string> const & r_paths,
+		std::string const & id);
+
+	/**
+	 * @brief Save the state of the online models, to be restored at the
+	 * next start
+	 */
+	void SaveOnlineModels();
+
+#endif // CONFIG_BBQUE_PM_ONLINE_MODELS
+
 private:
 
 	/*** Constructor */
@@ -101,11 +161,24 @@ private:
 	/*** Models map */
 	ModelsMap_t models;
 
+	/*** Models map access (online models are registered at run-time) */
+	std::mutex models_mtx;
+
 	/*** Default model (base class) */
 	ModelPtr_t default_model;
 
 	/***  The system power-thermal model */
 	SystemModelPtr_t system_model;
+
+#ifdef CONFIG_BBQUE_PM_ONLINE_MODELS
+
+	/*** Online models, by resource path */
+	std::map<std::string, OnlineModelPtr_t> online_models;
+
+	/*** The file storing the state of an online model */
+	static std::string OnlineModelFile(std::string const & r_path);
+
+#endif // CONFIG_BBQUE_PM_ONLINE_MODELS
 };
 
 } // namespace pm
@@ -0,0 +1,398 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_MODEL_ONLINE_H_
+#define BBQUE_MODEL_ONLINE_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "bbque/pm/models/model.h"
+
+/** Forgetting factor of the power relation estimator */
+#define BBQUE_MODEL_ONLINE_FORGETTING      0.995
+/** Forgetting factor of the thermal relation estimator (faster, to follow
+ * the changes of the cooling conditions) */
+#define BBQUE_MODEL_ONLINE_THERMAL_FORGETTING 0.98
+/** Initial covariance (inputs scaled to W, GHz and Celsius degrees) */
+#define BBQUE_MODEL_ONLINE_COVARIANCE      1e4
+/** Samples required before the fitted relations are used */
+#define BBQUE_MODEL_ONLINE_MIN_SAMPLES     20
+/** Minimum load change (fraction) of an informative power sample */
+#define BBQUE_MODEL_ONLINE_LOAD_STEP       0.05
+/** Minimum power change (fraction) of an informative thermal sample */
+#define BBQUE_MODEL_ONLINE_POWER_STEP      0.05
+/** Minimum temperature change (Celsius) of an informative thermal sample */
+#define BBQUE_MODEL_ONLINE_TEMP_STEP       1.0
+
+namespace bbque  { namespace pm {
+
+/**
+ * @class RecursiveLeastSquares
+ *
+ * @brief Recursive least squares estimator of a linear relation
+ * y = theta' * x, with directional forgetting of the past samples
+ */
+template <size_t N>
+class RecursiveLeastSquares {
+
+public:
+
+	using Vector_t = std::array<double, N>;
+
+	RecursiveLeastSquares(double lambda = BBQUE_MODEL_ONLINE_FORGETTING):
+		lambda(lambda) {
+		Reset();
+	}
+
+	/**
+	 * @brief Forget the estimated parameters
+	 */
+	void Reset() {
+		theta.fill(0);
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+				P[i][j] = (i == j) ? BBQUE_MODEL_ONLINE_COVARIANCE : 0;
+	}
+
+	/**
+	 * @brief Update the parameters with a new sample
+	 *
+	 * @param x The regressors vector
+	 * @param y The measured output
+	 *
+	 * @return The a-priori prediction error
+	 */
+	double Update(Vector_t const & x, double y) {
+		Vector_t Px;
+		double r = 0;
+		for (size_t i = 0; i < N; ++i) {
+			Px[i] = 0;
+			for (size_t j = 0; j < N; ++j)
+				Px[i] += P[i][j] * x[j];
+			r += x[i] * Px[i];
+		}
+
+		double err = y - Predict(x);
+		for (size_t i = 0; i < N; ++i)
+			theta[i] += Px[i] / (1 + r) * err;
+
+		// Directional forgetting: the past information is discounted only
+		// along the direction of the regressors, hence the covariance does
+		// not grow in the directions not excited (e.g., an idle resource)
+		if (r <= 0)
+			return err;
+		double eps = lambda - (1 - lambda) / r;
+		double denom = 1 / eps + r;
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+				P[i][j] -= Px[i] * Px[j] / denom;
+		return err;
+	}
+
+	/**
+	 * @brief The output estimated for the given regressors
+	 */
+	inline double Predict(Vector_t const & x) const {
+		double y = 0;
+		for (size_t i = 0; i < N; ++i)
+			y += theta[i] * x[i];
+		return y;
+	}
+
+	/**
+	 * @brief The estimated parameters
+	 */
+	inline Vector_t const & Parameters() const {
+		return theta;
+	}
+
+	/**
+	 * @brief Write the estimator state
+	 */
+	void Save(std::ostream & os) const;
+
+	/**
+	 * @brief Read the estimator state
+	 *
+	 * @return false if the state is not valid
+	 */
+	bool Load(std::istream & is);
+
+private:
+
+	double lambda;
+
+	Vector_t theta;
+
+	std::array<Vector_t, N> P;
+
+};
+
+
+/**
+ * @class OnlineModel
+ *
+ * @brief Power-thermal model of a resource, fitted at run-time on the
+ * samples of the power monitor
+ *
+ * Two relations are estimated by recursive least squares:
+ * - power, from the load and the clock frequency, with a static term
+ *   growing with the frequency and a dynamic term proportional to the load
+ *   and to f and f^3 (the voltage scaling with the frequency):
+ *   P = a0 + a1*f + a2*load*f + a3*load*f^3
+ * - temperature, as a first-order response to the power:
+ *   T(k) = b0 + b1*P(k) + b2*T(k-1), whose steady state is
+ *   T = (b0 + b1*P) / (1 - b2)
+ *
+ * Only the samples moving the operating point are used: with the inputs
+ * not changing (e.g., an idle resource), the noise alone would make the
+ * parameters drift along the directions not excited.
+ *
+ * The queries invert the relations at the last sampled frequency. Until
+ * enough samples have been collected, or if the temperature dynamics is
+ * not stable, the queries are answered by the base (default) model.
+ * The frequency governor argument is ignored: the relations are fitted
+ * on the samples collected under the current governor.
+ */
+class OnlineModel: public Model {
+
+public:
+
+	/**
+	 * @brief A power monitor sample
+	 */
+	struct Sample {
+		/** Load percentage */
+		uint32_t load;
+		/** Clock frequency in KHz */
+		uint32_t freq_khz;
+		/** Power consumption in milliwatts */
+		uint32_t power_mw;
+		/** Temperature in Celsius or millidegree Celsius */
+		uint32_t temp;
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param id Identifier string (e.g. the path of the resource)
+	 * @param tpd Thermal-Power Design value in milliwatts, used until the
+	 * model is trained
+	 */
+	OnlineModel(std::string const & id, uint32_t tpd = 100);
+
+	virtual ~OnlineModel() {};
+
+	/**
+	 * @brief Update the fitted relations with a new sample
+	 */
+	void Update(Sample const & sample);
+
+	/**
+	 * @brief The number of samples used to fit the power relation (also
+	 * before a restart)
+	 */
+	inline uint64_t Samples() const {
+		return nr_samples;
+	}
+
+	/**
+	 * @brief Check if the fitted relations are used by the queries
+	 */
+	inline bool Trained() const {
+		return nr_samples >= BBQUE_MODEL_ONLINE_MIN_SAMPLES;
+	}
+
+	/**
+	 * @brief The estimated power consumption
+	 *
+	 * @param load Load percentage
+	 * @param freq_khz Clock frequency in KHz
+	 *
+	 * @return Power in milliwatts
+	 */
+	uint32_t GetPowerFromLoad(uint32_t load, uint32_t freq_khz);
+
+	/**
+	 * @brief Write the model state (fitted parameters and last sample)
+	 */
+	void Save(std::ostream & os);
+
+	/**
+	 * @brief Restore a model state written by Save()
+	 *
+	 * @return false if the state is not valid, and the model is unchanged
+	 */
+	bool Load(std::istream & is);
+
+
+	/*** Member functions to override ***/
+
+	uint32_t GetPowerFromTemperature(
+			uint32_t temp_mc,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	uint32_t GetPowerFromSystemBudget(
+			uint32_t power_mw,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	uint32_t GetTemperatureFromPower(
+			uint32_t power_mw,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	float GetResourcePercentageFromPower(
+			uint32_t power_mw,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	uint32_t GetResourceFromPower(
+			uint32_t power_mw,
+			uint32_t total_amount,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+private:
+
+	/** Power from load and frequency */
+	RecursiveLeastSquares<4> power_rls;
+
+	/** Temperature from power and previous temperature */
+	RecursiveLeastSquares<3> thermal_rls{BBQUE_MODEL_ONLINE_THERMAL_FORGETTING};
+
+	/** The number of samples */
+	std::atomic<uint64_t> nr_samples{0};
+
+	/** The last frequency sampled, in GHz */
+	double last_freq = 0;
+
+	/** The last temperature sampled, in Celsius */
+	double last_temp = 0;
+
+	/** The operating point of the last power relation update */
+	double fit_load = -1, fit_freq = 0;
+
+	/** The operating point of the last thermal relation update */
+	double fit_power = 0, fit_temp = 0;
+
+	/** Samples from the power monitor and queries from the policies */
+	std::mutex mtx;
+
+	/**
+	 * @brief The regressors of the power relation (load in [0,1] and
+	 * frequency in GHz)
+	 */
+	static RecursiveLeastSquares<4>::Vector_t PowerRegressors(
+			double load, double freq);
+
+	/**
+	 * @brief The estimated load fraction drawing the given power (W) at the
+	 * last sampled frequency, not bounded to [0,1]
+	 */
+	double LoadFromPower(double power);
+
+	/**
+	 * @brief Check if the temperature dynamics estimated is stable
+	 */
+	bool ThermalValid() const;
+
+};
+
+
+/**
+ * @class OnlineModelGroup
+ *
+ * @brief Power-thermal model of a set of resources (e.g., the processing
+ * elements of a binding domain), from the online models of each one
+ *
+ * The power is shared evenly among the resources, each one accounting for
+ * the same fraction of the total amount: the power values are the sums of
+ * the ones of the resources, and the temperature is the one of the hottest
+ * resource.
+ */
+class OnlineModelGroup: public Model {
+
+public:
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param id Identifier string (e.g. the path of the binding domain)
+	 * @param models The online models of the resources (not empty)
+	 */
+	OnlineModelGroup(
+		std::string const & id,
+		std::vector<std::shared_ptr<OnlineModel>> const & models);
+
+	virtual ~OnlineModelGroup() {};
+
+	/**
+	 * @brief The online models of the resources
+	 */
+	inline std::vector<std::shared_ptr<OnlineModel>> const & Models() const {
+		return models;
+	}
+
+
+	/*** Member functions to override ***/
+
+	uint32_t GetPowerFromTemperature(
+			uint32_t temp_mc,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	uint32_t GetPowerFromSystemBudget(
+			uint32_t power_mw,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	uint32_t GetTemperatureFromPower(
+			uint32_t power_mw,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	float GetResourcePercentageFromPower(
+			uint32_t power_mw,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	uint32_t GetResourceFromPower(
+			uint32_t power_mw,
+			uint32_t total_amount,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+private:
+
+	std::vector<std::shared_ptr<OnlineModel>> models;
+
+};
+
+} // namespace pm
+
+} // namespace bbque
+
+#endif // BBQUE_MODEL_ONLINE_H_
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_POWER_CAP_CONTROLLER_H_
+#define BBQUE_POWER_CAP_CONTROLLER_H_
+
+#include <algorithm>
+#include <cstdint>
+
+/** Default proportional gain */
+#define BBQUE_PM_POWERCAP_KP   0.2
+/** Default integral gain */
+#define BBQUE_PM_POWERCAP_KI   0.8
+
+namespace bbque { namespace pm {
+
+/**
+ * @class PowerCapController
+ *
+ * @brief Proportional-integral controller of a power budget
+ *
+ * The power budget computed by a policy comes from power-thermal models,
+ * which can under/over-estimate the actual consumption. The controller
+ * corrects the budget, according to the error between the budget (target)
+ * and the measured power, such that the measured power converges on the
+ * target. The correction is bounded, and the integral term is frozen while
+ * the output is saturated (anti-windup).
+ */
+class PowerCapController {
+
+public:
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param kp The proportional gain
+	 * @param ki The integral gain
+	 */
+	PowerCapController(
+			float kp = BBQUE_PM_POWERCAP_KP,
+			float ki = BBQUE_PM_POWERCAP_KI):
+		kp(kp), ki(ki) {
+	}
+
+	/**
+	 * @brief Compute the corrected budget
+	 *
+	 * @param target_mw The power budget from the policy
+	 * @param measured_mw The power consumption measured
+	 * @param min_mw The minimum corrected budget
+	 * @param max_mw The maximum corrected budget
+	 *
+	 * @return The corrected power budget [mW]
+	 */
+	inline uint32_t Update(
+			uint32_t target_mw,
+			uint32_t measured_mw,
+			uint32_t min_mw,
+			uint32_t max_mw) {
+		float error = static_cast<float>(target_mw) - measured_mw;
+		float output = target_mw + kp * error + ki * (integral + error);
+
+		// Integrate only if not saturated
+		if ((output > min_mw) && (output < max_mw))
+			integral += error;
+		output = std::max<float>(output, min_mw);
+		output = std::min<float>(output, max_mw);
+		return static_cast<uint32_t>(output);
+	}
+
+	/**
+	 * @brief Forget the error accumulated
+	 */
+	inline void Reset() {
+		integral = 0;
+	}
+
+	/**
+	 * @brief The error accumulated [mW]
+	 */
+	inline float Integral() const {
+		return integral;
+	}
+
+private:
+
+	float kp;
+
+	float ki;
+
+	float integral = 0;
+};
+
+} // namespace pm
+
+} // namespace bbque
+
+#endif // BBQUE_POWER_CAP_CONTROLLER_H_
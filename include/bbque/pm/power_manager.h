@@ -201,6 +201,18 @@ public:
 		uint32_t &mwatt_min,
 		uint32_t &mwatt_max) ;
 
+	virtual PMResult GetEnergyUsage(
+		br::ResourcePathPtr_t const & rp, uint64_t &ujoule);
+
+
+	/** Power capping */
+
+	virtual PMResult GetPowerCap(
+		br::ResourcePathPtr_t const & rp, uint32_t &mwatt);
+
+	virtual PMResult SetPowerCap(
+		br::ResourcePathPtr_t const & rp, uint32_t mwatt);
+
 
 	/** Performance/power states */
 
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_POWER_MANAGER_CPU_POWERCAP_H_
+#define BBQUE_POWER_MANAGER_CPU_POWERCAP_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "bbque/pm/power_manager_cpu.h"
+#include "bbque/pm/powercap_zones.h"
+#include "bbque/res/resource_path.h"
+
+namespace bbque {
+
+/**
+ * @class PowercapCPUPowerManager
+ *
+ * Provide the power consumption and power capping of the CPUs through the
+ * Linux powercap interface (Intel RAPL driver), extending the generic
+ * @ref CPUPowerManager.
+ *
+ * The control zones are handled by @ref PowercapZones. The CPU ID in the
+ * resource path selects the package, while memory resources are mapped on
+ * the "dram" sub-zone.
+ *
+ * The sysfs root is configurable (PowerManager.sysfs_root), such that a
+ * fake powercap tree can be used for testing.
+ */
+class PowercapCPUPowerManager: public CPUPowerManager {
+
+public:
+
+	PowercapCPUPowerManager();
+
+	virtual ~PowercapCPUPowerManager();
+
+
+	/* ===========   Power consumption  =========== */
+
+	PMResult GetPowerUsage(br::ResourcePathPtr_t const & rp, uint32_t & mwatt);
+
+	PMResult GetPowerInfo(
+			br::ResourcePathPtr_t const & rp,
+			uint32_t & mwatt_min,
+			uint32_t & mwatt_max);
+
+	PMResult GetEnergyUsage(br::ResourcePathPtr_t const & rp, uint64_t & ujoule);
+
+
+	/* ===========   Power capping  =========== */
+
+	PMResult GetPowerCap(br::ResourcePathPtr_t const & rp, uint32_t & mwatt);
+
+	PMResult SetPowerCap(br::ResourcePathPtr_t const & rp, uint32_t mwatt);
+
+private:
+
+	/** Root of the sysfs tree */
+	std::string sysfs_root;
+
+	/** The control zones */
+	std::unique_ptr<PowercapZones> zones;
+
+	/** Serialize the accesses to the zones */
+	std::mutex zones_mtx;
+
+
+	/**
+	 * @brief The zones referenced by a resource path
+	 *
+	 * Package zones, or the "dram" sub-zones for memory resources. An unset
+	 * CPU ID references all the packages.
+	 */
+	std::vector<PowercapZones::Zone_t *> GetZones(
+			br::ResourcePathPtr_t const & rp);
+};
+
+} // namespace bbque
+
+#endif // BBQUE_POWER_MANAGER_CPU_POWERCAP_H_
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_POWERCAP_ZONES_H_
+#define BBQUE_POWERCAP_ZONES_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bbque/utils/timer.h"
+
+/** Default root of the sysfs tree */
+#define BBQUE_PM_POWERCAP_SYSFS_ROOT   "/sys"
+/** Powercap class directory, relative to the sysfs root */
+#define BBQUE_PM_POWERCAP_CLASS_DIR    "/class/powercap"
+/** Prefix of the Intel RAPL control zones */
+#define BBQUE_PM_POWERCAP_RAPL_PREFIX  "intel-rapl:"
+/** Minimum time between two samplings of the energy counters */
+#define BBQUE_PM_POWERCAP_SAMPLE_MS    50
+
+namespace bbque {
+
+/**
+ * @class PowercapZones
+ *
+ * The Intel RAPL control zones exported by the Linux powercap interface,
+ * under a given sysfs root.
+ *
+ * Each package ("package-N") zone, and its sub-zones (e.g., "core",
+ * "dram"), is discovered under the powercap class directory. The energy
+ * counters of all the zones are sampled together, keeping the files open,
+ * and the power consumption is derived from the energy increments between
+ * two samplings. The power limits changed are restored at destruction.
+ *
+ * No locking is done here: the users serialize the accesses.
+ */
+class PowercapZones {
+
+public:
+
+	/**
+	 * @struct Zone_t
+	 * @brief A powercap control zone
+	 */
+	struct Zone_t {
+		/** Zone directory */
+		std::string dir;
+		/** Zone name (e.g., "package-0", "core", "dram") */
+		std::string name;
+		/** Package of the zone */
+		int package = 0;
+		/** Open energy counter file */
+		int energy_fd = -1;
+		/** Maximum counter value, before wrapping around */
+		uint64_t max_energy_uj = 0;
+		/** Last counter value read */
+		uint64_t last_energy_uj = 0;
+		/** Energy consumed since the initialization */
+		uint64_t energy_uj = 0;
+		/** Mean power over the last sampling interval */
+		uint32_t power_mw = 0;
+		/** Power limit set before the initialization, to restore */
+		uint64_t orig_limit_uw = 0;
+		bool limit_changed = false;
+	};
+
+	/**
+	 * @brief Discover the zones and read the reference energy values
+	 *
+	 * @param sysfs_root The root of the sysfs tree
+	 */
+	PowercapZones(std::string const & sysfs_root);
+
+	virtual ~PowercapZones();
+
+	/**
+	 * @brief The control zones
+	 */
+	inline std::vector<Zone_t> & Zones() {
+		return zones;
+	}
+
+	/**
+	 * @brief The powercap class directory
+	 */
+	inline std::string const & ClassDir() const {
+		return class_dir;
+	}
+
+	/**
+	 * @brief The zones of a package
+	 *
+	 * @param package The package ID, or -1 for all the packages
+	 * @param dram Select the "dram" sub-zones, instead of the package
+	 * zones
+	 */
+	std::vector<Zone_t *> Select(int package, bool dram);
+
+	/**
+	 * @brief Read all the energy counters, if the last sampling is older
+	 * than BBQUE_PM_POWERCAP_SAMPLE_MS
+	 */
+	void Sample();
+
+	/**
+	 * @brief Read the current power limit of a zone
+	 */
+	bool GetLimit(Zone_t const & zone, uint64_t & limit_uw) const;
+
+	/**
+	 * @brief Set the power limit of a zone
+	 */
+	bool SetLimit(Zone_t & zone, uint64_t limit_uw);
+
+	/**
+	 * @brief Read the maximum power limit of a zone
+	 */
+	bool GetMaxPower(Zone_t const & zone, uint64_t & max_uw) const;
+
+	/**
+	 * @brief Energy consumed between two counter values
+	 *
+	 * The counter ranges in [0, max_uj]: on wrap around, it counts the
+	 * values up to max_uj, plus the step back to 0.
+	 */
+	static inline uint64_t EnergyDelta(
+			uint64_t last_uj, uint64_t curr_uj, uint64_t max_uj) {
+		if (curr_uj >= last_uj)
+			return curr_uj - last_uj;
+		return max_uj - last_uj + curr_uj + 1;
+	}
+
+private:
+
+	/** Powercap class directory */
+	std::string class_dir;
+
+	/** The control zones */
+	std::vector<Zone_t> zones;
+
+	/** Time since the last sampling */
+	utils::Timer sample_tmr;
+
+	/** Duration of the last sampling interval [us] */
+	double sample_us = 0;
+
+
+	/**
+	 * @brief Discover the control zones under the powercap directory
+	 */
+	void InitZones();
+
+	/**
+	 * @brief Read an energy counter
+	 */
+	bool ReadEnergy(Zone_t const & zone, uint64_t & ujoule) const;
+};
+
+} // namespace bbque
+
+#endif // BBQUE_POWERCAP_ZONES_H_
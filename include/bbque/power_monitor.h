@@ -244,6 +244,7 @@ private:
 	struct PowerMonitorInfo_t {
 		// Resource handlers
 		std::vector<ResourceHandler> resources;   /** Resources to monitor */
+		std::mutex register_mtx;   /** Platform proxies registering concurrently */
 		// Data logging
 		std::map<br::ResourcePathPtr_t, std::ofstream *> log_fp; /** Output file descriptors  */
 		std::string log_dir;       /** Output file directory    */
@@ -142,6 +142,11 @@ private:
 		    const TaskGraph & tg,
 		    const Partition & partition) noexcept override final;
 
+		/** HN library accesses are serialized by hn_mutex */
+		virtual bool IsReentrant() const override final {
+			return true;
+		}
+
 	private:
 		std::unique_ptr<bu::Logger> logger;
 		std::recursive_mutex hn_mutex;
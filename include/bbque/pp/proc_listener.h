@@ -21,6 +21,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <linux/cn_proc.h>
 
 #include "bbque/app/application.h"
@@ -31,8 +32,17 @@
 #include "bbque/pm/power_manager.h"
 #include "bbque/process_manager.h"
 #include "bbque/res/identifier.h"
+#include "bbque/utils/metrics_collector.h"
+#include "bbque/utils/timer.h"
 #include "bbque/utils/worker.h"
 
+/** Number of messages received with a single system call */
+#define BBQUE_PROCLISTENER_BATCH_SIZE       16
+/** Socket receive buffer size [bytes] */
+#define BBQUE_PROCLISTENER_RCVBUF_SIZE  (1024 * 1024)
+/** Receive timeout, to periodically check for termination [ms] */
+#define BBQUE_PROCLISTENER_TIMEOUT_MS      500
+
 namespace bu = bbque::utils;
 
 namespace bbque {
@@ -56,6 +66,12 @@ private:
 	/*** ProcessManager instance */
 	ProcessManager & prm;
 
+	/** The metrics collector */
+	bu::MetricsCollector & mc;
+
+	/** Process events metrics */
+	static bu::MetricsCollector::MetricsCollection_t metrics[3];
+
 	/*** Constructor */
 	ProcessListener();
 
@@ -75,10 +91,45 @@ private:
 	std::unique_ptr<bu::Logger> logger;
 
 	/**
-	 * @brief Buffer
+	 * @brief Receive buffers (one page per message of the batch)
 	 */
 	char *buf;
 	int buffSize;
+
+	/**
+	 * @brief Names of the managed processes started, by PID
+	 *
+	 * Filled at EXEC time, since at EXIT time /proc/<pid> could be no
+	 * longer available.
+	 */
+	std::unordered_map<int, std::string> proc_names;
+
+	/**
+	 * @brief Events received since the last rate sample
+	 */
+	uint32_t events_count = 0;
+
+	/**
+	 * @brief Timer for the events rate computation
+	 */
+	bu::Timer rate_tmr;
+
+	/**
+	 * @brief Attach a socket filter dropping (in kernel space) all the
+	 * process events but EXEC and EXIT
+	 */
+	void AttachFilter();
+
+	/**
+	 * @brief Process a single EXEC or EXIT event
+	 */
+	void HandleEvent(proc_event const * e);
+
+	/**
+	 * @brief Update the events rate metric, once per second
+	 */
+	void UpdateRate();
+
 	/**
 	 * @brief Helper function to retrieve the name of a given PID
 	 */
@@ -2,10 +2,24 @@
 #define BBQUE_REMOTE_PLATFORM_PROXY_H
 
 
+#include <chrono>
+#include <map>
+#include <mutex>
+
 #include "bbque/platform_proxy.h"
 #include "bbque/plugins/agent_proxy_if.h"
+#include "bbque/utils/metrics_collector.h"
 
 #define REMOTE_PLATFORM_PROXY_NAMESPACE "bb.pp.rpp"
+#define REMOTE_PLATFORM_PROXY_CONFIG    "RemotePlatformProxy"
+
+/** Default period of the status updates from the remote systems */
+#define BBQUE_RPP_STATUS_PERIOD_MS  500
+/** Periods without updates after which the cached status of a remote
+ * system is considered stale */
+#define BBQUE_RPP_STATUS_STALE_PERIODS  10
+/** Minimum time without updates for a stale cached status */
+#define BBQUE_RPP_STATUS_STALE_MIN_MS   1000
 
 namespace bbque {
 namespace pp {
@@ -77,6 +91,16 @@ public:
 	void WaitForServerToStop();
 
 
+	/**
+	 * @brief Status of a remote resource
+	 *
+	 * The status is read from the local cache, kept updated by the
+	 * subscriptions to the remote systems, without blocking. A remote
+	 * call is performed only if the resource is not in the cache yet.
+	 *
+	 * @return AGENT_DISCONNECTED if the updates from the remote system
+	 * stopped, i.e. the cached status is stale
+	 */
 	bbque::agent::ExitCode_t GetResourceStatus(
 		std::string const & resource_path, agent::ResourceStatus & status);
 
@@ -84,6 +108,10 @@ public:
 	bbque::agent::ExitCode_t GetWorkloadStatus(
 		std::string const & system_path, agent::WorkloadStatus & status);
 
+	/**
+	 * @brief Workload status of a remote system (cached, as for the
+	 * resources status)
+	 */
 	bbque::agent::ExitCode_t GetWorkloadStatus(
 		int system_id, agent::WorkloadStatus & status);
 
@@ -109,6 +137,35 @@ public:
 		std::string const & system_path,
 		agent::ApplicationScheduleRequest const & request) ;
 
+
+	bbque::agent::ExitCode_t SubscribeStatus(
+		int system_id,
+		std::vector<std::string> const & paths,
+		uint32_t period_ms,
+		agent::StatusUpdateCallback_t cb);
+
+	bbque::agent::ExitCode_t UnsubscribeStatus(int system_id);
+
+
+	bbque::agent::ExitCode_t SendScheduleRequests(
+		int system_id,
+		std::vector<agent::ApplicationScheduleRequest> const & requests,
+		std::vector<bbque::agent::ExitCode_t> & results);
+
+	/**
+	 * @brief Processing headroom of a remote system
+	 *
+	 * The fraction of processing elements capacity not used (or loaded),
+	 * computed from the cached status, without blocking.
+	 *
+	 * @param system_id The remote system
+	 * @param headroom The headroom in [0, 1]
+	 * @return PROXY_NOT_READY if no status has been received yet,
+	 * AGENT_DISCONNECTED if the cached status is stale
+	 */
+	bbque::agent::ExitCode_t GetProcessingHeadroom(
+		int system_id, float & headroom);
+
 private:
 	/**
 	 * @brief The logger used by the worker thread
@@ -117,8 +174,56 @@ private:
 
 	std::unique_ptr<bbque::plugins::AgentProxyIF> agent_proxy;
 
+	/** Period of the status updates (0 to poll the remote systems) */
+	uint32_t status_period_ms;
+
+	/** Remote systems subscribed to */
+	std::vector<int> subscribed_systems;
+
+	/**
+	 * @struct SystemStatusCache
+	 * @brief The status received from a remote system
+	 */
+	struct SystemStatusCache {
+		/** Status of the remote resources */
+		std::map<std::string, agent::ResourceStatus> resources;
+		/** Workload status (valid if has_workload) */
+		agent::WorkloadStatus workload;
+		bool has_workload = false;
+		/** Time of the last update received */
+		std::chrono::steady_clock::time_point last_update;
+	};
+
+	/** Cached status, per remote system (dropped when the stream closes) */
+	std::map<int, SystemStatusCache> status_cache;
+
+	/** Protect the cached status */
+	std::mutex cache_mtx;
+
+	/** The metrics collector */
+	bu::MetricsCollector & mc;
+
+	/** Status queries: cache hits, remote calls, updates received, query
+	 * time and stale status */
+	static bu::MetricsCollector::MetricsCollection_t metrics[5];
+
 	ExitCode_t LoadAgentProxy();
 
+	/**
+	 * @brief Subscribe to the status updates of all the remote systems
+	 */
+	void SubscribeRemoteSystems();
+
+	/**
+	 * @brief Merge a status update into the cache
+	 */
+	void UpdateStatusCache(int system_id, agent::StatusUpdate const & update);
+
+	/**
+	 * @brief Check if the cached status of a remote system is too old
+	 */
+	bool IsStale(SystemStatusCache const & sys_cache) const;
+
 };
 }   // namespace pp
 }   // namespace bbque
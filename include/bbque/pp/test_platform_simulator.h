@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_TEST_PLATFORM_SIMULATOR_H_
+#define BBQUE_TEST_PLATFORM_SIMULATOR_H_
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bbque/app/application.h"
+#include "bbque/utils/logging/logger.h"
+#include "bbque/utils/worker.h"
+
+#define TEST_PP_SIM_NAMESPACE "bq.pp.sim"
+
+/** PIDs of the synthetic EXCs: beyond the maximum PID of the system */
+#define TEST_PP_SIM_PID_BASE  5000000
+
+namespace ba = bbque::app;
+namespace bu = bbque::utils;
+
+namespace bbque {
+namespace pp {
+
+/**
+ * @class TestPlatformSimulator
+ *
+ * @brief Large-scale simulation of platforms and workloads
+ *
+ * In Simulated mode (Test Platform Data), the simulator can generate a
+ * platform of arbitrary size, i.e., a number of systems, CPUs per system,
+ * processing elements per CPU and memory nodes, in place of the one
+ * described by the TPD file.
+ *
+ * Moreover, it can drive a synthetic workload through the actual scheduling
+ * and synchronization code paths. The synthetic EXCs are EXC containers,
+ * whose synchronization protocol is not forwarded to any RTLib, using
+ * recipes generated at start-up. Each EXC has a cycle-time model: the cycle
+ * time is inversely proportional to the CPU quota assigned, and the goal
+ * gap is notified as the RTLib would do.
+ *
+ * The workload grows in steps (Simulator.excs). At each step, a number of
+ * rounds is executed, where a share of the EXCs terminates and is replaced
+ * (Simulator.churn), the runtime profiles are updated, and then a
+ * scheduling and synchronization are run. For each step, the report
+ * includes the scheduling and synchronization latencies, the share of EXCs
+ * running, the mean normalized AWM value, the CPU utilization and the
+ * memory used by the daemon.
+ *
+ * @note The simulator runs the optimizations in place of the
+ * ResourceManager: it is not meant to manage actual applications.
+ */
+class TestPlatformSimulator: public bu::Worker {
+
+public:
+
+	static TestPlatformSimulator & GetInstance();
+
+	virtual ~TestPlatformSimulator();
+
+	/**
+	 * @brief Register the resources of the synthetic platform
+	 *
+	 * @return false if no platform has been configured, i.e., the TPD file
+	 * must be used
+	 */
+	bool RegisterPlatform();
+
+	/**
+	 * @brief Start the workload simulation, if configured
+	 */
+	void StartWorkload();
+
+private:
+
+	/**
+	 * @struct SimEXC_t
+	 * @brief A synthetic EXC
+	 */
+	struct SimEXC_t {
+		ba::AppPtr_t papp;
+		/** Cycle time with the maximum CPU quota of the recipe [ms] */
+		float ctime_ref_ms;
+		/** CPU quota of the recipe maximum AWM */
+		uint32_t quota_ref;
+		/** Target cycle time [ms] */
+		float ctime_goal_ms;
+	};
+
+	/**
+	 * @struct StepReport_t
+	 * @brief The outcome of a step of the simulation
+	 */
+	struct StepReport_t {
+		uint32_t nr_excs = 0;
+		double sched_mean_us = 0;
+		double sched_max_us  = 0;
+		double sync_mean_us  = 0;
+		double sync_max_us   = 0;
+		/** Share of the EXCs RUNNING [%] */
+		double running_pct   = 0;
+		/** Mean normalized value of the AWMs assigned */
+		double awm_value     = 0;
+		/** CPU quota used [%] */
+		double cpu_usage_pct = 0;
+		/** Resident memory of the daemon [KB] */
+		uint64_t rss_kb      = 0;
+	};
+
+
+	/*** Platform ***/
+
+	uint16_t nr_systems;
+
+	uint16_t nr_cpus;
+
+	uint16_t nr_pes;
+
+	uint32_t mem_mb;
+
+	/*** Workload ***/
+
+	std::string excs_steps;
+
+	uint16_t nr_recipes;
+
+	uint16_t nr_awms;
+
+	uint32_t max_quota;
+
+	uint16_t nr_rounds;
+
+	uint16_t churn_pct;
+
+	uint32_t seed;
+
+	std::string report_file;
+
+	bool exit_at_end;
+
+
+	std::mt19937 rng;
+
+	/** The synthetic recipes: name and CPU quota of the maximum AWM */
+	std::vector<std::pair<std::string, uint32_t>> recipes;
+
+	std::map<ba::AppUid_t, SimEXC_t> excs;
+
+	uint32_t next_pid = TEST_PP_SIM_PID_BASE;
+
+	std::vector<StepReport_t> reports;
+
+
+	TestPlatformSimulator();
+
+	/**
+	 * @brief The workload simulation
+	 */
+	virtual void Task();
+
+	/**
+	 * @brief Generate the synthetic recipes
+	 */
+	bool CreateRecipes();
+
+	/**
+	 * @brief Create, enable and model a synthetic EXC
+	 */
+	bool SpawnEXC();
+
+	/**
+	 * @brief Terminate a synthetic EXC, as at application exit
+	 */
+	void TerminateEXC(ba::AppPtr_t papp);
+
+	/**
+	 * @brief Terminate a share of the running EXCs and replace them
+	 */
+	void Churn();
+
+	/**
+	 * @brief Notify the runtime profiles according to the cycle-time
+	 * models
+	 */
+	void UpdateRuntimeProfiles();
+
+	/**
+	 * @brief Run a scheduling and a synchronization, holding the RM not
+	 * ready
+	 *
+	 * @param sched_us The scheduling latency
+	 * @param sync_us The synchronization latency
+	 */
+	void Optimize(double & sched_us, double & sync_us);
+
+	/**
+	 * @brief Collect the allocation quality metrics
+	 */
+	void CollectQuality(StepReport_t & report);
+
+	/**
+	 * @brief Resident memory of the daemon [KB]
+	 */
+	uint64_t GetResidentMemory() const;
+
+	/**
+	 * @brief Log (and save) the report of all the steps
+	 */
+	void Report();
+};
+
+} // namespace pp
+
+} // namespace bbque
+
+#endif // BBQUE_TEST_PLATFORM_SIMULATOR_H_
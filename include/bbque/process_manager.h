@@ -23,6 +23,7 @@
 #include <mutex>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "bbque/app/process.h"
@@ -302,6 +303,15 @@ private:
 	/** The set containing the names of the managed processes */
 	std::map<std::string, ProcessInstancesInfo> managed_procs;
 
+	/**
+	 * Hash set of the managed process names, for a fast lookup on each
+	 * process event, without contending the processes maps mutex
+	 */
+	std::unordered_set<std::string> managed_names;
+
+	/** Mutex to protect the hash set of the managed process names */
+	mutable std::mutex names_mutex;
+
 	/** State vectors of the managed processes */
 	std::vector<ProcessMap_t> state_procs;
 
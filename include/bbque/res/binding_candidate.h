@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_BINDING_CANDIDATE_H_
+#define BBQUE_BINDING_CANDIDATE_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bbque/res/resource_assignment.h"
+#include "bbque/res/resource_path.h"
+
+namespace bbque { namespace res {
+
+/**
+ * @class BindingDomains
+ *
+ * The system resources to which the resource requests of a working mode can
+ * be bound, for each binding domain of a given type of resource (e.g., the
+ * processing elements of each CPU).
+ *
+ * The lists are the ones that ResourceBinder::Bind() would set in the
+ * bound resource assignments, but they are retrieved once, when the object
+ * is built. Requests not including the binding type are not bound: their
+ * list is the one of the requested assignment, as in the bound maps.
+ *
+ * The object is read-only after construction, and shared by all the
+ * BindingCandidate objects of the working mode.
+ */
+class BindingDomains {
+
+public:
+
+	/**
+	 * @brief A resource request and its binding lists
+	 */
+	struct Request {
+		/** The requested resource path, as in the recipe */
+		ResourcePathPtr_t path;
+		/** The requested assignment (shared with the working mode) */
+		ResourceAssignmentPtr_t assign;
+		/**
+		 * The requested path with any ID of the binding type. With the
+		 * domain ID, it identifies the bound resources, and it is the
+		 * same object for all the working modes (resource path registry).
+		 */
+		ResourcePathPtr_t domain_path;
+		/** Whether the path includes the binding type */
+		bool bound;
+		/** The binding list per domain ID */
+		std::vector<ResourcePtrList_t> domains;
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param requests The (unbound) resource requests of the working mode
+	 * @param r_type The type of the binding domains
+	 */
+	BindingDomains(ResourceAssignmentMap_t const & requests, ResourceType r_type);
+
+	/**
+	 * @brief The type of the binding domains
+	 */
+	inline ResourceType Type() const {
+		return r_type;
+	}
+
+	/**
+	 * @brief The resource requests, with their binding lists
+	 */
+	inline std::vector<Request> const & Requests() const {
+		return requests;
+	}
+
+	/**
+	 * @brief The resources to which a request can be bound in a domain
+	 *
+	 * @param req The request
+	 * @param domain_id The ID of the binding domain
+	 *
+	 * @return The list of resource descriptors, empty if the domain is
+	 * not there
+	 */
+	ResourcePtrList_t const & Resources(
+			Request const & req, BBQUE_RID_TYPE domain_id) const;
+
+private:
+
+	/** The type of the binding domains */
+	ResourceType r_type;
+
+	/** The resource requests, in the order of the requests map */
+	std::vector<Request> requests;
+
+	/** The (empty) list of the requests not bindable into a domain */
+	ResourcePtrList_t no_resources;
+
+};
+
+using BindingDomainsPtr_t = std::shared_ptr<BindingDomains const>;
+
+
+/**
+ * @class BindingCandidate
+ *
+ * A candidate binding of the resource requests of a working mode into a
+ * binding domain, i.e., what WorkingMode::BindResource(r_type, R_ID_ANY,
+ * domain_id) would produce, without building it.
+ *
+ * A candidate is just a reference to the BindingDomains of the working mode
+ * and a domain ID: the scheduling policies can evaluate the availability of
+ * the resources for all the working modes and binding domains, and then
+ * bind only the candidate selected (see WorkingMode::BindResource).
+ */
+class BindingCandidate {
+
+public:
+
+	/**
+	 * @brief An invalid candidate
+	 */
+	BindingCandidate():
+		domain_id(R_ID_NONE) {
+	}
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param domains The binding lists of the working mode
+	 * @param domain_id The ID of the binding domain
+	 */
+	BindingCandidate(BindingDomainsPtr_t domains, BBQUE_RID_TYPE domain_id):
+		domains(domains),
+		domain_id(domain_id) {
+	}
+
+	/**
+	 * @brief Check if the candidate refers to a working mode
+	 */
+	inline bool Valid() const {
+		return domains != nullptr;
+	}
+
+	/**
+	 * @brief The type of the binding domain
+	 */
+	inline ResourceType Type() const {
+		return domains->Type();
+	}
+
+	/**
+	 * @brief The ID of the binding domain
+	 */
+	inline BBQUE_RID_TYPE DomainID() const {
+		return domain_id;
+	}
+
+	/**
+	 * @brief The number of resource requests
+	 */
+	inline size_t Size() const {
+		return domains->Requests().size();
+	}
+
+	/**
+	 * @brief The (unbound) path of a resource request
+	 */
+	inline ResourcePathPtr_t const & RequestPath(size_t i) const {
+		return domains->Requests()[i].path;
+	}
+
+	/**
+	 * @brief The path of a resource request with any ID of the binding
+	 * type (see BindingDomains::Request)
+	 */
+	inline ResourcePathPtr_t const & DomainPath(size_t i) const {
+		return domains->Requests()[i].domain_path;
+	}
+
+	/**
+	 * @brief The amount of a resource request
+	 */
+	inline uint64_t Amount(size_t i) const {
+		return domains->Requests()[i].assign->GetAmount();
+	}
+
+	/**
+	 * @brief Whether a request is bound into the domain, i.e. its path
+	 * includes the binding type
+	 */
+	inline bool IsBound(size_t i) const {
+		return domains->Requests()[i].bound;
+	}
+
+	/**
+	 * @brief The resources to which a request would be bound
+	 */
+	inline ResourcePtrList_t const & Resources(size_t i) const {
+		return domains->Resources(domains->Requests()[i], domain_id);
+	}
+
+	/**
+	 * @brief The amount of resources available for a request
+	 *
+	 * @param i The index of the request
+	 * @param status_view The resource state view to consider
+	 * @param papp [optional] The application for which the resources are
+	 * evaluated (its current assignment counts as available)
+	 */
+	uint64_t Available(
+			size_t i,
+			RViewToken_t status_view = 0,
+			SchedPtr_t papp = SchedPtr_t()) const;
+
+	/**
+	 * @brief Check if all the requests can be satisfied in the domain
+	 */
+	bool Satisfiable(
+			RViewToken_t status_view = 0,
+			SchedPtr_t papp = SchedPtr_t()) const;
+
+	/**
+	 * @brief Check if the domain has none of the resources requested, i.e.
+	 * the requests including the binding type would be bound to empty lists
+	 */
+	bool Empty() const;
+
+private:
+
+	/** The binding lists of the working mode */
+	BindingDomainsPtr_t domains;
+
+	/** The binding domain */
+	BBQUE_RID_TYPE domain_id;
+
+};
+
+} // namespace res
+
+} // namespace bbque
+
+#endif // BBQUE_BINDING_CANDIDATE_H_
@@ -73,6 +73,8 @@ public:
 	}
 
 	inline std::string const & ToStringCG() const {
+		if (cg_dirty)
+			BuildStringCG();
 		return cg_str;
 	}
 
@@ -80,6 +82,33 @@ public:
 		return bit_set.to_ulong();
 	}
 
+	/**
+	 * @brief The position of the first bit set after a given one
+	 *
+	 * @param pos The starting position (excluded). R_ID_NONE to start
+	 * from the beginning.
+	 *
+	 * @return The position, or R_ID_NONE if no more bits are set
+	 */
+	BBQUE_RID_TYPE NextSet(BBQUE_RID_TYPE pos) const;
+
+	/**
+	 * @brief A bitset with the first N bits set of this one only
+	 *
+	 * @param num The number of bits to keep
+	 *
+	 * @return The resulting bitset. It has less than 'num' bits set if
+	 * this bitset does not have enough bits set.
+	 */
+	ResourceBitset FirstN(BBQUE_RID_TYPE num) const;
+
+	/**
+	 * @brief Check whether there are bits set in both the bitsets
+	 */
+	inline bool Intersects(ResourceBitset const & rbs) const {
+		return (bit_set & rbs.bit_set).any();
+	}
+
 	/*****************************************************************
 	 *                        Operators                              *
 	 *****************************************************************/
@@ -100,6 +129,13 @@ public:
 
 	ResourceBitset operator&= (const ResourceBitset & rbs);
 
+	/** Clear the bits set in the given bitset */
+	ResourceBitset operator-= (const ResourceBitset & rbs);
+
+	ResourceBitset operator| (const ResourceBitset & rbs) const;
+
+	ResourceBitset operator& (const ResourceBitset & rbs) const;
+
 private:
 
 	std::bitset<BBQUE_MAX_R_ID_NUM+1> bit_set;
@@ -112,7 +148,20 @@ private:
 
 	bool none;
 
-	std::string cg_str;
+	mutable std::string cg_str;
+
+	/** The CG string must be rebuilt before being returned */
+	mutable bool cg_dirty;
+
+	/**
+	 * @brief Recompute count and boundaries from the bits
+	 *
+	 * Called after the word-wide operations, which do not track the bits
+	 * set one by one. The CG string is rebuilt on demand.
+	 */
+	void Update();
+
+	void BuildStringCG() const;
 };
 
 } // namespace res
@@ -21,10 +21,14 @@
 #include <cstdint>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "bbque/utils/logging/logger.h"
+#include "bbque/utils/metrics_collector.h"
 #include "bbque/res/resources.h"
 #include "bbque/res/resource_utils.h"
 
@@ -74,6 +78,11 @@ public:
 	typedef std::shared_ptr<ResourceNode> ResourceNodePtr_t;
 	typedef std::list<ResourceNodePtr_t>  ResourceNodesList_t;
 
+	/** Vector of resource descriptors (result of a search) */
+	typedef std::vector<ResourcePtr_t> ResourcePtrVector_t;
+	/** Shared pointer to an immutable search result */
+	typedef std::shared_ptr<const ResourcePtrVector_t> ResourcePtrVectorPtr_t;
+
 	/**
 	 * @class ResourceNode
 	 *
@@ -171,6 +180,37 @@ public:
 	ResourcePtrList_t find_list(ResourcePath & rsrc_path,
 			uint16_t match_flags = 0) const;
 
+	/**
+	 * @brief Find a set of resources, through the resolution index
+	 *
+	 * Same semantic of @ref find_list(), but the result is shared and must
+	 * not be modified. The results are memoized per (path, matching flags),
+	 * so that repeated queries do not traverse the tree.
+	 *
+	 * @param rsrc_path   A resource path object to match
+	 * @param match_flags The matching flags
+	 *
+	 * @return A shared pointer to the vector of resource descriptors
+	 */
+	ResourcePtrVectorPtr_t find_shared(ResourcePath & rsrc_path,
+			uint16_t match_flags = 0) const;
+
+	/**
+	 * @brief Drop all the memoized search results
+	 *
+	 * This must be called whenever the set of resources, or the status
+	 * affecting their availability, changes.
+	 */
+	void invalidate_index() const;
+
+	/**
+	 * @brief Report the resolution index lookups counted so far
+	 *
+	 * The lookups are counted locally, on the hot path, and reported to the
+	 * metrics collector only by this call, e.g. once per scheduling run.
+	 */
+	void update_index_metrics() const;
+
 	/**
 	 * @brief Maximum depth of the tree
 	 * @return The maxim depth value
@@ -191,7 +231,10 @@ public:
 	 * @brief Clear the tree
 	 */
 	inline void clear() {
+		std::unique_lock<std::mutex> tree_ul(tree_mtx);
 		clear_node(root);
+		tree_ul.unlock();
+		invalidate_index();
 	}
 
 private:
@@ -208,6 +251,51 @@ private:
 	/** Counter of resources */
 	uint16_t count;
 
+	/**
+	 * Protect the tree structure: platform proxies can register their
+	 * resources concurrently during the start-up
+	 */
+	mutable std::mutex tree_mtx;
+
+	/** Resolution index key: (path string, matching flags) */
+	typedef std::pair<std::string, uint16_t> IndexKey_t;
+
+	/** Resolution index: memoized search results */
+	mutable std::map<IndexKey_t, ResourcePtrVectorPtr_t> index;
+
+	/** Protect the resolution index */
+	mutable std::mutex index_mtx;
+
+	/** Number of index invalidations (to discard stale search results) */
+	mutable uint32_t index_gen = 0;
+
+	/** Index lookups not yet reported to the metrics collector */
+	mutable uint32_t index_hits = 0, index_misses = 0;
+
+	/** The metrics collector */
+	bu::MetricsCollector & mc;
+
+	/** Resolution index metrics */
+	enum IndexMetrics {
+		RT_IDX_HIT_PERC = 0,
+		RT_IDX_HITS,
+		RT_IDX_MISSES,
+		RT_METRICS_COUNT
+	};
+
+	/** Index lookups metrics (hit rate sampled at each report) */
+	static bu::MetricsCollector::MetricsCollection_t metrics[RT_METRICS_COUNT];
+
+	/**
+	 * @brief Normalize the matching flags
+	 */
+	static inline uint16_t normalize_flags(uint16_t match_flags) {
+		// match_flags = "11x" is a not valid configuration
+		if (match_flags & RT_MATCH_TYPE & RT_MATCH_MIXED)
+			return RT_MATCH_MIXED;
+		return match_flags;
+	}
+
 	/**
 	 * @brief Find a node
 	 *
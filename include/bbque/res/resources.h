@@ -151,6 +151,17 @@ public:
 		MEAN
 	};
 
+	/**
+	 * @brief Memory/cache contention information, sampled from hardware
+	 * performance counters
+	 */
+	enum class ContentionInfoType {
+		IPC = 0,         /** Instructions per cycle */
+		LLC_MPKI,        /** Last-level cache misses per kilo-instruction */
+		MEM_STALLS_PERC, /** Percentage of cycles stalled in the back-end */
+		COUNT
+	};
+
 
 	/**********************************************************************
 	 * GENERAL INFORMATION                                                  *
@@ -434,6 +445,50 @@ public:
 #endif // CONFIG_BBQUE_PM
 
 
+#ifdef CONFIG_BBQUE_CONTENTION_MONITOR
+
+	/**********************************************************************
+	 * CONTENTION INFORMATION                                             *
+	 **********************************************************************/
+
+	/**
+	 * @brief Enable the collection of memory/cache contention information
+	 *
+	 * @param samples_window Number of samples for the computation of the
+	 * mean (exponential) values
+	 */
+	void EnableContentionProfile(uint samples_window);
+
+	/**
+	 * @brief Check if the contention profile information are collected
+	 */
+	inline bool IsContentionProfileEnabled() {
+		std::unique_lock<std::mutex> ul(ct_profile.mux);
+		return !ct_profile.values.empty();
+	}
+
+	/**
+	 * @brief Update the contention profile information
+	 *
+	 * @param i_type The contention information to update
+	 * @param sample The sample value
+	 */
+	void UpdateContentionInfo(ContentionInfoType i_type, double sample);
+
+	/**
+	 * @brief Contention profile information
+	 *
+	 * @param i_type Information type (e.g., IPC, LLC_MPKI,...)
+	 * @param v_type Specify if the value required is the instantaneous or the
+	 * mean (exponential) computed on a set of samples (@see ValueType)
+	 *
+	 * @return The value of the contention information required
+	 */
+	double GetContentionInfo(ContentionInfoType i_type, ValueType v_type = MEAN);
+
+#endif // CONFIG_BBQUE_CONTENTION_MONITOR
+
+
 	/**********************************************************************
 	 * RELIABILITY INFORMATION                                            *
 	 **********************************************************************/
@@ -493,6 +548,17 @@ private:
 	} PowerProfile_t;
 
 
+#ifdef CONFIG_BBQUE_CONTENTION_MONITOR
+	/**
+	 * @brief Information related to the memory/cache contention on the
+	 * resource
+	 */
+	typedef struct ContentionProfile {
+		std::mutex mux;
+		std::vector<pEma_t> values; /** Sampled values */
+	} ContentionProfile_t;
+#endif
+
 	/**
 	 * @brief Runtime information about the reliability of the resource
 	 */
@@ -530,6 +596,11 @@ private:
 		{BBQUE_PM_DEFAULT_SAMPLES_WINSIZE};
 #endif
 
+#ifdef CONFIG_BBQUE_CONTENTION_MONITOR
+	/** Memory/cache contention status (from performance counters) */
+	ContentionProfile_t ct_profile;
+#endif
+
 	/** The run-time reliability profile of this resource */
 	ReliabilityProfile_t rb_profile;
 
@@ -18,12 +18,16 @@
 #ifndef BBQUE_RESOURCE_ACCOUNTER_H_
 #define BBQUE_RESOURCE_ACCOUNTER_H_
 
+#include <map>
+#include <memory>
 #include <set>
+#include <string>
 
 #include "bbque/resource_accounter_conf.h"
 #include "bbque/configuration_manager.h"
 #include "bbque/command_manager.h"
 
+#include "bbque/res/bitset.h"
 #include "bbque/res/resource_utils.h"
 #include "bbque/res/resource_tree.h"
 #include "bbque/utils/logging/logger.h"
@@ -62,6 +66,64 @@ typedef std::shared_ptr<ResourceSet_t> ResourceSetPtr_t;
 /** Map of ResourcesSetPtr_t. The key is the view token */
 typedef std::map<br::RViewToken_t, ResourceSetPtr_t> ResourceViewsMap_t;
 
+
+/**
+ * @struct ResourceSnapshot
+ * @brief Immutable copy of the committed resource state view
+ *
+ * A new snapshot is published every time the system state view changes,
+ * and when resources are reserved, off-lined or on-lined.
+ * Once published it is never modified, so that readers can access it
+ * without any locking, even while a synchronization is in progress.
+ */
+struct ResourceSnapshot {
+
+	/**
+	 * @struct Entry
+	 * @brief The accounting status of a single resource
+	 */
+	struct Entry {
+		/** The resource descriptor */
+		br::ResourcePtr_t rsrc;
+		/** The resource path object */
+		br::ResourcePathPtr_t path;
+		/** Amount of resource used in the committed view */
+		uint64_t used;
+		/** Amount of resource not reserved */
+		uint64_t unreserved;
+		/** Total amount of resource */
+		uint64_t total;
+		/** Offline status */
+		bool offline;
+	};
+
+	/** Publication number (incremented at each update) */
+	uint32_t epoch = 0;
+
+	/** The token of the system view this snapshot refers to */
+	br::RViewToken_t view = 0;
+
+	/** Per-resource status. Key: resource path string */
+	std::map<std::string, Entry> entries;
+
+	/**
+	 * @brief The status entry of a resource
+	 *
+	 * @param path The resource path string
+	 * @return A pointer to the entry, or nullptr if missing
+	 */
+	inline Entry const * Find(std::string const & path) const {
+		auto it = entries.find(path);
+		if (it == entries.end())
+			return nullptr;
+		return &(it->second);
+	}
+};
+
+/** Shared pointer to an immutable resource snapshot */
+typedef std::shared_ptr<const ResourceSnapshot> ResourceSnapshotPtr_t;
+
+
 // Forward declarations
 class ApplicationManager;
 
@@ -204,6 +266,86 @@ public:
 		return resource_set;
 	}
 
+	/**
+	 * @brief Get the last published snapshot of the system state view
+	 *
+	 * This call does not wait for the platform to be ready, neither for the
+	 * completion of a synchronization in progress. The snapshot returned
+	 * remains valid as long as the caller holds the pointer.
+	 *
+	 * @return A shared pointer to the snapshot, or nullptr if the platform
+	 * has not been ready yet
+	 */
+	inline ResourceSnapshotPtr_t GetSnapshot() const {
+		return std::atomic_load(&sys_snapshot);
+	}
+
+	/**
+	 * @brief Wait for the first snapshot of the system state view
+	 *
+	 * Differently from WaitForPlatformReady(), this returns as soon as the
+	 * platform has been loaded once, even if a synchronization is in
+	 * progress.
+	 *
+	 * @return A shared pointer to the last published snapshot
+	 */
+	ResourceSnapshotPtr_t WaitForSnapshot();
+
+	/**
+	 * @brief The first N processing elements free in a binding domain
+	 *
+	 * A processing element is free if it is online, and not used or
+	 * reserved at all in the given state view. This is answered from the
+	 * per-view availability bitsets, without walking the resource tree.
+	 *
+	 * @param domain The binding domain path (e.g. "sys0.cpu1"), or a
+	 * prefix of it (e.g. "sys0") to consider all the domains included
+	 * @param num The number of processing elements required
+	 * @param status_view The token referencing the resource state view
+	 *
+	 * @return The IDs of at most 'num' free processing elements
+	 */
+	br::ResourceBitset GetFreePEs(
+		std::string const & domain,
+		BBQUE_RID_TYPE num,
+		br::RViewToken_t status_view = 0);
+
+	/**
+	 * @brief The processing elements free in a binding domain, among the
+	 * ones of a given mask
+	 *
+	 * @param domain The binding domain path, or a prefix of it
+	 * @param mask The processing elements IDs of interest
+	 * @param status_view The token referencing the resource state view
+	 *
+	 * @return The IDs of the free processing elements in the mask
+	 */
+	br::ResourceBitset GetFreePEs(
+		std::string const & domain,
+		br::ResourceBitset const & mask,
+		br::RViewToken_t status_view = 0);
+
+	/**
+	 * @brief The processing elements partially used (or reserved) in a
+	 * binding domain, still having some available quota
+	 *
+	 * @param domain The binding domain path, or a prefix of it
+	 * @param status_view The token referencing the resource state view
+	 */
+	br::ResourceBitset GetPartiallyUsedPEs(
+		std::string const & domain,
+		br::RViewToken_t status_view = 0);
+
+	/**
+	 * @brief The processing elements offline in a binding domain
+	 *
+	 * @param domain The binding domain path, or a prefix of it
+	 * @param status_view The token referencing the resource state view
+	 */
+	br::ResourceBitset GetOfflinePEs(
+		std::string const & domain,
+		br::RViewToken_t status_view = 0);
+
 	/**
 	 * @see ResourceAccounterStatusIF
 	 */
@@ -279,6 +421,14 @@ public:
 	 */
 	void PrintStatusReport(br::RViewToken_t status_view = 0, bool verbose = false) const;
 
+	/**
+	 * @brief Show the resources status of a snapshot of the system view
+	 *
+	 * @param snapshot The snapshot of the system state view
+	 * @param verbose print in INFO log level is true, while false in DEBUG
+	 */
+	void PrintStatusReport(ResourceSnapshotPtr_t snapshot, bool verbose) const;
+
 	/**
 	 * @brief Print details about how resource usage is partitioned among
 	 * applications/EXCs
@@ -613,6 +763,12 @@ private:
 	/** Keep track of the max length between resources path string */
 	uint8_t path_max_len = 0;
 
+	/**
+	 * Protect the registration data (paths, resources set, identifiers per
+	 * type), since platform proxies are loaded in parallel
+	 */
+	std::mutex register_mtx;
+
 
 	/**
 	 * Map containing the pointers to the map of resource assignments specified in
@@ -650,6 +806,54 @@ private:
 	 */
 	br::RViewToken_t sch_view_token = 0;
 
+	/**
+	 * @brief The last published snapshot of the system state view
+	 *
+	 * Always accessed through std::atomic_load/std::atomic_store: writers
+	 * replace the pointer, while the readers keep the previous copies alive
+	 * until they release them.
+	 */
+	ResourceSnapshotPtr_t sys_snapshot;
+
+	/** Number of snapshots published so far */
+	uint32_t snapshot_epoch = 0;
+
+	/** Serialize the snapshot writers (view changes, reservations...) */
+	std::mutex snapshot_mtx;
+
+	/** Notify the publication of a snapshot */
+	std::condition_variable snapshot_cv;
+
+
+	/**
+	 * @struct PEAvailability_t
+	 * @brief The availability of the processing elements of a binding
+	 * domain, as bitsets of processing element IDs
+	 *
+	 * A processing element fully used is in none of the bitsets.
+	 */
+	struct PEAvailability_t {
+		/** Online, not used nor reserved */
+		br::ResourceBitset free;
+		/** Online, partially used or reserved */
+		br::ResourceBitset partial;
+		/** Offline */
+		br::ResourceBitset offline;
+	};
+
+	/** Availability per binding domain. Key: the domain path string */
+	typedef std::map<std::string, PEAvailability_t> PEAvailabilityMap_t;
+
+	/**
+	 * The processing elements availability of the resource state views
+	 * queried so far. Key: the view token. This is kept consistent with
+	 * the resource booking and release.
+	 */
+	std::map<br::RViewToken_t, PEAvailabilityMap_t> pe_avail_per_views;
+
+	/** Protect the processing elements availability per view */
+	std::mutex pe_avail_mtx;
+
 	/**
 	 * Default constructor
 	 */
@@ -697,11 +901,67 @@ private:
 	 */
 	br::RViewToken_t _SetView(br::RViewToken_t tok);
 
+	/**
+	 * @brief Build and publish a new snapshot of the system state view
+	 *
+	 * This must be called by the writers only, i.e. while the system view
+	 * or the resource reservations and on-line status have been modified.
+	 */
+	void PublishSnapshot();
+
 	/**
 	 * @brief Thread unsafe version of @ref PutView
 	 */
 	ExitCode_t _PutView(br::RViewToken_t tok);
 
+	/**
+	 * @brief Reserve the resources, without refreshing the processing
+	 * elements availability and publishing a new snapshot
+	 */
+	ExitCode_t _ReserveResources(
+		br::ResourcePathPtr_t resource_path_ptr, uint64_t amount);
+
+
+	/**
+	 * @brief Build the processing elements availability of a view, from
+	 * the current status of the resources
+	 *
+	 * @note status_mtx and pe_avail_mtx must be held, in this order
+	 */
+	PEAvailabilityMap_t & InitPEAvailability(br::RViewToken_t status_view);
+
+	/**
+	 * @brief Drop the processing elements availability of all the views,
+	 * e.g. after an offline/online or reservation, to rebuild it at the
+	 * next query
+	 */
+	void RefreshPEAvailability();
+
+	/**
+	 * @brief Update the availability bits of a processing element, after
+	 * its usage in a view has changed
+	 *
+	 * Only the views already queried are indexed: for the other ones this
+	 * is just a lookup.
+	 */
+	void UpdatePEAvailability(
+		br::ResourcePtr_t const & rsrc, br::RViewToken_t status_view);
+
+	/**
+	 * @brief Set the availability bits of a processing element
+	 */
+	void SetPEAvailability(
+		PEAvailability_t & pe_avail,
+		br::ResourcePtr_t const & rsrc,
+		br::RViewToken_t status_view);
+
+	/**
+	 * @brief The processing elements availability of a binding domain (or
+	 * of all the domains matching a prefix)
+	 */
+	PEAvailability_t GetPEAvailability(
+		std::string const & domain, br::RViewToken_t status_view);
+
 
 	/**
 	 * @brief Get a list of resource descriptor
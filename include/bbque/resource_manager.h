@@ -158,6 +158,21 @@ public:
 	 */
 	void WaitForReady();
 
+	/**
+	 * @brief Wait for the RM to be ready, and keep it not ready until
+	 * ReleaseReady() is called
+	 *
+	 * This allows an external module to run an optimization (scheduling
+	 * and synchronization) without overlapping with the ones triggered by
+	 * the RM events.
+	 */
+	void AcquireReady();
+
+	/**
+	 * @brief Set the RM ready again, after AcquireReady()
+	 */
+	void ReleaseReady();
+
 private:
 
 	/**
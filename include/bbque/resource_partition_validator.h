@@ -22,7 +22,8 @@
 #include <map>
 #include <memory>
 #include <mutex>
-
+#include <tuple>
+#include <vector>
 
 #include "bbque/utils/logging/logger.h"
 #include "tg/task_graph.h"
@@ -87,6 +88,14 @@ public:
 		return type;
 	}
 
+	/**
+	 * @brief True if Skim() can be called concurrently (e.g., for
+	 *	  different clusters). Otherwise the calls are serialized.
+	 */
+	virtual bool IsReentrant() const {
+		return false;
+	}
+
 private:
 
 	SkimmerType_t type;
@@ -129,6 +138,32 @@ public:
 	    const TaskGraph &tg, std::list<Partition> &partitions,
 	    uint32_t hw_cluster_id);
 
+	/**
+	 * @brief Load the feasible partitions of a task-graph on a set of HW clusters
+	 *
+	 * The clusters are skimmed in parallel. The results are cached as
+	 * in the single cluster case.
+	 *
+	 * @param tg The task-graph
+	 * @param hw_cluster_ids The HW clusters to consider
+	 * @param partitions The feasible partitions per cluster
+	 * @param results The exit code per cluster
+	 */
+	void LoadPartitions(
+	    const TaskGraph &tg,
+	    std::vector<uint32_t> const & hw_cluster_ids,
+	    std::map<uint32_t, std::list<Partition>> & partitions,
+	    std::map<uint32_t, ExitCode_t> & results);
+
+	/**
+	 * @brief Drop all the cached partitions
+	 *
+	 * To call when the availability of the resources managed by the
+	 * skimmers changes outside of partition set/unset requests, e.g. when
+	 * the platform proxy maps a task-graph without a partition.
+	 */
+	void InvalidatePartitions() noexcept;
+
 
 	/**
 	 * @brief Register a new skimmer with the given priority (high numbers mean high priority)
@@ -162,17 +197,63 @@ public:
 
 private:
 
+	/**
+	 * Cache key: task-graph hash, HW cluster id, availability epoch
+	 */
+	typedef std::tuple<std::size_t, uint32_t, uint32_t> CacheKey_t;
+
+	/**
+	 * Cached outcome of a skimming
+	 */
+	struct CacheEntry_t {
+		ExitCode_t result;
+		PartitionSkimmer::SkimmerType_t failed_skimmer;
+		std::list<Partition> partitions;
+	};
+
 	/* ******* ATTRIBUTES ******* */
 	std::unique_ptr<bu::Logger> logger;
 
 	mutable std::mutex skimmers_lock;
 	std::multimap<int, PartitionSkimmerPtr_t> skimmers;
 
+	/**
+	 * Serialize the calls to the non-reentrant skimmers
+	 */
+	std::map<PartitionSkimmer *, std::shared_ptr<std::mutex>> skimmers_mtx;
+
 	PartitionSkimmer::SkimmerType_t failed_skimmer;
 
+	/**
+	 * Resource availability epoch: incremented each time a partition
+	 * is set or unset, since this changes the skimming outcome
+	 */
+	mutable uint32_t availability_epoch = 0;
+
+	/**
+	 * Partitions found in the current availability epoch
+	 */
+	mutable std::map<CacheKey_t, CacheEntry_t> cache;
+
+	mutable std::mutex cache_lock;
+
 	/* ******* METHODS ******* */
 	ResourcePartitionValidator();
 
+	/**
+	 * @brief Run the skimmers chain (without caching)
+	 * @param failed The skimmer failed, if any
+	 */
+	ExitCode_t Skim(
+	    const TaskGraph &tg, std::list<Partition> &partitions,
+	    uint32_t hw_cluster_id,
+	    PartitionSkimmer::SkimmerType_t & failed);
+
+	/**
+	 * @brief Drop the cached partitions, moving to a new availability epoch
+	 */
+	void NextEpoch() const noexcept;
+
 };
 
 }
@@ -1034,6 +1034,8 @@ typedef struct RTLIB_Config {
 		struct {
 			bool enabled = false;
 			int  level   = 0;
+			// Profile 1 command every 'sampling'
+			int  sampling = 1;
 		} opencl;
 
 	} profile;
@@ -30,12 +30,15 @@
 #include "bbque/rtlib/bbque_rpc.h"
 
 #define EVENT_RC_CONTROL(ev) \
-	cl_event local_event; \
+	cl_event local_event = NULL; \
 	if (ev == NULL) ev = &local_event;
 
 #define OCL_PROF_OUTDIR BBQUE_PATH_TEMP
 #define OCL_PROF_FMT    "%s/profOCL-%s-AWM%d-%s.dat"
 
+/** Maximum period of the profiling statistics update [ms] */
+#define BBQUE_OCL_PROF_PERIOD_MS 100
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -301,8 +304,7 @@ struct RTLIB_OpenCL {
 
 using bbque::rtlib::BbqueRPC;
 
-void acc_command_event_info(QueueProfPtr_t, cl_event, cl_command_type &, void *,
-							int8_t, int);
+void acc_command_event_info(QueueProfPtr_t, RTLIB_OCL_EventRecord const &, int);
 void acc_command_stats(QueueProfPtr_t, cl_command_type, double, double, double);
 void acc_address_stats(QueueProfPtr_t, void *, double, double, double);
 void dump_command_prof_info(int8_t, cl_command_type, double, double, double,
@@ -311,11 +313,46 @@ void dump_command_prof_info(int8_t, cl_command_type, double, double, double,
 void rtlib_ocl_init();
 void rtlib_init_devices();
 void rtlib_ocl_set_device(uint8_t device_id, RTLIB_ExitCode_t status);
-void rtlib_ocl_flush_events();
-void rtlib_ocl_coll_event(cl_command_queue, cl_event *, void *);
-void rtlib_ocl_prof_save(cl_command_queue, OclEventsStatsMap_t &);
-void rtlib_ocl_prof_clean();
+
+/**
+ * @brief Enable the asynchronous profiling of the OpenCL commands
+ *
+ * @param level The profiling level (> 0 for per-address statistics)
+ * @param sampling Profile 1 command every 'sampling' of each queue
+ */
+void rtlib_ocl_prof_enable(int level, int sampling);
+
+/**
+ * @brief Track the completion of an enqueued command
+ *
+ * @param owned The event has not been requested by the application, and
+ * thus it must be released by the RTLib
+ */
+void rtlib_ocl_coll_event(cl_command_queue, cl_event *, void *, bool owned);
+
+/**
+ * @brief Discard the commands enqueued since the last cycle, e.g. during the
+ * configuration, and account the next ones to the given AWM
+ */
+void rtlib_ocl_prof_clean(int8_t awm_id);
+
+/**
+ * @brief Cycle boundary: account the next commands to the given AWM, and
+ * get the statistics of the AWM if a new copy has been published.
+ * This does not block.
+ */
 void rtlib_ocl_prof_run(int8_t, OclEventsStatsMap_t &, int);
+
+/**
+ * @brief Wait for the commands in flight and account all of them
+ */
+void rtlib_ocl_flush_events();
+
+/**
+ * @brief Get the statistics of an AWM, waiting for a concurrent update
+ */
+void rtlib_ocl_prof_get(int8_t, OclEventsStatsMap_t &);
+
 cl_command_type rtlib_ocl_get_command_type(void *);
 
 /******************************************************************************
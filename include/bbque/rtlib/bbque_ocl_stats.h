@@ -19,6 +19,7 @@
 #define BBQUE_OCL_STATS_H_
 
 #include <array>
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -27,6 +28,8 @@
 
 #include <CL/cl.h>
 
+#include "bbque/config.h"
+
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/sum.hpp>
@@ -39,17 +42,18 @@
 namespace bac = boost::accumulators;
 
 typedef class RTLIB_OCL_QueueProf RTLIB_OCL_QueueProf_t;
+typedef class RTLIB_OCL_QueueEvents RTLIB_OCL_QueueEvents_t;
 typedef std::array<bac::accumulator_set<double,
 		bac::stats<bac::tag::sum, bac::tag::min, bac::tag::max,
 		bac::tag::variance, bac::tag::mean>>, 3> AccArray_t;
 typedef std::map<cl_command_type, AccArray_t> CmdProf_t;
 typedef std::shared_ptr<RTLIB_OCL_QueueProf_t> QueueProfPtr_t;
 typedef std::shared_ptr<CmdProf_t> CmdProfPtr_t;
+typedef std::shared_ptr<RTLIB_OCL_QueueEvents_t> QueueEventsPtr_t;
 typedef std::map<cl_command_queue, QueueProfPtr_t> OclEventsStatsMap_t;
 typedef std::pair<cl_command_type, std::string> CmdStrPair_t;
 typedef std::pair<cl_command_queue, QueueProfPtr_t> QueueProfPair_t;
 typedef std::pair<cl_command_type, AccArray_t> CmdProfPair_t;
-typedef std::pair<void *, cl_event> AddrEventPair_t;
 typedef std::pair<void *, AccArray_t> AddrProfPair_t;
 
 extern std::map<cl_command_type, std::string> ocl_cmd_str;
@@ -102,25 +106,79 @@ static const cl_command_type memory_trans_cmds[] = {
 class RTLIB_OCL_QueueProf
 {
 public:
-	~RTLIB_OCL_QueueProf()
-	{
-		std::map<void *, cl_event>::iterator it_ev;
-		cl_uint ref_count;
-
-		for (it_ev = events.begin(); it_ev != events.end(); it_ev++) {
-			clGetEventInfo(it_ev->second, CL_EVENT_REFERENCE_COUNT, sizeof(cl_uint),
-						   &ref_count, NULL);
+	std::map<void *, AccArray_t> addr_prof;
+	std::map<cl_command_type, AccArray_t> cmd_prof;
+};
 
-			if (ref_count > 0)
-				clReleaseEvent(it_ev->second);
-		}
 
-		cmd_prof.clear();
+/**
+ * @struct RTLIB_OCL_EventRecord
+ *
+ * @brief The profiling record of an OpenCL command
+ *
+ * The record is reserved by an application thread when the command is
+ * enqueued, filled by the event completion callback (on a thread of the
+ * OpenCL runtime) and then folded into the statistics by the profiling
+ * thread. The state hands the record over from one to the next.
+ */
+struct RTLIB_OCL_EventRecord
+{
+	enum State : uint8_t {
+		FREE = 0,
+		PENDING,
+		DONE
 	};
 
-	std::map<void *, cl_event> events;
-	std::map<void *, AccArray_t> addr_prof;
-	std::map<cl_command_type, AccArray_t> cmd_prof;
+	std::atomic<uint8_t> state{FREE};
+
+	/** Profiling session of the enqueue */
+	uint32_t session;
+	/** The AWM the command has been enqueued in */
+	int8_t awm_id;
+	/** The code address of the command */
+	void * addr;
+
+	/** Command execution status (CL_COMPLETE or error) */
+	cl_int status;
+	cl_command_type cmd_type;
+	cl_ulong queued;
+	cl_ulong submit;
+	cl_ulong start;
+	cl_ulong end;
+};
+
+/**
+ * @class RTLIB_OCL_QueueEvents
+ *
+ * @brief The preallocated table of profiling records of a command queue
+ *
+ * The records are used as a ring: the application threads reserve them at
+ * the head, the profiling thread releases them from the tail, in enqueue
+ * order. If the table is full, the command is not profiled.
+ */
+class RTLIB_OCL_QueueEvents
+{
+public:
+	RTLIB_OCL_QueueEvents(cl_command_queue cq):
+		cmd_queue(cq),
+		records(BBQUE_OCL_PROF_RECORDS) {
+	}
+
+	cl_command_queue cmd_queue;
+
+	std::vector<RTLIB_OCL_EventRecord> records;
+
+	/** Next record to reserve (application threads) */
+	std::atomic<uint32_t> head{0};
+
+	/** Next record to fold (profiling thread) */
+	std::atomic<uint32_t> tail{0};
+
+	/** Commands enqueued, for the 1-in-N sampling */
+	std::atomic<uint32_t> nr_commands{0};
+
+	/** Commands not profiled, since the table was full */
+	std::atomic<uint32_t> nr_dropped{0};
 };
 
 #endif // BBQUE_OCL_STATS_H_
@@ -35,6 +35,10 @@
 # include "bbque/utils/perf.h"
 #endif
 
+#ifdef CONFIG_BBQUE_CGROUPS_DISTRIBUTED_ACTUATION
+#include "bbque/utils/cgroups.h"
+#endif
+
 #ifdef CONFIG_BBQUE_OPENCL
 #include "bbque/rtlib/bbque_ocl_stats.h"
 #endif
@@ -440,6 +444,12 @@ protected:
 		accumulator_set<double,
 						stats<tag::min, tag::max, tag::variance>> monitor_samples;
 
+		/** Streaming quantiles (p50, p95, p99) of the AWM cycle times */
+		bu::QuantileStats cycle_quantiles;
+
+		/** Streaming quantiles (p50, p95, p99) of the onRun times */
+		bu::QuantileStats run_quantiles;
+
 #ifdef CONFIG_BBQUE_RTLIB_PERF_SUPPORT
 		/** Map of registered Perf counters */
 		PerfEventStatsMap_t events_map;
@@ -564,6 +574,10 @@ protected:
 		    std::string cpuset_mems;
                     std::vector<int32_t> cpu_affinity_mask;
 		} cg_current_allocation;
+		/** The CGroup setup last written */
+		bu::CGroups::CGSetup cg_committed;
+		/** The EXC has been moved into its CGroup */
+		bool cg_attached = false;
 #endif
 		struct RT_Profile {
 		    float cpu_goal_gap = 0.0f;
@@ -571,6 +585,7 @@ protected:
 		} runtime_profiling;
 
 		double mon_tstart = 0; // [ms] at the last monitoring start time
+		double run_tstart = 0; // [ms] at the last onRun start time
 
 		/** CPS performance monitoring/control */
 		// [ms] at the last cycle start time
@@ -777,7 +792,7 @@ protected:
 	 ******************************************************************************/
 #ifdef CONFIG_BBQUE_OPENCL
 	void OclSetDevice(uint8_t device_id, RTLIB_ExitCode_t status);
-	void OclClearStats();
+	void OclClearStats(int8_t current_awm_id);
 	void OclCollectStats(
 		int8_t current_awm_id, OclEventsStatsMap_t & ocl_events_map);
 	void OclPrintCmdStats(QueueProfPtr_t, cl_command_queue);
@@ -941,6 +956,16 @@ protected:
 	 */
 	char channel_thread_unique_id[20] = "00000:undef";
 
+	/**
+	 * @brief Get the cycle and onRun times quantiles of the current AWM
+	 *
+	 * This is used by the communication channels to fill the runtime
+	 * profile messages sent to the BarbequeRTRM.
+	 */
+	void GetQuantileStats(pRegisteredEXC_t exc,
+		rpc_msg_quantiles_t & ctime_q,
+		rpc_msg_quantiles_t & rtime_q);
+
 	inline void SetChannelThreadID(pid_t id, const char * name)
 	{
 		channel_thread_pid = id;
@@ -1010,6 +1035,12 @@ private:
 	 */
 	RTLIB_ExitCode_t UpdateMonitorStatistics(pRegisteredEXC_t exc);
 
+	/**
+	 * @brief Update statistics about onRun execution for the currently
+	 * selected awm
+	 */
+	void UpdateRunStatistics(pRegisteredEXC_t exc);
+
 	/**
 	 * @brief Log the header for statistics collection
 	 */
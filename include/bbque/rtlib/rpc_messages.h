@@ -180,6 +180,17 @@ typedef struct rpc_msg_EXC_CLEAR {
 	rpc_msg_header_t hdr;
 } rpc_msg_EXC_CLEAR_t;
 
+/**
+ * @brief Streaming estimation of the quantiles of a time distribution
+ *
+ * All the values are expressed in microseconds.
+ */
+typedef struct rpc_msg_quantiles {
+	uint32_t p50_us;
+	uint32_t p95_us;
+	uint32_t p99_us;
+} rpc_msg_quantiles_t;
+
 /**
  * @brief Command to set a Goal-Gap on an execution context.
  */
@@ -190,6 +201,10 @@ typedef struct rpc_msg_EXC_RTNOTIFY {
 	int gap;
 	int cusage;
 	int ctime_ms;
+	/** Cycle time quantiles of the current AWM */
+	rpc_msg_quantiles_t ctime_q;
+	/** onRun execution time quantiles of the current AWM */
+	rpc_msg_quantiles_t rtime_q;
 } rpc_msg_EXC_RTNOTIFY_t;
 
 /**
@@ -397,6 +412,10 @@ typedef struct rpc_msg_BBQ_GET_PROFILE_RESP {
 	uint32_t exec_time;
 	/** Data transfer overhead */
 	uint32_t mem_time;
+	/** Cycle time quantiles of the current AWM */
+	rpc_msg_quantiles_t ctime_q;
+	/** onRun execution time quantiles of the current AWM */
+	rpc_msg_quantiles_t rtime_q;
 } rpc_msg_BBQ_GET_PROFILE_RESP_t;
 
 
@@ -107,6 +107,13 @@ public:
 		return sched_count;
 	}
 
+	/**
+	 * @brief Name of the optimization policy in use
+	 */
+	inline const char * GetPolicyName() const {
+		return (policy != nullptr) ? policy->Name() : "none";
+	}
+
 	/**
 	 * @brief Wait for the end of the scheduling policy execution
 	 */
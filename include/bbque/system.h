@@ -316,6 +316,47 @@ public:
 	}
 
 
+#ifdef CONFIG_BBQUE_CONTENTION_MONITOR
+
+	/**
+	 * @brief Memory/cache contention information of a set of resources
+	 *
+	 * @param rsrc_list The list of resources (e.g., the processing elements
+	 * of a CPU)
+	 * @param i_type The contention information required (IPC, LLC_MPKI,...)
+	 * @param v_type Instantaneous or mean value
+	 *
+	 * @return The average value over the monitored resources of the list
+	 */
+	inline double ResourceContention(br::ResourcePtrList_t const & rsrc_list,
+			br::Resource::ContentionInfoType i_type,
+			br::Resource::ValueType v_type = br::Resource::MEAN) const {
+		double sum = 0.0;
+		uint16_t count = 0;
+		for (auto const & rsrc: rsrc_list) {
+			if (!rsrc->IsContentionProfileEnabled())
+				continue;
+			sum += rsrc->GetContentionInfo(i_type, v_type);
+			++count;
+		}
+		return (count > 0) ? (sum / count) : 0.0;
+	}
+
+	inline double ResourceContention(std::string const & path,
+			br::Resource::ContentionInfoType i_type,
+			br::Resource::ValueType v_type = br::Resource::MEAN) const {
+		return ResourceContention(ra.GetResources(path), i_type, v_type);
+	}
+
+	inline double ResourceContention(ResourcePathPtr_t ppath,
+			br::Resource::ContentionInfoType i_type,
+			br::Resource::ValueType v_type = br::Resource::MEAN) const {
+		return ResourceContention(ra.GetResources(ppath), i_type, v_type);
+	}
+
+#endif // CONFIG_BBQUE_CONTENTION_MONITOR
+
+
 	/**
 	 * @see ResourceAccounterConfIF::GetView()
 	 */
@@ -110,6 +110,37 @@ public:
 		int pid);
 	static CGResult Delete(const char *cgpath);
 
+	/**
+	 * @brief Update a CGroup, writing only the attributes changed
+	 *
+	 * The new setup is compared with the last one written, with no
+	 * read-back of the current values, and the attributes changed are
+	 * written directly on the cgroup filesystem. Empty values are not
+	 * written.
+	 *
+	 * @param cgpath The CGroup path
+	 * @param cgroup_data The new setup
+	 * @param cgroup_cache The setup last written, updated on success
+	 * @param nr_writes If not null, set to the number of attributes
+	 * written
+	 */
+	static CGResult WriteCgroupDiff(
+		const char *cgpath,
+		const CGSetup &cgroup_data,
+		CGSetup &cgroup_cache,
+		uint8_t *nr_writes = nullptr);
+
+	/**
+	 * @brief Move a task into a CGroup, on each hierarchy mounted
+	 */
+	static CGResult AttachTask(const char *cgpath, int pid);
+
+	/**
+	 * @brief Set the mount point of a controller, overriding the one
+	 * found at initialization (e.g., a fake cgroup filesystem for testing)
+	 */
+	static void SetMountPoint(CGC id, const char *mount_point);
+
 private:
 
 	// This class has just static methods
@@ -124,6 +155,15 @@ private:
 
 	static char *mounts[];
 
+	/**
+	 * @brief Write an attribute on the cgroup filesystem
+	 */
+	static CGResult WriteAttribute(
+		CGC id,
+		const char *cgpath,
+		const char *attribute,
+		std::string const &value);
+
 };
 
 } // namespace utils
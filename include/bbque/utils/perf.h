@@ -26,6 +26,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "bbque/utils/utility.h"
 
@@ -36,6 +37,9 @@
 #define PERF_HC(COUNTER) \
 	PERF_TYPE_HW_CACHE, COUNTER
 
+/** Maximum number of counters in a group (0 for no limit) */
+#define BBQUE_PERF_GROUP_SIZE_MAX 4
+
 #define PERF_COLOR_NORMAL   ""
 #define PERF_COLOR_RESET    "\033[m"
 #define PERF_COLOR_BOLD     "\033[1m"
@@ -129,8 +133,15 @@ public:
 
 	/**
 	 * @brief Build a new Perf object
+	 *
+	 * @param cpu If not negative, the counters are opened in system-wide
+	 * mode on the specified CPU (i.e. they count all the tasks running on
+	 * it), otherwise they track the calling thread only
+	 * @param grouped If true, the counters are opened in groups (of at most
+	 * BBQUE_PERF_GROUP_SIZE_MAX counters) sharing a leader, so that each
+	 * group is enabled, disabled and read with a single system call
 	 */
-	Perf();
+	Perf(int cpu = -1, bool grouped = true);
 
 	/**
 	 * @brief Release all counters
@@ -144,7 +155,8 @@ public:
 	 * on a group will be co-scheduled, if possible, otherwise none of them
 	 * will count.
 	 * The first added counter is the "group leader" of the successive added
-	 * counter.
+	 * counter. If the kernel does not support a group, the counter is
+	 * opened as a standalone one.
 	 * Once a counter has been added, an index is reqiured which could be used
 	 * by the following read methods to get back the counter values and other
 	 * attributed, e.g. enabled and running time.
@@ -225,6 +237,17 @@ public:
 	 */
 	uint64_t Update(int id, bool delta = true);
 
+	/**
+	 * @brief Update all the performance counters
+	 *
+	 * Each group of counters is read with a single system call. The
+	 * updated values can then be retrieved by @see Read, @see Enabled and
+	 * @see Running.
+	 *
+	 * @return the number of read system calls performed, -1 on error
+	 */
+	int UpdateAll();
+
 	/**
 	 * @brief Read the performance counter value
 	 */
@@ -257,6 +280,16 @@ private:
 	 */
 	int fd_group = 0;
 
+	/**
+	 * @brief The CPU monitored by system-wide counters (-1 for per-thread)
+	 */
+	int cpu_id;
+
+	/**
+	 * @brief True if the counters are opened in groups
+	 */
+	bool grouped;
+
 	/**
 	 * @brief The format of bytes readed from kernel space
 	 */
@@ -276,6 +309,8 @@ private:
 		pid_t pid = -1;
 		/** The attributed of this counter */
 		struct perf_event_attr attr;
+		/** The FD of the group leader (-1 for standalone counters) */
+		int leader = -1;
 
 		/** Counters values as of last last update */
 		ReadFormat_t count;
@@ -326,6 +361,22 @@ private:
 	 */
 	pRegisteredCounter_t pGroupLeader;
 
+	/**
+	 * @brief The counters of each group (in opening order), by leader FD
+	 */
+	std::map<int, std::vector<pRegisteredCounter_t>> groups;
+
+	/**
+	 * @brief The leader of the group new counters are added to
+	 */
+	int last_leader = -1;
+
+	/**
+	 * @brief Buffer for the group reads: number of counters, time
+	 * enabled, time running, and the value of each counter
+	 */
+	std::vector<uint64_t> group_buf;
+
 	/**
 	 * @brief Return the number of registered counters
 	 */
@@ -354,7 +405,28 @@ private:
 	 */
 	int EventOpen(struct perf_event_attr *attr,
 			pid_t pid, int cpu, int group_fd,
-			unsigned long flags);
+			unsigned long flags, bool quiet = false);
+
+	/**
+	 * @brief Open a counter, trying to add it to the current group
+	 *
+	 * @return the counter FD, -1 on error
+	 */
+	int OpenCounter(pRegisteredCounter_t prc);
+
+	/**
+	 * @brief Read all the counters of a group with a single system call
+	 *
+	 * @return the number of bytes read, -1 on error
+	 */
+	int ReadGroup(int leader);
+
+	/**
+	 * @brief Read a standalone counter
+	 *
+	 * @return the number of bytes read, -1 on error
+	 */
+	int ReadSingle(pRegisteredCounter_t prc);
 
 	/**
 	 * @brief Ensure a proper reading of a counter from kernel space
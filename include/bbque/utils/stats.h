@@ -18,6 +18,7 @@
 #ifndef BBQUE_UTILS_STATS_H_
 #define BBQUE_UTILS_STATS_H_
 
+#include <algorithm>
 #include <memory>
 #include <cmath>
 #include <list>
@@ -194,6 +195,176 @@ public:
 
 };
 
+/**
+ * @class P2Quantile
+ * @brief Streaming quantile estimator
+ *
+ * This class implements the P-square algorithm (R. Jain and I. Chlamtac,
+ * "The P2 algorithm for dynamic calculation of quantiles and histograms
+ * without storing observations", CACM 1985), which estimates a given
+ * quantile of a distribution on-line, by keeping only five markers, i.e.
+ * with a fixed amount of memory and a constant update cost.
+ */
+class P2Quantile {
+
+private:
+
+	// The quantile to estimate, in the range (0, 1)
+	double p;
+
+	// Markers heights
+	double q[5];
+
+	// Markers actual positions
+	double n[5];
+
+	// Markers desired positions and their increments
+	double np[5];
+	double dn[5];
+
+	// Number of observations
+	uint32_t count = 0;
+
+	double Parabolic(int i, int d) const {
+		return q[i] + d / (n[i+1] - n[i-1]) * (
+			(n[i] - n[i-1] + d) * (q[i+1] - q[i]) / (n[i+1] - n[i]) +
+			(n[i+1] - n[i] - d) * (q[i] - q[i-1]) / (n[i] - n[i-1]));
+	}
+
+	double Linear(int i, int d) const {
+		return q[i] + d * (q[i+d] - q[i]) / (n[i+d] - n[i]);
+	}
+
+public:
+
+	P2Quantile(double _p = 0.5) :
+		p(_p) {
+		Reset();
+	}
+
+	// Clear all the observations
+	void Reset() {
+		count = 0;
+		for (int i = 0; i < 5; ++i) {
+			q[i] = 0.0;
+			n[i] = i + 1;
+		}
+		np[0] = 1;   np[1] = 1 + 2 * p; np[2] = 1 + 4 * p;
+		np[3] = 3 + 2 * p; np[4] = 5;
+		dn[0] = 0;   dn[1] = p / 2;     dn[2] = p;
+		dn[3] = (1 + p) / 2; dn[4] = 1;
+	}
+
+	// Store a new observation
+	void InsertValue(double value) {
+		// Initialization: the first five observations are the markers
+		if (count < 5) {
+			q[count++] = value;
+			if (count == 5)
+				std::sort(q, q + 5);
+			return;
+		}
+		++count;
+
+		// Find the cell k such that q[k] <= value < q[k+1]
+		int k;
+		if (value < q[0]) {
+			q[0] = value;
+			k = 0;
+		}
+		else if (value >= q[4]) {
+			q[4] = value;
+			k = 3;
+		}
+		else {
+			for (k = 0; value >= q[k+1]; ++k);
+		}
+
+		// Update the markers positions
+		for (int i = k + 1; i < 5; ++i)
+			n[i] += 1;
+		for (int i = 0; i < 5; ++i)
+			np[i] += dn[i];
+
+		// Adjust the heights of the central markers, if required
+		for (int i = 1; i < 4; ++i) {
+			double d = np[i] - n[i];
+			if ((d >=  1 && (n[i+1] - n[i]) >  1) ||
+				(d <= -1 && (n[i-1] - n[i]) < -1)) {
+				int ds = (d >= 0) ? 1 : -1;
+				double qp = Parabolic(i, ds);
+				if (q[i-1] < qp && qp < q[i+1])
+					q[i] = qp;
+				else
+					q[i] = Linear(i, ds);
+				n[i] += ds;
+			}
+		}
+	}
+
+	// The current estimation of the quantile
+	double Get() const {
+		if (count == 0)
+			return 0.0;
+		if (count >= 5)
+			return q[2];
+		// Not enough observations: exact quantile of the samples
+		double v[5];
+		std::copy(q, q + count, v);
+		std::sort(v, v + count);
+		return v[static_cast<uint32_t>(std::round(p * (count - 1)))];
+	}
+
+	inline uint32_t GetCount() const {
+		return count;
+	}
+
+};
+
+/**
+ * @class QuantileStats
+ * @brief Median and tail (95th, 99th percentile) streaming estimation
+ */
+class QuantileStats {
+
+private:
+
+	P2Quantile p50 = P2Quantile(0.50);
+	P2Quantile p95 = P2Quantile(0.95);
+	P2Quantile p99 = P2Quantile(0.99);
+
+public:
+
+	void InsertValue(double value) {
+		p50.InsertValue(value);
+		p95.InsertValue(value);
+		p99.InsertValue(value);
+	}
+
+	inline void Reset() {
+		p50.Reset();
+		p95.Reset();
+		p99.Reset();
+	}
+
+	inline double GetP50() const {
+		return p50.Get();
+	}
+
+	inline double GetP95() const {
+		return p95.Get();
+	}
+
+	inline double GetP99() const {
+		return p99.Get();
+	}
+
+	inline uint32_t GetCount() const {
+		return p50.GetCount();
+	}
+
+};
+
 /**
  * @brief A pointer to an EMA-defined accounter
  */
@@ -36,6 +36,7 @@
 #include "bbque/config.h"
 #include "bbque/bbque_exc.h"
 #include "bbque/utils/timer.h"
+#include "pmsl/task_executor.h"
 #include "tg/task_graph.h"
 
 #define BBQUE_TASKS_MAX_NUM BBQUE_APP_TG_TASKS_MAX_NUM
@@ -112,6 +113,24 @@ public:
 		return task_graph;
 	}
 
+	/**
+	 * \brief Set the body of a task
+	 *
+	 * If all the tasks of the task-graph have a body, the library runs
+	 * them at each cycle, on a pool of worker threads (one per assigned
+	 * CPU), according to the dependencies expressed by the buffers.
+	 * Otherwise, the tasks execution is left to the programming model,
+	 * which notifies the events.
+	 *
+	 * \param task_id The task identification number
+	 * \param fn The task body
+	 * \return SUCCESS for success. ERR_TASK_ID in case of wrong
+	 * task identification number. ERR_TASK_GRAPH_NOT_VALID in case
+	 * of bad formed task-graph
+	 */
+	ExitCode SetTaskFunction(
+		uint32_t task_id, TaskExecutor::TaskFunction_t fn) noexcept;
+
 	/**
 	 * \brief Notify the launch of a task
 	 * \param task_id The task identification number
@@ -208,7 +227,8 @@ protected:
 
 	struct RuntimeInfo {
 		std::atomic<bool> is_running;
-		std::thread  monitor_thr;
+		/** Time of the last completion of the task [us] */
+		double t_last = 0;
 		TaskProfiling ctime;
 		TaskProfiling throughput;
 
@@ -231,6 +251,15 @@ protected:
 
 	std::map<uint32_t, std::shared_ptr<EventSync>> events;
 
+	/** The tasks whose completion is signaled by each event */
+	std::map<uint32_t, std::list<uint32_t>> event_tasks;
+
+	/** The task bodies, if the tasks are run by the library */
+	std::map<uint32_t, TaskExecutor::TaskFunction_t> task_functions;
+
+	/** The executor of the tasks, if run by the library */
+	std::unique_ptr<TaskExecutor> executor;
+
 
 	/**
 	 * \struct tasks
@@ -284,10 +313,24 @@ protected:
 	void NotifyResourceAllocation() noexcept;
 
 	/**
-	 * \brief Perform the task profiling
-	 * \param task_id The task identification number
+	 * \brief Update the timing of the tasks whose completion is signaled
+	 * by an event
+	 *
+	 * To call with the event lock held.
+	 * \param event_id The event identification number
+	 */
+	void ProfileEvent(uint32_t event_id) noexcept;
+
+	/**
+	 * \brief Setup the executor running the task bodies, according to
+	 * the buffer dependencies of the task-graph
+	 *
+	 * The executor is built once. Then, only the number of worker threads
+	 * follows the CPU set assigned.
+	 *
+	 * \return false if some task has no body
 	 */
-	void TaskProfiler(uint32_t task_id) noexcept;
+	bool SetupTaskExecutor();
 
 	/**
 	 * \brief Send a notification to all the events associated to the buffers
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_TASK_EXECUTOR_H_
+#define BBQUE_TASK_EXECUTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace bbque {
+
+/**
+ * \class TaskExecutor
+ *
+ * \brief Dataflow execution of a graph of tasks on a fixed pool of worker
+ * threads
+ *
+ * Each task has a counter of the predecessors still to complete (in-degree),
+ * atomically decremented by the worker completing a predecessor. The worker
+ * that brings the counter to zero schedules the successor: the first one is
+ * run directly by the same worker, the others are pushed into the shared
+ * ready queue. Therefore no thread is bound to a task, and idle workers only
+ * wait on the ready queue.
+ */
+class TaskExecutor {
+
+public:
+
+	/** The body of a task */
+	using TaskFunction_t = std::function<void()>;
+
+	/** Called at each task completion, with the task execution time */
+	using CompletionCallback_t =
+		std::function<void(uint32_t task_id, double exec_time_us)>;
+
+	/** The tasks failed in the last run, with the error message */
+	using FailureList_t = std::vector<std::pair<uint32_t, std::string>>;
+
+	/**
+	 * \brief Constructor
+	 * \param nr_workers Number of worker threads. If 0, one per CPU of
+	 * the calling thread affinity mask (i.e. the assigned CPU set)
+	 */
+	TaskExecutor(uint16_t nr_workers = 0);
+
+	/**
+	 * \brief Destructor: terminates and joins the worker threads
+	 */
+	~TaskExecutor();
+
+	/**
+	 * \brief Add a task
+	 * \param task_id The task identification number
+	 * \param fn The task body
+	 */
+	void AddTask(uint32_t task_id, TaskFunction_t fn);
+
+	/**
+	 * \brief Add a dependency between two tasks
+	 * \param from_id The predecessor task
+	 * \param to_id The successor task
+	 * \return false if one of the tasks has not been added
+	 */
+	bool AddDependency(uint32_t from_id, uint32_t to_id);
+
+	/**
+	 * \brief Set the function called at each task completion
+	 */
+	inline void SetCompletionCallback(CompletionCallback_t cb) {
+		on_completion = cb;
+	}
+
+	/**
+	 * \brief Execute all the tasks once, according to the dependencies
+	 *
+	 * A task throwing an exception still releases its successors, so
+	 * that the run always completes.
+	 *
+	 * \return false if the graph is empty or contains cycles, or some task
+	 * failed (see Failures()), true after all the tasks have been completed
+	 */
+	bool Run();
+
+	/**
+	 * \brief The tasks failed in the last run
+	 */
+	inline FailureList_t const & Failures() const {
+		return failures;
+	}
+
+	/**
+	 * \brief Change the number of worker threads
+	 *
+	 * Not to call while running. Nothing happens if the number does not
+	 * change.
+	 *
+	 * \param nr_workers Number of worker threads. If 0, one per CPU of
+	 * the calling thread affinity mask
+	 */
+	void Resize(uint16_t nr_workers = 0);
+
+	/**
+	 * \brief The number of worker threads
+	 */
+	inline uint16_t WorkersCount() const {
+		return workers.size();
+	}
+
+	/**
+	 * \brief The number of CPUs in the affinity mask of the calling thread
+	 */
+	static uint16_t AvailableCPUs();
+
+private:
+
+	/**
+	 * \struct TaskNode
+	 * \brief A task and its dependencies
+	 */
+	struct TaskNode {
+		uint32_t id;
+		TaskFunction_t fn;
+		std::vector<TaskNode *> successors;
+		uint32_t nr_predecessors = 0;
+		/** Predecessors not completed yet in the current run */
+		std::atomic<uint32_t> pending;
+
+		TaskNode(uint32_t _id, TaskFunction_t _fn):
+			id(_id), fn(_fn), pending(0) {}
+	};
+
+	std::map<uint32_t, std::unique_ptr<TaskNode>> nodes;
+
+	/** Tasks without predecessors */
+	std::vector<TaskNode *> sources;
+
+	/** True if the graph must be checked before the next run */
+	bool graph_changed = true;
+
+	std::vector<std::thread> workers;
+
+	std::mutex queue_mtx;
+
+	std::condition_variable queue_cv;
+
+	std::deque<TaskNode *> ready_queue;
+
+	bool done = false;
+
+	/** Tasks not completed yet in the current run */
+	std::atomic<uint32_t> remaining;
+
+	std::mutex run_mtx;
+
+	std::condition_variable run_cv;
+
+	CompletionCallback_t on_completion;
+
+	/** Tasks failed in the current run */
+	FailureList_t failures;
+
+	std::mutex failures_mtx;
+
+	/**
+	 * \brief Collect the source tasks and check the graph is acyclic
+	 */
+	bool CheckGraph();
+
+	/**
+	 * \brief Start the worker threads
+	 */
+	void StartWorkers(uint16_t nr_workers);
+
+	/**
+	 * \brief Terminate and join the worker threads
+	 */
+	void StopWorkers();
+
+	/**
+	 * \brief Worker thread loop
+	 */
+	void WorkerLoop();
+
+	/**
+	 * \brief Execute a task
+	 * \return The first successor made ready by the task completion, to
+	 * run on the same worker (the others are queued)
+	 */
+	TaskNode * Execute(TaskNode * node);
+};
+
+} // namespace bbque
+
+#endif // BBQUE_TASK_EXECUTOR_H_
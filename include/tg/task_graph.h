@@ -247,6 +247,16 @@ public:
 	 */
 	void Print() const noexcept;
 
+	/**
+	 * \brief Hash of the task-graph resource requirements
+	 *
+	 * It accounts for the features considered in the partitions search:
+	 * the tasks assigned processing architecture, threads, bandwidth and
+	 * binary size, and the size of the buffers.
+	 * \return The hash value
+	 */
+	std::size_t Hash() const noexcept;
+
 private:
 
 	/*** Application identification number (PID, or other) ***/
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Scheduling overhead of the TaskExecutor on synthetic DAGs
+ *
+ * The tasks are empty, so the time per task is the cost of releasing it
+ * when its predecessors complete. Three shapes of N tasks:
+ * - chain:     0 -> 1 -> ... -> N-1;
+ * - fork-join: 0 -> {1 .. N-2} -> N-1;
+ * - fan-out:   0 -> {1 .. N-1}.
+ *
+ * The baseline is the execution model the ExecutionSynchronizer had before
+ * the executor: one thread per task, blocking until its predecessors are
+ * done.
+ *
+ * Usage: bbque-pms-bench-executor [tasks] [workers]
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "pmsl/task_executor.h"
+
+using bbque::TaskExecutor;
+
+using Edges_t = std::vector<std::pair<uint32_t, uint32_t>>;
+
+using Clock = std::chrono::steady_clock;
+
+static double ThreadPerTask(uint32_t nr_tasks, Edges_t const & edges,
+		int iterations) {
+	std::vector<std::vector<uint32_t>> successors(nr_tasks);
+	for (auto const & e: edges)
+		successors[e.first].push_back(e.second);
+
+	auto start = Clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		std::vector<uint32_t> pending(nr_tasks, 0);
+		for (auto const & e: edges)
+			pending[e.second]++;
+
+		std::mutex deps_mtx;
+		std::condition_variable deps_cv;
+		std::vector<std::thread> threads;
+		for (uint32_t t = 0; t < nr_tasks; ++t) {
+			threads.emplace_back([&, t]() {
+				std::unique_lock<std::mutex> deps_ul(deps_mtx);
+				deps_cv.wait(deps_ul, [&]() { return pending[t] == 0; });
+				for (auto s: successors[t])
+					pending[s]--;
+				deps_cv.notify_all();
+			});
+		}
+		for (auto & thr: threads)
+			thr.join();
+	}
+
+	return std::chrono::duration<double, std::micro>(
+		Clock::now() - start).count() / (iterations * nr_tasks);
+}
+
+static double Pooled(uint32_t nr_tasks, Edges_t const & edges,
+		uint16_t nr_workers, int iterations) {
+	TaskExecutor executor(nr_workers);
+	for (uint32_t t = 0; t < nr_tasks; ++t)
+		executor.AddTask(t, []() {});
+	for (auto const & e: edges)
+		executor.AddDependency(e.first, e.second);
+
+	// Warm-up: start the workers
+	if (!executor.Run()) {
+		fprintf(stderr, "Task-graph execution failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	auto start = Clock::now();
+	for (int i = 0; i < iterations; ++i)
+		executor.Run();
+
+	return std::chrono::duration<double, std::micro>(
+		Clock::now() - start).count() / (iterations * nr_tasks);
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t nr_tasks  = (argc > 1) ? atoi(argv[1]) : 256;
+	uint16_t nr_workers = (argc > 2) ? atoi(argv[2]) : 4;
+
+	Edges_t chain, fork_join, fan_out;
+	for (uint32_t t = 0; t + 1 < nr_tasks; ++t)
+		chain.emplace_back(t, t + 1);
+	for (uint32_t t = 1; t + 1 < nr_tasks; ++t) {
+		fork_join.emplace_back(0, t);
+		fork_join.emplace_back(t, nr_tasks - 1);
+	}
+	for (uint32_t t = 1; t < nr_tasks; ++t)
+		fan_out.emplace_back(0, t);
+
+	printf("%u tasks, %u workers, %u CPUs available\n",
+		nr_tasks, nr_workers, TaskExecutor::AvailableCPUs());
+	printf("%-10s %20s %16s\n", "DAG", "thread/task [us]", "pooled [us]");
+	std::pair<char const *, Edges_t const *> dags[] = {
+		{ "chain", &chain },
+		{ "fork-join", &fork_join },
+		{ "fan-out", &fan_out } };
+	for (auto const & dag: dags)
+		printf("%-10s %20.2f %16.2f\n", dag.first,
+			ThreadPerTask(nr_tasks, *dag.second, 20),
+			Pooled(nr_tasks, *dag.second, nr_workers, 2000));
+
+	return EXIT_SUCCESS;
+}
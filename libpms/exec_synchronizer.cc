@@ -87,6 +87,23 @@ ExecutionSynchronizer::ExitCode ExecutionSynchronizer::SetTaskGraph(std::shared_
                 events.emplace(event->Id(), ev_sync);
 	}
 
+	// Task completion signaled by the event of the first output buffer
+	for (auto & t_entry: task_graph->Tasks()) {
+		auto & task(t_entry.second);
+		if (task->OutputBuffers().empty()) {
+			logger->Warn("SetTaskGraph: [Task %2d] missing output buffers",
+				task->Id());
+			continue;
+		}
+		auto buffer = task_graph->GetBuffer(task->OutputBuffers().front());
+		if (buffer == nullptr) {
+			logger->Warn("SetTaskGraph: [Task %2d] missing output buffer "
+				"descriptor", task->Id());
+			continue;
+		}
+		event_tasks[buffer->Event()].push_back(task->Id());
+	}
+
 	logger->Info("SetTaskGraph: task-graph successfully set");
 
 	return ExitCode::SUCCESS;
@@ -162,6 +179,23 @@ void ExecutionSynchronizer::RecvTaskGraphFromRM() {
 }
 
 
+ExecutionSynchronizer::ExitCode ExecutionSynchronizer::SetTaskFunction(
+		uint32_t task_id, TaskExecutor::TaskFunction_t fn) noexcept {
+	if (!CheckTaskGraph(task_graph))
+		return ExitCode::ERR_TASK_GRAPH_NOT_VALID;
+
+	if (task_graph->GetTask(task_id) == nullptr) {
+		logger->Error("SetTaskFunction: unknown task id: %d", task_id);
+		return ExitCode::ERR_TASK_ID;
+	}
+
+	std::unique_lock<std::mutex> tasks_lock(tasks.mx);
+	task_functions[task_id] = fn;
+	logger->Debug("SetTaskFunction: [Task %2d] body set", task_id);
+	return ExitCode::SUCCESS;
+}
+
+
 ExecutionSynchronizer::ExitCode ExecutionSynchronizer::StartTask(uint32_t task_id) noexcept {
 	if (!CheckTaskGraph(task_graph))
 		return ExitCode::ERR_TASK_GRAPH_NOT_VALID;
@@ -281,6 +315,10 @@ void ExecutionSynchronizer::NotifyEvent(uint32_t event_id) noexcept {
 	event->occurred = true;
 	event->cv.notify_all();
 	logger->Debug("[Event %2d] notified", event_id);
+
+	// Tasks run by the library are profiled by the executor
+	if (!executor)
+		ProfileEvent(event_id);
 }
 
 
@@ -300,53 +338,74 @@ void ExecutionSynchronizer::NotifyResourceAllocation() noexcept {
 	rtrm.cv.notify_all();
 }
 
-void ExecutionSynchronizer::TaskProfiler(uint32_t task_id) noexcept {
-
-	auto task = task_graph->GetTask(task_id);
-	if (task == nullptr) {
-		logger->Crit("[Task %2d] missing task descriptor", task_id);
+void ExecutionSynchronizer::ProfileEvent(uint32_t event_id) noexcept {
+	auto et_it = event_tasks.find(event_id);
+	if (et_it == event_tasks.end())
 		return;
+
+	// Synchronize the profiling timing according to the events (write)
+	// affecting the output buffer of the tasks
+	for (auto task_id: et_it->second) {
+		auto & rt_info(tasks.runtime[task_id]);
+		if (!rt_info->is_running)
+			continue;
+		auto & ctime(rt_info->ctime);
+		double t_finish = ctime.timer.getElapsedTimeUs();
+		double t_curr = t_finish - rt_info->t_last;
+		rt_info->t_last = t_finish;
+		ctime.acc(t_curr);
+		logger->Debug("[Task %d] timing current = %.2f us", task_id, t_curr);
 	}
+}
 
-	auto out_buffers = task->OutputBuffers();
-	if (out_buffers.empty()) {
-		logger->Error("[Task %2d] missing output buffers", task_id);
-		return;
+bool ExecutionSynchronizer::SetupTaskExecutor() {
+	// Already built: just follow the assigned CPU set
+	if (executor) {
+		uint16_t nr_workers = executor->WorkersCount();
+		executor->Resize();
+		if (executor->WorkersCount() != nr_workers)
+			logger->Info("SetupTaskExecutor: worker threads %d -> %d",
+				nr_workers, executor->WorkersCount());
+		return true;
 	}
 
-	// Pick the first output buffer of the task
-	auto buffer = task_graph->GetBuffer(out_buffers.front());
-	if (buffer == nullptr) {
-		logger->Error("[Task %2d] missing output buffer descriptor", task_id);
-		return;
+	if (task_functions.size() < task_graph->TaskCount())
+		return false;
+
+	executor.reset(new TaskExecutor());
+	for (auto & tf_entry: task_functions) {
+		auto & rt_info(tasks.runtime[tf_entry.first]);
+		auto & fn(tf_entry.second);
+		// Stopped tasks just release their successors
+		executor->AddTask(tf_entry.first, [rt_info, fn]() {
+			if (rt_info->is_running)
+				fn();
+		});
 	}
 
-	auto evit = events.find(buffer->Event());
-	if (evit == events.end()) {
-		logger->Error("[Task %2d] missing event(%d) associated to buffer %d",
-			task_id, buffer->Event(), buffer->Id());
-		return;
+	// Dependencies: the producers of the input buffers of each task
+	std::map<uint32_t, std::list<uint32_t>> producers;
+	for (auto & t_entry: task_graph->Tasks()) {
+		for (auto buffer_id: t_entry.second->OutputBuffers())
+			producers[buffer_id].push_back(t_entry.first);
+	}
+	for (auto & t_entry: task_graph->Tasks()) {
+		for (auto buffer_id: t_entry.second->InputBuffers()) {
+			for (auto producer_id: producers[buffer_id]) {
+				if (producer_id != t_entry.first)
+					executor->AddDependency(producer_id, t_entry.first);
+			}
+		}
 	}
 
-	auto & event(evit->second);
-	auto & ctime = tasks.runtime[task_id]->ctime;
-	ctime.timer.start();
-	double t_curr, t_start, t_finish;
+	// Per-task profiling, to feed the application controller
+	executor->SetCompletionCallback([this](uint32_t task_id, double exec_time_us) {
+		tasks.runtime.at(task_id)->ctime.acc(exec_time_us);
+	});
 
-	// Synchronize the profiling timing according to the events (write)
-	// affecting the output buffer of the task
-	logger->Info("[Task %2d] profiling started", task_id);
-	while (tasks.runtime[task_id]->is_running) {
-		std::unique_lock<std::mutex> ev_lock(event->mx);
-		t_start  = ctime.timer.getElapsedTimeUs();
-		event->cv.wait(ev_lock);
-		t_finish = ctime.timer.getElapsedTimeUs();
-		t_curr = t_finish - t_start;
-		ctime.acc(t_curr);
-		logger->Debug("[Task %d] timing current = %.2f us", task_id, t_curr);
-	}
-	ctime.timer.stop();
-	logger->Info("[Task %2d] profiling stopped", task_id);
+	logger->Info("SetupTaskExecutor: %d tasks on %d worker threads",
+		task_functions.size(), executor->WorkersCount());
+	return true;
 }
 
 // ---------------- BbqueEXC overloading ------------------------------------//
@@ -391,6 +450,9 @@ RTLIB_ExitCode_t ExecutionSynchronizer::onConfigure(int8_t awm_id) {
 	// TODO: reconfiguration management
 	if (Cycles() > 1) {
 		logger->Warn("onConfigure: Reconfiguration not supported yet");
+		// The CPU set assigned may have changed
+		if (executor)
+			SetupTaskExecutor();
 		return RTLIB_OK;
 	}
 
@@ -405,8 +467,9 @@ RTLIB_ExitCode_t ExecutionSynchronizer::onConfigure(int8_t awm_id) {
 	logger->Info("onConfigure: Tasks queue length: %d", tasks.start_queue.size());
 	while (!tasks.start_queue.empty()) {
 		auto task_id = tasks.start_queue.front();
-		tasks.runtime[task_id]->monitor_thr = std::move(
-			std::thread(&ExecutionSynchronizer::TaskProfiler, this, task_id));
+		auto & rt_info(tasks.runtime[task_id]);
+		rt_info->ctime.timer.start();
+		rt_info->t_last = 0;
 		tasks.start_queue.pop();
 		logger->Info("onConfigure: [Task %2d] started on processor %d", task_id,
 				task_graph->GetTask(task_id)->GetMappedProcessor());
@@ -414,6 +477,10 @@ RTLIB_ExitCode_t ExecutionSynchronizer::onConfigure(int8_t awm_id) {
 
 	logger->Info("onConfigure: All tasks have been launched");
 
+	// Tasks bodies available: the library runs the tasks
+	if (SetupTaskExecutor())
+		logger->Info("onConfigure: Tasks executed by the library");
+
 	return RTLIB_OK;
 }
 
@@ -427,6 +494,19 @@ RTLIB_ExitCode_t ExecutionSynchronizer::onRun() {
 		}
 	}
 
+	// Run all the tasks, according to the dependencies
+	if (executor) {
+		if (!executor->Run()) {
+			for (auto const & failure: executor->Failures())
+				logger->Error("onRun: [c=%02d] [Task %2d] failed: %s",
+					Cycles(), failure.first, failure.second.c_str());
+			logger->Error("onRun: [c=%02d] task-graph execution failed",
+				Cycles());
+			return RTLIB_ERROR;
+		}
+		return RTLIB_OK;
+	}
+
 	// Wait for synchronization event: task-graph output
 	std::unique_lock<std::mutex> run_lock(on_run_sync->mx);
 	while (!on_run_sync->occurred) {
@@ -477,10 +557,9 @@ RTLIB_ExitCode_t ExecutionSynchronizer::onRelease() {
 		NotifyEvent(ev_entry.first);
 	}
 
-	for (auto & rt_entry: tasks.runtime) {
-		auto & monitor(rt_entry.second->monitor_thr);
-		monitor.join();
-		logger->Info("onRelease: Monitoring thread joined");
+	if (executor) {
+		executor.reset();
+		logger->Info("onRelease: Worker threads joined");
 	}
 
 	PrintProfilingData();
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+#include <sched.h>
+
+#include "pmsl/task_executor.h"
+
+
+namespace bbque {
+
+TaskExecutor::TaskExecutor(uint16_t nr_workers):
+	remaining(0) {
+	StartWorkers(nr_workers);
+}
+
+
+TaskExecutor::~TaskExecutor() {
+	StopWorkers();
+}
+
+
+void TaskExecutor::StartWorkers(uint16_t nr_workers) {
+	if (nr_workers == 0)
+		nr_workers = AvailableCPUs();
+
+	done = false;
+	for (uint16_t i = 0; i < nr_workers; ++i)
+		workers.emplace_back(&TaskExecutor::WorkerLoop, this);
+}
+
+
+void TaskExecutor::StopWorkers() {
+	{
+		std::unique_lock<std::mutex> queue_lock(queue_mtx);
+		done = true;
+		queue_cv.notify_all();
+	}
+
+	for (auto & worker: workers)
+		worker.join();
+	workers.clear();
+}
+
+
+void TaskExecutor::Resize(uint16_t nr_workers) {
+	if (nr_workers == 0)
+		nr_workers = AvailableCPUs();
+	if (nr_workers == workers.size())
+		return;
+
+	// Between two runs the ready queue is empty: just restart the pool
+	StopWorkers();
+	StartWorkers(nr_workers);
+}
+
+
+uint16_t TaskExecutor::AvailableCPUs() {
+	cpu_set_t cpu_set;
+	CPU_ZERO(&cpu_set);
+	if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) != 0)
+		return std::max(1u, std::thread::hardware_concurrency());
+	return std::max(1, CPU_COUNT(&cpu_set));
+}
+
+
+void TaskExecutor::AddTask(uint32_t task_id, TaskFunction_t fn) {
+	nodes[task_id].reset(new TaskNode(task_id, fn));
+	graph_changed = true;
+}
+
+
+bool TaskExecutor::AddDependency(uint32_t from_id, uint32_t to_id) {
+	auto from_it = nodes.find(from_id);
+	auto to_it   = nodes.find(to_id);
+	if ((from_it == nodes.end()) || (to_it == nodes.end()))
+		return false;
+
+	auto & successors(from_it->second->successors);
+	TaskNode * to_node = to_it->second.get();
+	if (std::find(successors.begin(), successors.end(), to_node)
+			!= successors.end())
+		return true;
+
+	successors.push_back(to_node);
+	++to_node->nr_predecessors;
+	graph_changed = true;
+	return true;
+}
+
+
+bool TaskExecutor::CheckGraph() {
+	sources.clear();
+	for (auto & n_entry: nodes) {
+		if (n_entry.second->nr_predecessors == 0)
+			sources.push_back(n_entry.second.get());
+	}
+
+	// Kahn's visit: all the tasks must be reachable by the sources
+	std::map<TaskNode *, uint32_t> in_degree;
+	std::vector<TaskNode *> visit(sources);
+	size_t nr_visited = 0;
+	while (!visit.empty()) {
+		TaskNode * node = visit.back();
+		visit.pop_back();
+		++nr_visited;
+		for (auto succ: node->successors) {
+			if (++in_degree[succ] == succ->nr_predecessors)
+				visit.push_back(succ);
+		}
+	}
+
+	graph_changed = false;
+	return nr_visited == nodes.size();
+}
+
+
+bool TaskExecutor::Run() {
+	if (graph_changed && !CheckGraph())
+		return false;
+	if (sources.empty())
+		return false;
+
+	for (auto & n_entry: nodes) {
+		auto & node(n_entry.second);
+		node->pending.store(node->nr_predecessors, std::memory_order_relaxed);
+	}
+	remaining.store(nodes.size(), std::memory_order_release);
+	failures.clear();
+
+	{
+		std::unique_lock<std::mutex> queue_lock(queue_mtx);
+		ready_queue.insert(ready_queue.end(), sources.begin(), sources.end());
+		queue_cv.notify_all();
+	}
+
+	std::unique_lock<std::mutex> run_lock(run_mtx);
+	run_cv.wait(run_lock, [this]() {
+		return remaining.load(std::memory_order_acquire) == 0;
+	});
+
+	return failures.empty();
+}
+
+
+void TaskExecutor::WorkerLoop() {
+	while (true) {
+		TaskNode * node;
+		{
+			std::unique_lock<std::mutex> queue_lock(queue_mtx);
+			queue_cv.wait(queue_lock, [this]() {
+				return done || !ready_queue.empty();
+			});
+			if (done)
+				return;
+			node = ready_queue.front();
+			ready_queue.pop_front();
+		}
+
+		// Follow the chain of successors made ready by this worker
+		while (node != nullptr)
+			node = Execute(node);
+	}
+}
+
+
+TaskExecutor::TaskNode * TaskExecutor::Execute(TaskNode * node) {
+	auto t_start = std::chrono::steady_clock::now();
+	try {
+		if (node->fn)
+			node->fn();
+	}
+	// A failing task still releases its successors
+	catch (std::exception & ex) {
+		std::unique_lock<std::mutex> failures_lock(failures_mtx);
+		failures.emplace_back(node->id, ex.what());
+	}
+	catch (...) {
+		std::unique_lock<std::mutex> failures_lock(failures_mtx);
+		failures.emplace_back(node->id, "unknown exception");
+	}
+	auto t_finish = std::chrono::steady_clock::now();
+
+	if (on_completion) {
+		on_completion(node->id,
+			std::chrono::duration<double, std::micro>(
+				t_finish - t_start).count());
+	}
+
+	// Release the successors
+	TaskNode * next = nullptr;
+	std::vector<TaskNode *> ready;
+	for (auto succ: node->successors) {
+		if (succ->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			continue;
+		if (next == nullptr)
+			next = succ;
+		else
+			ready.push_back(succ);
+	}
+
+	if (!ready.empty()) {
+		std::unique_lock<std::mutex> queue_lock(queue_mtx);
+		ready_queue.insert(ready_queue.end(), ready.begin(), ready.end());
+		if (ready.size() == 1)
+			queue_cv.notify_one();
+		else
+			queue_cv.notify_all();
+	}
+
+	// Last task of the run
+	if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		std::unique_lock<std::mutex> run_lock(run_mtx);
+		run_cv.notify_all();
+	}
+
+	return next;
+}
+
+} // namespace bbque
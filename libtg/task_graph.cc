@@ -15,6 +15,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <functional>
 #include <iostream>
 #include "tg/task_graph.h"
 
@@ -143,4 +144,37 @@ TaskGraph::ExitCode TaskGraph::SetOutputBuffer(int32_t id) {
 }
 
 
+
+/*** Combine a value into a hash (boost::hash_combine like) ***/
+template <typename T>
+static inline void HashCombine(std::size_t & seed, T const & value) {
+	seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+std::size_t TaskGraph::Hash() const noexcept {
+	std::size_t seed = 0;
+	HashCombine(seed, application_id);
+
+	for (auto const & t_entry: tasks) {
+		auto const & t(t_entry.second);
+		HashCombine(seed, t->Id());
+		HashCombine(seed, static_cast<int>(t->GetAssignedArch()));
+		HashCombine(seed, t->GetThreadCount());
+		HashCombine(seed, t->GetAssignedBandwidth().in_kbps);
+		HashCombine(seed, t->GetAssignedBandwidth().out_kbps);
+		auto const & target(t->Targets().find(t->GetAssignedArch()));
+		if (target != t->Targets().end()) {
+			HashCombine(seed, target->second->BinarySize());
+			HashCombine(seed, target->second->StackSize());
+		}
+	}
+
+	for (auto const & b_entry: buffers) {
+		HashCombine(seed, b_entry.second->Id());
+		HashCombine(seed, b_entry.second->Size());
+	}
+
+	return seed;
+}
+
 } // namespace bbque
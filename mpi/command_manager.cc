@@ -23,8 +23,8 @@
 #include <iostream>
 
 // Network
+#include <poll.h>
 #include <sys/socket.h>
-#include <fcntl.h>
 
 // BBQ
 #include <bbque/utils/utility.h>
@@ -37,7 +37,61 @@ CommandsManager::CommandsManager(int socket, std::shared_ptr<res_list> avail_res
 }
 
 
+int CommandsManager::recv_msg(void *buf, size_t len, bool wait_first) noexcept {
+	size_t received = 0;
+
+	while (received < len) {
+		int bytes = recv(this->socket_client, (char *) buf + received,
+				len - received, 0);
+		if (bytes > 0) {
+			received += bytes;
+			continue;
+		}
+		if (bytes == 0)
+			return -1;	// Connection closed
+		if (errno == EINTR)
+			continue;
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+			return -1;
+
+		// No data yet: nothing to do, unless a message is incomplete
+		if (received == 0 && !wait_first)
+			return 0;
+		struct pollfd pfd = { this->socket_client, POLLIN, 0 };
+		if (::poll(&pfd, 1, MPIRUN_CMD_TIMEOUT_MS) <= 0)
+			return -1;
+	}
+
+	return received;
+}
+
+int CommandsManager::send_msg(const void *buf, size_t len) noexcept {
+	size_t sent = 0;
+
+	while (sent < len) {
+		int bytes = send(this->socket_client, (const char *) buf + sent,
+				len - sent, MSG_NOSIGNAL);
+		if (bytes >= 0) {
+			sent += bytes;
+			continue;
+		}
+		if (errno == EINTR)
+			continue;
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+			return -1;
+
+		// Socket buffer full
+		struct pollfd pfd = { this->socket_client, POLLOUT, 0 };
+		if (::poll(&pfd, 1, MPIRUN_CMD_TIMEOUT_MS) <= 0)
+			return -1;
+	}
+
+	return sent;
+}
+
+
 void CommandsManager::request_migration(const std::string &src, const std::string &dst) {
+    std::unique_lock<std::mutex> socket_lock(this->socket_mtx);
 
     if ( ! this->mig_is_available ) {
         mpirun_logger->Error("Migration is not available.");
@@ -48,41 +102,41 @@ void CommandsManager::request_migration(const std::string &src, const std::strin
     cmd.jobid = 0;
     cmd.cmd_type = BBQ_CMD_MIGRATE;
     cmd.flags = 0;
-    send(this->socket_client, &cmd, sizeof(local_bbq_cmd_t), 0);
+    send_msg(&cmd, sizeof(local_bbq_cmd_t));
 
     local_bbq_migrate_t mig_cmd;
     mig_cmd.jobid = 0;
     strncpy(mig_cmd.src, src.c_str(), 255);
     strncpy(mig_cmd.dest, dst.c_str(), 255);
-    send(this->socket_client, &mig_cmd, sizeof(local_bbq_migrate_t), 0);
+    send_msg(&mig_cmd, sizeof(local_bbq_migrate_t));
 
 }
 
 
 bool CommandsManager::get_and_manage_commands() noexcept {
-	local_bbq_cmd_t cmd;
+	std::unique_lock<std::mutex> socket_lock(this->socket_mtx);
+
+	// Manage all the commands already received
+	while (true) {
+		local_bbq_cmd_t cmd;
+		int bytes = recv_msg(&cmd, sizeof(local_bbq_cmd_t), false);
+		if (bytes == 0) {
+			// No requests (remember, the socket is non-blocking!)
+			return true;
+		}
 
-	// Now set the socket as non-blocking
-	::fcntl(this->socket_client,
-			F_SETFL, ::fcntl(this->socket_client,F_GETFL, 0) | O_NONBLOCK);
+		if (bytes != sizeof(local_bbq_cmd_t)) {
+			this->error = true;
+			mpirun_logger->Crit("Error receiving data from `mpirun` (maybe dirty close?)");
+			return false;
+		}
 
-	// First of all, receive a command from the shell
-	int bytes = recv(this->socket_client, &cmd, sizeof(local_bbq_cmd_t), 0);
-	if (bytes==-1 && errno == EWOULDBLOCK) {
-		// No requests (remember, recv is non-blocking!)
-		return true;
+		if (!manage_command(cmd))
+			return false;
 	}
+}
 
-	if(bytes != sizeof(local_bbq_cmd_t)) {
-		this->error = true;
-        mpirun_logger->Crit("Error receiving data from `mpirun` (maybe dirty close?)");
-		return false;
-    }
-
-	// Now reset the socket as blocking
-	::fcntl(this->socket_client,
-			F_SETFL, ::fcntl(this->socket_client,F_GETFL, 0) & ~O_NONBLOCK);
-
+bool CommandsManager::manage_command(const local_bbq_cmd_t &cmd) noexcept {
 	switch(cmd.cmd_type) {
     case BBQ_CMD_NODES_REQUEST:
         if ( cmd.flags & BBQ_OPT_MIG_AVAILABLE ) {
@@ -127,7 +181,7 @@ bool CommandsManager::get_and_manage_commands() noexcept {
 bool CommandsManager::manage_nodes_request() noexcept {
 	local_bbq_job_t job;
 
-	int bytes  = recv(this->socket_client, &job, sizeof(local_bbq_job_t), 0);
+	int bytes  = recv_msg(&job, sizeof(local_bbq_job_t), true);
 	if (bytes != sizeof(local_bbq_job_t)) {
 		// Something bad happened here
         mpirun_logger->Crit("Error receiving data from `mpirun`");
@@ -142,7 +196,7 @@ bool CommandsManager::manage_nodes_request() noexcept {
 	cmd_to_send.jobid    = job.jobid;
 	cmd_to_send.cmd_type = BBQ_CMD_NODES_REPLY;
 
-	bytes = send(this->socket_client, &cmd_to_send, sizeof(local_bbq_cmd_t), 0);
+	bytes = send_msg(&cmd_to_send, sizeof(local_bbq_cmd_t));
 	if (bytes != sizeof(local_bbq_cmd_t)) {
 		// Something bad happened here
         mpirun_logger->Crit("Error sending cmd reply to `mpirun`");
@@ -150,6 +204,7 @@ bool CommandsManager::manage_nodes_request() noexcept {
 	}
 
 	// Now we can send all resources available.
+	std::unique_lock<std::mutex> res_lock(this->res_mtx);
 	int size = available_resources->size();
 	for (int i=0; i < size; i++) {
 		local_bbq_res_item_t to_send;
@@ -161,7 +216,7 @@ bool CommandsManager::manage_nodes_request() noexcept {
         mpirun_logger->Info((std::string("Sending node, more items: ")
 					+ std::to_string(to_send.more_items)).c_str());
 
-		bytes = send(this->socket_client, &to_send, sizeof(local_bbq_res_item_t), 0);
+		bytes = send_msg(&to_send, sizeof(local_bbq_res_item_t));
 		if (bytes != sizeof(local_bbq_res_item_t)) {
             mpirun_logger->Crit("Error sending nodes reply to `mpirun`");
 			return false;
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "event_loop.h"
+
+// pidfd_open() is available since Linux 5.3
+#if !defined(SYS_pidfd_open) && defined(__linux__)
+# define SYS_pidfd_open 434
+#endif
+
+#define MPIRUN_EVENTLOOP_MAX_EVENTS 8
+
+
+namespace mpirun {
+
+EventLoop::EventLoop() noexcept :
+		stopping(false), child_exited(false), wakeups(0) {
+	this->epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+	this->wake_fd  = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	struct epoll_event ev = {};
+	ev.events  = EPOLLIN;
+	ev.data.fd = this->wake_fd;
+	::epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, this->wake_fd, &ev);
+
+	this->loop_thread = std::thread(&EventLoop::loop, this);
+}
+
+EventLoop::~EventLoop() noexcept {
+	this->stop();
+	if (this->loop_thread.joinable())
+		this->loop_thread.join();
+
+	if (this->pidfd != -1)
+		::close(this->pidfd);
+	if (this->signal_fd != -1)
+		::close(this->signal_fd);
+	::close(this->wake_fd);
+	::close(this->epoll_fd);
+}
+
+void EventLoop::stop() noexcept {
+	this->stopping = true;
+	this->wake_up();
+}
+
+void EventLoop::wake_up() noexcept {
+	uint64_t value = 1;
+	if (::write(this->wake_fd, &value, sizeof(value)) < 0) {
+		// Already notified (counter overflow): nothing to do
+	}
+}
+
+bool EventLoop::watch_child(int pid, ExitHandler_t on_exit) noexcept {
+	std::unique_lock<std::mutex> handlers_lock(this->handlers_mtx);
+	this->pid_child = pid;
+	this->on_exit   = on_exit;
+
+	struct epoll_event ev = {};
+	ev.events = EPOLLIN;
+
+	// Exit notification by process file descriptor...
+	this->pidfd = ::syscall(SYS_pidfd_open, pid, 0);
+	if (this->pidfd != -1) {
+		ev.data.fd = this->pidfd;
+		return ::epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, this->pidfd, &ev) == 0;
+	}
+
+	// ...or by SIGCHLD, blocked by the caller and by the loop thread
+	sigset_t mask;
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGCHLD);
+	::pthread_sigmask(SIG_BLOCK, &mask, NULL);
+	this->signal_fd = ::signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+	if (this->signal_fd == -1)
+		return false;
+	ev.data.fd = this->signal_fd;
+	if (::epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, this->signal_fd, &ev) != 0)
+		return false;
+
+	// The child could be already terminated. Moreover, the loop must
+	// start the periodic check
+	handlers_lock.unlock();
+	this->check_child();
+	this->wake_up();
+	return true;
+}
+
+bool EventLoop::watch_socket(int fd, ReadHandler_t on_read) noexcept {
+	// The socket is never blocking from now on
+	::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+	std::unique_lock<std::mutex> handlers_lock(this->handlers_mtx);
+	this->sockets[fd] = on_read;
+
+	struct epoll_event ev = {};
+	ev.events  = EPOLLIN | EPOLLRDHUP;
+	ev.data.fd = fd;
+	if (::epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+		this->sockets.erase(fd);
+		return false;
+	}
+	return true;
+}
+
+void EventLoop::loop() noexcept {
+	struct epoll_event events[MPIRUN_EVENTLOOP_MAX_EVENTS];
+
+	// SIGCHLD is consumed through the signalfd, if used
+	sigset_t mask;
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGCHLD);
+	::pthread_sigmask(SIG_BLOCK, &mask, NULL);
+
+	while (true) {
+		// With SIGCHLD, the signal could be delivered to another thread:
+		// check the child status periodically as well
+		int timeout = -1;
+		if ((this->signal_fd != -1) && !this->child_exited)
+			timeout = MPIRUN_CHILD_CHECK_PERIOD_MS;
+
+		int nr_events = ::epoll_wait(
+			this->epoll_fd, events, MPIRUN_EVENTLOOP_MAX_EVENTS, timeout);
+		++this->wakeups;
+		if (nr_events < 0) {
+			if (errno == EINTR)
+				continue;
+			return;
+		}
+
+		if ((nr_events == 0) && (this->signal_fd != -1)) {
+			this->check_child();
+			continue;
+		}
+
+		for (int i = 0; i < nr_events; ++i) {
+			int fd = events[i].data.fd;
+			if (fd == this->wake_fd) {
+				uint64_t value;
+				if (::read(fd, &value, sizeof(value)) < 0) {
+					// Already drained
+				}
+				if (this->stopping)
+					return;
+			}
+			else if (fd == this->pidfd) {
+				::epoll_ctl(this->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+				this->check_child();
+			}
+			else if (fd == this->signal_fd) {
+				struct signalfd_siginfo si;
+				while (::read(fd, &si, sizeof(si)) == sizeof(si));
+				this->check_child();
+			}
+			else {
+				this->dispatch_socket(fd);
+			}
+		}
+	}
+}
+
+void EventLoop::check_child() noexcept {
+	if (this->child_exited || (this->pid_child == -1))
+		return;
+
+	// With SIGCHLD, the caller and the loop thread could both get here:
+	// only one of them must reap the child
+	std::unique_lock<std::mutex> child_lock(this->child_mtx);
+	int status = 0;
+	pid_t result;
+	do {
+		result = ::waitpid(this->pid_child, &status, WNOHANG);
+	} while ((result == -1) && (errno == EINTR));
+	if (result == 0)
+		return;
+	if ((result == -1) && (errno != ECHILD))
+		return;
+
+	// Terminated (or already reaped by someone else)
+	if (this->child_exited.exchange(true))
+		return;
+	child_lock.unlock();
+
+	ExitHandler_t handler;
+	{
+		std::unique_lock<std::mutex> handlers_lock(this->handlers_mtx);
+		handler = this->on_exit;
+	}
+	if (handler)
+		handler(status);
+}
+
+void EventLoop::dispatch_socket(int fd) noexcept {
+	ReadHandler_t handler;
+	{
+		std::unique_lock<std::mutex> handlers_lock(this->handlers_mtx);
+		auto it = this->sockets.find(fd);
+		if (it == this->sockets.end())
+			return;
+		handler = it->second;
+	}
+
+	if (handler())
+		return;
+
+	// No longer watched
+	std::unique_lock<std::mutex> handlers_lock(this->handlers_mtx);
+	::epoll_ctl(this->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+	this->sockets.erase(fd);
+}
+
+} // namespace mpirun
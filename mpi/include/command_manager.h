@@ -18,10 +18,17 @@
 #ifndef MPIRUN_COMMANDSMANAGER_H_
 #define MPIRUN_COMMANDSMANAGER_H_
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <bbque/utils/logging/logger.h>
 
+#include "ompi_types.h"
+
+/** Maximum waiting time for the completion of a partially received message */
+#define MPIRUN_CMD_TIMEOUT_MS 1000
+
 extern std::unique_ptr<bbque::utils::Logger> mpirun_logger;
 
 
@@ -45,7 +52,8 @@ public:
 	/**
 	 * @brief The core method. It checks if new messages are on socket and in
 	 *        in case it manages them. If there is no new messages, it simply
-	 *        return successfully. (Note that this call is non-blocking)
+	 *        return successfully. (Note that this call is non-blocking: the
+	 *        socket must have been set as non-blocking)
 	 *
 	 * @note  You MUST call set_available_resources() before any call to this
 	 *        method!
@@ -79,6 +87,7 @@ public:
 	 * to get_and_manage_commands().
 	 */
     inline void set_available_resources(std::shared_ptr<const res_list> av) noexcept {
+		std::unique_lock<std::mutex> res_lock(this->res_mtx);
 		this->available_resources = av;
 	}
 
@@ -89,6 +98,7 @@ public:
 	 * set NULL is returned.
 	 */
     inline std::shared_ptr<const res_list> get_available_resources() const noexcept {
+		std::unique_lock<std::mutex> res_lock(this->res_mtx);
 		return this->available_resources;
 	}
 
@@ -101,8 +111,29 @@ private:
 
     std::shared_ptr<const res_list> available_resources;
 
+	/** Serialize the messages exchanged on the socket */
+	std::mutex socket_mtx;
+
+	/** Protect the list of available resources */
+	mutable std::mutex res_mtx;
+
+	bool manage_command(const local_bbq_cmd_t &cmd) noexcept;
+
 	bool manage_nodes_request() noexcept;
 
+	/**
+	 * @brief Receive a message from the (non-blocking) socket
+	 * @param wait_first if false, return 0 if no data is available
+	 * @return the number of bytes received, -1 on error or timeout
+	 */
+	int recv_msg(void *buf, size_t len, bool wait_first) noexcept;
+
+	/**
+	 * @brief Send a message on the (non-blocking) socket
+	 * @return the number of bytes sent, -1 on error or timeout
+	 */
+	int send_msg(const void *buf, size_t len) noexcept;
+
 };
 
 } // namespace mpirun
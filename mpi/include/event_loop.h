@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MPIRUN_EVENTLOOP_H_
+#define MPIRUN_EVENTLOOP_H_
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+/**
+ * Period of the child status check, when the exit notification relies on
+ * SIGCHLD (which could be delivered to threads not blocking it)
+ */
+#define MPIRUN_CHILD_CHECK_PERIOD_MS 500
+
+namespace mpirun {
+
+/**
+ * @brief Event loop supervising the `mpirun` child and the command socket
+ *
+ * A single thread waits (epoll) for the termination of the child process and
+ * for incoming data on the watched sockets. The child termination is notified
+ * by a pidfd, where supported by the kernel, otherwise by a signalfd on
+ * SIGCHLD. Therefore the loop does not wake up while idle, and the exit of
+ * the child is seen immediately.
+ */
+class EventLoop {
+
+public:
+
+	/**
+	 * @brief Called at the child termination, with the exit status
+	 */
+	typedef std::function<void(int status)> ExitHandler_t;
+
+	/**
+	 * @brief Called when a socket is readable. Returning false the socket
+	 *        is no longer watched.
+	 */
+	typedef std::function<bool()> ReadHandler_t;
+
+	/**
+	 * @brief Creates the loop and starts its thread
+	 */
+	EventLoop() noexcept;
+
+	/**
+	 * @brief Stops the thread of the loop
+	 */
+	~EventLoop() noexcept;
+
+	/**
+	 * @brief Watch for the termination of a child process
+	 * @param pid        the pid of the child to monitor
+	 * @param on_exit    the handler of the termination
+	 * @return false if the termination cannot be watched
+	 */
+	bool watch_child(int pid, ExitHandler_t on_exit) noexcept;
+
+	/**
+	 * @brief Watch for incoming data on a socket
+	 *
+	 * The socket is set (permanently) as non-blocking.
+	 *
+	 * @param fd         the socket to watch
+	 * @param on_read    the handler of the incoming data
+	 * @return false if the socket cannot be watched
+	 */
+	bool watch_socket(int fd, ReadHandler_t on_read) noexcept;
+
+	/**
+	 * @brief Stops the thread of the loop
+	 */
+	void stop() noexcept;
+
+	/**
+	 * @brief True if the child termination has been notified
+	 */
+	inline bool is_child_exited() const noexcept {
+		return this->child_exited;
+	}
+
+	/**
+	 * @brief True if the child termination is notified by a pidfd
+	 */
+	inline bool is_using_pidfd() const noexcept {
+		return this->pidfd != -1;
+	}
+
+	/**
+	 * @brief The number of times the loop thread has been woken up
+	 */
+	inline unsigned long get_wakeups() const noexcept {
+		return this->wakeups;
+	}
+
+private:
+
+	int epoll_fd  = -1;
+	/** To wake up (or stop) the loop thread */
+	int wake_fd   = -1;
+	std::atomic<int> pidfd{-1};
+	std::atomic<int> signal_fd{-1};
+
+	std::atomic<int> pid_child{-1};
+
+	std::atomic<bool> stopping;
+
+	std::atomic<bool> child_exited;
+
+	std::atomic<unsigned long> wakeups;
+
+	ExitHandler_t on_exit;
+
+	std::map<int, ReadHandler_t> sockets;
+
+	std::mutex handlers_mtx;
+
+	/** Serialize the reaping of the child */
+	std::mutex child_mtx;
+
+	std::thread loop_thread;
+
+	void loop() noexcept;
+
+	void wake_up() noexcept;
+
+	/**
+	 * @brief Reap the child, if terminated, and notify its exit
+	 */
+	void check_child() noexcept;
+
+	void dispatch_socket(int fd) noexcept;
+};
+
+} // namespace mpirun
+
+#endif // MPIRUN_EVENTLOOP_H_
@@ -20,12 +20,14 @@
 
 #include <bbque/bbque_exc.h>
 #include <netinet/in.h>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <bbque/utils/logging/logger.h>
 #include "command_manager.h"
-#include "process_checker.h"
+#include "event_loop.h"
 
 using bbque::rtlib::BbqueEXC;
 
@@ -64,9 +66,21 @@ private:
 
 	unsigned int avail_res_n = 0;
 
-    std::unique_ptr<ProcessChecker>  pc;
     std::unique_ptr<CommandsManager> cm;
 
+	/** Supervision of `mpirun` and of its command socket */
+	std::unique_ptr<EventLoop> loop;
+
+	/** Set at `mpirun` termination or on shutdown command */
+	bool terminated = false;
+	std::mutex status_mtx;
+	std::condition_variable status_cv;
+
+	/**
+	 * @brief Notify the termination to the EXC control thread
+	 */
+	void notify_termination() noexcept;
+
 	bool call_mpirun();
     void clean_mpirun() const noexcept;
 	bool open_socket();
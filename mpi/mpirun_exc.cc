@@ -17,6 +17,7 @@
 
 #include "mpirun_exc.h"
 #include "config.h"
+#include <chrono>
 #include <cstdio>
 #include <bbque/utils/utility.h>
 #include <vector>
@@ -38,6 +39,8 @@ MpiRun::MpiRun(
 }
 
 MpiRun::~MpiRun() {
+	// Stop the supervision before releasing what it uses
+	this->loop.reset();
     this->clean_mpirun();
 	this->clean_sockets();
 }
@@ -108,6 +111,15 @@ RTLIB_ExitCode_t MpiRun::onConfigure(int8_t awm_id) {
         this->cm->set_available_resources(avail_res);
     } else {
         this->cm = std::unique_ptr<CommandsManager>(new CommandsManager(this->socket_client,avail_res));
+
+		// Manage the commands from `mpirun` as soon as they arrive
+		this->loop->watch_socket(this->socket_client, [this]() {
+			if (this->cm->get_and_manage_commands())
+				return true;
+			// Error or clean shutdown
+			this->notify_termination();
+			return false;
+		});
     }
 	return RTLIB_OK;
 }
@@ -116,8 +128,16 @@ RTLIB_ExitCode_t MpiRun::onRun() {
     Config &config = Config::get();
     static int n=0;
 
-    // Do nothing: this application as no particular workload
-    usleep(config.get_updatetime_res()*1000);    // milliseconds -> microseconds
+    // Do nothing: this application as no particular workload. Just wait
+    // for the update period, or for the termination
+    {
+        std::unique_lock<std::mutex> status_lock(this->status_mtx);
+        this->status_cv.wait_for(status_lock,
+            std::chrono::milliseconds(config.get_updatetime_res()),
+            [this]() { return this->terminated; });
+        if (this->terminated)
+            return RTLIB_OK;
+    }
 
     mpirun_logger->Info("MpiRun::onRun() %d %d",
         config.get_mig_time(), config.get_updatetime_res()*(n));
@@ -140,14 +160,11 @@ RTLIB_ExitCode_t MpiRun::onMonitor() {
     mpirun_logger->Info("MpiRun::onMonitor(): AWM [%02d], Cycle [%4d]",
 		wmp.awm_id, Cycles());
 
-	// Now check for MPI requests
-	// If a 'true' is returned the execution should continue, 'false'
-	// otherwise.
-	bool status = this->cm->get_and_manage_commands();
-	if (!status) {
-		// Error or clean shutdown
+	// MPI requests are managed by the event loop, as soon as they arrive.
+	// Here just check for `mpirun` termination, errors or clean shutdown
+	std::unique_lock<std::mutex> status_lock(this->status_mtx);
+	if (this->terminated)
 		return RTLIB_EXC_WORKLOAD_NONE;
-	}
 
 	return RTLIB_OK;
 }
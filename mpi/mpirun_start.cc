@@ -66,13 +66,31 @@ bool MpiRun::call_mpirun() {
 		// Parent
         mpirun_logger->Notice("Forked %i", pid);
 		this->pid_child = pid;
-        pc =  std::unique_ptr<ProcessChecker>(new ProcessChecker(this->pid_child, this->socket_listening));
+
+		// Child terminated: close the socket so the accept() can return
+		this->loop = std::unique_ptr<EventLoop>(new EventLoop());
+		bool watched = this->loop->watch_child(pid, [this](int status) {
+			mpirun_logger->Notice("`mpirun` terminated [status=%d]", status);
+			::shutdown(this->socket_listening, SHUT_RDWR);
+			this->notify_termination();
+		});
+		if (!watched)
+			mpirun_logger->Error("Unable to watch the `mpirun` termination");
+		else
+			mpirun_logger->Debug("Watching `mpirun` termination by %s",
+				this->loop->is_using_pidfd() ? "pidfd" : "SIGCHLD");
 
 	}
 
 	return true;
 }
 
+void MpiRun::notify_termination() noexcept {
+	std::unique_lock<std::mutex> status_lock(this->status_mtx);
+	this->terminated = true;
+	this->status_cv.notify_all();
+}
+
 void MpiRun::clean_mpirun() const noexcept {
     mpirun_logger->Info("Sending SIGTERM to `mpirun`...");
     kill(this->pid_child, SIGTERM);
@@ -118,10 +136,6 @@ bool MpiRun::accept_socket() {
 	this->socket_client = ::accept(
 			this->socket_listening, (struct sockaddr *) &this->client_addr,	&clilen);
 
-	// Just to check, should not be happens. Let's stop the checker (doesn't
-	// matter what happens)
-    this->pc.reset();
-
 	if (this->socket_client < 0 && errno == EINVAL) {
         mpirun_logger->Warn("`mpirun` terminates before opening a socket.");
 		return false;
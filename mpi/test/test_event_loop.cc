@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Event loop test: a dummy child process is supervised, while a socket is
+ * watched. The test measures the child exit-detection latency and the
+ * wakeups of the loop while idle.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "event_loop.h"
+
+/** The child lifetime */
+#define TEST_CHILD_LIFETIME_MS  200
+/** Maximum accepted exit-detection latency */
+#define TEST_MAX_LATENCY_MS      50
+/** Idle period to count the loop wakeups */
+#define TEST_IDLE_MS            300
+
+static uint64_t now_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+int main() {
+	std::mutex mtx;
+	std::condition_variable cv;
+	uint64_t t_detected = 0;
+	int nr_exits = 0;
+	int nr_reads = 0;
+	bool failed = false;
+
+	// The socket: count the read events
+	int sv[2];
+	if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+		perror("socketpair");
+		return EXIT_FAILURE;
+	}
+
+	// The dummy child: send its exit time through a pipe
+	int pipe_fd[2];
+	if (::pipe(pipe_fd) != 0) {
+		perror("pipe");
+		return EXIT_FAILURE;
+	}
+	pid_t pid = ::fork();
+	if (pid == 0) {
+		std::this_thread::sleep_for(
+			std::chrono::milliseconds(TEST_CHILD_LIFETIME_MS));
+		uint64_t t_exit = now_ns();
+		if (::write(pipe_fd[1], &t_exit, sizeof(t_exit)) < 0)
+			::_exit(EXIT_FAILURE);
+		::_exit(EXIT_SUCCESS);
+	}
+
+	mpirun::EventLoop loop;
+	loop.watch_socket(sv[0], [&]() {
+		char buf[16];
+		while (::read(sv[0], buf, sizeof(buf)) > 0);
+		std::unique_lock<std::mutex> lock(mtx);
+		++nr_reads;
+		cv.notify_all();
+		return true;
+	});
+	loop.watch_child(pid, [&](int status) {
+		std::unique_lock<std::mutex> lock(mtx);
+		t_detected = now_ns();
+		++nr_exits;
+		if (status != 0)
+			fprintf(stderr, "Child exit status: %d\n", status);
+		cv.notify_all();
+	});
+	printf("Child exit notified by: %s\n",
+		loop.is_using_pidfd() ? "pidfd" : "signalfd (SIGCHLD)");
+
+	// Idle wakeups: nothing happens while the child is alive
+	unsigned long wakeups_start = loop.get_wakeups();
+	std::this_thread::sleep_for(std::chrono::milliseconds(TEST_IDLE_MS / 2));
+	unsigned long idle_wakeups = loop.get_wakeups() - wakeups_start;
+	unsigned long max_idle_wakeups = loop.is_using_pidfd() ?
+		0 : (TEST_IDLE_MS / 2) / MPIRUN_CHILD_CHECK_PERIOD_MS + 1;
+	printf("Idle wakeups (child alive):  %lu [max %lu]\n",
+		idle_wakeups, max_idle_wakeups);
+	if (idle_wakeups > max_idle_wakeups)
+		failed = true;
+
+	// Exit-detection latency
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		cv.wait_for(lock, std::chrono::seconds(2),
+			[&]() { return t_detected != 0; });
+	}
+	uint64_t t_exit = 0;
+	if ((t_detected == 0) ||
+			(::read(pipe_fd[0], &t_exit, sizeof(t_exit)) != sizeof(t_exit))) {
+		printf("Child exit not detected\n");
+		return EXIT_FAILURE;
+	}
+	double latency_ms = (t_detected - t_exit) / 1e6;
+	printf("Exit-detection latency:      %.3f ms [max %d ms]\n",
+		latency_ms, TEST_MAX_LATENCY_MS);
+	if (latency_ms > TEST_MAX_LATENCY_MS)
+		failed = true;
+
+	// Idle wakeups: nothing happens after the child exit
+	wakeups_start = loop.get_wakeups();
+	std::this_thread::sleep_for(std::chrono::milliseconds(TEST_IDLE_MS));
+	idle_wakeups = loop.get_wakeups() - wakeups_start;
+	printf("Idle wakeups (child exited): %lu [max 0]\n", idle_wakeups);
+	if (idle_wakeups > 0)
+		failed = true;
+
+	// The socket is still watched
+	if (::write(sv[1], "x", 1) != 1) {
+		perror("write");
+		return EXIT_FAILURE;
+	}
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		cv.wait_for(lock, std::chrono::seconds(1),
+			[&]() { return nr_reads > 0; });
+	}
+	printf("Socket read events:          %d [expected 1]\n", nr_reads);
+	if (nr_reads != 1)
+		failed = true;
+
+	// The exit is notified only once
+	printf("Exit notifications:          %d [expected 1]\n", nr_exits);
+	if (nr_exits != 1)
+		failed = true;
+
+	loop.stop();
+	::close(sv[0]);
+	::close(sv[1]);
+
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -15,6 +15,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <chrono>
+
 #include "agent_client.h"
 
 namespace bbque
@@ -33,6 +36,11 @@ AgentClient::AgentClient(int _local_id, int _remote_id, const std::string & _add
 	Connect();
 }
 
+AgentClient::~AgentClient()
+{
+	UnsubscribeStatus();
+}
+
 ExitCode_t AgentClient::Connect()
 {
 	logger->Debug("Connecting to %s...", remote_address_port.c_str());
@@ -172,6 +180,112 @@ ExitCode_t AgentClient::GetChannelStatus(agent::ChannelStatus & channel_status)
 	return ExitCode_t::OK;
 }
 
+ExitCode_t AgentClient::SubscribeStatus(
+		std::vector<std::string> const & paths,
+		uint32_t period_ms,
+		agent::StatusUpdateCallback_t cb) {
+	ExitCode_t exit_code = Connect();
+	if (exit_code != ExitCode_t::OK) {
+		logger->Error("SubscribeStatus: Connection failed");
+		return exit_code;
+	}
+
+	std::unique_lock<std::mutex> subscription_ul(subscription_mtx);
+	if (subscribed) {
+		logger->Warn("SubscribeStatus: already subscribed to sys%d",
+			remote_system_id);
+		return ExitCode_t::OK;
+	}
+
+	bbque::StatusSubscriptionRequest request;
+	request.set_sender_id(local_system_id);
+	request.set_dest_id(remote_system_id);
+	request.set_period_ms(period_ms);
+	for (auto const & path: paths)
+		request.add_paths(path);
+
+	subscribed = true;
+	subscription_thr = std::thread(
+		&AgentClient::StatusSubscriptionTask, this, request, cb);
+	logger->Info("SubscribeStatus: subscribed to sys%d [T=%d ms]",
+		remote_system_id, period_ms);
+
+	return ExitCode_t::OK;
+}
+
+ExitCode_t AgentClient::UnsubscribeStatus() {
+	std::unique_lock<std::mutex> subscription_ul(subscription_mtx);
+	if (!subscribed)
+		return ExitCode_t::OK;
+
+	subscribed = false;
+	if (subscription_ctx)
+		subscription_ctx->TryCancel();
+	subscription_cv.notify_all();
+	subscription_ul.unlock();
+
+	if (subscription_thr.joinable())
+		subscription_thr.join();
+	logger->Info("UnsubscribeStatus: unsubscribed from sys%d", remote_system_id);
+
+	return ExitCode_t::OK;
+}
+
+void AgentClient::StatusSubscriptionTask(
+		bbque::StatusSubscriptionRequest request,
+		agent::StatusUpdateCallback_t cb) {
+	std::unique_lock<std::mutex> subscription_ul(subscription_mtx);
+
+	while (subscribed) {
+		subscription_ctx.reset(new grpc::ClientContext);
+		auto reader(service_stub->SubscribeStatus(
+			subscription_ctx.get(), request));
+		subscription_ul.unlock();
+
+		bbque::StatusUpdate reply;
+		while (reader->Read(&reply)) {
+			agent::StatusUpdate update;
+			update.seq = reply.seq();
+			for (auto const & delta: reply.resources()) {
+				auto & status(update.resources[delta.path()]);
+				status.total       = delta.status().total();
+				status.used        = delta.status().used();
+				status.power_mw    = delta.status().power_mw();
+				status.temperature = delta.status().temperature();
+				status.degradation = delta.status().degradation();
+				status.load        = delta.status().load();
+			}
+			update.workload_changed    = reply.workload_changed();
+			update.workload.nr_ready   = reply.workload().nr_ready();
+			update.workload.nr_running = reply.workload().nr_running();
+			logger->Debug("SubscribeStatus: update %d from sys%d: %d resources",
+				update.seq, remote_system_id, update.resources.size());
+			cb(remote_system_id, update);
+		}
+		grpc::Status status = reader->Finish();
+
+		// The status received so far is not valid anymore
+		agent::StatusUpdate closed_update;
+		closed_update.seq = 0;
+		closed_update.workload_changed = false;
+		closed_update.closed = true;
+		cb(remote_system_id, closed_update);
+
+		subscription_ul.lock();
+		if (!subscribed)
+			break;
+
+		// Stream interrupted: retry later
+		logger->Warn("SubscribeStatus: stream from sys%d closed [code=%d]",
+			remote_system_id, status.error_code());
+		subscription_cv.wait_for(subscription_ul,
+			std::chrono::milliseconds(
+				std::max<uint32_t>(request.period_ms(), 1000)));
+	}
+
+	subscription_ctx.reset();
+}
+
 // ----------- Multi-agent management
 
 ExitCode_t AgentClient::SendJoinRequest()
@@ -191,6 +305,49 @@ ExitCode_t AgentClient::SendDisjoinRequest()
 ExitCode_t AgentClient::SendScheduleRequest(
         agent::ApplicationScheduleRequest const & request)
 {
+	std::vector<ExitCode_t> results;
+	ExitCode_t exit_code = SendScheduleRequests({ request }, results);
+	if (exit_code != ExitCode_t::OK)
+		return exit_code;
+	return results[0];
+}
+
+ExitCode_t AgentClient::SendScheduleRequests(
+		std::vector<agent::ApplicationScheduleRequest> const & requests,
+		std::vector<ExitCode_t> & results) {
+	results.assign(requests.size(), ExitCode_t::AGENT_UNREACHABLE);
+	ExitCode_t exit_code = Connect();
+	if (exit_code != ExitCode_t::OK) {
+		logger->Error("ScheduleRequests: Connection failed");
+		return exit_code;
+	}
+
+	bbque::ApplicationSchedulingBatch batch;
+	batch.set_sender_id(local_system_id);
+	batch.set_dest_id(remote_system_id);
+	for (auto const & request: requests) {
+		auto req = batch.add_requests();
+		req->set_sender_id(local_system_id);
+		req->set_app_id(request.app_id);
+		req->set_app_name(request.app_name);
+		req->set_awm_id(request.awm_id);
+	}
+
+	grpc::Status status;
+	grpc::ClientContext context;
+	bbque::ApplicationSchedulingBatchReply reply;
+
+	logger->Debug("ScheduleRequests: sending %d requests...", requests.size());
+	status = service_stub->SetApplicationsScheduling(&context, batch, &reply);
+	if (!status.ok()) {
+		logger->Error("ScheduleRequests: Returned code %d", status.error_code());
+		return ExitCode_t::AGENT_DISCONNECTED;
+	}
+
+	for (int i = 0; (i < reply.values_size()) && (i < (int) results.size()); ++i) {
+		results[i] = (reply.values(i) == bbque::GenericReply::OK) ?
+			ExitCode_t::OK : ExitCode_t::REQUEST_REJECTED;
+	}
 
 	return ExitCode_t::OK;
 }
@@ -18,8 +18,12 @@
 #ifndef BBQUE_AGENT_PROXY_GRPC_CLIENT_H_
 #define BBQUE_AGENT_PROXY_GRPC_CLIENT_H_
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <grpc/grpc.h>
 #include <grpc++/channel.h>
@@ -47,6 +51,8 @@ public:
 
 	AgentClient(int _local_id, int _remote_id, const std::string & _address_port);
 
+	~AgentClient();
+
 	bool IsConnected();
 
 	// ---------- Status
@@ -59,6 +65,19 @@ public:
 
 	ExitCode_t GetChannelStatus(agent::ChannelStatus & channel_status);
 
+	/**
+	 * @brief Open a stream of status updates from the remote agent
+	 *
+	 * The updates are read by a dedicated thread, which re-opens the
+	 * stream in case of disconnection, until unsubscribed.
+	 */
+	ExitCode_t SubscribeStatus(
+		std::vector<std::string> const & paths,
+		uint32_t period_ms,
+		agent::StatusUpdateCallback_t cb);
+
+	ExitCode_t UnsubscribeStatus();
+
 	// ----------- Multi-agent management
 
 	ExitCode_t SendJoinRequest();
@@ -70,6 +89,10 @@ public:
 	ExitCode_t SendScheduleRequest(
 	        agent::ApplicationScheduleRequest const & request);
 
+	ExitCode_t SendScheduleRequests(
+	        std::vector<agent::ApplicationScheduleRequest> const & requests,
+	        std::vector<ExitCode_t> & results);
+
 private:
 
 	int local_system_id;
@@ -86,6 +109,21 @@ private:
 
 	bbque::utils::Timer timer;
 
+	/** Thread reading the status updates stream */
+	std::thread subscription_thr;
+
+	/** The context of the (current) status updates stream */
+	std::unique_ptr<grpc::ClientContext> subscription_ctx;
+
+	bool subscribed = false;
+
+	std::mutex subscription_mtx;
+
+	std::condition_variable subscription_cv;
+
+	void StatusSubscriptionTask(
+		bbque::StatusSubscriptionRequest request,
+		agent::StatusUpdateCallback_t cb);
 
 	ExitCode_t Connect();
 };
@@ -17,7 +17,16 @@
 
 #include "agent_impl.h"
 
+#include <algorithm>
+#include <chrono>
+#include <map>
+
 #include "bbque/config.h"
+#include "bbque/resource_accounter.h"
+
+#ifdef CONFIG_BBQUE_DIST_MODE
+  #include "bbque/placement_manager.h"
+#endif
 
 #ifdef CONFIG_BBQUE_PM
   #include "bbque/pm/power_manager.h"
@@ -40,25 +49,33 @@ grpc::Status AgentImpl::GetResourceStatus(
 		return grpc::Status::CANCELLED;
 	}
 
+	if (!FillResourceStatus(request->path(), reply)) {
+		logger->Error("ResourceStatus: invalid resource path specified");
+		return grpc::Status::CANCELLED;
+	}
+
+	return grpc::Status::OK;
+}
+
+
+bool AgentImpl::FillResourceStatus(
+		std::string const & path,
+		bbque::ResourceStatusReply * reply) {
+
 	// Call ResourceAccounter member functions...
-	int64_t total = system.ResourceTotal(request->path());
-	int64_t used  = system.ResourceUsed(request->path());
+	int64_t total = system.ResourceTotal(path);
+	int64_t used  = system.ResourceUsed(path);
 	reply->set_total(total);
 	reply->set_used(used);
 
 	// Power information...
-	bbque::res::ResourcePtr_t resource(system.GetResource(request->path()));
-	if (resource == nullptr) {
-		logger->Error("ResourceStatus: invalid resource path specified");
-		return grpc::Status::CANCELLED;
-	}
+	bbque::res::ResourcePtr_t resource(system.GetResource(path));
+	if (resource == nullptr)
+		return false;
 
-	bbque::res::ResourcePathPtr_t resource_path(
-		system.GetResourcePath(request->path()));
-	if (resource_path == nullptr) {
-		logger->Error("ResourceStatus: invalid resource path specified");
-		return grpc::Status::CANCELLED;
-	}
+	bbque::res::ResourcePathPtr_t resource_path(system.GetResourcePath(path));
+	if (resource_path == nullptr)
+		return false;
 
 	uint32_t degr_perc = 100;
 	uint32_t power_mw = 0, temp = 0, load = 0;
@@ -73,7 +90,7 @@ grpc::Status AgentImpl::GetResourceStatus(
 	reply->set_temperature(temp);
 	reply->set_load(load);
 
-	return grpc::Status::OK;
+	return true;
 }
 
 
@@ -117,6 +134,133 @@ grpc::Status AgentImpl::SetNodeManagementAction(
 	return grpc::Status::OK;
 }
 
+
+std::vector<std::string> AgentImpl::GetSystemResourcePaths(uint32_t system_id) {
+	std::vector<std::string> paths;
+	bbque::ResourceAccounter & ra(bbque::ResourceAccounter::GetInstance());
+	auto snapshot(ra.GetSnapshot());
+	if (snapshot == nullptr)
+		return paths;
+
+	std::string prefix("sys" + std::to_string(system_id) + ".");
+	for (auto const & entry: snapshot->entries) {
+		if (entry.first.compare(0, prefix.size(), prefix) == 0)
+			paths.push_back(entry.first);
+	}
+	return paths;
+}
+
+
+grpc::Status AgentImpl::SubscribeStatus(
+		grpc::ServerContext * context,
+		const bbque::StatusSubscriptionRequest * request,
+		grpc::ServerWriter<bbque::StatusUpdate> * writer) {
+
+	uint32_t period_ms = std::max<uint32_t>(
+		request->period_ms(), BBQUE_AGENT_PROXY_STATUS_PERIOD_MIN_MS);
+	logger->Info("SubscribeStatus: sys%d subscribed to sys%d [paths=%d, T=%d ms]",
+		request->sender_id(), request->dest_id(),
+		request->paths_size(), period_ms);
+
+	std::vector<std::string> paths(
+		request->paths().begin(), request->paths().end());
+	if (paths.empty())
+		paths = GetSystemResourcePaths(request->dest_id());
+
+	// Last status sent, to push only the differences
+	std::map<std::string, std::string> last_sent;
+	std::string last_workload;
+	uint64_t seq = 0;
+	uint32_t idle_periods = 0;
+
+	std::unique_lock<std::mutex> stopping_ul(stopping_mtx);
+	while (!stopping && !context->IsCancelled()) {
+		stopping_ul.unlock();
+
+		bbque::StatusUpdate update;
+		update.set_seq(seq);
+		for (auto const & path: paths) {
+			bbque::ResourceStatusReply status;
+			if (!FillResourceStatus(path, &status))
+				continue;
+			std::string status_str(status.SerializeAsString());
+			auto it = last_sent.find(path);
+			if ((it != last_sent.end()) && (it->second == status_str))
+				continue;
+			last_sent[path] = status_str;
+
+			auto delta = update.add_resources();
+			delta->set_path(path);
+			*(delta->mutable_status()) = status;
+		}
+
+		bbque::WorkloadStatusReply workload;
+		workload.set_nr_running(system.ApplicationsCount(
+			bbque::app::ApplicationStatusIF::RUNNING));
+		workload.set_nr_ready(system.ApplicationsCount(
+			bbque::app::ApplicationStatusIF::READY));
+		std::string workload_str(workload.SerializeAsString());
+		if ((seq == 0) || (workload_str != last_workload)) {
+			last_workload = workload_str;
+			update.set_workload_changed(true);
+			*(update.mutable_workload()) = workload;
+		}
+
+		// Nothing changed: skip the update (but the first one and the
+		// keep-alive ones)
+		if ((seq == 0) || update.workload_changed()
+				|| (update.resources_size() > 0)
+				|| (++idle_periods >= BBQUE_AGENT_PROXY_STATUS_KEEPALIVE)) {
+			idle_periods = 0;
+			logger->Debug("SubscribeStatus: update %d for sys%d: %d resources",
+				seq, request->sender_id(), update.resources_size());
+			if (!writer->Write(update)) {
+				logger->Warn("SubscribeStatus: sys%d stream closed",
+					request->sender_id());
+				break;
+			}
+			++seq;
+		}
+
+		stopping_ul.lock();
+		stopping_cv.wait_for(stopping_ul, std::chrono::milliseconds(period_ms));
+	}
+
+	logger->Info("SubscribeStatus: sys%d unsubscribed [updates=%d]",
+		request->sender_id(), seq);
+	return grpc::Status::OK;
+}
+
+grpc::Status AgentImpl::SetApplicationsScheduling(
+		grpc::ServerContext * context,
+		const bbque::ApplicationSchedulingBatch * batch,
+		bbque::ApplicationSchedulingBatchReply * reply) {
+
+	logger->Debug("ApplicationsScheduling: %d requests from sys%d",
+		batch->requests_size(), batch->sender_id());
+	for (auto const & req: batch->requests()) {
+		agent::ApplicationScheduleRequest request;
+		request.app_id   = req.app_id();
+		request.app_name = req.app_name();
+		request.awm_id   = req.awm_id();
+		bool accepted = false;
+#ifdef CONFIG_BBQUE_DIST_MODE
+		bbque::PlacementManager & plc(bbque::PlacementManager::GetInstance());
+		accepted = plc.AcceptRemote(batch->sender_id(), request);
+#endif
+		reply->add_values(accepted ?
+			bbque::GenericReply::OK : bbque::GenericReply::REQUEST_REJECTED);
+	}
+
+	return grpc::Status::OK;
+}
+
+void AgentImpl::Stop() {
+	std::unique_lock<std::mutex> stopping_ul(stopping_mtx);
+	stopping = true;
+	stopping_cv.notify_all();
+}
+
 } // namespace plugins
 
 } // namespace bbque
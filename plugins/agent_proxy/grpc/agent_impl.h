@@ -18,6 +18,9 @@
 #ifndef BBQUE_AGENT_PROXY_GRPC_IMPL_H_
 #define BBQUE_AGENT_PROXY_GRPC_IMPL_H_
 
+#include <condition_variable>
+#include <mutex>
+
 #include "bbque/plugins/agent_proxy_if.h"
 #include "bbque/system.h"
 #include "bbque/utils/logging/logger.h"
@@ -25,6 +28,12 @@
 #include <grpc/grpc.h>
 #include "agent_com.grpc.pb.h"
 
+/** Minimum period of the status updates pushed to the subscribers */
+#define BBQUE_AGENT_PROXY_STATUS_PERIOD_MIN_MS  50
+/** Periods without changes after which an empty status update is sent
+ * anyway, to let the subscriber detect a lost stream */
+#define BBQUE_AGENT_PROXY_STATUS_KEEPALIVE      4
+
 namespace bbque
 {
 namespace plugins
@@ -60,10 +69,49 @@ public:
 	        grpc::ServerContext * context,
 	        const bbque::NodeManagementRequest * action,
 	        bbque::GenericReply * error) override;
+
+	grpc::Status SubscribeStatus(
+		grpc::ServerContext * context,
+		const bbque::StatusSubscriptionRequest * request,
+		grpc::ServerWriter<bbque::StatusUpdate> * writer) override;
+
+	grpc::Status SetApplicationsScheduling(
+		grpc::ServerContext * context,
+		const bbque::ApplicationSchedulingBatch * batch,
+		bbque::ApplicationSchedulingBatchReply * reply) override;
+
+	/**
+	 * @brief Terminate the active status subscriptions
+	 *
+	 * To call before shutting down the server, which otherwise waits for
+	 * the streaming calls to complete.
+	 */
+	void Stop();
+
 private:
 
 	bbque::System & system;
 
+	/** True if the subscriptions must be terminated */
+	bool stopping = false;
+
+	std::mutex stopping_mtx;
+
+	std::condition_variable stopping_cv;
+
+	/**
+	 * @brief Fill the status of a single resource
+	 * @return false if the path does not reference a valid resource
+	 */
+	bool FillResourceStatus(
+		std::string const & path,
+		bbque::ResourceStatusReply * reply);
+
+	/**
+	 * @brief Paths of all the resources of a (local) system
+	 */
+	std::vector<std::string> GetSystemResourcePaths(uint32_t system_id);
+
 	std::unique_ptr<bbque::utils::Logger> logger;
 
 };
@@ -152,6 +152,7 @@ void AgentProxyGRPC::StopServer() {
 		logger->Warn("Server already stopped");
 		return;
 	}
+	service.Stop();
 	server->Shutdown();
 }
 
@@ -174,11 +175,14 @@ std::shared_ptr<AgentClient> AgentProxyGRPC::GetAgentClient(uint16_t remote_syst
 		return nullptr;
 	}
 
+	std::unique_lock<std::mutex> clients_ul(clients_mtx);
 	auto sys_client = clients.find(remote_system_id);
 	if(sys_client == clients.end()) {
 		logger->Debug("GetAgentClient: creating a client for sys%d", remote_system_id);
 		std::string server_address_port(platform->GetSystem(remote_system_id).GetNetAddress());
-		server_address_port.append(":" + std::to_string(port_num));
+		// An explicit port number allows more agents on the same host
+		if (server_address_port.find(':') == std::string::npos)
+			server_address_port.append(":" + std::to_string(port_num));
 		logger->Debug("GetAgentClient: allocating a client to connect to --> %s",
 			server_address_port.c_str());
 
@@ -233,6 +237,25 @@ ExitCode_t AgentProxyGRPC::GetChannelStatus(
 }
 
 
+ExitCode_t AgentProxyGRPC::SubscribeStatus(
+		int remote_system_id,
+		std::vector<std::string> const & paths,
+		uint32_t period_ms,
+		agent::StatusUpdateCallback_t cb) {
+	std::shared_ptr<AgentClient> client(GetAgentClient(remote_system_id));
+	if (client)
+		return client->SubscribeStatus(paths, period_ms, cb);
+	return agent::ExitCode_t::AGENT_UNREACHABLE;
+}
+
+ExitCode_t AgentProxyGRPC::UnsubscribeStatus(int remote_system_id) {
+	std::shared_ptr<AgentClient> client(GetAgentClient(remote_system_id));
+	if (client)
+		return client->UnsubscribeStatus();
+	return agent::ExitCode_t::AGENT_UNREACHABLE;
+}
+
+
 // ------------- Multi-agent management functions ------------------
 
 ExitCode_t AgentProxyGRPC::SendJoinRequest(std::string const & path) {
@@ -262,7 +285,20 @@ ExitCode_t AgentProxyGRPC::SendDisjoinRequest(int remote_system_id) {
 ExitCode_t AgentProxyGRPC::SendScheduleRequest(
 		std::string const & path,
 		agent::ApplicationScheduleRequest const & request) {
+	std::shared_ptr<AgentClient> client(GetAgentClient(GetSystemId(path)));
+	if (client)
+		return client->SendScheduleRequest(request);
+	return agent::ExitCode_t::AGENT_UNREACHABLE;
+}
 
+ExitCode_t AgentProxyGRPC::SendScheduleRequests(
+		int remote_system_id,
+		std::vector<agent::ApplicationScheduleRequest> const & requests,
+		std::vector<ExitCode_t> & results) {
+	std::shared_ptr<AgentClient> client(GetAgentClient(remote_system_id));
+	if (client)
+		return client->SendScheduleRequests(requests, results);
+	results.assign(requests.size(), agent::ExitCode_t::AGENT_UNREACHABLE);
 	return agent::ExitCode_t::AGENT_UNREACHABLE;
 }
 
@@ -21,6 +21,7 @@
 #include <chrono>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -99,6 +100,15 @@ public:
 	        int system_id, agent::ChannelStatus & status) override;
 
 
+	ExitCode_t SubscribeStatus(
+	        int system_id,
+	        std::vector<std::string> const & paths,
+	        uint32_t period_ms,
+	        agent::StatusUpdateCallback_t cb) override;
+
+	ExitCode_t UnsubscribeStatus(int system_id) override;
+
+
 	// ------------- Multi-agent management functions ------------------
 
 	ExitCode_t SendJoinRequest(std::string const & system_path) override;
@@ -117,6 +127,11 @@ public:
 	        std::string const & system_path,
 	        agent::ApplicationScheduleRequest const & request) override;
 
+	ExitCode_t SendScheduleRequests(
+	        int system_id,
+	        std::vector<agent::ApplicationScheduleRequest> const & requests,
+	        std::vector<ExitCode_t> & results) override;
+
 private:
 
 	std::string server_address_port = "0.0.0.0:";
@@ -137,6 +152,8 @@ private:
 
 	std::map<uint16_t, std::shared_ptr<AgentClient>> clients;
 
+	std::mutex clients_mtx;
+
 	bool server_started = false;
 
 	// Plugin required
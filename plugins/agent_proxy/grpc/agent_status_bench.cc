@@ -0,0 +1,330 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Remote resource status: polling vs streaming
+ *
+ * A local RemoteAgent server exports the status of N resources, and changes
+ * a fraction of them every period. The client reads the status of all the
+ * resources, as a scheduling round does:
+ * - polling: one GetResourceStatus call per resource (status_period_ms = 0);
+ * - streaming: a SubscribeStatus stream merges the changed entries into a
+ *   local cache, and the round reads the cache.
+ *
+ * For each N, the benchmark reports the time of a round and the bytes
+ * exchanged: per round when polling, per period when streaming.
+ *
+ * Usage: bbque-agent-status-bench [period_ms] [changed %] [rounds]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <grpc++/grpc++.h>
+
+#include "agent_com.grpc.pb.h"
+
+using Clock = std::chrono::steady_clock;
+
+static double ElapsedUs(Clock::time_point start) {
+	return std::chrono::duration<double, std::micro>(
+		Clock::now() - start).count();
+}
+
+/**
+ * @class StatusServer
+ *
+ * The status of the resources, served as AgentImpl does: by path on
+ * request, or as periodic batches of the changed entries
+ */
+class StatusServer: public bbque::RemoteAgent::Service {
+
+public:
+
+	StatusServer(uint32_t nr_resources, uint32_t period_ms, uint32_t changed_pc):
+			period_ms(period_ms),
+			changed_pc(changed_pc) {
+		for (uint32_t i = 0; i < nr_resources; ++i) {
+			std::string path("sys0.cpu" + std::to_string(i / 16) +
+				".pe" + std::to_string(i % 16));
+			auto & status(resources[path]);
+			status.set_total(100);
+			status.set_used(0);
+			status.set_temperature(40000);
+			status.set_power_mw(1000);
+			paths.push_back(path);
+		}
+		updater_thr = std::thread(&StatusServer::Update, this);
+	}
+
+	~StatusServer() {
+		Stop();
+	}
+
+	void Stop() {
+		std::unique_lock<std::mutex> status_ul(status_mtx);
+		if (stopping)
+			return;
+		stopping = true;
+		status_cv.notify_all();
+		status_ul.unlock();
+		updater_thr.join();
+	}
+
+	std::vector<std::string> const & Paths() const {
+		return paths;
+	}
+
+	grpc::Status GetResourceStatus(
+			grpc::ServerContext *,
+			const bbque::ResourceStatusRequest * request,
+			bbque::ResourceStatusReply * reply) override {
+		std::unique_lock<std::mutex> status_ul(status_mtx);
+		auto it = resources.find(request->path());
+		if (it == resources.end())
+			return grpc::Status::CANCELLED;
+		*reply = it->second;
+		return grpc::Status::OK;
+	}
+
+	grpc::Status SubscribeStatus(
+			grpc::ServerContext * context,
+			const bbque::StatusSubscriptionRequest * request,
+			grpc::ServerWriter<bbque::StatusUpdate> * writer) override {
+		std::map<std::string, std::string> last_sent;
+		uint64_t seq = 0;
+
+		std::unique_lock<std::mutex> status_ul(status_mtx);
+		while (!stopping && !context->IsCancelled()) {
+			bbque::StatusUpdate update;
+			update.set_seq(seq);
+			for (auto const & entry: resources) {
+				std::string status_str(entry.second.SerializeAsString());
+				auto it = last_sent.find(entry.first);
+				if ((it != last_sent.end()) && (it->second == status_str))
+					continue;
+				last_sent[entry.first] = status_str;
+				auto delta = update.add_resources();
+				delta->set_path(entry.first);
+				*delta->mutable_status() = entry.second;
+			}
+			status_ul.unlock();
+
+			if ((update.resources_size() > 0) && !writer->Write(update))
+				break;
+			++seq;
+
+			status_ul.lock();
+			status_cv.wait_for(status_ul,
+				std::chrono::milliseconds(request->period_ms()));
+		}
+		return grpc::Status::OK;
+	}
+
+private:
+
+	uint32_t const period_ms;
+
+	uint32_t const changed_pc;
+
+	std::map<std::string, bbque::ResourceStatusReply> resources;
+
+	std::vector<std::string> paths;
+
+	std::mutex status_mtx;
+
+	std::condition_variable status_cv;
+
+	bool stopping = false;
+
+	std::thread updater_thr;
+
+	/** Change the status of changed_pc% of the resources every period */
+	void Update() {
+		uint32_t next = 0;
+		uint32_t nr_changed = std::max<uint32_t>(
+			1, paths.size() * changed_pc / 100);
+		std::unique_lock<std::mutex> status_ul(status_mtx);
+		while (!stopping) {
+			for (uint32_t i = 0; i < nr_changed; ++i) {
+				auto & status(resources[paths[next]]);
+				status.set_used((status.used() + 7) % 100);
+				status.set_load(status.used());
+				status.set_temperature(40000 + 100 * (next % 50));
+				next = (next + 1) % paths.size();
+			}
+			status_cv.wait_for(status_ul, std::chrono::milliseconds(period_ms));
+		}
+	}
+
+};
+
+/**
+ * @class StatusCache
+ *
+ * The client side of the stream: the updates merged into a local cache,
+ * as in RemotePlatformProxy
+ */
+class StatusCache {
+
+public:
+
+	StatusCache(bbque::RemoteAgent::Stub * stub, uint32_t period_ms) {
+		bbque::StatusSubscriptionRequest request;
+		request.set_period_ms(period_ms);
+		reader_thr = std::thread([this, stub, request]() {
+			auto reader(stub->SubscribeStatus(&context, request));
+			bbque::StatusUpdate update;
+			while (reader->Read(&update)) {
+				std::unique_lock<std::mutex> cache_ul(cache_mtx);
+				for (auto const & delta: update.resources())
+					cache[delta.path()] = delta.status();
+				nr_updates++;
+				update_bytes += update.ByteSizeLong();
+				cache_cv.notify_all();
+			}
+			reader->Finish();
+		});
+	}
+
+	~StatusCache() {
+		context.TryCancel();
+		reader_thr.join();
+	}
+
+	void WaitForEntries(size_t count) {
+		std::unique_lock<std::mutex> cache_ul(cache_mtx);
+		cache_cv.wait(cache_ul, [&]() { return cache.size() >= count; });
+		nr_updates = 0;
+		update_bytes = 0;
+	}
+
+	bool Get(std::string const & path, bbque::ResourceStatusReply & status) {
+		std::unique_lock<std::mutex> cache_ul(cache_mtx);
+		auto it = cache.find(path);
+		if (it == cache.end())
+			return false;
+		status = it->second;
+		return true;
+	}
+
+	std::atomic<uint64_t> nr_updates{0};
+
+	std::atomic<uint64_t> update_bytes{0};
+
+private:
+
+	grpc::ClientContext context;
+
+	std::map<std::string, bbque::ResourceStatusReply> cache;
+
+	std::mutex cache_mtx;
+
+	std::condition_variable cache_cv;
+
+	std::thread reader_thr;
+
+};
+
+static void RunCase(uint32_t nr_resources, uint32_t period_ms,
+		uint32_t changed_pc, uint32_t rounds) {
+	StatusServer server(nr_resources, period_ms, changed_pc);
+	int port = 0;
+	grpc::ServerBuilder builder;
+	builder.AddListeningPort("127.0.0.1:0",
+		grpc::InsecureServerCredentials(), &port);
+	builder.RegisterService(&server);
+	std::unique_ptr<grpc::Server> grpc_server(builder.BuildAndStart());
+	if (!grpc_server) {
+		fprintf(stderr, "Server not started\n");
+		exit(EXIT_FAILURE);
+	}
+
+	auto channel(grpc::CreateChannel("127.0.0.1:" + std::to_string(port),
+		grpc::InsecureChannelCredentials()));
+	auto stub(bbque::RemoteAgent::NewStub(channel));
+	bbque::ResourceStatusReply status;
+
+	// Polling: a remote call per resource
+	double poll_us = 0;
+	size_t poll_bytes = 0;
+	for (uint32_t r = 0; r < rounds; ++r) {
+		auto start = Clock::now();
+		for (auto const & path: server.Paths()) {
+			bbque::ResourceStatusRequest request;
+			request.set_path(path);
+			grpc::ClientContext context;
+			if (!stub->GetResourceStatus(&context, request, &status).ok()) {
+				fprintf(stderr, "Polling %s failed\n", path.c_str());
+				exit(EXIT_FAILURE);
+			}
+			if (r == 0)
+				poll_bytes += request.ByteSizeLong() + status.ByteSizeLong();
+		}
+		poll_us += ElapsedUs(start);
+	}
+
+	// Streaming: the rounds read the cache, over the same time span
+	double cache_us = 0;
+	StatusCache cache(stub.get(), period_ms);
+	cache.WaitForEntries(nr_resources);
+	auto stream_start = Clock::now();
+	for (uint32_t r = 0; r < rounds; ++r) {
+		auto start = Clock::now();
+		for (auto const & path: server.Paths()) {
+			if (!cache.Get(path, status)) {
+				fprintf(stderr, "Missing %s in the cache\n", path.c_str());
+				exit(EXIT_FAILURE);
+			}
+		}
+		cache_us += ElapsedUs(start);
+		std::this_thread::sleep_for(std::chrono::milliseconds(period_ms) / 4);
+	}
+	double stream_s = ElapsedUs(stream_start) / 1e6;
+
+	server.Stop();
+	grpc_server->Shutdown();
+	double updates_per_s = cache.nr_updates / stream_s;
+	printf("%9u %15.1f %16.2f %14zu %16.0f %10.1f\n",
+		nr_resources, poll_us / rounds, cache_us / rounds, poll_bytes,
+		cache.nr_updates ? double(cache.update_bytes) / cache.nr_updates : 0.0,
+		updates_per_s);
+}
+
+int main(int argc, char *argv[]) {
+	uint32_t period_ms  = (argc > 1) ? atoi(argv[1]) : 50;
+	uint32_t changed_pc = (argc > 2) ? atoi(argv[2]) : 10;
+	uint32_t rounds     = (argc > 3) ? atoi(argv[3]) : 40;
+
+	printf("Period %u ms, %u%% of the resources changed per period, "
+		"%u rounds\n", period_ms, changed_pc, rounds);
+	printf("%9s %15s %16s %14s %16s %10s\n", "resources", "poll round [us]",
+		"cache round [us]", "poll B/round", "stream B/update", "updates/s");
+	for (uint32_t nr_resources: { 16, 64, 256, 1024 })
+		RunCase(nr_resources, period_ms, changed_pc, rounds);
+
+	return EXIT_SUCCESS;
+}
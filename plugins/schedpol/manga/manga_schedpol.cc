@@ -214,6 +214,9 @@ MangASchedPol::ServeApplicationsWithPriority(int priority) noexcept {
 	ba::AppCPtr_t  papp;
 	AppsUidMapIt app_iterator;
 
+	// Skim the waiting applications in parallel, then serve them in order
+	PrefetchPartitions(priority);
+
 	// Get all the applications @ this priority
 	papp = sys->GetFirstWithPrio(priority, app_iterator);
 	for (; papp; papp = sys->GetNextWithPrio(priority, app_iterator)) {
@@ -266,6 +269,39 @@ MangASchedPol::ServeApplicationsWithPriority(int priority) noexcept {
 }
 
 
+void MangASchedPol::PrefetchPartitions(int priority) noexcept {
+	ba::AppCPtr_t papp;
+	AppsUidMapIt app_iterator;
+
+	std::vector<uint32_t> cluster_ids;
+	for (uint32_t cluster_id = 0; cluster_id < pe_per_acc.size(); ++cluster_id)
+		cluster_ids.push_back(cluster_id);
+
+	// The first mapping option of each task-graph, as ServeApp() starts
+	std::vector<std::future<void>> pending;
+	papp = sys->GetFirstWithPrio(priority, app_iterator);
+	for (; papp; papp = sys->GetNextWithPrio(priority, app_iterator)) {
+		if (papp->Disabled() || papp->Running())
+			continue;
+		if (InitTaskGraphMappingOptions(papp) != SCHED_OK)
+			continue;
+
+		// Independent task-graphs: skim in parallel
+		auto tg(papp->GetTaskGraph());
+		pending.push_back(std::async(std::launch::async,
+			[this, tg, &cluster_ids]() {
+				std::map<uint32_t, std::list<Partition>> partitions;
+				std::map<uint32_t, ResourcePartitionValidator::ExitCode_t> results;
+				rmv.LoadPartitions(*tg, cluster_ids, partitions, results);
+			}));
+	}
+
+	for (auto & p: pending)
+		p.get();
+	logger->Debug("PrefetchPartitions: %d task-graphs skimmed [priority=%d]",
+		pending.size(), priority);
+}
+
 SchedulerPolicyIF::ExitCode_t MangASchedPol::ServeApp(ba::AppCPtr_t papp) noexcept {
 	ExitCode_t err = SCHED_OK;
 
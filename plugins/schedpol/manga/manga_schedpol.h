@@ -120,6 +120,16 @@ private:
 
 	ExitCode_t ServeApplicationsWithPriority(int priority) noexcept;
 
+	/**
+	 * @brief Skim the task-graphs of the applications waiting at the given
+	 * priority level, concurrently and on all the HN clusters
+	 *
+	 * The partitions found are not used here: they fill the cache of the
+	 * validator, so that serving the applications in order finds them
+	 * there, as long as the resource availability does not change.
+	 */
+	void PrefetchPartitions(int priority) noexcept;
+
 	ExitCode_t ServeApp(ba::AppCPtr_t papp) noexcept;
 
 	ExitCode_t InitTaskGraphMappingOptions(ba::AppCPtr_t papp) noexcept;
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * MMKP solver vs a YaMCA-like greedy allocation
+ *
+ * The instances have the shape of the TestPlatformProxy simulator defaults:
+ * 4 CPUs of 4 PEs (400% CPU quota) and 1024 MB each, 8 recipes of 4 AWMs
+ * with increasing CPU quota (up to 100-400%), memory (16 MB steps) and
+ * value, EXCs with random recipe and priority.
+ *
+ * The values are weighted by priority as in the MMKP policy. The greedy
+ * baseline serves the EXCs by priority and gives each one the AWM of
+ * highest value that fits in a CPU, taking the CPUs in order, as YaMCA does
+ * when the contention is low.
+ *
+ * Usage: bbque-mmkp-bench [time budget us] [exact max space] [runs]
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "bbque/utils/timer.h"
+#include "mmkp_solver.h"
+
+using bbque::plugins::MMKPSolver;
+
+#define BENCH_CPUS        4
+#define BENCH_PES         4
+#define BENCH_MEM_MB      1024
+#define BENCH_RECIPES     8
+#define BENCH_AWMS        4
+#define BENCH_MAX_QUOTA   400
+#define BENCH_PRIO_LEVELS 5
+
+struct AWM_t {
+	double value;
+	uint64_t quota;
+	uint64_t mem_mb;
+};
+
+struct EXC_t {
+	int prio;
+	std::vector<AWM_t> const * awms;
+};
+
+struct Totals_t {
+	double greedy_value   = 0;
+	double mmkp_value     = 0;
+	double upper_bound    = 0;
+	double greedy_quota   = 0;
+	double mmkp_quota     = 0;
+	double greedy_hiprio  = 0;
+	double mmkp_hiprio    = 0;
+	double gap            = 0;
+	double time_us        = 0;
+	int optimal           = 0;
+};
+
+/** Value of an AWM for an EXC, as in the MMKP policy */
+static double Weighted(EXC_t const & exc, AWM_t const & awm) {
+	return std::ldexp(awm.value, BENCH_PRIO_LEVELS - 1 - exc.prio);
+}
+
+static void Greedy(std::vector<EXC_t> const & excs, Totals_t & totals) {
+	std::vector<uint64_t> quota(BENCH_CPUS, BENCH_PES * 100);
+	std::vector<uint64_t> mem(BENCH_CPUS, BENCH_MEM_MB);
+
+	std::vector<size_t> order(excs.size());
+	for (size_t i = 0; i < order.size(); ++i)
+		order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+		return excs[a].prio < excs[b].prio; });
+
+	for (auto i: order) {
+		auto const & exc(excs[i]);
+		// The AWMs are in increasing value order
+		bool done = false;
+		for (auto awm = exc.awms->rbegin(); awm != exc.awms->rend() && !done;
+				++awm) {
+			for (int c = 0; c < BENCH_CPUS && !done; ++c) {
+				if ((awm->quota > quota[c]) || (awm->mem_mb > mem[c]))
+					continue;
+				quota[c] -= awm->quota;
+				mem[c]   -= awm->mem_mb;
+				totals.greedy_value += Weighted(exc, *awm);
+				totals.greedy_quota += awm->quota;
+				if (exc.prio == 0)
+					totals.greedy_hiprio += awm->value;
+				done = true;
+			}
+		}
+	}
+}
+
+static void Solve(std::vector<EXC_t> const & excs, double budget_us,
+		uint64_t exact_max, Totals_t & totals) {
+	// Two dimensions per CPU: quota and memory
+	std::vector<uint64_t> capacities;
+	for (int c = 0; c < BENCH_CPUS; ++c) {
+		capacities.push_back(BENCH_PES * 100);
+		capacities.push_back(BENCH_MEM_MB);
+	}
+
+	bbque::utils::Timer timer;
+	timer.start();
+	MMKPSolver solver(capacities);
+	for (auto const & exc: excs) {
+		uint32_t class_id = solver.AddClass();
+		for (size_t a = 0; a < exc.awms->size(); ++a) {
+			auto const & awm((*exc.awms)[a]);
+			for (int c = 0; c < BENCH_CPUS; ++c)
+				solver.AddItem(class_id, a * BENCH_CPUS + c,
+					Weighted(exc, awm),
+					{ { 2 * c, awm.quota }, { 2 * c + 1, awm.mem_mb } });
+		}
+	}
+	auto result = solver.Solve(budget_us, exact_max);
+	totals.time_us += timer.getElapsedTimeUs();
+
+	for (size_t i = 0; i < excs.size(); ++i) {
+		int32_t selected = solver.Selected(i);
+		if (selected < 0)
+			continue;
+		auto const & awm((*excs[i].awms)[selected / BENCH_CPUS]);
+		totals.mmkp_quota += awm.quota;
+		if (excs[i].prio == 0)
+			totals.mmkp_hiprio += awm.value;
+	}
+	totals.mmkp_value  += solver.Value();
+	totals.upper_bound += solver.UpperBound();
+	totals.gap         += solver.Gap();
+	if (result == MMKPSolver::MMKP_OPTIMAL)
+		totals.optimal++;
+}
+
+int main(int argc, char *argv[]) {
+	double budget_us   = (argc > 1) ? atof(argv[1]) : 5000;
+	uint64_t exact_max = (argc > 2) ? atoi(argv[2]) : 32;
+	int runs           = (argc > 3) ? atoi(argv[3]) : 20;
+	std::mt19937 rng(0);
+
+	// The simulator recipes
+	std::uniform_int_distribution<uint32_t> quota_dist(10, BENCH_MAX_QUOTA / 10);
+	std::vector<std::vector<AWM_t>> recipes(BENCH_RECIPES);
+	for (auto & awms: recipes) {
+		uint32_t quota_max = 10 * quota_dist(rng);
+		for (int a = 0; a < BENCH_AWMS; ++a)
+			awms.push_back({
+				100.0 * (a + 1) / BENCH_AWMS,
+				std::max<uint64_t>(quota_max * (a + 1) / BENCH_AWMS, 1),
+				16u * (a + 1) });
+	}
+
+	printf("%d CPUs x %d PEs, budget %.0f us, %d runs per size\n",
+		BENCH_CPUS, BENCH_PES, budget_us, runs);
+	printf("%5s %10s %10s %8s %10s %6s %5s %14s %16s %9s\n",
+		"EXCs", "greedy", "mmkp", "gain", "bound", "gap", "opt",
+		"quota gr/mmkp", "hi-prio gr/mmkp", "time");
+	std::uniform_int_distribution<size_t> recipe_dist(0, BENCH_RECIPES - 1);
+	std::uniform_int_distribution<int> prio_dist(0, BENCH_PRIO_LEVELS - 1);
+	for (int nr_excs: { 4, 8, 16, 32, 64, 128 }) {
+		Totals_t totals;
+		for (int r = 0; r < runs; ++r) {
+			std::vector<EXC_t> excs(nr_excs);
+			for (auto & exc: excs) {
+				exc.awms = &recipes[recipe_dist(rng)];
+				exc.prio = prio_dist(rng);
+			}
+			Greedy(excs, totals);
+			Solve(excs, budget_us, exact_max, totals);
+		}
+
+		double cpu_quota = BENCH_CPUS * BENCH_PES * 100.0 * runs;
+		printf("%5d %10.1f %10.1f %7.1f%% %10.1f %5.2f%% %2d/%-2d %6.1f%%/%5.1f%% "
+			"%8.1f/%7.1f %7.0fus\n",
+			nr_excs, totals.greedy_value / runs, totals.mmkp_value / runs,
+			100 * (totals.mmkp_value - totals.greedy_value) / totals.greedy_value,
+			totals.upper_bound / runs, 100 * totals.gap / runs,
+			totals.optimal, runs,
+			100 * totals.greedy_quota / cpu_quota,
+			100 * totals.mmkp_quota / cpu_quota,
+			totals.greedy_hiprio / runs, totals.mmkp_hiprio / runs,
+			totals.time_us / runs);
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mmkp_schedpol.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+
+#include "bbque/application_manager.h"
+#include "bbque/modules_factory.h"
+#include "bbque/system.h"
+#include "bbque/app/application.h"
+#include "bbque/app/working_mode.h"
+#include "bbque/res/resource_path.h"
+
+/** Metrics (class SAMPLE) declaration */
+#define MMKP_SAMPLE_METRIC(NAME, DESC)\
+ {SCHEDULER_MANAGER_NAMESPACE ".mmkp." NAME, DESC, \
+	 bu::MetricsCollector::SAMPLE, 0, NULL, 0}
+
+/** Metrics (class COUNTER) declaration */
+#define MMKP_COUNTER_METRIC(NAME, DESC)\
+ {SCHEDULER_MANAGER_NAMESPACE ".mmkp." NAME, DESC, \
+	 bu::MetricsCollector::COUNTER, 0, NULL, 0}
+
+namespace po = boost::program_options;
+
+namespace bbque { namespace plugins {
+
+MetricsCollector::MetricsCollection_t
+MMKPSchedPol::coll_metrics[MMKP_METRICS_COUNT] = {
+	MMKP_SAMPLE_METRIC("time",
+			"Time to solve the AWM assignment problem [ms]"),
+	MMKP_SAMPLE_METRIC("gap",
+			"Distance of the solution from the upper bound [%]"),
+	MMKP_SAMPLE_METRIC("gain",
+			"Value improvement over the greedy solution [%]"),
+	MMKP_COUNTER_METRIC("optimal",
+			"Number of solutions proven optimal")
+};
+
+// :::::::::::::::::::::: Static plugin interface ::::::::::::::::::::::::::::
+
+void * MMKPSchedPol::Create(PF_ObjectParams *) {
+	return new MMKPSchedPol();
+}
+
+int32_t MMKPSchedPol::Destroy(void * plugin) {
+	if (!plugin)
+		return -1;
+	delete (MMKPSchedPol *)plugin;
+	return 0;
+}
+
+// ::::::::::::::::::::: Scheduler policy module interface :::::::::::::::::::
+
+char const * MMKPSchedPol::Name() {
+	return SCHEDULER_POLICY_NAME;
+}
+
+MMKPSchedPol::MMKPSchedPol():
+		cm(ConfigurationManager::GetInstance()),
+		ra(ResourceAccounter::GetInstance()),
+		bdm(BindingManager::GetInstance()),
+		mc(MetricsCollector::GetInstance()) {
+	logger = bu::Logger::GetLogger(MODULE_NAMESPACE);
+	assert(logger);
+	logger->Debug("Built MMKP SchedPol object @%p", (void*)this);
+
+	// Configuration parameters
+	po::options_description opts_desc("MMKP scheduling policy parameters");
+	opts_desc.add_options()
+		(SCHEDULER_POLICY_CONFIG".binding.domain",
+		 po::value<std::string>
+		 (&binding_domain)->default_value(SCHEDULER_DEFAULT_BINDING_DOMAIN),
+		"Resource binding domain")
+		(MODULE_CONFIG".time_budget_ms",
+		 po::value<uint32_t>
+		 (&time_budget_ms)->default_value(MMKP_DEFAULT_TIME_BUDGET_MS),
+		"Time available to improve the greedy solution [ms]")
+		(MODULE_CONFIG".exact_max_space",
+		 po::value<uint64_t>
+		 (&exact_max_space)->default_value(MMKP_DEFAULT_EXACT_MAX_SPACE),
+		"Maximum number of AWM combinations for an exact solving")
+	;
+	po::variables_map opts_vm;
+	cm.ParseConfigurationFile(opts_desc, opts_vm);
+
+	// Binding domain resource type
+	br::ResourcePath rp(binding_domain);
+	binding_type = rp.Type();
+	logger->Info("Binding domain: '%s' time budget: %d ms exact max space: %lu",
+			binding_domain.c_str(), time_budget_ms, exact_max_space);
+
+	mc.Register(coll_metrics, MMKP_METRICS_COUNT);
+}
+
+
+MMKPSchedPol::~MMKPSchedPol() {
+
+}
+
+
+SchedulerPolicyIF::ExitCode_t MMKPSchedPol::Init() {
+	// Build a string path for the resource state view
+	std::string token_path(MODULE_NAMESPACE);
+	++status_view_count;
+	token_path.append(std::to_string(status_view_count));
+	logger->Debug("Init: Require a new resource state view [%s]",
+		token_path.c_str());
+
+	// Get a fresh resource status view
+	ResourceAccounterStatusIF::ExitCode_t ra_result =
+		ra.GetView(token_path, sched_status_view);
+	if (ra_result != ResourceAccounterStatusIF::RA_SUCCESS) {
+		logger->Fatal("Init: cannot get a resource state view");
+		return SCHED_ERROR_VIEW;
+	}
+	logger->Debug("Init: resources state view token: %ld", sched_status_view);
+
+	classes.clear();
+	dimensions.clear();
+	capacities.clear();
+
+	return SCHED_OK;
+}
+
+
+SchedulerPolicyIF::ExitCode_t MMKPSchedPol::Schedule(
+		System & system,
+		RViewToken_t & status_view) {
+	sys = &system;
+	ExitCode_t result = Init();
+	if (result != SCHED_OK)
+		return result;
+
+	// The knapsack problem: the EXCs with their bound AWMs
+	AppsUidMapIt app_it;
+	ba::AppCPtr_t papp = sys->GetFirstRunning(app_it);
+	for (; papp; papp = sys->GetNextRunning(app_it))
+		AddApplication(papp);
+	papp = sys->GetFirstReady(app_it);
+	for (; papp; papp = sys->GetNextReady(app_it)) {
+		if (IsOffloaded(papp))
+			continue;
+		AddApplication(papp);
+	}
+	logger->Debug("Schedule: %d EXCs on %d resources",
+		classes.size(), capacities.size());
+
+	MMKPSolver solver(capacities);
+	for (auto const & exc: classes) {
+		uint32_t class_id = solver.AddClass();
+		for (uint32_t i = 0; i < exc.candidates.size(); ++i) {
+			auto const & cand(exc.candidates[i]);
+			solver.AddItem(class_id, i, cand.value, cand.weights);
+		}
+	}
+
+	// Solve and send the schedule requests
+	Timer solving_tmr;
+	solving_tmr.start();
+	MMKPSolver::ExitCode_t solver_result =
+		solver.Solve(time_budget_ms * 1000.0, exact_max_space);
+	double solving_time_ms = solving_tmr.getElapsedTimeMs();
+	ReportSolution(solver, solver_result, solving_time_ms);
+	ApplySolution(solver);
+
+	classes.clear();
+	status_view = sched_status_view;
+	return SCHED_DONE;
+}
+
+
+void MMKPSchedPol::AddApplication(ba::AppCPtr_t papp) {
+	// Skip if disabled in the meanwhile, or already scheduled
+	auto const snap = papp->GetSchedulingSnapshot();
+	if (!snap.Active() && !snap.Blocking()) {
+		logger->Debug("AddApplication: [%s] skipped (not active)",
+			papp->StrId());
+		return;
+	}
+	if (snap.has_next_awm) {
+		logger->Debug("AddApplication: [%s] skipped (already scheduled)",
+			papp->StrId());
+		return;
+	}
+
+	BindingMap_t & bindings(bdm.GetBindingDomains());
+	auto const bd_it = bindings.find(binding_type);
+	if (bd_it == bindings.end()) {
+		logger->Error("AddApplication: no binding domains of type <%s>",
+			br::GetResourceTypeString(binding_type));
+		return;
+	}
+
+	classes.emplace_back();
+	Class_t & exc(classes.back());
+	exc.papp = papp;
+	// A dominated AWM (lower value, more of every resource) is never
+	// selected: it fits only where the dominating one fits too
+	for (auto const & pawm: papp->ParetoWorkingModes()) {
+		for (BBQUE_RID_TYPE bd_id: bd_it->second->r_ids)
+			AddCandidate(exc, pawm, bd_id);
+	}
+	logger->Debug("AddApplication: [%s] %d candidates",
+		papp->StrId(), exc.candidates.size());
+}
+
+
+void MMKPSchedPol::AddCandidate(
+		Class_t & exc,
+		ba::AwmPtr_t pawm,
+		BBQUE_RID_TYPE bd_id) {
+	Candidate_t cand;
+	cand.binding = pawm->GetBindingCandidate(binding_type, bd_id);
+	if (cand.binding.Empty()) {
+		logger->Debug("AddCandidate: %s nothing to bind into <%s%d>",
+			pawm->StrId(), br::GetResourceTypeString(binding_type), bd_id);
+		return;
+	}
+
+	// Priority weighted value: each priority level doubles the value of
+	// the lower one
+	AppPrio_t prio_levels =
+		sys->ApplicationLowestPriority() - exc.papp->Priority();
+	cand.pawm   = pawm;
+	cand.value  = std::ldexp(pawm->Value(), prio_levels);
+
+	// Weights: the amount of each bound resource request. Each bound
+	// resource path is a dimension of the knapsack.
+	br::BindingCandidate const & binding(cand.binding);
+	for (size_t i = 0; i < binding.Size(); ++i) {
+		std::pair<br::ResourcePath const *, BBQUE_RID_TYPE> const dim_key(
+			binding.DomainPath(i).get(),
+			binding.IsBound(i) ? bd_id : R_ID_ANY);
+		auto dim_it = dimensions.find(dim_key);
+		if (dim_it == dimensions.end()) {
+			uint64_t available = binding.Available(i, sched_status_view);
+			dim_it = dimensions.emplace(dim_key, capacities.size()).first;
+			capacities.push_back(available);
+			logger->Debug("AddCandidate: <%s> in <%s%d> available: %lu",
+				binding.DomainPath(i)->ToString().c_str(),
+				br::GetResourceTypeString(binding_type), bd_id,
+				available);
+		}
+		cand.weights.emplace_back(dim_it->second, binding.Amount(i));
+	}
+
+	exc.candidates.push_back(std::move(cand));
+}
+
+
+void MMKPSchedPol::ApplySolution(MMKPSolver const & solver) {
+	std::vector<uint32_t> rejected;
+
+	// The selected candidates first
+	for (uint32_t c = 0; c < classes.size(); ++c) {
+		int32_t selected = solver.Selected(c);
+		if ((selected >= 0) &&
+				ScheduleCandidate(classes[c], classes[c].candidates[selected]))
+			continue;
+		rejected.push_back(c);
+	}
+
+	// Then, the others take what is left
+	for (uint32_t c: rejected) {
+		auto & candidates(classes[c].candidates);
+		std::stable_sort(candidates.begin(), candidates.end(),
+			[](Candidate_t const & c1, Candidate_t const & c2) {
+				return c1.value > c2.value;
+			});
+		for (auto const & cand: candidates) {
+			if (ScheduleCandidate(classes[c], cand))
+				break;
+		}
+	}
+}
+
+
+bool MMKPSchedPol::ScheduleCandidate(
+		Class_t const & exc,
+		Candidate_t const & cand) {
+	int32_t b_refn = cand.pawm->BindResource(cand.binding);
+	if (b_refn < 0) {
+		logger->Debug("ScheduleCandidate: %s binding to <%s%d> failed",
+			cand.pawm->StrId(), br::GetResourceTypeString(binding_type),
+			cand.binding.DomainID());
+		return false;
+	}
+
+	ApplicationManager & am(ApplicationManager::GetInstance());
+	auto am_ret = am.ScheduleRequest(
+		exc.papp, cand.pawm, sched_status_view, b_refn);
+	if (am_ret != ApplicationManager::AM_SUCCESS) {
+		logger->Debug("ScheduleCandidate: %s [refn=%d] rejected",
+			cand.pawm->StrId(), b_refn);
+		return false;
+	}
+
+	logger->Info("ScheduleCandidate: %s [refn=%d] scheduled (value=%.4f)",
+		cand.pawm->StrId(), b_refn, cand.value);
+	return true;
+}
+
+
+void MMKPSchedPol::ReportSolution(
+		MMKPSolver const & solver,
+		MMKPSolver::ExitCode_t result,
+		double solving_time_ms) {
+	static char const * result_str[] = {
+		"empty", "greedy", "improved", "optimal"};
+
+	if (result == MMKPSolver::MMKP_EMPTY) {
+		logger->Debug("ReportSolution: nothing to schedule");
+		return;
+	}
+
+	// Solution quality vs. time
+	for (auto const & sample: solver.Trace()) {
+		logger->Debug("ReportSolution: t=%9.1f us value=%.4f",
+			sample.time_us, sample.value);
+	}
+
+	double gain = 0.0;
+	if (solver.GreedyValue() > 0.0)
+		gain = (solver.Value() / solver.GreedyValue() - 1.0) * 100.0;
+	logger->Info("ReportSolution: %s solution in %.3f ms [nodes=%lu]: "
+		"value=%.4f greedy=%.4f (+%.1f%%) bound=%.4f gap=%.2f%%",
+		result_str[result], solving_time_ms, solver.NodesCount(),
+		solver.Value(), solver.GreedyValue(), gain,
+		solver.UpperBound(), solver.Gap() * 100.0);
+
+	mc.AddSample(coll_metrics[MMKP_SOLVING_TIME].mh, solving_time_ms);
+	mc.AddSample(coll_metrics[MMKP_GAP].mh, solver.Gap() * 100.0);
+	mc.AddSample(coll_metrics[MMKP_GAIN].mh, gain);
+	if (result == MMKPSolver::MMKP_OPTIMAL)
+		mc.Count(coll_metrics[MMKP_OPTIMAL].mh);
+}
+
+} // namespace plugins
+
+} // namespace bbque
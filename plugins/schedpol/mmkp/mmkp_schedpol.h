@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_MMKP_SCHEDPOL_H_
+#define BBQUE_MMKP_SCHEDPOL_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bbque/binding_manager.h"
+#include "bbque/configuration_manager.h"
+#include "bbque/plugins/plugin.h"
+#include "bbque/plugins/scheduler_policy.h"
+#include "bbque/res/binding_candidate.h"
+#include "bbque/scheduler_manager.h"
+#include "bbque/utils/logging/logger.h"
+#include "bbque/utils/metrics_collector.h"
+
+#include "mmkp_solver.h"
+
+#define SCHEDULER_POLICY_NAME "mmkp"
+
+#define MODULE_NAMESPACE SCHEDULER_POLICY_NAMESPACE "." SCHEDULER_POLICY_NAME
+#define MODULE_CONFIG SCHEDULER_POLICY_CONFIG "." SCHEDULER_POLICY_NAME
+
+/** Default time available to improve the greedy solution [ms] */
+#define MMKP_DEFAULT_TIME_BUDGET_MS   5
+/** Default maximum search space (AWM combinations) for an exact solving */
+#define MMKP_DEFAULT_EXACT_MAX_SPACE 1000000
+
+using bbque::res::RViewToken_t;
+using bbque::utils::MetricsCollector;
+using bbque::utils::Timer;
+
+namespace ba = bbque::app;
+namespace br = bbque::res;
+namespace bu = bbque::utils;
+
+// These are the parameters received by the PluginManager on create calls
+struct PF_ObjectParams;
+
+namespace bbque { namespace plugins {
+
+/**
+ * @class MMKPSchedPol
+ *
+ * @brief Scheduling policy solving the AWM assignment as a multi-choice
+ * multi-dimensional knapsack problem
+ *
+ * Each EXC to schedule is a class, whose items are the AWMs bound to each
+ * binding domain (e.g. CPU). The weights of an item are the amounts of the
+ * bound resource requests, and the capacities are the resources available in
+ * the state view. The value of an item is the AWM value, weighted by the EXC
+ * priority. The problem is solved by the MMKPSolver: a greedy solution is
+ * produced immediately and then improved within the configured time budget
+ * (or solved to optimality, if the instance is small).
+ */
+class MMKPSchedPol: public SchedulerPolicyIF {
+
+public:
+
+	// :::::::::::::::::::::: Static plugin interface :::::::::::::::::::::::::
+
+	/**
+	 * @brief Create the mmkp plugin
+	 */
+	static void * Create(PF_ObjectParams *);
+
+	/**
+	 * @brief Destroy the mmkp plugin
+	 */
+	static int32_t Destroy(void *);
+
+
+	// :::::::::::::::::: Scheduler policy module interface :::::::::::::::::::
+
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~MMKPSchedPol();
+
+	/**
+	 * @brief Return the name of the policy plugin
+	 */
+	char const * Name();
+
+	/**
+	 * @brief The member function called by the SchedulerManager to perform a
+	 * new scheduling / resource allocation
+	 */
+	ExitCode_t Schedule(System & system, RViewToken_t & status_view);
+
+private:
+
+	/**
+	 * @brief Collection of statistical metrics generated by this module
+	 */
+	enum SchedPolMetrics_t {
+		MMKP_SOLVING_TIME,
+		MMKP_GAP,
+		MMKP_GAIN,
+		MMKP_OPTIMAL,
+		MMKP_METRICS_COUNT
+	};
+
+	/**
+	 * @struct Candidate_t
+	 * @brief An AWM bound to a binding domain
+	 *
+	 * The binding is built only when the schedule request is sent.
+	 */
+	struct Candidate_t {
+		ba::AwmPtr_t pawm;
+		br::BindingCandidate binding;
+		double value;
+		MMKPSolver::Weights_t weights;
+	};
+
+	/**
+	 * @struct Class_t
+	 * @brief An EXC to schedule, with its candidate AWMs
+	 */
+	struct Class_t {
+		ba::AppCPtr_t papp;
+		std::vector<Candidate_t> candidates;
+	};
+
+	/** Configuration manager instance */
+	ConfigurationManager & cm;
+
+	/** Resource accounter instance */
+	ResourceAccounter & ra;
+
+	BindingManager & bdm;
+
+	MetricsCollector & mc;
+
+	/** System logger instance */
+	std::unique_ptr<bu::Logger> logger;
+
+	/** The base resource path for the binding step */
+	std::string binding_domain;
+
+	/** The type of resource for the binding step */
+	br::ResourceType binding_type;
+
+	/** Time available to improve the greedy solution [ms] */
+	uint32_t time_budget_ms;
+
+	/** Maximum search space (AWM combinations) for an exact solving */
+	uint64_t exact_max_space;
+
+	/** The EXCs to schedule */
+	std::vector<Class_t> classes;
+
+	/**
+	 * The index of each bound resource path (knapsack dimension), i.e. of
+	 * each (request path with any binding ID, binding domain ID) pair
+	 */
+	std::map<std::pair<br::ResourcePath const *, BBQUE_RID_TYPE>, uint32_t>
+		dimensions;
+
+	/** The available amount of each bound resource path */
+	std::vector<uint64_t> capacities;
+
+	/** Statistical metrics of the scheduling policy */
+	static MetricsCollector::MetricsCollection_t
+		coll_metrics[MMKP_METRICS_COUNT];
+
+	/**
+	 * @brief Constructor
+	 *
+	 * Plugins objects could be build only by using the "create" method.
+	 * Usually the PluginManager acts as object
+	 */
+	MMKPSchedPol();
+
+	/**
+	 * @brief Get a new resource state view
+	 */
+	ExitCode_t Init();
+
+	/**
+	 * @brief Add the EXC to the problem, with all its bound AWMs
+	 */
+	void AddApplication(ba::AppCPtr_t papp);
+
+	/**
+	 * @brief Add an AWM, bound to a binding domain, to the candidates
+	 */
+	void AddCandidate(Class_t & exc, ba::AwmPtr_t pawm, BBQUE_RID_TYPE bd_id);
+
+	/**
+	 * @brief Send the schedule requests for the solution found
+	 *
+	 * The EXCs whose selected candidate is rejected, or without a selected
+	 * candidate, try the other candidates by decreasing value.
+	 */
+	void ApplySolution(MMKPSolver const & solver);
+
+	/**
+	 * @brief Send the schedule request for a candidate
+	 */
+	bool ScheduleCandidate(Class_t const & exc, Candidate_t const & cand);
+
+	/**
+	 * @brief Report the quality of the solution
+	 */
+	void ReportSolution(MMKPSolver const & solver,
+			MMKPSolver::ExitCode_t result, double solving_time_ms);
+};
+
+} // namespace plugins
+
+} // namespace bbque
+
+#endif // BBQUE_MMKP_SCHEDPOL_H_
@@ -0,0 +1,399 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mmkp_solver.h"
+
+#include <algorithm>
+#include <cmath>
+
+/** Tolerance on the comparison of total values */
+#define MMKP_EPSILON 1e-9
+
+namespace bbque { namespace plugins {
+
+MMKPSolver::MMKPSolver(std::vector<uint64_t> const & _capacities):
+		capacities(_capacities),
+		lambda(_capacities.size(), 0.0) {
+}
+
+uint32_t MMKPSolver::AddClass() {
+	classes.emplace_back();
+	return classes.size() - 1;
+}
+
+void MMKPSolver::AddItem(
+		uint32_t class_id,
+		int32_t item_id,
+		double value,
+		Weights_t const & weights) {
+	Item_t item;
+	item.id    = item_id;
+	item.value = std::max(value, 0.0);
+
+	// Items that can never fit are useless
+	for (auto const & w: weights) {
+		if (w.second == 0)
+			continue;
+		if (w.second > capacities[w.first])
+			return;
+		item.weights.push_back(w);
+		item.norm_weights.emplace_back(w.first,
+			static_cast<double>(w.second) / capacities[w.first]);
+	}
+
+	classes[class_id].items.push_back(std::move(item));
+}
+
+
+MMKPSolver::ExitCode_t MMKPSolver::Solve(
+		double _time_budget_us,
+		uint64_t exact_max_space) {
+	timer.start();
+	time_budget_us = _time_budget_us;
+
+	// Items by decreasing value, classes by decreasing maximum value (the
+	// most valuable classes are served first by the greedy selection)
+	uint32_t nr_items = 0;
+	uint64_t space = 1;
+	exact = true;
+	order.clear();
+	for (uint32_t c = 0; c < classes.size(); ++c) {
+		auto & items(classes[c].items);
+		std::stable_sort(items.begin(), items.end(),
+			[](Item_t const & i1, Item_t const & i2) {
+				return i1.value > i2.value;
+			});
+		nr_items += items.size();
+		order.push_back(c);
+		// Search space, up to the threshold
+		uint64_t choices = items.size() + 1;
+		if (exact && (space > exact_max_space / choices))
+			exact = false;
+		space *= choices;
+	}
+	if (nr_items == 0)
+		return MMKP_EMPTY;
+
+	// Small search space: the exact solution is worth some more time
+	time_limit_us = time_budget_us;
+	if (exact)
+		time_limit_us *= MMKP_EXACT_TIME_FACTOR;
+
+	std::stable_sort(order.begin(), order.end(),
+		[this](uint32_t c1, uint32_t c2) {
+			auto const & items1(classes[c1].items);
+			auto const & items2(classes[c2].items);
+			double v1 = items1.empty() ? 0.0 : items1.front().value;
+			double v2 = items2.empty() ? 0.0 : items2.front().value;
+			return v1 > v2;
+		});
+
+	// Immediate solution
+	Greedy();
+	greedy_value = best_value;
+
+	// Upper bound, and a second greedy solution guided by the Lagrangian
+	// multipliers (i.e. the resource prices)
+	upper_bound = LagrangeBound();
+	for (auto & cl: classes) {
+		std::stable_sort(cl.items.begin(), cl.items.end(),
+			[](Item_t const & i1, Item_t const & i2) {
+				return i1.lagrange_value > i2.lagrange_value;
+			});
+	}
+	LagrangeGreedy();
+
+	// Pruning information
+	suffix_max.assign(order.size() + 1, 0.0);
+	suffix_lagrange.assign(order.size() + 1, 0.0);
+	for (int32_t d = order.size() - 1; d >= 0; --d) {
+		auto const & cl(classes[order[d]]);
+		double v_max = 0.0;
+		for (auto const & item: cl.items)
+			v_max = std::max(v_max, item.value);
+		suffix_max[d] = suffix_max[d + 1] + v_max;
+		suffix_lagrange[d] = suffix_lagrange[d + 1] + cl.lagrange_max;
+	}
+	upper_bound = std::min(upper_bound, suffix_max[0]);
+	if (best_value >= upper_bound - MMKP_EPSILON) {
+		upper_bound = best_value;
+		return MMKP_OPTIMAL;
+	}
+
+	// Improve by branch-and-bound search, visiting first the items with
+	// the highest Lagrangian value
+	residual = capacities;
+	current.assign(classes.size(), -1);
+	stopped  = false;
+	nr_nodes = 0;
+	Branch(0, 0.0);
+
+	// Completed search: optimal solution
+	if (!stopped) {
+		upper_bound = best_value;
+		return MMKP_OPTIMAL;
+	}
+	if (best_value > greedy_value + MMKP_EPSILON)
+		return MMKP_IMPROVED;
+	return MMKP_GREEDY;
+}
+
+
+void MMKPSolver::Greedy() {
+	residual = capacities;
+	current.assign(classes.size(), -1);
+
+	double value = 0.0;
+	for (uint32_t c: order) {
+		auto const & items(classes[c].items);
+		for (uint32_t i = 0; i < items.size(); ++i) {
+			if (!Fits(items[i]))
+				continue;
+			Take(items[i]);
+			current[c] = i;
+			value += items[i].value;
+			break;
+		}
+	}
+
+	best_value = -1.0;
+	Commit(value);
+}
+
+
+void MMKPSolver::LagrangeGreedy() {
+	residual = capacities;
+	current.assign(classes.size(), -1);
+
+	// The fitting item with the highest positive Lagrangian value
+	double value = 0.0;
+	for (uint32_t c: order) {
+		auto const & items(classes[c].items);
+		for (uint32_t i = 0; i < items.size(); ++i) {
+			if (items[i].lagrange_value <= 0.0)
+				break;
+			if (!Fits(items[i]))
+				continue;
+			Take(items[i]);
+			current[c] = i;
+			value += items[i].value;
+			break;
+		}
+	}
+
+	// Upgrade to higher value items with the residual capacity
+	bool upgraded = true;
+	while (upgraded) {
+		upgraded = false;
+		for (uint32_t c: order) {
+			auto const & items(classes[c].items);
+			double curr_value = 0.0;
+			if (current[c] >= 0) {
+				curr_value = items[current[c]].value;
+				Release(items[current[c]]);
+			}
+			int32_t best_i = current[c];
+			for (uint32_t i = 0; i < items.size(); ++i) {
+				if ((items[i].value > curr_value + MMKP_EPSILON) &&
+						Fits(items[i])) {
+					curr_value = items[i].value;
+					best_i = i;
+				}
+			}
+			if (best_i >= 0)
+				Take(items[best_i]);
+			if (best_i == current[c])
+				continue;
+			value += curr_value -
+				((current[c] >= 0) ? items[current[c]].value : 0.0);
+			current[c] = best_i;
+			upgraded = true;
+		}
+	}
+
+	if (value > best_value + MMKP_EPSILON)
+		Commit(value);
+}
+
+
+double MMKPSolver::LagrangeValue(
+		std::vector<double> const & lambda_try,
+		std::vector<double> & subgrad) const {
+	// Normalized capacities are all equal to 1
+	double value = 0.0;
+	subgrad.assign(capacities.size(), 1.0);
+	for (auto const & l: lambda_try)
+		value += l;
+
+	for (auto const & cl: classes) {
+		// Not selecting any item is always possible (value 0)
+		double l_max = 0.0;
+		Item_t const * i_max = nullptr;
+		for (auto const & item: cl.items) {
+			double l_value = item.value;
+			for (auto const & w: item.norm_weights)
+				l_value -= lambda_try[w.first] * w.second;
+			if (l_value > l_max) {
+				l_max = l_value;
+				i_max = &item;
+			}
+		}
+		value += l_max;
+		if (i_max == nullptr)
+			continue;
+		for (auto const & w: i_max->norm_weights)
+			subgrad[w.first] -= w.second;
+	}
+
+	return value;
+}
+
+
+double MMKPSolver::LagrangeBound() {
+	std::vector<double> lambda_try(capacities.size(), 0.0);
+	std::vector<double> subgrad;
+	double bound = LagrangeValue(lambda_try, subgrad);
+	lambda = lambda_try;
+
+	// Polyak step size, halved when the bound does not improve
+	double step_scale = 2.0;
+	uint32_t no_improve = 0;
+	for (uint32_t k = 0; k < MMKP_LAGRANGE_ITERATIONS; ++k) {
+		double norm = 0.0;
+		for (uint32_t d = 0; d < subgrad.size(); ++d) {
+			// Projection: no move below zero
+			if ((lambda_try[d] <= 0.0) && (subgrad[d] > 0.0))
+				subgrad[d] = 0.0;
+			norm += subgrad[d] * subgrad[d];
+		}
+		if (norm <= MMKP_EPSILON)
+			break;
+
+		double step = step_scale * (bound - best_value) / norm;
+		for (uint32_t d = 0; d < lambda_try.size(); ++d)
+			lambda_try[d] = std::max(0.0, lambda_try[d] - step * subgrad[d]);
+
+		double value = LagrangeValue(lambda_try, subgrad);
+		if (value < bound - MMKP_EPSILON) {
+			bound  = value;
+			lambda = lambda_try;
+			no_improve = 0;
+		}
+		else if (++no_improve == 5) {
+			step_scale /= 2.0;
+			no_improve  = 0;
+		}
+
+		if (bound <= best_value + MMKP_EPSILON)
+			break;
+		if (timer.getElapsedTimeUs() > time_limit_us)
+			break;
+	}
+
+	// Per class contributions for the bound of the partial solutions
+	for (auto & cl: classes) {
+		cl.lagrange_max = 0.0;
+		for (auto & item: cl.items) {
+			item.lagrange_value = item.value;
+			for (auto const & w: item.norm_weights)
+				item.lagrange_value -= lambda[w.first] * w.second;
+			cl.lagrange_max = std::max(cl.lagrange_max, item.lagrange_value);
+		}
+	}
+
+	return bound;
+}
+
+
+void MMKPSolver::Branch(uint32_t depth, double value) {
+	if (stopped)
+		return;
+
+	if ((++nr_nodes % MMKP_DEADLINE_CHECK_NODES) == 0 &&
+			(timer.getElapsedTimeUs() > time_limit_us)) {
+		stopped = true;
+		return;
+	}
+
+	// Complete solution
+	if (depth == order.size()) {
+		if (value > best_value + MMKP_EPSILON)
+			Commit(value);
+		return;
+	}
+
+	// Bound: the Lagrangian relaxation on the residual capacity, or the
+	// maximum values of the remaining classes
+	double bound = value + suffix_lagrange[depth];
+	for (uint32_t d = 0; d < residual.size(); ++d) {
+		if (lambda[d] > 0.0)
+			bound += lambda[d] * residual[d] / capacities[d];
+	}
+	bound = std::min(bound, value + suffix_max[depth]);
+	if (bound <= best_value + MMKP_EPSILON)
+		return;
+
+	uint32_t c = order[depth];
+	auto const & items(classes[c].items);
+	for (uint32_t i = 0; i < items.size(); ++i) {
+		if (!Fits(items[i]))
+			continue;
+		Take(items[i]);
+		current[c] = i;
+		Branch(depth + 1, value + items[i].value);
+		current[c] = -1;
+		Release(items[i]);
+		if (stopped)
+			return;
+	}
+
+	// No item selected for this class
+	Branch(depth + 1, value);
+}
+
+
+void MMKPSolver::Commit(double value) {
+	best_value = value;
+	for (uint32_t c = 0; c < classes.size(); ++c) {
+		classes[c].selected = (current[c] < 0) ?
+			-1 : classes[c].items[current[c]].id;
+	}
+	trace.push_back({timer.getElapsedTimeUs(), value});
+}
+
+
+inline bool MMKPSolver::Fits(Item_t const & item) const {
+	for (auto const & w: item.weights) {
+		if (w.second > residual[w.first])
+			return false;
+	}
+	return true;
+}
+
+inline void MMKPSolver::Take(Item_t const & item) {
+	for (auto const & w: item.weights)
+		residual[w.first] -= w.second;
+}
+
+inline void MMKPSolver::Release(Item_t const & item) {
+	for (auto const & w: item.weights)
+		residual[w.first] += w.second;
+}
+
+} // namespace plugins
+
+} // namespace bbque
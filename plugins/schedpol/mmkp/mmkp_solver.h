@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_MMKP_SOLVER_H_
+#define BBQUE_MMKP_SOLVER_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "bbque/utils/timer.h"
+
+/** Number of subgradient iterations for the Lagrangian upper bound */
+#define MMKP_LAGRANGE_ITERATIONS  1000
+
+/** Number of branch-and-bound nodes between two checks of the deadline */
+#define MMKP_DEADLINE_CHECK_NODES 256
+
+/** Hard limit of the exact solving time, in multiples of the time budget */
+#define MMKP_EXACT_TIME_FACTOR     20
+
+namespace bu = bbque::utils;
+
+namespace bbque { namespace plugins {
+
+/**
+ * @class MMKPSolver
+ *
+ * @brief Anytime solver of the multi-choice multi-dimensional knapsack
+ * problem (MMKP)
+ *
+ * Each class (i.e. an EXC) groups a set of items (i.e. the bound AWMs), each
+ * one featuring a value and a vector of weights (i.e. resource amounts), and
+ * at most one item per class can be selected. The selection must maximize the
+ * total value, without exceeding the capacity of any dimension.
+ *
+ * A greedy solution, taking the highest value item fitting in each class, is
+ * always produced first. Then the Lagrangian relaxation of the capacity
+ * constraints is solved by subgradient optimization: the multipliers give the
+ * upper bound of the optimal value and act as resource prices, driving a
+ * second greedy selection. Finally, a depth-first branch-and-bound search
+ * improves the solution until the time budget expires. If the search
+ * completes, the solution is optimal.
+ */
+class MMKPSolver {
+
+public:
+
+	/** Sparse vector of weights: (dimension, amount) */
+	typedef std::vector<std::pair<uint32_t, uint64_t>> Weights_t;
+
+	/**
+	 * @brief Quality of the solution found
+	 */
+	enum ExitCode_t {
+		/** Nothing to select */
+		MMKP_EMPTY,
+		/** Greedy solution, not improved */
+		MMKP_GREEDY,
+		/** Solution improved, optimality not proven */
+		MMKP_IMPROVED,
+		/** Optimal solution */
+		MMKP_OPTIMAL
+	};
+
+	/**
+	 * @brief A new solution found during the search
+	 */
+	struct Sample_t {
+		/** Time since the beginning of the solving [us] */
+		double time_us;
+		/** Total value of the solution */
+		double value;
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param capacities The capacity of each dimension
+	 */
+	MMKPSolver(std::vector<uint64_t> const & capacities);
+
+	/**
+	 * @brief Add a class of items
+	 *
+	 * @return The index of the class
+	 */
+	uint32_t AddClass();
+
+	/**
+	 * @brief Add an item to a class
+	 *
+	 * Items exceeding the capacity of some dimension are discarded.
+	 *
+	 * @param class_id The index of the class
+	 * @param item_id The identifier of the item, returned by Selected()
+	 * @param value The value of the item (not negative)
+	 * @param weights The weights of the item
+	 */
+	void AddItem(uint32_t class_id, int32_t item_id, double value,
+			Weights_t const & weights);
+
+	/**
+	 * @brief Solve the problem
+	 *
+	 * @param time_budget_us The time available to improve the greedy
+	 * solution
+	 * @param exact_max_space If the search space (the product of the
+	 * number of choices of each class, "no item" included) is not larger
+	 * than this, the search goes on beyond the time budget, up to
+	 * MMKP_EXACT_TIME_FACTOR times it, to find the optimal solution
+	 *
+	 * @return The quality of the solution
+	 */
+	ExitCode_t Solve(double time_budget_us, uint64_t exact_max_space);
+
+	/**
+	 * @brief The item selected for a class
+	 *
+	 * @return The item identifier, or -1 if none
+	 */
+	inline int32_t Selected(uint32_t class_id) const {
+		return classes[class_id].selected;
+	}
+
+	/**
+	 * @brief The total value of the greedy solution
+	 */
+	inline double GreedyValue() const {
+		return greedy_value;
+	}
+
+	/**
+	 * @brief The total value of the solution
+	 */
+	inline double Value() const {
+		return best_value;
+	}
+
+	/**
+	 * @brief The upper bound of the optimal total value
+	 */
+	inline double UpperBound() const {
+		return upper_bound;
+	}
+
+	/**
+	 * @brief The relative distance of the solution from the upper bound
+	 */
+	inline double Gap() const {
+		if (upper_bound <= 0.0)
+			return 0.0;
+		return (upper_bound - best_value) / upper_bound;
+	}
+
+	/**
+	 * @brief The number of branch-and-bound nodes visited
+	 */
+	inline uint64_t NodesCount() const {
+		return nr_nodes;
+	}
+
+	/**
+	 * @brief The solutions found over time (value vs. time)
+	 */
+	inline std::vector<Sample_t> const & Trace() const {
+		return trace;
+	}
+
+private:
+
+	/**
+	 * @struct Item_t
+	 * @brief An item, with weights normalized on the capacities
+	 */
+	struct Item_t {
+		int32_t id;
+		double value;
+		Weights_t weights;
+		std::vector<std::pair<uint32_t, double>> norm_weights;
+		/** Value minus the (normalized) weights priced by the multipliers */
+		double lagrange_value = 0.0;
+	};
+
+	/**
+	 * @struct Class_t
+	 * @brief A class of items
+	 */
+	struct Class_t {
+		std::vector<Item_t> items;
+		/** Item selected by the best solution */
+		int32_t selected = -1;
+		/** Maximum value of the Lagrangian relaxation over the items */
+		double lagrange_max = 0.0;
+	};
+
+	std::vector<uint64_t> capacities;
+
+	std::vector<Class_t> classes;
+
+	/** Order of visit of the classes */
+	std::vector<uint32_t> order;
+
+	/** Lagrangian multipliers, on normalized weights */
+	std::vector<double> lambda;
+
+	/** Upper bounds of the value of the classes not visited yet */
+	std::vector<double> suffix_max;
+
+	std::vector<double> suffix_lagrange;
+
+	/** Capacity not used by the current partial solution */
+	std::vector<uint64_t> residual;
+
+	/** Item index for each class in the current partial solution */
+	std::vector<int32_t> current;
+
+	double greedy_value = 0.0;
+
+	double best_value = 0.0;
+
+	double upper_bound = 0.0;
+
+	uint64_t nr_nodes = 0;
+
+	bool stopped = false;
+
+	bool exact = false;
+
+	double time_budget_us = 0.0;
+
+	/** The time limit of the current solving: the budget, or the hard
+	 * limit of the exact solving */
+	double time_limit_us = 0.0;
+
+	std::vector<Sample_t> trace;
+
+	bu::Timer timer;
+
+	/**
+	 * @brief Greedy selection of the highest value fitting items
+	 */
+	void Greedy();
+
+	/**
+	 * @brief Greedy selection of the items with the highest Lagrangian
+	 * value, followed by the upgrade of the items as long as the residual
+	 * capacity allows it
+	 */
+	void LagrangeGreedy();
+
+	/**
+	 * @brief Subgradient optimization of the Lagrangian multipliers
+	 *
+	 * @return The upper bound given by the best multipliers found
+	 */
+	double LagrangeBound();
+
+	/**
+	 * @brief Value of the Lagrangian relaxation for the given multipliers
+	 *
+	 * @param lambda_try The multipliers
+	 * @param subgrad Filled with the subgradient
+	 */
+	double LagrangeValue(std::vector<double> const & lambda_try,
+			std::vector<double> & subgrad) const;
+
+	/**
+	 * @brief Depth-first branch-and-bound from the given class
+	 */
+	void Branch(uint32_t depth, double value);
+
+	/**
+	 * @brief Save the current partial solution as the best one
+	 */
+	void Commit(double value);
+
+	bool Fits(Item_t const & item) const;
+
+	void Take(Item_t const & item);
+
+	void Release(Item_t const & item);
+};
+
+} // namespace plugins
+
+} // namespace bbque
+
+#endif // BBQUE_MMKP_SOLVER_H_
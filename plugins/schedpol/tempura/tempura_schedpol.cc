@@ -20,6 +20,8 @@
 #include <cstdlib>
 #include <cstdint>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "bbque/modules_factory.h"
 #include "bbque/power_monitor.h"
@@ -35,6 +37,8 @@
 
 #define BBQUE_TEMPURA_LITTLECPU_FIXED_BUDGET  50
 #define BBQUE_TEMPURA_CPU_LOAD_MARGIN         10
+/** Maximum correction factor of the power budgets */
+#define BBQUE_TEMPURA_POWERCAP_RANGE           2
 
 namespace br = bbque::res;
 namespace bu = bbque::utils;
@@ -136,6 +140,22 @@ TempuraSchedPol::TempuraSchedPol():
 		logger->Error("No battery available. Cannot perform energy budgeting");
 #endif
 
+#ifdef CONFIG_BBQUE_PM_POWERCAP
+	// Power budget controllers
+	po::variables_map opts_vm;
+	po::options_description opts_desc("Tempura options");
+	opts_desc.add_options()
+		(MODULE_CONFIG ".powercap.kp",
+		 po::value<float>(&powercap_kp)->default_value(BBQUE_PM_POWERCAP_KP),
+		 "Proportional gain of the power budget controller")
+		(MODULE_CONFIG ".powercap.ki",
+		 po::value<float>(&powercap_ki)->default_value(BBQUE_PM_POWERCAP_KI),
+		 "Integral gain of the power budget controller");
+	cm.ParseConfigurationFile(opts_desc, opts_vm);
+	logger->Debug("tempura: power budget controller [kp=%.2f, ki=%.2f]",
+		powercap_kp, powercap_ki);
+#endif
+
 	// System power-thermal model
 	pmodel_sys = mm.GetSystemModel();
 	if (pmodel_sys)
@@ -238,6 +258,10 @@ TempuraSchedPol::InitBudgets() {
 			// Add a budget info object
 			br::ResourcePtrList_t r_list(ra.GetResources(r_path));
 			budgets.emplace(r_path, std::make_shared<BudgetInfo>(r_path, r_list));
+#ifdef CONFIG_BBQUE_PM_POWERCAP
+			budgets[r_path]->pcc =
+				pm::PowerCapController(powercap_kp, powercap_ki);
+#endif
 			logger->Debug("Init: budgeting on '%s' [Model: %s]",
 					r_path->ToString().c_str(),
 					budgets[r_path]->model.c_str());
@@ -325,11 +349,23 @@ SchedulerPolicyIF::ExitCode_t TempuraSchedPol::ComputeBudgets() {
 		br::ResourcePathPtr_t const  & r_path(entry.first);
 		std::shared_ptr<BudgetInfo> & budget_ptr(entry.second);
 	//	bw::ModelPtr_t pmodel(mm.GetModel("ARM Cortex A15"));
+#ifdef CONFIG_BBQUE_PM_ONLINE_MODELS
+		// The online models of the resources in the budget, once trained
+		std::vector<std::string> pe_paths;
+		for (auto & rsrc: budget_ptr->r_list)
+			pe_paths.push_back(rsrc->Path());
+		bw::ModelPtr_t pmodel(mm.GetResourceModel(
+				r_path->ToString(), pe_paths, budget_ptr->model));
+#else
 		bw::ModelPtr_t pmodel(mm.GetModel(budget_ptr->model));
+#endif
 		logger->Debug("Budget: <%s> using power-thermal model '%s'",
 				r_path->ToString().c_str(), pmodel->GetID().c_str());
 
 		budget_ptr->power = GetPowerBudget(budget_ptr, pmodel);
+#ifdef CONFIG_BBQUE_PM_POWERCAP
+		budget_ptr->power = EnforcePowerBudget(budget_ptr);
+#endif
 		budget_ptr->prev  = budget_ptr->curr;
 		budget_ptr->curr  = GetResourceBudget(r_path, pmodel);
 	}
@@ -408,6 +444,45 @@ inline uint32_t TempuraSchedPol::GetPowerBudget(
 	return std::min<uint32_t>(temp_pwr_budget, energy_pwr_budget);
 }
 
+#ifdef CONFIG_BBQUE_PM_POWERCAP
+
+uint32_t TempuraSchedPol::EnforcePowerBudget(
+		std::shared_ptr<BudgetInfo> budget_ptr) {
+	PowerManager & pm(PowerManager::GetInstance());
+	PowerManager::PMResult pm_result;
+	uint32_t target_power = budget_ptr->power;
+	uint32_t curr_power = 0;
+
+	// Hard limit on the actual consumption
+	pm_result = pm.SetPowerCap(budget_ptr->r_path, target_power);
+	if (pm_result != PowerManager::PMResult::OK) {
+		logger->Debug("PowerCap: <%s> power capping not available",
+				budget_ptr->r_path->ToString().c_str());
+		return target_power;
+	}
+
+	// Correction of the budget driving the resource allocation
+	pm_result = pm.GetPowerUsage(budget_ptr->r_path, curr_power);
+	if (pm_result != PowerManager::PMResult::OK) {
+		logger->Warn("PowerCap: <%s> power consumption not available",
+				budget_ptr->r_path->ToString().c_str());
+		return target_power;
+	}
+
+	uint32_t corr_power = budget_ptr->pcc.Update(
+			target_power, curr_power,
+			target_power / BBQUE_TEMPURA_POWERCAP_RANGE,
+			target_power * BBQUE_TEMPURA_POWERCAP_RANGE);
+	logger->Debug("PowerCap: <%s> P_budget=[%d]mW P_curr=[%d]mW "
+			"=> P_corrected=[%d]mW",
+			budget_ptr->r_path->ToString().c_str(),
+			target_power, curr_power, corr_power);
+
+	return corr_power;
+}
+
+#endif // CONFIG_BBQUE_PM_POWERCAP
+
 
 inline int64_t TempuraSchedPol::GetResourceBudget(
 		br::ResourcePathPtr_t const & r_path,
@@ -28,6 +28,9 @@
 #include "bbque/plugins/scheduler_policy.h"
 #include "bbque/pm/battery_manager.h"
 #include "bbque/pm/model_manager.h"
+#ifdef CONFIG_BBQUE_PM_POWERCAP
+#include "bbque/pm/power_cap_controller.h"
+#endif
 #include "bbque/scheduler_manager.h"
 #include "bbque/resource_manager.h"
 #include "bbque/utils/metrics_collector.h"
@@ -150,6 +153,13 @@ private:
 	/** Resource power consumption derived from the system power budget */
 	uint32_t tot_resource_power_budget = 0;
 
+#ifdef CONFIG_BBQUE_PM_POWERCAP
+	/** Gains of the power budget controllers */
+	float powercap_kp;
+
+	float powercap_ki;
+#endif
+
 
 	/** Power-thermal model for the entire system  */
 	bw::SystemModelPtr_t pmodel_sys;
@@ -168,6 +178,10 @@ private:
 		uint32_t prev;
 		uint32_t curr;
 		uint32_t power;
+#ifdef CONFIG_BBQUE_PM_POWERCAP
+		/** Correction of the power budget from the measured power */
+		pm::PowerCapController pcc;
+#endif
 	};
 
 	std::map<br::ResourcePathPtr_t, std::shared_ptr<BudgetInfo>> budgets;
@@ -232,6 +246,22 @@ private:
 			std::shared_ptr<BudgetInfo> budget_ptr,
 			ModelPtr_t pmodel);
 
+#ifdef CONFIG_BBQUE_PM_POWERCAP
+	/**
+	 * @brief Enforce the power budget of a specific resource in closed-loop
+	 *
+	 * The power budget is set as power cap of the resource, while the
+	 * budget used to compute the resource amount is corrected according to
+	 * the measured power consumption, such that the consumption converges
+	 * on the budget.
+	 *
+	 * @param budget_ptr The budget information of the resource
+	 *
+	 * @return The corrected power budget (in milliwatts)
+	 */
+	uint32_t EnforcePowerBudget(std::shared_ptr<BudgetInfo> budget_ptr);
+#endif
+
 	/**
 	 * @brief Define the resource budget to allocate according to the power
 	 * budget
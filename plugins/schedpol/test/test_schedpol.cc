@@ -319,17 +319,22 @@ int32_t TestSchedPol::DoCPUBinding(
 	auto resource_path = ra.GetPath("sys0.cpu" + std::to_string(cpu_id) + ".pe");
 
 	// The ResourceBitset object is used for the processing elements binding
-	// (CPU core mapping)
-	br::ResourceBitset pes;
-	uint16_t pe_count = 0;
+	// (CPU core mapping): the processing elements still free in the CPU
+	// first, otherwise the first ones
+	BBQUE_RID_TYPE nr_pes = CPU_QUOTA_TO_ALLOCATE / 100;
+	br::ResourceBitset pes(ra.GetFreePEs(
+		"sys0.cpu" + std::to_string(cpu_id), nr_pes, sched_status_view));
 	for (auto & pe_id: pe_ids) {
+		if (pes.Count() >= nr_pes)
+			break;
 		pes.Set(pe_id);
-		ref_num = pawm->BindResource(resource_path, pes, ref_num);
-		logger->Info("DoCPUBinding: [%s] binding refn: %d",
-			pawm->StrId(), ref_num);
-		++pe_count;
-		if (pe_count == CPU_QUOTA_TO_ALLOCATE / 100) break;
 	}
+	logger->Debug("DoCPUBinding: [%s] processing elements: %s",
+		pawm->StrId(), pes.ToString().c_str());
+
+	ref_num = pawm->BindResource(resource_path, pes, ref_num);
+	logger->Info("DoCPUBinding: [%s] binding refn: %d",
+		pawm->StrId(), ref_num);
 
 	return ref_num;
 }
@@ -218,7 +218,7 @@ SchedulerPolicyIF::ExitCode_t YamcaSchedPol::SchedulePrioQueue(
 		YAMCA_RESET_TIMING(yamca_tmr);
 
 		// For each application schedule a working mode
-		SelectWorkingModes(sched_map);
+		SelectWorkingModes(sched_map, cl_id);
 
 		YAMCA_GET_TIMING(coll_metrics, YAMCA_SELECT_TIME, yamca_tmr);
 	}
@@ -257,7 +257,7 @@ SchedulerPolicyIF::ExitCode_t YamcaSchedPol::OrderSchedEntity(
 }
 
 
-void YamcaSchedPol::SelectWorkingModes(SchedEntityMap_t & sched_map) {
+void YamcaSchedPol::SelectWorkingModes(SchedEntityMap_t & sched_map, int cl_id) {
 	Application::ExitCode_t app_result;
 	logger->Debug(
 			"____________________| Scheduling entities |____________________");
@@ -281,8 +281,18 @@ void YamcaSchedPol::SelectWorkingModes(SchedEntityMap_t & sched_map) {
 				papp->StrId(),
 				eval_awm->Id());
 
+		// Bind the resource requests into the cluster: only the working
+		// modes selected are bound, the evaluation uses binding candidates
+		int32_t refn = eval_awm->BindResource(
+				br::ResourceType::CPU, R_ID_ANY, cl_id);
+		if (refn < 0) {
+			logger->Debug("Selecting: [%s] AWM{%d} binding failed",
+					papp->StrId(), eval_awm->Id());
+			continue;
+		}
+
 		// Schedule the application in the working mode just evaluated
-		app_result = papp->ScheduleRequest(eval_awm, rsrc_view_token);
+		app_result = papp->ScheduleRequest(eval_awm, rsrc_view_token, refn);
 		eval_awm->ClearSchedResourceBinding();
 
 		// Debugging messages
@@ -489,8 +499,6 @@ SchedulerPolicyIF::ExitCode_t YamcaSchedPol::GetContentionLevel(
 		ba::AwmPtr_t const & wm,
 		int cl_id,
 		float & cont_level) {
-	size_t refn;
-
 	// Safety data check
 	if (!wm) {
 		logger->Crit("Contention level: Missing working mode.\n"
@@ -500,55 +508,51 @@ SchedulerPolicyIF::ExitCode_t YamcaSchedPol::GetContentionLevel(
 		return SCHED_ERROR;
 	}
 
-	// Binding of the resources requested by the working mode into the current
-	// cluster. Note: No multi-cluster allocation supported yet!
+	// Candidate binding of the resources requested by the working mode into
+	// the current cluster. Note: No multi-cluster allocation supported yet!
 	logger->Debug("Contention level: Binding into cluster %d", cl_id);
-	refn = wm->BindResource(br::ResourceType::CPU, R_ID_ANY, cl_id, cl_id);
-	if (refn == 0)
+	br::BindingCandidate binding(
+			wm->GetBindingCandidate(br::ResourceType::CPU, cl_id));
+	if (binding.Empty())
 		logger->Error("Contention level: {AWM %d} [cluster = %d]"
-				"Incomplete resources binding. %d / %d resources bound.",
+				"No resources to bind. %d resources requested.",
 						wm->Id(), cl_id,
-						wm->GetSchedResourceBinding(refn)->size(),
 						wm->ResourceRequests().size());
 
 	// Contention level
-	return ComputeContentionLevel(
-			papp, wm->GetSchedResourceBinding(refn), cont_level);
+	return ComputeContentionLevel(papp, binding, cont_level);
 }
 
 
 SchedulerPolicyIF::ExitCode_t YamcaSchedPol::ComputeContentionLevel(
 		ba::AppCPtr_t const & papp,
-		br::ResourceAssignmentMapPtr_t const & assign_map,
+		br::BindingCandidate const & binding,
 		float & cont_level) {
 	uint64_t rsrc_avail;
 	uint64_t min_usage;
 	cont_level = 0;
 
 	// Check the availability of the resources requested
-	br::ResourceAssignmentMap_t::const_iterator usage_it(assign_map->begin());
-	br::ResourceAssignmentMap_t::const_iterator end_usage(assign_map->end());
-	while (usage_it != end_usage) {
+	for (size_t i = 0; i < binding.Size(); ++i) {
 		// Current resource
-		ResourcePathPtr_t const & rsrc_path(usage_it->first);
-		br::ResourceAssignmentPtr_t const & r_assign(usage_it->second);
+		ResourcePathPtr_t const & rsrc_path(binding.RequestPath(i));
+		uint64_t rsrc_amount = binding.Amount(i);
 
 		// Query resource availability
-		rsrc_avail = rsrc_acct.Available(r_assign->GetResourcesList(),
-				rsrc_view_token, papp);
+		rsrc_avail = binding.Available(i, rsrc_view_token, papp);
 		logger->Debug("{%s} availability = %" PRIu64,
 				rsrc_path->ToString().c_str(), rsrc_avail);
 
 		// Is the request satisfiable?
-		if (rsrc_avail < r_assign->GetAmount()) {
+		if (rsrc_avail < rsrc_amount) {
 			logger->Debug("Contention level: [%s] R=%d / A=%d",
 					rsrc_path->ToString().c_str(),
-					r_assign->GetAmount(), rsrc_avail);
+					rsrc_amount, rsrc_avail);
 
 			// Set the availability to a 1/10 of the requested amount of
 			// resource in order to increase dramatically the resulting
 			// contention level
-			rsrc_avail = 0.1 * r_assign->GetAmount();
+			rsrc_avail = 0.1 * rsrc_amount;
 		}
 
 		// Get the resource usage of the AWM with the min value
@@ -557,9 +561,7 @@ SchedulerPolicyIF::ExitCode_t YamcaSchedPol::ComputeContentionLevel(
 
 		// Update the contention level (inverse)
 		cont_level +=
-			(((float) r_assign->GetAmount()) * min_usage) / (float) rsrc_avail;
-
-		++usage_it;
+			(((float) rsrc_amount) * min_usage) / (float) rsrc_avail;
 	}
 
 	// Avoid division by zero (in the caller)
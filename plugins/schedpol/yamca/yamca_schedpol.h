@@ -23,6 +23,7 @@
 #include "bbque/scheduler_manager.h"
 #include "bbque/plugins/scheduler_policy.h"
 #include "bbque/plugins/plugin.h"
+#include "bbque/res/binding_candidate.h"
 #include "bbque/utils/logging/logger.h"
 
 #define SCHEDULER_POLICY_NAME "yamca"
@@ -187,11 +188,13 @@ private:
 	/**
 	 * @brief Schedule the entities
 	 *
-	 * For each application pick the next working mode to schedule
+	 * For each application pick the next working mode to schedule, bound
+	 * into the cluster
 	 *
 	 * @param sched_map Multimap for scheduling entities ordering
+	 * @param cl_id The current cluster
 	 */
-	void SelectWorkingModes(SchedEntityMap_t & sched_map);
+	void SelectWorkingModes(SchedEntityMap_t & sched_map, int cl_id);
 
 	/**
 	 * @brief Check if an application/EXC must be skipped
@@ -239,12 +242,12 @@ private:
 	 * @brief Compute the resource contention level
 	 *
 	 * @param papp Shared pointer to the application to schedule
-	 * @param assign_map Map of resource assignments to bind
+	 * @param binding The candidate binding of the resource requests
 	 * @param cont_level The contention level value to return
 	 * @return @see ExitCode_t
 	 */
 	ExitCode_t ComputeContentionLevel(ba::AppCPtr_t const & papp,
-			br::ResourceAssignmentMapPtr_t const & assign_map, float & cont_level);
+			br::BindingCandidate const & binding, float & cont_level);
 
 };
 
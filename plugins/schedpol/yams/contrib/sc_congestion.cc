@@ -17,6 +17,8 @@
 
 #include "sc_congestion.h"
 
+#include <algorithm>
+
 namespace po = boost::program_options;
 
 namespace bbque { namespace plugins {
@@ -86,52 +88,94 @@ SCCongestion::Init(void * params) {
 SchedContrib::ExitCode_t
 SCCongestion::_Compute(SchedulerPolicyIF::EvalEntity_t const & evl_ent,
 		float & ctrib) {
-	br::ResourceAssignmentMap_t::const_iterator usage_it;
 	ResourceThresholds_t rl;
+	ExitCode_t result;
+	ctrib = 1.0;
+
+	// No candidate bindings: iterate the whole set of (bound) resource
+	// assign_map
+	if (evl_ent.candidates.empty()) {
+		for (auto const & ru_entry:
+				*((evl_ent.pawm->GetSchedResourceBinding(evl_ent.bind_refn)).get())) {
+			ResourcePathPtr_t const & r_path(ru_entry.first);
+			br::ResourceAssignmentPtr_t const & r_assign(ru_entry.second);
+
+			// Get the region of the (next) resource usage
+			GetResourceThresholds(r_path, r_assign->GetAmount(), evl_ent, rl);
+			result = ComputeIndex(evl_ent, r_path, r_assign->GetAmount(), rl, ctrib);
+			if (result != SC_SUCCESS)
+				return result;
+		}
+		return SC_SUCCESS;
+	}
+
+	// Candidate bindings: each request is evaluated on the resources of
+	// the last candidate binding it, without binding the AWM
+	auto const & requests(evl_ent.candidates.front());
+	for (size_t i = 0; i < requests.Size(); ++i) {
+		ResourcePathPtr_t const & r_path(requests.RequestPath(i));
+		uint64_t amount = requests.Amount(i);
+
+		auto cand_it = std::find_if(evl_ent.candidates.rbegin(),
+				evl_ent.candidates.rend(),
+				[i](br::BindingCandidate const & c) { return c.IsBound(i); });
+		if (cand_it == evl_ent.candidates.rend()) {
+			GetResourceThresholds(r_path, amount, evl_ent, rl);
+		}
+		else {
+			uint64_t total = 0;
+			for (auto const & rsrc: cand_it->Resources(i))
+				total += rsrc->Total();
+			GetResourceThresholds(total, cand_it->Available(i, status_view),
+					r_path->Type(), amount, evl_ent, rl);
+		}
+
+		result = ComputeIndex(evl_ent, r_path, amount, rl, ctrib);
+		if (result != SC_SUCCESS)
+			return result;
+	}
+
+	return SC_SUCCESS;
+}
+
+SchedContrib::ExitCode_t
+SCCongestion::ComputeIndex(SchedulerPolicyIF::EvalEntity_t const & evl_ent,
+		ResourcePathPtr_t const & r_path,
+		uint64_t amount,
+		ResourceThresholds_t const & rl,
+		float & ctrib) {
 	CLEParams_t params;
 	float ru_index;
-	ctrib = 1.0;
+	logger->Debug("%s: {%s}", evl_ent.StrId(), r_path->ToString().c_str());
+
+	// If there are no free resources the index contribute is equal to 0
+	if (rl.free < amount) {
+		ctrib = 0;
+		logger->Debug("%s: {%s} U:%" PRIu64 " A:%" PRIu64,
+				evl_ent.StrId(), r_path->ToString().c_str(),
+				rl.free, amount);
+		if ((rl.free == 0) &&
+			(r_path->Type() == br::ResourceType::PROC_ELEMENT))
+			return SC_RSRC_NO_PE;
+		return SC_RSRC_UNAVL;
+	}
 
 	// Fixed function parameters
 	params.k = 1.0;
 	params.exp.base = expbase;
 
-	// Iterate the whole set of (boud) resource assign_map
-	for (auto const & ru_entry:
-			*((evl_ent.pawm->GetSchedResourceBinding(evl_ent.bind_refn)).get())) {
-		ResourcePathPtr_t const & r_path(ru_entry.first);
-		br::ResourceAssignmentPtr_t    const & r_assign(ru_entry.second);
-		logger->Debug("%s: {%s}",
-				evl_ent.StrId(), r_path->ToString().c_str());
-
-		// Get the region of the (next) resource usage
-		GetResourceThresholds(r_path, r_assign->GetAmount(), evl_ent, rl);
-
-		// If there are no free resources the index contribute is equal to 0
-		if (rl.free < r_assign->GetAmount()) {
-			ctrib = 0;
-			logger->Debug("%s: {%s} U:%" PRIu64 " A:%" PRIu64,
-					evl_ent.StrId(), r_path->ToString().c_str(),
-					rl.free, r_assign->GetAmount());
-			if ((rl.free == 0) &&
-				(r_path->Type() == br::ResourceType::PROC_ELEMENT))
-				return SC_RSRC_NO_PE;
-			return SC_RSRC_UNAVL;
-		}
+	// Set the last parameters for the index computation
+	int r_type_index = static_cast<int>(r_path->Type());
+	SetIndexParameters(rl, penalties[r_type_index], params);
 
-		// Set the last parameters for the index computation
-		int r_type_index = static_cast<int>(r_path->Type());
-		SetIndexParameters(rl, penalties[r_type_index], params);
+	// Compute the region index
+	ru_index = CLEIndex(rl.sat_lack, rl.free, amount, params);
+	logger->Debug("%s: {%s} reconfiguration index = %.4f",
+			evl_ent.StrId(), r_path->ToString().c_str(), ru_index);
 
-		// Compute the region index
-		ru_index = CLEIndex(rl.sat_lack, rl.free, r_assign->GetAmount(), params);
-		logger->Debug("%s: {%s} reconfiguration index = %.4f",
-				evl_ent.StrId(), r_path->ToString().c_str(), ru_index);
-
-		// Update the contribute if the index is lower, i.e. the most
-		// penalizing request dominates
-		ru_index < ctrib ? ctrib = ru_index: ctrib;
-	}
+	// Update the contribute if the index is lower, i.e. the most
+	// penalizing request dominates
+	ru_index < ctrib ? ctrib = ru_index: ctrib;
 
 	return SC_SUCCESS;
 }
@@ -76,6 +76,22 @@ private:
 	ExitCode_t _Compute(SchedulerPolicyIF::EvalEntity_t const & evl_ent,
 			float & ctrib);
 
+	/**
+	 * @brief Compute the congestion index of a resource request
+	 *
+	 * @param evl_ent The entity to evaluate (EXC/AWM/ClusterID)
+	 * @param r_path The path of the resource requested
+	 * @param amount The amount requested
+	 * @param rl The resource thresholds of the request
+	 * @param ctrib The contribute to update, if the index is lower
+	 *
+	 * @return SC_SUCCESS for success, SC_RSRC_UNAVL (or SC_RSRC_NO_PE)
+	 * if the amount requested is not available
+	 */
+	ExitCode_t ComputeIndex(SchedulerPolicyIF::EvalEntity_t const & evl_ent,
+			ResourcePathPtr_t const & r_path, uint64_t amount,
+			ResourceThresholds_t const & rl, float & ctrib);
+
 	/**
 	 * @brief Set the parameters for the filter function
 	 *
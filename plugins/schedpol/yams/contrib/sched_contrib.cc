@@ -88,16 +88,28 @@ void SchedContrib::GetResourceThresholds(
 		uint64_t rsrc_amount,
 		SchedulerPolicyIF::EvalEntity_t const & evl_ent,
 		ResourceThresholds_t & rl) {
+	// Total amount of resource and availability (scheduling resource
+	// state view)
+	GetResourceThresholds(
+			sv->ResourceTotal(r_path),
+			sv->ResourceAvailable(r_path, status_view),
+			r_path->Type(), rsrc_amount, evl_ent, rl);
+}
 
-	// Total amount of resource
-	rl.total = sv->ResourceTotal(r_path);
+void SchedContrib::GetResourceThresholds(
+		uint64_t total,
+		uint64_t free,
+		br::ResourceType r_type,
+		uint64_t rsrc_amount,
+		SchedulerPolicyIF::EvalEntity_t const & evl_ent,
+		ResourceThresholds_t & rl) {
+	rl.total = total;
 
 	// Get the max saturation level of this type of resource
-	int r_type_index = static_cast<int>(r_path->Type());
+	int r_type_index = static_cast<int>(r_type);
 	rl.saturate = rl.total * msl_params[r_type_index];
 
-	// Resource availability (scheduling resource state view)
-	rl.free  = sv->ResourceAvailable(r_path, status_view);
+	rl.free  = free;
 	rl.usage = rl.total - rl.free;
 
 	// Amount of resource remaining before reaching the saturation
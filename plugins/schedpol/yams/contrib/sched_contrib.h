@@ -293,6 +293,22 @@ protected:
 			 SchedulerPolicyIF::EvalEntity_t const & evl_ent,
 			 ResourceThresholds_t & rt);
 
+	/**
+	 * @brief Resource usage thresholds, given the total and the available
+	 * amounts of resource
+	 *
+	 * @param total The total amount of resource
+	 * @param free The amount of resource available
+	 * @param r_type The type of resource
+	 * @param amount Requested resource usage amount
+	 * @param evl_ent Entity to evaluate for scheduling
+	 * @param rt The structure filled with the resource thresholds
+	 */
+	 void GetResourceThresholds(uint64_t total, uint64_t free,
+			 br::ResourceType r_type, uint64_t amount,
+			 SchedulerPolicyIF::EvalEntity_t const & evl_ent,
+			 ResourceThresholds_t & rt);
+
 	 /**
 	  * @brief Filter function for resource usage index computation
 	  *
@@ -412,7 +412,8 @@ bool YamsSchedPol::SelectSchedEntities(uint8_t naps_count) {
 					cpu_bindings->ids[(*rit).second], (*rit).first);
 			pschd->SetBindingID(
 					cpu_bindings->ids[(*rit).second], br::ResourceType::CPU);
-			ExitCode_t bd_result = BindResources(pschd, 0);
+			pschd->candidates.clear();
+			ExitCode_t bd_result = BindResources(pschd);
 			if (bd_result != YAMS_SUCCESS) {
 				logger->Error("COWS: CPU binding failed [%d]",
 						bd_result);
@@ -436,6 +437,10 @@ bool YamsSchedPol::SelectSchedEntities(uint8_t naps_count) {
 			continue;
 		}
 #else
+		// Bind the candidate bindings evaluated
+		if (BindResources(pschd) != YAMS_SUCCESS)
+			continue;
+
 		// Send the schedule request
 		app_result = pschd->papp->ScheduleRequest(
 				pschd->pawm, status_view, pschd->bind_refn);
@@ -594,7 +599,6 @@ YamsSchedPol::ExitCode_t YamsSchedPol::EvalBindings(
 	SchedEntityPtr_t pschd_domain(dom_it->second);
 	float  sc_value  = 0.0;
 	float  base_metr = 0.0;
-	size_t base_refn = 0;
 	ExitCode_t result;
 
 	// Get the BindingInfo of the given resource binding type
@@ -619,11 +623,11 @@ YamsSchedPol::ExitCode_t YamsSchedPol::EvalBindings(
 		return YAMS_IGNORE;
 	}
 
-	// Multiple bindings: cumulate metrics and keep track of the binding reference
-	if (pschd_parent != nullptr) {
-		base_refn = pschd_parent->bind_refn;
+	// Multiple bindings: cumulate metrics and candidate bindings
+	if (pschd_parent != nullptr)
 		base_metr = pschd_parent->metrics;
-	}
+	auto const base_candidates(pschd_parent != nullptr ?
+		pschd_parent->candidates : pschd_domain->candidates);
 
 	// Binding IDs
 	BindingInfo_t bd_info = *(bd_it->second);
@@ -639,11 +643,15 @@ YamsSchedPol::ExitCode_t YamsSchedPol::EvalBindings(
 			continue;
 		}
 
-		// Get the scheduling contributions for <AWM, Binding (ID)>
+		// Get the scheduling contributions for <AWM, Binding (ID)>, on
+		// the candidate binding: only the entity selected is bound
 		SchedEntityPtr_t pschd_bound(
 				new SchedEntity_t(*pschd_domain.get()));
 		pschd_bound->SetBindingID(bd_id, bd_type);
-		result = GetBoundContrib(pschd_bound, base_refn, sc_value);
+		pschd_bound->candidates = base_candidates;
+		pschd_bound->candidates.push_back(
+			pschd_bound->pawm->GetBindingCandidate(bd_type, bd_id));
+		result = GetBoundContrib(pschd_bound, sc_value);
 		if (result != YAMS_SUCCESS) {
 			logger->Warn("EvalBindings: <%s> nothing to bind here",
 				br::GetResourceTypeString(bd_type));
@@ -726,9 +734,7 @@ void YamsSchedPol::GetSchedContribValue(
 
 YamsSchedPol::ExitCode_t YamsSchedPol::GetBoundContrib(
 		SchedEntityPtr_t pschd_bd,
-		size_t b_refn,
 		float & value) {
-	ExitCode_t result;
 	float sc_value   = 0.0;
 	uint8_t mlog_len = 0;
 	char mlog[255];
@@ -739,11 +745,9 @@ YamsSchedPol::ExitCode_t YamsSchedPol::GetBoundContrib(
 			bindings[bd_type]->base_path->ToString().c_str(),
 			pschd_bd->bind_id);
 
-	// Bind the resources of the AWM to the given binding domain
-	result = BindResources(pschd_bd, b_refn);
-	if (result != YAMS_SUCCESS) {
-		return result;
-	}
+	// Nothing to bind into the domain
+	if (pschd_bd->candidates.back().Empty())
+		return YAMS_IGNORE;
 
 	// Aggregate binding-dependent scheduling contributions
 	value = 0.0;
@@ -761,23 +765,28 @@ YamsSchedPol::ExitCode_t YamsSchedPol::GetBoundContrib(
 	return YAMS_SUCCESS;
 }
 
-YamsSchedPol::ExitCode_t YamsSchedPol::BindResources(
-		SchedEntityPtr_t pschd,
-		size_t b_refn) {
+YamsSchedPol::ExitCode_t YamsSchedPol::BindResources(SchedEntityPtr_t pschd) {
 	ba::AwmPtr_t & pawm(pschd->pawm);
 	BBQUE_RID_TYPE & bd_id(pschd->bind_id);
 	br::ResourceType & bd_type(pschd->bind_type);
-	size_t r_refn;
+	int32_t r_refn = -1;
 
 	BindingMap_t & bindings(bdm.GetBindingDomains());
-	// Binding of the AWM resource into the current binding resource ID.
-	// Since the policy handles more than one binding per AWM the resource
-	// binding is referenced by a number.
-	r_refn = pawm->BindResource(bd_type, R_ID_ANY, bd_id, b_refn);
-	logger->Debug("BindResources: reference number {%ld}", r_refn);
+	// Binding of the AWM resource into the current binding resource ID, or
+	// into the chain of candidate bindings evaluated. Since the policy
+	// handles more than one binding per AWM the resource binding is
+	// referenced by a number.
+	if (pschd->candidates.empty())
+		r_refn = pawm->BindResource(bd_type, R_ID_ANY, bd_id, r_refn);
+	for (auto const & candidate: pschd->candidates) {
+		r_refn = pawm->BindResource(candidate, r_refn);
+		if (r_refn < 0)
+			break;
+	}
+	logger->Debug("BindResources: reference number {%d}", r_refn);
 
 	// The resource binding should never fail
-	if (r_refn == 0) {
+	if (r_refn < 0) {
 		logger->Error("BindResources: AWM{%d} on <%s%d> failed",
 			pawm->Id(), br::GetResourceTypeString(bd_type), bd_id);
 		return YAMS_ERROR;
@@ -937,7 +946,6 @@ YamsSchedPol::ExitCode_t YamsSchedPol::CowsInit(SchedEntityPtr_t pschd) {
 }
 
 void YamsSchedPol::CowsBoundMix(SchedEntityPtr_t pschd) {
-	ExitCode_t result;
 	float value;
 
 	logger->Info("COWS: ------------ Bound mix computation -------------");
@@ -981,12 +989,9 @@ void YamsSchedPol::CowsBoundMix(SchedEntityPtr_t pschd) {
 		logger->Info("COWS: Bound mix @BD[%d] for %s: %3.2f",
 				cpu_bindings->ids[i], pschd->StrId(), cows_info.bound_mix[i]);
 
-		// Set the binding ID
+		// Set the binding ID: the migration contribution does not need the
+		// resources to be bound
 		pschd->SetBindingID(cpu_bindings->ids[i], br::ResourceType::CPU);
-		result = BindResources(pschd, 0);
-		if (result != YAMS_SUCCESS) {
-			logger->Error("COWS: Resource binding failed [%d]", result);
-		}
 
 		// Get migration contribution
 		value = 0.0;
@@ -434,21 +434,29 @@ private:
 	/**
 	 * @brief Evaluate an AWM in a specific binding domain
 	 *
+	 * The evaluation is done on the candidate bindings of the entity, without
+	 * binding the resources.
+	 *
 	 * @param pschd  Scheduling entitity to evaluate
-	 * @param b_refn Reference number of a previously bound resource set
 	 * @param value  The value of the scheduling contributions aggregation
+	 *
+	 * @return YAMS_IGNORE if there is nothing to bind into the domain
 	 */
-	ExitCode_t GetBoundContrib(SchedEntityPtr_t pschd_bd, size_t b_refn, float & value);
+	ExitCode_t GetBoundContrib(SchedEntityPtr_t pschd_bd, float & value);
 
 	/**
 	 * @brief Bind the resources of the AWM into the given binding domain
 	 *
-	 * @param pschd The scheduling entity to evaluate
+	 * The candidate bindings of the entity are bound, in the order of
+	 * evaluation. Without candidates, the resources are bound into the
+	 * binding domain ID of the entity.
+	 *
+	 * @param pschd The scheduling entity to bind
 	 *
 	 * @return YAMS_SUCCESS for success, YAMS_ERROR if an unexpected error has
 	 * been encountered
 	 */
-	ExitCode_t BindResources(SchedEntityPtr_t pschd, size_t b_refn);
+	ExitCode_t BindResources(SchedEntityPtr_t pschd);
 
 #ifdef CONFIG_BBQUE_SP_COWS_BINDING
 	/**
@@ -16,9 +16,12 @@
  */
 #include <dlfcn.h>
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <set>
 #include <unistd.h>
 
 #include "bbque/config.h"
@@ -27,6 +30,9 @@
 #include "bbque/utils/utility.h"
 #include "bbque/utils/logging/logger.h"
 #include "bbque/pp/opencl_platform_proxy.h"
+#include "bbque/cpp11/condition_variable.h"
+#include "bbque/cpp11/mutex.h"
+#include "bbque/cpp11/thread.h"
 
 #undef  BBQUE_LOG_MODULE
 #define BBQUE_LOG_MODULE "rtl.ocl"
@@ -46,7 +52,6 @@ static std::unique_ptr<bu::Logger> logger;
 extern const char * rtlib_app_name;
 extern RTLIB_OpenCL_t rtlib_ocl;
 extern RTLIB_Services_t rtlib_services;
-extern std::map<cl_command_queue, QueueProfPtr_t> ocl_queues_prof;
 extern std::map<void *, cl_command_type> ocl_addr_cmd;
 
 /* Platform API */
@@ -935,9 +940,11 @@ CL_API_SUFFIX__VERSION_1_0
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueReadBuffer()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -969,9 +976,11 @@ CL_API_SUFFIX__VERSION_1_1
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueReadBufferRect()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -996,9 +1005,11 @@ CL_API_SUFFIX__VERSION_1_0
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueWriteBuffer()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1030,9 +1041,11 @@ CL_API_SUFFIX__VERSION_1_1
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueWriteBufferRect()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1057,9 +1070,11 @@ CL_API_SUFFIX__VERSION_1_0
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueCopyBuffer()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1089,9 +1104,11 @@ CL_API_SUFFIX__VERSION_1_1
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueCopyBufferRect()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1119,9 +1136,11 @@ CL_API_SUFFIX__VERSION_1_0
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueReadImage()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1149,9 +1168,11 @@ CL_API_SUFFIX__VERSION_1_0
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueWriteImage()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1176,9 +1197,11 @@ CL_API_SUFFIX__VERSION_1_0
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueCopyImage()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1204,9 +1227,11 @@ CL_API_SUFFIX__VERSION_1_0
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueCopyImageToBuffer()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1232,9 +1257,11 @@ CL_API_SUFFIX__VERSION_1_0
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueCopyBufferToImage()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1259,11 +1286,13 @@ CL_API_SUFFIX__VERSION_1_0
 					map_flags, offset, size, num_events_in_wait_list, event_wait_list,
 					event, errcode_ret);
 
-	if ((*errcode_ret) != CL_SUCCESS) {
+	if ((errcode_ret != NULL) && (*errcode_ret != CL_SUCCESS)) {
 		logger->Error("OCL: Error [%d] in clEnqueueMapBuffer()", *errcode_ret);
+		return buff_ptr;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return buff_ptr;
 }
 
@@ -1290,11 +1319,13 @@ CL_API_SUFFIX__VERSION_1_0
 					map_flags, origin, region, image_row_pitch, image_slice_pitch,
 					num_events_in_wait_list, event_wait_list, event, errcode_ret);
 
-	if (errcode_ret != CL_SUCCESS) {
+	if ((errcode_ret != NULL) && (*errcode_ret != CL_SUCCESS)) {
 		logger->Error("OCL: Error [%d] in clEnqueueMapImage()", *errcode_ret);
+		return buff_ptr;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return buff_ptr;
 }
 
@@ -1317,9 +1348,11 @@ CL_API_SUFFIX__VERSION_1_0
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueUnmapMemObject()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1345,9 +1378,11 @@ CL_API_SUFFIX__VERSION_1_0
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueNDRangeKernel()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1368,9 +1403,11 @@ CL_API_SUFFIX__VERSION_1_0
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueTask()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1397,9 +1434,11 @@ CL_API_SUFFIX__VERSION_1_0
 
 	if (status != CL_SUCCESS) {
 		logger->Error("OCL: Error [%d] in clEnqueueNativeKernel()", status);
+		return status;
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0),
+		event == &local_event);
 	return status;
 }
 
@@ -1643,38 +1682,272 @@ void rtlib_ocl_set_device(uint8_t device_id, RTLIB_ExitCode_t status)
 	rtlib_ocl.status    = status;
 }
 
-void rtlib_ocl_coll_event(cl_command_queue cmd_queue, cl_event * event,
-			  void * addr)
-{
-	std::map<cl_command_queue, QueueProfPtr_t>::iterator it;
-	clRetainEvent(*event);
-	// Collect events per command queue
-	it = ocl_queues_prof.find(cmd_queue);
+/*******************************************************************************
+ *    Asynchronous profiling
+ ******************************************************************************/
+
+/**
+ * The state of the profiling. The application thread only reserves a record
+ * per (sampled) command, which is filled by the event completion callback.
+ * The records are folded into the statistics by the profiling thread, that
+ * publishes a copy of the statistics of each AWM updated. The application
+ * takes them over at the cycle boundaries, if not busy.
+ */
+static struct OclProfiling {
+	bool enabled  = false;
+	uint32_t sampling = 1;
+	std::atomic<int> level{0};
+
+	/** The AWM the commands are enqueued in */
+	std::atomic<int8_t> awm_id{0};
+	/** Profiling session: a new one starts at each cycle boundary */
+	std::atomic<uint32_t> session{0};
+	/** The session whose commands must not be accounted */
+	std::atomic<uint32_t> discarded{UINT32_MAX};
+
+	/** The command queues profiled */
+	std::map<cl_command_queue, QueueEventsPtr_t> queues;
+	std::mutex queues_mtx;
+
+	/** The profiling thread */
+	std::thread worker;
+	std::mutex worker_mtx;
+	std::condition_variable worker_cv;
+	std::atomic<bool> wakeup{false};
+	bool done = false;
+
+	/** Serialize the folding of the records */
+	std::mutex fold_mtx;
+	/** Statistics of each AWM, updated by the profiling thread only */
+	std::map<int8_t, OclEventsStatsMap_t> awm_stats;
+
+	/** Copies of the updated statistics, for the application thread */
+	std::mutex published_mtx;
+	std::map<int8_t, OclEventsStatsMap_t> published;
+
+	/** Protect the command types of the code addresses */
+	std::mutex addr_mtx;
+
+	~OclProfiling() {
+		std::unique_lock<std::mutex> worker_ul(worker_mtx);
+		done = true;
+		worker_cv.notify_one();
+		worker_ul.unlock();
+		if (worker.joinable())
+			worker.join();
+	}
+} ocl_prof;
 
-	if (it == ocl_queues_prof.end())
-		ocl_queues_prof.insert(QueueProfPair_t(
-						cmd_queue, QueueProfPtr_t(new RTLIB_OCL_QueueProf)));
+/** Event completion callback, called by a thread of the OpenCL runtime */
+static void CL_CALLBACK rtlib_ocl_event_cb(
+			cl_event event,
+			cl_int status,
+			void * user_data)
+{
+	RTLIB_OCL_EventRecord * rec =
+		static_cast<RTLIB_OCL_EventRecord *>(user_data);
+	rec->status = status;
+
+	if (status == CL_COMPLETE) {
+		rtlib_ocl.getEventInfo(event, CL_EVENT_COMMAND_TYPE,
+			sizeof (cl_command_type), &rec->cmd_type, NULL);
+		cl_int prof_status = CL_SUCCESS;
+		prof_status |= rtlib_ocl.getEventProfilingInfo(event,
+			CL_PROFILING_COMMAND_QUEUED, sizeof (cl_ulong), &rec->queued, NULL);
+		prof_status |= rtlib_ocl.getEventProfilingInfo(event,
+			CL_PROFILING_COMMAND_SUBMIT, sizeof (cl_ulong), &rec->submit, NULL);
+		prof_status |= rtlib_ocl.getEventProfilingInfo(event,
+			CL_PROFILING_COMMAND_START, sizeof (cl_ulong), &rec->start, NULL);
+		prof_status |= rtlib_ocl.getEventProfilingInfo(event,
+			CL_PROFILING_COMMAND_END, sizeof (cl_ulong), &rec->end, NULL);
+		// E.g., command queue without profiling enabled
+		if (prof_status != CL_SUCCESS)
+			rec->status = CL_INVALID_EVENT;
+	}
 
-	ocl_queues_prof[cmd_queue]->events.insert(AddrEventPair_t(addr, *event));
+	rtlib_ocl.releaseEvent(event);
+	rec->state.store(RTLIB_OCL_EventRecord::DONE, std::memory_order_release);
+}
+
+/** Fold the completed records into the statistics, and publish them */
+static void rtlib_ocl_prof_fold()
+{
+	std::unique_lock<std::mutex> fold_ul(ocl_prof.fold_mtx);
+	std::vector<QueueEventsPtr_t> queues;
+	std::set<int8_t> awm_updated;
+	uint32_t discarded = ocl_prof.discarded.load();
+	int prof_level = ocl_prof.level.load();
+
+	std::unique_lock<std::mutex> queues_ul(ocl_prof.queues_mtx);
+	for (auto & entry : ocl_prof.queues)
+		queues.push_back(entry.second);
+	queues_ul.unlock();
+
+	for (auto & qe : queues) {
+		uint32_t tail = qe->tail.load(std::memory_order_relaxed);
+
+		// In enqueue order: a command still running stops the folding
+		while (true) {
+			RTLIB_OCL_EventRecord & rec(qe->records[tail]);
+			if (rec.state.load(std::memory_order_acquire) !=
+					RTLIB_OCL_EventRecord::DONE)
+				break;
+
+			if ((rec.status == CL_COMPLETE) && (rec.session != discarded)) {
+				QueueProfPtr_t & stPtr(
+					ocl_prof.awm_stats[rec.awm_id][qe->cmd_queue]);
+				if (! stPtr)
+					stPtr = std::make_shared<RTLIB_OCL_QueueProf>();
+				acc_command_event_info(stPtr, rec, prof_level);
+				awm_updated.insert(rec.awm_id);
+			}
+
+			rec.state.store(
+				RTLIB_OCL_EventRecord::FREE, std::memory_order_release);
+			tail = (tail + 1) % qe->records.size();
+		}
+
+		qe->tail.store(tail, std::memory_order_release);
+	}
+
+	// Publish a copy of the statistics updated
+	for (int8_t awm_id : awm_updated) {
+		OclEventsStatsMap_t stats_copy;
+		for (auto & entry : ocl_prof.awm_stats[awm_id])
+			stats_copy[entry.first] =
+				std::make_shared<RTLIB_OCL_QueueProf>(*(entry.second));
+
+		std::unique_lock<std::mutex> published_ul(ocl_prof.published_mtx);
+		ocl_prof.published[awm_id] = std::move(stats_copy);
+	}
 }
 
-void rtlib_ocl_prof_clean()
+static void rtlib_ocl_prof_task()
 {
-	ocl_queues_prof.clear();
+	std::unique_lock<std::mutex> worker_ul(ocl_prof.worker_mtx);
+
+	while (! ocl_prof.done) {
+		ocl_prof.worker_cv.wait_for(worker_ul,
+			std::chrono::milliseconds(BBQUE_OCL_PROF_PERIOD_MS));
+		ocl_prof.wakeup = false;
+		worker_ul.unlock();
+		rtlib_ocl_prof_fold();
+		worker_ul.lock();
+	}
 }
 
-void rtlib_ocl_flush_events()
+/** Wake up the profiling thread (once, until it runs) */
+static inline void rtlib_ocl_prof_wakeup()
+{
+	if (! ocl_prof.wakeup.exchange(true))
+		ocl_prof.worker_cv.notify_one();
+}
+
+void rtlib_ocl_prof_enable(int level, int sampling)
 {
-	std::map<cl_command_queue, QueueProfPtr_t>::iterator it_cq;
-	cl_command_queue cq;
+	if (ocl_prof.enabled)
+		return;
+
+	ocl_prof.level    = level;
+	ocl_prof.sampling = (sampling > 0) ? sampling : 1;
+	ocl_prof.enabled  = true;
+	ocl_prof.worker   = std::thread(rtlib_ocl_prof_task);
+}
+
+/**
+ * @brief Reserve a profiling record for a command, and register the
+ * completion callback
+ *
+ * @return true if the command is profiled, i.e. the callback will release
+ * the event
+ */
+static bool rtlib_ocl_prof_reserve(cl_command_queue cmd_queue, cl_event event,
+			  void * addr, bool owned)
+{
+	// Last command queue used by this thread, to skip the look-up
+	static thread_local RTLIB_OCL_QueueEvents * last_qe = nullptr;
+	RTLIB_OCL_QueueEvents * qe = last_qe;
+
+	if ((qe == nullptr) || (qe->cmd_queue != cmd_queue)) {
+		std::unique_lock<std::mutex> queues_ul(ocl_prof.queues_mtx);
+		auto it = ocl_prof.queues.find(cmd_queue);
+		if (it == ocl_prof.queues.end())
+			it = ocl_prof.queues.emplace(cmd_queue,
+				std::make_shared<RTLIB_OCL_QueueEvents>(cmd_queue)).first;
+		qe = last_qe = it->second.get();
+	}
 
-	for (it_cq = ocl_queues_prof.begin(); it_cq != ocl_queues_prof.end(); it_cq ++) {
-		QueueProfPtr_t stPtr = it_cq->second;
-		cq = it_cq->first;
-		stPtr->events.clear();
+	// 1-in-N sampling
+	if ((qe->nr_commands.fetch_add(1, std::memory_order_relaxed) %
+			ocl_prof.sampling) != 0)
+		return false;
+
+	// The application can enqueue from several threads: each one moves the
+	// head forward, and then takes the record, if free
+	uint32_t head = qe->head.load(std::memory_order_relaxed);
+	while (! qe->head.compare_exchange_weak(head,
+			(head + 1) % qe->records.size(), std::memory_order_relaxed));
+
+	RTLIB_OCL_EventRecord & rec(qe->records[head]);
+	uint8_t rec_state = RTLIB_OCL_EventRecord::FREE;
+	if (! rec.state.compare_exchange_strong(rec_state,
+			RTLIB_OCL_EventRecord::PENDING, std::memory_order_acquire)) {
+		++ qe->nr_dropped;
+		rtlib_ocl_prof_wakeup();
+		return false;
 	}
 
-	ocl_queues_prof.erase(cq);
+	rec.session = ocl_prof.session.load(std::memory_order_relaxed);
+	rec.awm_id  = ocl_prof.awm_id.load(std::memory_order_relaxed);
+	rec.addr    = addr;
+
+	// The callback releases a reference
+	if (! owned)
+		rtlib_ocl.retainEvent(event);
+	if (rtlib_ocl.setEventCallback(
+			event, CL_COMPLETE, rtlib_ocl_event_cb, &rec) != CL_SUCCESS) {
+		// The head could be moved already: the record is folded, not
+		// accounted
+		rec.status = CL_INVALID_EVENT;
+		rec.state.store(RTLIB_OCL_EventRecord::DONE, std::memory_order_release);
+		if (! owned)
+			rtlib_ocl.releaseEvent(event);
+		return false;
+	}
+
+	// Fold before the table fills up
+	head = qe->head.load(std::memory_order_relaxed);
+	uint32_t tail = qe->tail.load(std::memory_order_relaxed);
+	uint32_t busy = (head + qe->records.size() - tail) % qe->records.size();
+	if (busy > qe->records.size() / 2)
+		rtlib_ocl_prof_wakeup();
+
+	return true;
+}
+
+void rtlib_ocl_coll_event(cl_command_queue cmd_queue, cl_event * event,
+			  void * addr, bool owned)
+{
+	if (*event == NULL)
+		return;
+
+	if (ocl_prof.enabled &&
+			rtlib_ocl_prof_reserve(cmd_queue, *event, addr, owned))
+		return;
+
+	// Not profiled: the event not requested by the application is not
+	// needed anymore
+	if (owned)
+		rtlib_ocl.releaseEvent(*event);
+}
+
+void rtlib_ocl_prof_clean(int8_t awm_id)
+{
+	if (! ocl_prof.enabled)
+		return;
+
+	ocl_prof.awm_id = awm_id;
+	ocl_prof.discarded = ocl_prof.session ++;
 }
 
 void rtlib_ocl_prof_run(
@@ -1682,55 +1955,67 @@ void rtlib_ocl_prof_run(
 			OclEventsStatsMap_t & awm_ocl_events,
 			int prof_level)
 {
-	cl_command_type cmd_type = 0;
-	cl_int status;
-	std::map<cl_command_queue, QueueProfPtr_t>::iterator it_cq;
-	std::map<void *, cl_event>::iterator it_ev;
-
-	for (it_cq = ocl_queues_prof.begin();
-			it_cq != ocl_queues_prof.end(); it_cq ++) {
-		cl_command_queue cq = it_cq->first;
-		clFinish(cq);
-		// Resume previously stored statistics
-		QueueProfPtr_t stPtr = it_cq->second;
-
-		if (awm_ocl_events[cq] != nullptr) {
-			stPtr->cmd_prof  = awm_ocl_events[cq]->cmd_prof;
-			stPtr->addr_prof = awm_ocl_events[cq]->addr_prof;
-		}
+	// Start a new session, for the commands of the next cycle
+	ocl_prof.level  = prof_level;
+	ocl_prof.awm_id = awm_id;
+	++ ocl_prof.session;
+	rtlib_ocl_prof_wakeup();
+
+	// Take over the statistics, if a new copy is available and the
+	// profiling thread is not publishing
+	std::unique_lock<std::mutex> published_ul(
+		ocl_prof.published_mtx, std::try_to_lock);
+	if (! published_ul.owns_lock())
+		return;
 
-		// Extract event profiling timings
-		for (it_ev = stPtr->events.begin(); it_ev != stPtr->events.end(); it_ev ++) {
-			cl_event & ev(it_ev->second);
-			status = clWaitForEvents(1, &ev);
+	auto it = ocl_prof.published.find(awm_id);
+	if (it == ocl_prof.published.end())
+		return;
 
-			if (status != CL_SUCCESS)
-				logger->Error("OCL: Error [%d] in clWaitForEvents", status);
+	awm_ocl_events = std::move(it->second);
+	ocl_prof.published.erase(it);
+}
 
-			acc_command_event_info(
-					stPtr, ev, cmd_type, it_ev->first, awm_id, prof_level);
-		}
+void rtlib_ocl_flush_events()
+{
+	if (! ocl_prof.enabled)
+		return;
 
-		rtlib_ocl_prof_save(cq, awm_ocl_events);
+	std::unique_lock<std::mutex> queues_ul(ocl_prof.queues_mtx);
+	std::vector<QueueEventsPtr_t> queues;
+	for (auto & entry : ocl_prof.queues)
+		queues.push_back(entry.second);
+	queues_ul.unlock();
+
+	for (auto & qe : queues)
+		rtlib_ocl.finish(qe->cmd_queue);
+
+	// The callbacks can be still running once the commands completed
+	auto deadline = std::chrono::steady_clock::now() +
+		std::chrono::milliseconds(BBQUE_OCL_PROF_PERIOD_MS);
+	for (auto & qe : queues) {
+		for (auto & rec : qe->records) {
+			while ((rec.state.load() == RTLIB_OCL_EventRecord::PENDING) &&
+					(std::chrono::steady_clock::now() < deadline))
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		if (qe->nr_dropped > 0)
+			logger->Warn("OCL: Queue @%p: %u commands not profiled "
+				"(too many in flight)", qe->cmd_queue, qe->nr_dropped.load());
 	}
 
-	rtlib_ocl_prof_clean();
+	rtlib_ocl_prof_fold();
 }
 
-void rtlib_ocl_prof_save(
-			 cl_command_queue cmd_queue,
-			 OclEventsStatsMap_t & awm_ocl_events)
+void rtlib_ocl_prof_get(int8_t awm_id, OclEventsStatsMap_t & awm_ocl_events)
 {
-	OclEventsStatsMap_t::iterator it_cq;
-	it_cq = awm_ocl_events.find(cmd_queue);
+	std::unique_lock<std::mutex> published_ul(ocl_prof.published_mtx);
+	auto it = ocl_prof.published.find(awm_id);
+	if (it == ocl_prof.published.end())
+		return;
 
-	if (it_cq == awm_ocl_events.end()) {
-		QueueProfPtr_t p(new RTLIB_OCL_QueueProf(*(ocl_queues_prof[cmd_queue].get())));
-		awm_ocl_events.insert(QueueProfPair_t(cmd_queue, p));
-	}
-	else {
-		awm_ocl_events[cmd_queue] = ocl_queues_prof[cmd_queue];
-	}
+	awm_ocl_events = std::move(it->second);
+	ocl_prof.published.erase(it);
 }
 
 void acc_command_stats(
@@ -1812,92 +2097,36 @@ void dump_command_prof_info(
 
 void acc_command_event_info(
 			    QueueProfPtr_t stPtr,
-			    cl_event event,
-			    cl_command_type & cmd_type,
-			    void * addr,
-			    int8_t awm_id,
+			    RTLIB_OCL_EventRecord const & rec,
 			    int prof_level)
 {
-	size_t return_bytes;
-	cl_int status;
-	cl_ulong ev_queued_time = (cl_ulong) 0;
-	cl_ulong ev_submit_time = (cl_ulong) 0;
-	cl_ulong ev_start_time  = (cl_ulong) 0;
-	cl_ulong ev_end_time    = (cl_ulong) 0;
-	// Extract event times
-	clGetEventInfo(event, CL_EVENT_COMMAND_TYPE, sizeof (cl_command_type),
-		&cmd_type, NULL);
-	status = clGetEventProfilingInfo(
-					event,
-					CL_PROFILING_COMMAND_QUEUED,
-					sizeof (cl_ulong),
-					&ev_queued_time,
-					&return_bytes);
-
-	if (status != CL_SUCCESS) {
-		logger->Error("OCL: Error [%d] in queued event profiling", status);
-		return;
-	}
-
-	status = clGetEventProfilingInfo(
-					event,
-					CL_PROFILING_COMMAND_SUBMIT,
-					sizeof (cl_ulong),
-					&ev_submit_time,
-					&return_bytes);
-
-	if (status != CL_SUCCESS) {
-		logger->Error("OCL: Error [%d] in submit event profiling", status);
-		return;
-	}
-
-	status = clGetEventProfilingInfo(
-					event,
-					CL_PROFILING_COMMAND_START,
-					sizeof (cl_ulong),
-					&ev_start_time,
-					&return_bytes);
-
-	if (status != CL_SUCCESS) {
-		logger->Error("OCL: Error [%d] in start event profiling", status);
-		return;
-	}
-
-	status = clGetEventProfilingInfo(
-					event,
-					CL_PROFILING_COMMAND_END,
-					sizeof (cl_ulong),
-					&ev_end_time,
-					&return_bytes);
-
-	if (status != CL_SUCCESS) {
-		logger->Error("OCL: Error [%d] in end event profiling", status);
-		return;
-	}
+	void * addr = rec.addr;
 
 	// Accumulate event times for this command
-	double queued_time = (double) (ev_submit_time - ev_queued_time);
-	double submit_time = (double) (ev_start_time  - ev_submit_time);
-	double exec_time   = (double) (ev_end_time    - ev_start_time);
-	acc_command_stats(stPtr, cmd_type, queued_time, submit_time, exec_time);
+	double queued_time = (double) (rec.submit - rec.queued);
+	double submit_time = (double) (rec.start  - rec.submit);
+	double exec_time   = (double) (rec.end    - rec.start);
+	acc_command_stats(stPtr, rec.cmd_type, queued_time, submit_time, exec_time);
 
 	// Collects stats for command instances
 	if (prof_level > 0) {
 		acc_address_stats(stPtr, addr, queued_time, submit_time, exec_time);
-		ocl_addr_cmd[addr] = cmd_type;
+		std::unique_lock<std::mutex> addr_ul(ocl_prof.addr_mtx);
+		ocl_addr_cmd[addr] = rec.cmd_type;
 	}
 	else
 		addr = 0;
 
 	// File dump
 	dump_command_prof_info(
-			awm_id, cmd_type, queued_time, submit_time, exec_time, addr);
+			rec.awm_id, rec.cmd_type, queued_time, submit_time, exec_time, addr);
 }
 
 cl_command_type rtlib_ocl_get_command_type(void * addr)
 {
 	cl_command_type cmd_type = CL_COMMAND_USER;
 	std::map<void *, cl_command_type>::iterator it_ev;
+	std::unique_lock<std::mutex> addr_ul(ocl_prof.addr_mtx);
 	it_ev = ocl_addr_cmd.find(addr);
 
 	if (it_ev == ocl_addr_cmd.end()) {
@@ -28,6 +28,7 @@
 
 #include <cstdio>
 #include <cmath>
+#include <algorithm>
 #include <cstring>
 #include <sys/stat.h>
 
@@ -39,9 +40,12 @@
 #undef  BBQUE_LOG_MODULE
 #define BBQUE_LOG_MODULE "rpc"
 
-// cpu controller does not support periods > 1s (1000000 us))
-#define MAX_ALLOWED_CFS_PERIOD 1000000
+// CFS period until the cycle time is measured
 #define DEFAULT_CFS_PERIOD 100000
+// Relative change of the cycle time updating the CFS period [%]
+#define CFS_PERIOD_HYSTERESIS_PCT 10
+// The minimum CFS quota accepted by the cpu controller
+#define MIN_CFS_QUOTA 1000
 
 namespace ba = bbque::app;
 namespace bu = bbque::utils;
@@ -316,10 +320,19 @@ RTLIB_ExitCode_t BbqueRPC::ParseOptions()
 
 		case 'o':
 			// Enabling OpenCL Profiling Output on file
+			// Format: o<level>[,<sampling>]
 			rtlib_configuration.profile.opencl.enabled = true;
-			sscanf(option + 1, "%d", &rtlib_configuration.profile.opencl.level);
-			logger->Notice("Enabling OpenCL profiling [verbosity: %d]",
-						   rtlib_configuration.profile.opencl.level);
+			sscanf(option + 1, "%d,%d",
+				&rtlib_configuration.profile.opencl.level,
+				&rtlib_configuration.profile.opencl.sampling);
+			if (rtlib_configuration.profile.opencl.sampling < 1)
+				rtlib_configuration.profile.opencl.sampling = 1;
+			logger->Notice("Enabling OpenCL profiling [verbosity: %d, sampling: 1/%d]",
+						   rtlib_configuration.profile.opencl.level,
+						   rtlib_configuration.profile.opencl.sampling);
+			rtlib_ocl_prof_enable(
+				rtlib_configuration.profile.opencl.level,
+				rtlib_configuration.profile.opencl.sampling);
 			break;
 #endif //CONFIG_BBQUE_OPENCL
 
@@ -871,10 +884,16 @@ RTLIB_ExitCode_t BbqueRPC::CGroupCreate(pRegisteredEXC_t exc, int pid)
 	// Setup CGroup PATH
 	if (bu::CGroups::WriteCgroup(cgroup_path, cgsetup, 0) !=
 		bu::CGroups::CGResult::OK) {
-		logger->Error("CGroup setup [%s] FAILED");
+		logger->Error("CGroup setup [%s] FAILED", cgroup_path);
 		return RTLIB_ERROR;
 	}
 
+#ifdef CONFIG_BBQUE_CGROUPS_DISTRIBUTED_ACTUATION
+	// The reference for the updates of the allocation
+	exc->cg_committed = cgsetup;
+	exc->cg_attached  = false;
+#endif
+
 	return RTLIB_OK;
 }
 
@@ -887,73 +906,73 @@ RTLIB_ExitCode_t BbqueRPC::CGroupCommitAllocation(pRegisteredEXC_t exc)
 
 #ifdef CONFIG_BBQUE_CGROUPS_DISTRIBUTED_ACTUATION
 
-	bu::CGroups::CGSetup cgsetup;
+	// Start from the values last written: no read-back is needed
+	bu::CGroups::CGSetup cgsetup(exc->cg_committed);
 	const char * cgroup_path = exc->cgroup_path.c_str();
-	// Reading previous values
-	bu::CGroups::Read(cgroup_path, cgsetup);
 
 	// CPUSET representing the allocated processing elements
-	logger->Debug("Updating cpuset.cpus: %s -> %s",
-		 cgsetup.cpuset.cpus.c_str(),
-		 exc->cg_current_allocation.cpuset_cpus.c_str());
-
 	cgsetup.cpuset.cpus = exc->cg_current_allocation.cpuset_cpus;
 
 	// MEMS representing the allocated memory nodes, if any
-	if (exc->cg_current_allocation.cpuset_mems != "") {
-		logger->Debug("Updating cpuset.mems: %s -> %s",
-			cgsetup.cpuset.mems.c_str(),
-			 exc->cg_current_allocation.cpuset_mems.c_str());
-
+	if (exc->cg_current_allocation.cpuset_mems != "")
 		cgsetup.cpuset.mems = exc->cg_current_allocation.cpuset_mems;
-	} else
-		logger->Debug("Keeping previous cpuset.mems value: %s",
-				cgsetup.cpuset.mems.c_str());
-
-
-	// CFS_PERIOD: the period over which cpu bandwidth. limit is enforced
-	uint32_t cycletime_mean_us = 1000u * exc->cycletime_analyser_system.GetMean();
-	//if (cycletime_mean_us == 0 || cycletime_mean_us > MAX_ALLOWED_CFS_PERIOD)
-		cycletime_mean_us = DEFAULT_CFS_PERIOD;
 
-	logger->Debug("Updating cpu.cfs_period_us: %s to %u",
-		cgsetup.cpu.cfs_period_us.c_str(),
-		cycletime_mean_us);
-
-	cgsetup.cpu.cfs_period_us = std::to_string(cycletime_mean_us);
+	// CFS_PERIOD: the period over which cpu bandwidth limit is enforced,
+	// tracking the cycle time
+	uint32_t cfs_period = DEFAULT_CFS_PERIOD;
+	double cycletime_mean_ms = exc->cycletime_analyser_system.GetMean();
+	if (cycletime_mean_ms > 0)
+		cfs_period = 1000u * cycletime_mean_ms;
+	cfs_period = std::max<uint32_t>(cfs_period, BBQUE_CGROUPS_CFS_PERIOD_MIN_US);
+	cfs_period = std::min<uint32_t>(cfs_period, BBQUE_CGROUPS_CFS_PERIOD_MAX_US);
+
+	// Keep the previous period for small cycle time variations
+	if (exc->cg_committed.cpu.cfs_period_us != "") {
+		uint32_t prev_cfs_period = std::stoul(exc->cg_committed.cpu.cfs_period_us);
+		uint32_t delta = (cfs_period > prev_cfs_period) ?
+			cfs_period - prev_cfs_period : prev_cfs_period - cfs_period;
+		if (100u * delta < CFS_PERIOD_HYSTERESIS_PCT * prev_cfs_period)
+			cfs_period = prev_cfs_period;
+	}
+	cgsetup.cpu.cfs_period_us = std::to_string(cfs_period);
 
 	// CFS_quota: the enforced CPU bandwidth wrt the period
 	// note: getting rid of floats, here (multiplying by 100))
-	uint32_t cpu_allocation = 100u * exc->cg_current_allocation.cpu_budget;
-	uint32_t cfs_quota = cycletime_mean_us * cpu_allocation;
+	uint64_t cpu_allocation = 100u * exc->cg_current_allocation.cpu_budget;
+	uint64_t cfs_quota = cfs_period * cpu_allocation;
 	cfs_quota /= 100u;
-
-	logger->Debug("Updating cpu.cfs_quota_us: %s to %s",
-		cgsetup.cpu.cfs_quota_us.c_str(),
-		std::to_string(cfs_quota).c_str());
-
-	cgsetup.cpu.cfs_quota_us = std::to_string(cfs_quota);
+	cgsetup.cpu.cfs_quota_us =
+		std::to_string(std::max<uint64_t>(cfs_quota, MIN_CFS_QUOTA));
 
 	// Memory limit in bytes
-	if (exc->cg_current_allocation.memory_limit_bytes != "") {
-		logger->Debug("Updating memory.limit_in_bytes: %s -> %s",
-			cgsetup.memory.limit_in_bytes.c_str(),
-			exc->cg_current_allocation.memory_limit_bytes.c_str());
-
-		cgsetup.memory.limit_in_bytes = exc->cg_current_allocation.memory_limit_bytes;
-	} else
-		logger->Debug("Keeping previous memory.limit_in_bytes value: %s",
-				cgsetup.memory.limit_in_bytes.c_str());
+	if (exc->cg_current_allocation.memory_limit_bytes != "")
+		cgsetup.memory.limit_in_bytes =
+			exc->cg_current_allocation.memory_limit_bytes;
 
+	// Write only the values changed
+	uint8_t nr_writes = 0;
+	if (bu::CGroups::WriteCgroupDiff(cgroup_path, cgsetup,
+			exc->cg_committed, &nr_writes) != bu::CGroups::CGResult::OK)
+		logger->Error("CGroup update [%s] FAILED", cgroup_path);
 
-	logger->Debug("Cgroup write: [pes %s] [mem %s - %s bytes] [cfs %s/%s]",
+	logger->Debug("CGroup update: [pes %s] [mem %s - %s bytes] [cfs %s/%s] "
+		"(%d attributes written)",
 		cgsetup.cpuset.cpus.c_str(),
 		cgsetup.cpuset.mems.c_str(),
 		cgsetup.memory.limit_in_bytes.c_str(),
 		cgsetup.cpu.cfs_quota_us.c_str(),
-		cgsetup.cpu.cfs_period_us.c_str());
-
-	bu::CGroups::WriteCgroup(cgroup_path, cgsetup, channel_thread_pid);
+		cgsetup.cpu.cfs_period_us.c_str(),
+		nr_writes);
+
+	// Move the EXC into the CGroup at the first allocation
+	if (!exc->cg_attached) {
+		if (bu::CGroups::AttachTask(cgroup_path, channel_thread_pid) !=
+				bu::CGroups::CGResult::OK) {
+			logger->Error("CGroup [%s] attach FAILED", cgroup_path);
+			return RTLIB_ERROR;
+		}
+		exc->cg_attached = true;
+	}
 #else
 	UNUSED(exc);
 #endif // CONFIG_BBQUE_CGROUPS_DISTRIBUTED_ACTUATION
@@ -1087,6 +1106,7 @@ void BbqueRPC::_SyncTimeEstimation(pRegisteredEXC_t exc)
 	CheckDurationTimeout(exc);
 	// Push sample into accumulator
 	awm_stats->cycle_samples(user_cycletime_ms);
+	awm_stats->cycle_quantiles.InsertValue(user_cycletime_ms);
 	exc->cycles_count += 1;
 	// Push sample into bbque CPS estimator
 	exc->cycletime_analyser_system.InsertValue(bbque_cycletime_ms);
@@ -1179,6 +1199,37 @@ RTLIB_ExitCode_t BbqueRPC::UpdateMonitorStatistics(pRegisteredEXC_t exc)
 	return RTLIB_OK;
 }
 
+void BbqueRPC::UpdateRunStatistics(pRegisteredEXC_t exc)
+{
+	pAwmStats_t awm_stats(exc->current_awm_stats);
+	if (unlikely(! awm_stats))
+		return;
+	double last_run_ms = exc->execution_timer.getElapsedTimeMs();
+	last_run_ms -= exc->run_tstart;
+	std::unique_lock<std::mutex> stats_lock(awm_stats->stats_mutex);
+	awm_stats->run_quantiles.InsertValue(last_run_ms);
+}
+
+void BbqueRPC::GetQuantileStats(
+	pRegisteredEXC_t exc,
+	rpc_msg_quantiles_t & ctime_q,
+	rpc_msg_quantiles_t & rtime_q)
+{
+	pAwmStats_t awm_stats(exc->current_awm_stats);
+	ctime_q = { 0, 0, 0 };
+	rtime_q = { 0, 0, 0 };
+	if (! awm_stats)
+		return;
+
+	std::unique_lock<std::mutex> stats_lock(awm_stats->stats_mutex);
+	ctime_q.p50_us = std::round(awm_stats->cycle_quantiles.GetP50() * 1e3);
+	ctime_q.p95_us = std::round(awm_stats->cycle_quantiles.GetP95() * 1e3);
+	ctime_q.p99_us = std::round(awm_stats->cycle_quantiles.GetP99() * 1e3);
+	rtime_q.p50_us = std::round(awm_stats->run_quantiles.GetP50() * 1e3);
+	rtime_q.p95_us = std::round(awm_stats->run_quantiles.GetP95() * 1e3);
+	rtime_q.p99_us = std::round(awm_stats->run_quantiles.GetP99() * 1e3);
+}
+
 void BbqueRPC::ResetRuntimeProfileStats(RTLIB_EXCHandler_t exc_handler)
 {
         pRegisteredEXC_t exc;
@@ -2382,16 +2433,15 @@ RTLIB_ExitCode_t BbqueRPC::GetRuntimeProfile(
 	if (isSyncMode(exc))
 		return RTLIB_OK;
 
-	// Only OpenCL profiling actually supported
-	if (! msg.is_ocl)
-		return RTLIB_OK;
-
+	// Execution/memory timings are available for OpenCL EXCs only, while
+	// the cycle times quantiles are always sent back
+	uint32_t exec_time = 0, mem_time = 0;
 #ifdef CONFIG_BBQUE_OPENCL
-	uint32_t exec_time, mem_time;
-	OclGetRuntimeProfile(exc, exec_time, mem_time);
+	if (msg.is_ocl)
+		OclGetRuntimeProfile(exc, exec_time, mem_time);
+#endif
 	// Send the profile to the resource manager
 	_GetRuntimeProfileResp(msg.hdr.token, exc, exec_time, mem_time);
-#endif
 	return RTLIB_OK;
 }
 
@@ -2613,12 +2663,16 @@ void BbqueRPC::PerfCollectStats(pRegisteredEXC_t exc)
 	uint64_t          increase_from_last_sampling;
 	int               event_id;
 
+	// Read all the counters at once (a single system call per group)
+	if (exc->perf.UpdateAll() < 0)
+		return;
+
 	// Collect counters for registered events
 	for (auto & event_counter : awm_stats->events_map) {
 		event_stats = event_counter.second;
 		event_id = event_counter.first;
 		// Reading increase_from_last_sampling for this perf counter
-		increase_from_last_sampling = exc->perf.Update(event_id);
+		increase_from_last_sampling = exc->perf.Read(event_id);
 		// Computing stats for this counter
 		event_stats->value += increase_from_last_sampling;
 		event_stats->perf_samples(increase_from_last_sampling);
@@ -2898,9 +2952,9 @@ void BbqueRPC::OclSetDevice(uint8_t device_id, RTLIB_ExitCode_t status)
 	rtlib_ocl_set_device(device_id, status);
 }
 
-void BbqueRPC::OclClearStats()
+void BbqueRPC::OclClearStats(int8_t current_awm_id)
 {
-	rtlib_ocl_prof_clean();
+	rtlib_ocl_prof_clean(current_awm_id);
 }
 
 void BbqueRPC::OclCollectStats(int8_t current_awm_id, OclEventsStatsMap_t & ocl_events_map)
@@ -2938,12 +2992,16 @@ void BbqueRPC::OclDumpStats(pRegisteredEXC_t exc)
 	AwmStatsMap_t::iterator it;
 	pAwmStats_t awm_stats;
 	int8_t current_awm_id;
+	// Account the commands still in flight
+	rtlib_ocl_flush_events();
+
 	// Print RTLib stats for each AWM
 	it = exc->awm_stats.begin();
 
 	for ( ; it != exc->awm_stats.end(); ++ it) {
 		current_awm_id = (*it).first;
 		awm_stats = (*it).second;
+		rtlib_ocl_prof_get(current_awm_id, awm_stats->ocl_events_map);
 		std::map<cl_command_queue, QueueProfPtr_t>::iterator it_cq;
 		fprintf(output_file, OCL_EXC_AWM_HEADER, exc->name.c_str(), current_awm_id);
 		fprintf(output_file, OCL_STATS_BAR);
@@ -3356,7 +3414,7 @@ void BbqueRPC::NotifyPostConfigure(
 	(void) exc_handler;
 #ifdef CONFIG_BBQUE_OPENCL
 	// Clear pre-run OpenCL command events
-	OclClearStats();
+	OclClearStats(exc->current_awm_id);
 #endif
 
 	if (exc->cycles_count == 0) {
@@ -3403,6 +3461,9 @@ void BbqueRPC::NotifyPreRun(
 
 	logger->Debug("Pre-Run: Starting computing CPU quota");
 	InitCPUBandwidthStats(exc);
+
+	// Keep track of onRun start time
+	exc->run_tstart = exc->execution_timer.getElapsedTimeMs();
 }
 
 void BbqueRPC::NotifyPostRun(
@@ -3419,6 +3480,9 @@ void BbqueRPC::NotifyPostRun(
 	}
 
 	assert(isRegistered(exc) == true);
+	// Update onRun statistics
+	UpdateRunStatistics(exc);
+
 	logger->Debug("Post-Run: Checking if perf counters are activated");
 	bool pcounters_collected_systemwide =
 		rtlib_configuration.profile.perf_counters.global;
@@ -3554,6 +3618,10 @@ void BbqueRPC::OclGetRuntimeProfile(
 		}
 	}
 
+	// Only 1 command every 'sampling' has been profiled
+	cum_exec_time *= rtlib_configuration.profile.opencl.sampling;
+	cum_mem_time  *= rtlib_configuration.profile.opencl.sampling;
+
 	// Update
 	exec_time = (cum_exec_time - cum_exec_time_prev) / delta_cycles_count;
 	mem_time  = (cum_mem_time  - cum_mem_time_prev)  / delta_cycles_count;
@@ -65,12 +65,6 @@ RTLIB_Services_t rtlib_services;
  */
 RTLIB_OpenCL_t rtlib_ocl;
 
-/**
- * The map contains OpenCL command queues and shared pointers to profiling
- * events data structures
- */
-std::map<cl_command_queue, QueueProfPtr_t> ocl_queues_prof;
-
 /**
  * The map contains OpenCL command types and their respective string values
  */
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Per-cycle overhead of the RTLib performance counters
+ *
+ * Each cycle does what the RTLib does around onRun() when the performance
+ * counters are enabled: disable the counters, collect them
+ * (BbqueRPC::PerfCollectStats), enable them again. Software events are
+ * used, so that the benchmark runs on any machine and in virtual ones.
+ *
+ * Cases:
+ * - single:  standalone counters, one read per counter (Update);
+ * - batched: standalone counters, collected with UpdateAll;
+ * - grouped: counter groups, one read per group (the RTLib default).
+ *
+ * Usage: bbque-rtlib-bench-perf [cycles] [runs]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "bbque/utils/perf.h"
+
+using bbque::utils::Perf;
+
+// The software events, as many as the default RTLib hardware ones
+static const perf_sw_ids events[] = {
+	PERF_COUNT_SW_TASK_CLOCK,
+	PERF_COUNT_SW_CONTEXT_SWITCHES,
+	PERF_COUNT_SW_CPU_MIGRATIONS,
+	PERF_COUNT_SW_PAGE_FAULTS,
+	PERF_COUNT_SW_CPU_CLOCK,
+	PERF_COUNT_SW_PAGE_FAULTS_MIN,
+	PERF_COUNT_SW_PAGE_FAULTS_MAJ,
+	PERF_COUNT_SW_ALIGNMENT_FAULTS,
+};
+
+enum Collect_t {
+	SINGLE,
+	BATCHED,
+	GROUPED
+};
+
+static double MeasureCycles(Collect_t collect, int cycles) {
+	Perf perf(-1, collect == GROUPED);
+	std::vector<int> ids;
+	for (auto event: events) {
+		int id = perf.AddCounter(PERF_TYPE_SOFTWARE, event);
+		if (id < 0) {
+			fprintf(stderr, "Software event %d not available\n", event);
+			exit(EXIT_FAILURE);
+		}
+		ids.push_back(id);
+	}
+
+	uint64_t sum = 0;
+	perf.Enable();
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < cycles; ++i) {
+		perf.Disable();
+		if (collect == SINGLE) {
+			for (int id: ids)
+				sum += perf.Update(id);
+		} else {
+			perf.UpdateAll();
+			for (int id: ids)
+				sum += perf.Read(id);
+		}
+		perf.Enable();
+	}
+	auto elapsed = std::chrono::steady_clock::now() - start;
+	perf.Disable();
+
+	// Keep the reads
+	if (sum == 0)
+		fprintf(stderr, "No events counted\n");
+	return std::chrono::duration<double, std::micro>(elapsed).count() / cycles;
+}
+
+int main(int argc, char *argv[]) {
+	int cycles = (argc > 1) ? atoi(argv[1]) : 100000;
+	int runs   = (argc > 2) ? atoi(argv[2]) : 5;
+	char const * names[] = { "single", "batched", "grouped" };
+
+	printf("%zu software counters, %d cycles, %d runs\n",
+		sizeof(events) / sizeof(events[0]), cycles, runs);
+	for (auto collect: { SINGLE, BATCHED, GROUPED }) {
+		double min = 1e9, sum = 0;
+		for (int r = 0; r < runs; ++r) {
+			double us = MeasureCycles(collect, cycles);
+			min = std::min(min, us);
+			sum += us;
+		}
+		printf("%-8s %6.2f us/cycle (min %.2f)\n",
+			names[collect], sum / runs, min);
+	}
+
+	return EXIT_SUCCESS;
+}
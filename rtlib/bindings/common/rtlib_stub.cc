@@ -0,0 +1,258 @@
+#include "rtlib_stub.h"
+
+#include <chrono>
+
+/* Weight of the last sample in the cycle time moving average */
+#define STUB_CTIME_ALPHA 0.1
+
+namespace {
+
+/*
+ * The state of an EXC registered to the stub: the handler returned is the
+ * address of the (first) parameters field
+ */
+struct StubEXC {
+	RTLIB_EXCParameters_t params;
+	bool started = false;
+	RTLIB_SystemResources_t system;
+	std::chrono::steady_clock::time_point last_run;
+	double ctime_ms = 0;
+	float cps_max = 0;
+	uint32_t ctime_min_us = 0;
+	int jpc = 1;
+};
+
+inline StubEXC * stub_exc(RTLIB_EXCHandler_t exc_handler) {
+	return reinterpret_cast<StubEXC *>(exc_handler);
+}
+
+RTLIB_Conf_t stub_config;
+
+RTLIB_Services_t stub_services;
+
+/*** Execution contexts ***/
+
+RTLIB_EXCHandler_t stub_register(
+		const char * name, const RTLIB_EXCParameters_t * params) {
+	(void) name;
+	StubEXC * exc = new StubEXC;
+	exc->params = *params;
+	exc->system.number_cpus = 1;
+	exc->system.number_proc_elements = 1;
+	exc->system.cpu_bandwidth = 100;
+	return &exc->params;
+}
+
+void stub_unregister(const RTLIB_EXCHandler_t exc_handler) {
+	delete stub_exc(exc_handler);
+}
+
+RTLIB_ExitCode_t stub_accept(const RTLIB_EXCHandler_t exc_handler) {
+	(void) exc_handler;
+	return RTLIB_OK;
+}
+
+RTLIB_ExitCode_t stub_getwm(
+		RTLIB_EXCHandler_t exc_handler,
+		RTLIB_WorkingModeParams_t * wm,
+		RTLIB_SyncType_t st) {
+	(void) st;
+	StubEXC * exc = stub_exc(exc_handler);
+	if (exc->started)
+		return RTLIB_OK;
+
+	wm->awm_id = 0;
+	wm->services = &stub_services;
+	wm->nr_sys = 1;
+	wm->systems = &exc->system;
+	exc->started = true;
+	return RTLIB_EXC_GWM_START;
+}
+
+RTLIB_ExitCode_t stub_set_constraints(
+		RTLIB_EXCHandler_t exc_handler,
+		RTLIB_Constraint_t * constraints,
+		uint8_t count) {
+	(void) exc_handler;
+	(void) constraints;
+	(void) count;
+	return RTLIB_OK;
+}
+
+RTLIB_ExitCode_t stub_clear_constraints(RTLIB_EXCHandler_t exc_handler) {
+	(void) exc_handler;
+	return RTLIB_OK;
+}
+
+RTLIB_ExitCode_t stub_ggap(RTLIB_EXCHandler_t exc_handler, int gap) {
+	(void) exc_handler;
+	(void) gap;
+	return RTLIB_OK;
+}
+
+/*** Utilities ***/
+
+const char * stub_getchuid() {
+	return "00000:stub";
+}
+
+AppUid_t stub_getuid(RTLIB_EXCHandler_t exc_handler) {
+	(void) exc_handler;
+	return 0;
+}
+
+RTLIB_ExitCode_t stub_get_resources(
+		RTLIB_EXCHandler_t exc_handler,
+		const RTLIB_WorkingModeParams_t * wm,
+		RTLIB_ResourceType_t r_type,
+		int32_t & r_amount) {
+	(void) exc_handler;
+	switch (r_type) {
+	case SYSTEM:
+		r_amount = wm->nr_sys;
+		break;
+	case CPU:
+		r_amount = wm->systems[0].number_cpus;
+		break;
+	case PROC_NR:
+		r_amount = wm->systems[0].number_proc_elements;
+		break;
+	case PROC_ELEMENT:
+		r_amount = wm->systems[0].cpu_bandwidth;
+		break;
+	case MEMORY:
+		r_amount = wm->systems[0].mem_bandwidth;
+		break;
+	default:
+		r_amount = -1;
+	}
+	return RTLIB_OK;
+}
+
+RTLIB_ExitCode_t stub_get_affinity_mask(
+		RTLIB_EXCHandler_t exc_handler,
+		const RTLIB_WorkingModeParams_t * wm,
+		int32_t * ids_vector,
+		int vector_size) {
+	(void) exc_handler;
+	(void) wm;
+	for (int i = 0; i < vector_size; ++i)
+		ids_vector[i] = (i == 0) ? 0 : -1;
+	return RTLIB_OK;
+}
+
+RTLIB_ExitCode_t stub_get_resources_array(
+		RTLIB_EXCHandler_t exc_handler,
+		const RTLIB_WorkingModeParams_t * wm,
+		RTLIB_ResourceType_t r_type,
+		int32_t * sys_array,
+		uint16_t array_size) {
+	if (array_size > 0)
+		return stub_get_resources(exc_handler, wm, r_type, sys_array[0]);
+	return RTLIB_OK;
+}
+
+void stub_notify(RTLIB_EXCHandler_t exc_handler) {
+	(void) exc_handler;
+}
+
+/*** Cycles and jobs rate ***/
+
+void stub_notify_pre_run(RTLIB_EXCHandler_t exc_handler) {
+	StubEXC * exc = stub_exc(exc_handler);
+	auto now = std::chrono::steady_clock::now();
+	if (exc->last_run.time_since_epoch().count() != 0) {
+		double ctime_ms = std::chrono::duration<double, std::milli>(
+				now - exc->last_run).count();
+		exc->ctime_ms = (exc->ctime_ms == 0) ? ctime_ms :
+			STUB_CTIME_ALPHA * ctime_ms + (1 - STUB_CTIME_ALPHA) * exc->ctime_ms;
+	}
+	exc->last_run = now;
+}
+
+float stub_cps_get(RTLIB_EXCHandler_t exc_handler) {
+	StubEXC * exc = stub_exc(exc_handler);
+	return (exc->ctime_ms == 0) ? 0 : 1e3 / exc->ctime_ms;
+}
+
+RTLIB_ExitCode_t stub_cps_set(RTLIB_EXCHandler_t exc_handler, float cps) {
+	stub_exc(exc_handler)->cps_max = cps;
+	return RTLIB_OK;
+}
+
+RTLIB_ExitCode_t stub_cps_goal_set(
+		RTLIB_EXCHandler_t exc_handler, float cps_min, float cps_max) {
+	(void) exc_handler;
+	(void) cps_min;
+	(void) cps_max;
+	return RTLIB_OK;
+}
+
+RTLIB_ExitCode_t stub_cps_set_ctime_us(
+		RTLIB_EXCHandler_t exc_handler, uint32_t us) {
+	stub_exc(exc_handler)->ctime_min_us = us;
+	return RTLIB_OK;
+}
+
+uint32_t stub_get_ctime_ms(RTLIB_EXCHandler_t exc_handler) {
+	return static_cast<uint32_t>(stub_exc(exc_handler)->ctime_ms);
+}
+
+float stub_jps_get(RTLIB_EXCHandler_t exc_handler) {
+	return stub_cps_get(exc_handler) * stub_exc(exc_handler)->jpc;
+}
+
+RTLIB_ExitCode_t stub_jps_goal_set(
+		RTLIB_EXCHandler_t exc_handler, float jps_min, float jps_max, int jpc) {
+	(void) jps_min;
+	(void) jps_max;
+	stub_exc(exc_handler)->jpc = jpc;
+	return RTLIB_OK;
+}
+
+RTLIB_ExitCode_t stub_jps_goal_update(RTLIB_EXCHandler_t exc_handler, int jpc) {
+	stub_exc(exc_handler)->jpc = jpc;
+	return RTLIB_OK;
+}
+
+} // namespace
+
+RTLIB_Services_t * RTLIB_StubServices() {
+	stub_services.version.major = RTLIB_VERSION_MAJOR;
+	stub_services.version.minor = RTLIB_VERSION_MINOR;
+	stub_services.config = &stub_config;
+	stub_services.Register = stub_register;
+	stub_services.SetupCGroups = stub_accept;
+	stub_services.EnableEXC = stub_accept;
+	stub_services.GetWorkingMode = stub_getwm;
+	stub_services.SetAWMConstraints = stub_set_constraints;
+	stub_services.ClearAWMConstraints = stub_clear_constraints;
+	stub_services.SetGoalGap = stub_ggap;
+	stub_services.Disable = stub_accept;
+	stub_services.Unregister = stub_unregister;
+	// Utility functions interface
+	stub_services.Utils.GetUniqueID_String = stub_getchuid;
+	stub_services.Utils.GetUniqueID = stub_getuid;
+	stub_services.Utils.GetResources = stub_get_resources;
+	stub_services.Utils.GetAffinityMask = stub_get_affinity_mask;
+	stub_services.Utils.GetResourcesArray = stub_get_resources_array;
+	stub_services.Utils.MonitorPerfCounters = stub_notify;
+	// Cycles Time Control interface
+	stub_services.CPS.ExecTime_ms = stub_get_ctime_ms;
+	stub_services.CPS.Set = stub_cps_set;
+	stub_services.CPS.Get = stub_cps_get;
+	stub_services.CPS.SetGoal = stub_cps_goal_set;
+	stub_services.CPS.SetMinCycleTime_us = stub_cps_set_ctime_us;
+	stub_services.JPS.Get = stub_jps_get;
+	stub_services.JPS.SetGoal = stub_jps_goal_set;
+	stub_services.JPS.UpdateJPC = stub_jps_goal_update;
+	// Performance monitoring notifiers
+	stub_services.Notify.Exit = stub_notify;
+	stub_services.Notify.PreConfigure = stub_notify;
+	stub_services.Notify.PostConfigure = stub_notify;
+	stub_services.Notify.PreRun = stub_notify_pre_run;
+	stub_services.Notify.PostRun = stub_notify;
+	stub_services.Notify.PreMonitor = stub_notify;
+	stub_services.Notify.PostMonitor = stub_notify;
+	return &stub_services;
+}
@@ -0,0 +1,17 @@
+#ifndef RTLIB_STUB_H
+#define RTLIB_STUB_H
+
+#include <bbque/rtlib.h>
+
+/*
+ * RTLib services not backed by the BarbequeRTRM daemon: the EXCs are started
+ * straight into AWM 0 (a single system, with a CPU and 100% bandwidth), the
+ * notifications only measure the cycle time, and the control requests are
+ * accepted and ignored.
+ *
+ * They are meant for testing and benchmarking the language bindings, e.g. the
+ * per-cycle overhead of the callbacks, without a running daemon.
+ */
+RTLIB_Services_t * RTLIB_StubServices();
+
+#endif
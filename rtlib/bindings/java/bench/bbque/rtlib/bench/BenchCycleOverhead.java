@@ -0,0 +1,100 @@
+package bbque.rtlib.bench;
+
+import bbque.rtlib.enumeration.RTLibExitCode;
+import bbque.rtlib.exception.RTLibException;
+import bbque.rtlib.model.BbqueEXC;
+import bbque.rtlib.model.RTLibServices;
+
+/**
+ * Per-cycle overhead of the RTLib Java binding.
+ *
+ * The EXCs run on the stub RTLib services (BenchStub.init()), i.e. without the BarbequeRTRM daemon, with empty
+ * callbacks: the time per cycle is the cost of the control loop and of the JNI callbacks dispatching. Each case
+ * is run a few times to warm up the JIT, then measured over the same number of runs.
+ *
+ * Usage: java -Djava.library.path=[bindings path]:[bench stub path] -jar RTLibJavaBench.jar [cycles] [runs]
+ */
+public class BenchCycleOverhead {
+
+    /** Empty callbacks */
+    static class Empty extends BbqueEXC {
+
+        private final int mCycles;
+
+        private int mCount = 0;
+
+        Empty(String name, RTLibServices services, int cycles) throws RTLibException {
+            super(name, "stub", services);
+            mCycles = cycles;
+        }
+
+        @Override
+        protected void onSetup() { }
+
+        @Override
+        protected void onConfigure(int awmId) { }
+
+        @Override
+        protected void onSuspend() { }
+
+        @Override
+        protected void onResume() { }
+
+        @Override
+        protected void onRun() throws RTLibException {
+            if (++mCount > mCycles)
+                throw new RTLibException(RTLibExitCode.RTLIB_EXC_WORKLOAD_NONE);
+        }
+
+        @Override
+        protected void onMonitor() { }
+
+        @Override
+        protected void onRelease() { }
+    }
+
+    /** onMonitor reading the cycle statistics by calls into the RTLib */
+    static class MonitorCalls extends Empty {
+
+        float mStats;
+
+        MonitorCalls(String name, RTLibServices services, int cycles) throws RTLibException {
+            super(name, services, cycles);
+        }
+
+        @Override
+        protected void onMonitor() {
+            mStats = cycles() + currentAWM() + getCPS() + getJPS();
+        }
+    }
+
+    private static double measure(Class<? extends Empty> excClass, RTLibServices services, int cycles)
+            throws Exception {
+        Empty exc = excClass
+                .getDeclaredConstructor(String.class, RTLibServices.class, int.class)
+                .newInstance("bench_" + excClass.getSimpleName(), services, cycles);
+        long start = System.nanoTime();
+        exc.start();
+        exc.waitCompletion();
+        long elapsed = System.nanoTime() - start;
+        return elapsed / 1e3 / cycles;
+    }
+
+    public static void main(String[] args) throws Exception {
+        int cycles = (args.length > 0) ? Integer.parseInt(args[0]) : 100000;
+        int runs = (args.length > 1) ? Integer.parseInt(args[1]) : 5;
+        RTLibServices services = BenchStub.init();
+
+        for (Class<? extends Empty> excClass : java.util.Arrays.asList(Empty.class, MonitorCalls.class)) {
+            for (int r = 0; r < runs; r++)
+                measure(excClass, services, cycles);
+            double min = Double.MAX_VALUE, sum = 0;
+            for (int r = 0; r < runs; r++) {
+                double usPerCycle = measure(excClass, services, cycles);
+                min = Math.min(min, usPerCycle);
+                sum += usPerCycle;
+            }
+            System.out.printf("%-14s %8.2f us/cycle (min %.2f)%n", excClass.getSimpleName(), sum / runs, min);
+        }
+    }
+}
@@ -0,0 +1,25 @@
+package bbque.rtlib.bench;
+
+import bbque.rtlib.RTLib;
+import bbque.rtlib.model.RTLibServices;
+
+/**
+ * RTLib services not connected to the BarbequeRTRM daemon: the EXCs are started straight into AWM 0 and the
+ * control requests are ignored. They come from a benchmark-only native library, not from the RTLib binding.
+ */
+public class BenchStub {
+
+    private static final String SHARED_LIBRARY_NAME = "bbque_java_bench_stub";
+
+    static {
+        // The EXCs natives are in the RTLib binding library
+        try {
+            Class.forName(RTLib.class.getName());
+        } catch (ClassNotFoundException e) {
+            throw new ExceptionInInitializerError(e);
+        }
+        System.loadLibrary(SHARED_LIBRARY_NAME);
+    }
+
+    public static native RTLibServices init();
+}
@@ -0,0 +1,27 @@
+#include <jni.h>
+#include <bbque/rtlib.h>
+#include "rtlib_stub.h"
+
+extern "C" {
+
+/*
+ * Class:     bbque_rtlib_bench_BenchStub
+ * Method:    init
+ * Signature: ()Lbbque/rtlib/model/RTLibServices;
+ */
+JNIEXPORT jobject JNICALL Java_bbque_rtlib_bench_BenchStub_init
+  (JNIEnv *, jclass);
+
+}
+
+/*
+ * The RTLibServices object is built here, instead of reusing the binding
+ * helpers, so that the shipping library does not export anything for the
+ * benchmarks.
+ */
+jobject Java_bbque_rtlib_bench_BenchStub_init(JNIEnv *env, jclass java_class) {
+	jclass java_services_class = env->FindClass("bbque/rtlib/model/RTLibServices");
+	jmethodID constructor_id = env->GetMethodID(java_services_class, "<init>", "(J)V");
+	jlong native_pointer = reinterpret_cast<jlong>(RTLIB_StubServices());
+	return env->NewObject(java_services_class, constructor_id, native_pointer);
+}
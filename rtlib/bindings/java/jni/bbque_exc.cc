@@ -1,3 +1,4 @@
+#include <cstdarg>
 #include <jni.h>
 #include <bbque/bbque_exc.h>
 #include "bbque_exc.h"
@@ -279,17 +280,108 @@ jobject Java_bbque_rtlib_model_BbqueEXC_configuration(JNIEnv *env, jobject obj)
 	return createRTLibConfigObjFromNativeObj(env, config);
 }
 
-RTLIB_ExitCode_t JNIBbqueEXC::onGenericIntCallback(const char *method, const char *signature, ...) {
-	va_list arguments;
-	va_start(arguments, signature);
+namespace {
+
+/**
+ * Keep a native thread attached to the JVM until the thread terminates,
+ * thus avoiding an attach/detach pair for each callback of the control loop
+ */
+struct JNIThreadAttachment {
+	JavaVM *jvm = nullptr;
+	JNIEnv *env = nullptr;
+
+	~JNIThreadAttachment() {
+		if (jvm != nullptr)
+			jvm->DetachCurrentThread();
+	}
+};
+
+thread_local JNIThreadAttachment thread_attachment;
+
+struct JNICallbackSignature {
+	const char *method;
+	const char *signature;
+};
+
+} // namespace
+
+JNIBbqueEXC::JNIBbqueEXC(std::string const & name, std::string const & recipe, RTLIB_Services_t *rtlib, JNIEnv *env, jobject obj)
+											: BbqueEXC(name, recipe, rtlib) {
+	static const JNICallbackSignature callbacks[CB_COUNT] = {
+		{ "onSetupCallback",     "()I"  },
+		{ "onConfigureCallback", "(I)I" },
+		{ "onSuspendCallback",   "()I"  },
+		{ "onResumeCallback",    "()I"  },
+		{ "onRunCallback",       "()I"  },
+		{ "onMonitorCallback",   "()I"  },
+		{ "onReleaseCallback",   "()I"  }
+	};
+
+	env->GetJavaVM(&jvm);
+	callback_obj = env->NewGlobalRef(obj);
+	jclass obj_class = env->GetObjectClass(obj);
+	callback_class = reinterpret_cast<jclass>(env->NewGlobalRef(obj_class));
+	env->DeleteLocalRef(obj_class);
+
+	// Resolve the callbacks once for all
+	for (int i = 0; i < CB_COUNT; i++) {
+		callback_methods[i] = env->GetMethodID(callback_class,
+				callbacks[i].method, callbacks[i].signature);
+	}
+}
+
+JNIBbqueEXC::~JNIBbqueEXC() {
 	JNIEnv *env;
-	jvm->AttachCurrentThread((void **)&env, NULL);
-	jmethodID callback_method = env->GetMethodID(callback_class, method, signature);
-	jobject java_exit_code = env->CallObjectMethodV(callback_obj, callback_method, arguments);
-	jclass java_exit_code_class = env->GetObjectClass(java_exit_code);
-	jfieldID jni_exit_code_value_id = env->GetFieldID(java_exit_code_class, "mJNIValue", "I");
-	jint jni_exit_code_value = env->GetIntField(java_exit_code, jni_exit_code_value_id);
+	bool attached = false;
+
+	// The EXC can be destroyed by a native thread not attached to the JVM:
+	// attach it just to release the global references
+	jint result = jvm->GetEnv((void **)&env, JNI_VERSION_1_6);
+	if (result == JNI_EDETACHED) {
+		if (jvm->AttachCurrentThread((void **)&env, NULL) != JNI_OK)
+			return;
+		attached = true;
+	}
+	else if (result != JNI_OK)
+		return;
+
+	env->DeleteGlobalRef(callback_obj);
+	env->DeleteGlobalRef(callback_class);
+	if (attached)
+		jvm->DetachCurrentThread();
+}
+
+JNIEnv *JNIBbqueEXC::getCallbackEnv() {
+	JNIEnv *env;
+	if (thread_attachment.env != nullptr)
+		return thread_attachment.env;
+
+	// Thread already known by the JVM (e.g. a Java thread)
+	if (jvm->GetEnv((void **)&env, JNI_VERSION_1_6) == JNI_OK)
+		return env;
+
+	if (jvm->AttachCurrentThread((void **)&env, NULL) != JNI_OK)
+		return nullptr;
+	thread_attachment.jvm = jvm;
+	thread_attachment.env = env;
+	return env;
+}
+
+RTLIB_ExitCode_t JNIBbqueEXC::onGenericIntCallback(CallbackID id, ...) {
+	JNIEnv *env = getCallbackEnv();
+	if ((env == nullptr) || (callback_methods[id] == nullptr))
+		return RTLIB_ERROR;
+
+	va_list arguments;
+	va_start(arguments, id);
+	jint jni_exit_code_value = env->CallIntMethodV(callback_obj, callback_methods[id], arguments);
 	va_end(arguments);
-	jvm->DetachCurrentThread();
+
+	// Unchecked exceptions thrown by the callback
+	if (env->ExceptionCheck()) {
+		env->ExceptionDescribe();
+		env->ExceptionClear();
+		return RTLIB_ERROR;
+	}
 	return getNativeExitCode(jni_exit_code_value);
 }
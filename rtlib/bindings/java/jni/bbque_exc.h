@@ -10,53 +10,68 @@ class JNIBbqueEXC : public BbqueEXC {
 
 public:
 
-	JNIBbqueEXC(std::string const & name, std::string const & recipe, RTLIB_Services_t *rtlib, JNIEnv *env, jobject obj)
-												: BbqueEXC(name, recipe, rtlib) {
-		env->GetJavaVM(&jvm);
-		callback_obj = env->NewGlobalRef(obj);
-		jclass obj_class = env->GetObjectClass(obj);
-		callback_class = reinterpret_cast<jclass>(env->NewGlobalRef(obj_class));
-	}
+	JNIBbqueEXC(std::string const & name, std::string const & recipe, RTLIB_Services_t *rtlib, JNIEnv *env, jobject obj);
 
-	virtual ~JNIBbqueEXC() {
-		delete jvm;
-	}
+	virtual ~JNIBbqueEXC();
 
 private:
 
+	/**
+	 * The Java callbacks, whose method IDs are resolved once at construction
+	 * time
+	 */
+	enum CallbackID {
+		CB_SETUP = 0,
+		CB_CONFIGURE,
+		CB_SUSPEND,
+		CB_RESUME,
+		CB_RUN,
+		CB_MONITOR,
+		CB_RELEASE,
+		CB_COUNT
+	};
+
 	JavaVM *jvm;
 	jobject callback_obj;
 	jclass callback_class;
+	jmethodID callback_methods[CB_COUNT];
 
 	RTLIB_ExitCode_t onSetup() override {
-		return onGenericIntCallback("onSetupCallback", "()Lbbque/rtlib/enumeration/RTLibExitCode;");
+		return onGenericIntCallback(CB_SETUP);
 	}
 
 	RTLIB_ExitCode_t onConfigure(int8_t awm_id) override {
-		return onGenericIntCallback("onConfigureCallback", "(I)Lbbque/rtlib/enumeration/RTLibExitCode;", (jint) awm_id);
+		return onGenericIntCallback(CB_CONFIGURE, (jint) awm_id);
 	}
 
 	RTLIB_ExitCode_t onSuspend() override {
-		return onGenericIntCallback("onSuspendCallback", "()Lbbque/rtlib/enumeration/RTLibExitCode;");
+		return onGenericIntCallback(CB_SUSPEND);
 	}
 
 	RTLIB_ExitCode_t onResume() override {
-		return onGenericIntCallback("onResumeCallback", "()Lbbque/rtlib/enumeration/RTLibExitCode;");
+		return onGenericIntCallback(CB_RESUME);
 	}
 
 	RTLIB_ExitCode_t onRun() override {
-		return onGenericIntCallback("onRunCallback", "()Lbbque/rtlib/enumeration/RTLibExitCode;");
+		return onGenericIntCallback(CB_RUN);
 	}
 
 	RTLIB_ExitCode_t onMonitor() override {
-		return onGenericIntCallback("onMonitorCallback", "()Lbbque/rtlib/enumeration/RTLibExitCode;");
+		return onGenericIntCallback(CB_MONITOR);
 	}
 
 	RTLIB_ExitCode_t onRelease() override {
-		return onGenericIntCallback("onReleaseCallback", "()Lbbque/rtlib/enumeration/RTLibExitCode;");
+		return onGenericIntCallback(CB_RELEASE);
 	}
 
-	RTLIB_ExitCode_t onGenericIntCallback(const char *method, const char *signature, ...);
+	/**
+	 * Return the JNI environment of the calling thread. Native threads (e.g.
+	 * the control loop) are attached to the JVM at the first call, and
+	 * detached only when the thread terminates.
+	 */
+	JNIEnv *getCallbackEnv();
+
+	RTLIB_ExitCode_t onGenericIntCallback(CallbackID id, ...);
 };
 
 #ifdef __cplusplus
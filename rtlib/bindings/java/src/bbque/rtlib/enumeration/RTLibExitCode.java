@@ -123,4 +123,8 @@ public enum RTLibExitCode {
     RTLibExitCode(int value) {
         mJNIValue = value;
     }
+
+    public int getJNIValue() {
+        return mJNIValue;
+    }
 }
\ No newline at end of file
@@ -106,66 +106,66 @@ public abstract class BbqueEXC {
      ************************************* NATIVE CALLBACKS BRIDGE *********************************************
      ***********************************************************************************************************/
 
-    private RTLibExitCode onSetupCallback() {
+    private int onSetupCallback() {
         try {
             onSetup();
         } catch (RTLibException e) {
-            return e.getExitCode();
+            return e.getExitCode().getJNIValue();
         }
-        return RTLibExitCode.RTLIB_OK;
+        return RTLibExitCode.RTLIB_OK.getJNIValue();
     }
 
-    private RTLibExitCode onConfigureCallback(int awmId) {
+    private int onConfigureCallback(int awmId) {
         try {
             onConfigure(awmId);
         } catch (RTLibException e) {
-            return e.getExitCode();
+            return e.getExitCode().getJNIValue();
         }
-        return RTLibExitCode.RTLIB_OK;
+        return RTLibExitCode.RTLIB_OK.getJNIValue();
     }
 
-    private RTLibExitCode onSuspendCallback() {
+    private int onSuspendCallback() {
         try {
             onSuspend();
         } catch (RTLibException e) {
-            return e.getExitCode();
+            return e.getExitCode().getJNIValue();
         }
-        return RTLibExitCode.RTLIB_OK;
+        return RTLibExitCode.RTLIB_OK.getJNIValue();
     }
 
-    private RTLibExitCode onResumeCallback() {
+    private int onResumeCallback() {
         try {
             onResume();
         } catch (RTLibException e) {
-            return e.getExitCode();
+            return e.getExitCode().getJNIValue();
         }
-        return RTLibExitCode.RTLIB_OK;
+        return RTLibExitCode.RTLIB_OK.getJNIValue();
     }
 
-    private RTLibExitCode onRunCallback() {
+    private int onRunCallback() {
         try {
             onRun();
         } catch (RTLibException e) {
-            return e.getExitCode();
+            return e.getExitCode().getJNIValue();
         }
-        return RTLibExitCode.RTLIB_OK;
+        return RTLibExitCode.RTLIB_OK.getJNIValue();
     }
 
-    private RTLibExitCode onMonitorCallback() {
+    private int onMonitorCallback() {
         try {
             onMonitor();
         } catch (RTLibException e) {
-            return e.getExitCode();
+            return e.getExitCode().getJNIValue();
         }
-        return RTLibExitCode.RTLIB_OK;
+        return RTLibExitCode.RTLIB_OK.getJNIValue();
     }
 
-    private RTLibExitCode onReleaseCallback() {
+    private int onReleaseCallback() {
         try {
             onRelease();
         } catch (RTLibException e) {
-            return e.getExitCode();
+            return e.getExitCode().getJNIValue();
         }
-        return RTLibExitCode.RTLIB_OK;
+        return RTLibExitCode.RTLIB_OK.getJNIValue();
     }
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+#
+# Per-cycle overhead of the RTLib python binding.
+#
+# The EXCs run on the stub RTLib services (RTLIB_InitStub), i.e. without the
+# BarbequeRTRM daemon, with empty callbacks: the time per cycle is the cost of
+# the control loop and of the callbacks dispatching.
+#
+# Usage: PYTHONPATH=<bindings path> bench_cycle_overhead.py [cycles]
+
+import sys
+import time
+
+import barbeque as bq
+
+
+class Empty(bq.BbqueEXC):
+    """Empty onRun and onMonitor, the other callbacks are not overridden"""
+
+    def __init__(self, name, services, cycles):
+        bq.BbqueEXC.__init__(self, name, "stub", services)
+        self.cycles = cycles
+        self.count = 0
+
+    def onRun(self):
+        self.count += 1
+        if self.count > self.cycles:
+            return bq.RTLIB_ExitCode.RTLIB_EXC_WORKLOAD_NONE
+        return bq.RTLIB_ExitCode.RTLIB_OK
+
+    def onMonitor(self):
+        return bq.RTLIB_ExitCode.RTLIB_OK
+
+
+class MonitorCalls(Empty):
+    """onMonitor reading the cycle statistics by calls into the RTLib"""
+
+    def onMonitor(self):
+        self.stats = (self.Cycles(), self.CurrentAWM(), self.GetCPS(),
+                      self.GetJPS())
+        return bq.RTLIB_ExitCode.RTLIB_OK
+
+
+class MonitorViews(Empty):
+    """onMonitor reading the cycle statistics from the in-place view"""
+
+    def onSetup(self):
+        self.data = memoryview(self.cycle_data)
+        return bq.RTLIB_ExitCode.RTLIB_OK
+
+    def onMonitor(self):
+        data = self.data
+        self.stats = (data[bq.RTLIB_CycleData.CYCLES],
+                      data[bq.RTLIB_CycleData.AWM_ID],
+                      data[bq.RTLIB_CycleData.CPS],
+                      data[bq.RTLIB_CycleData.JPS])
+        return bq.RTLIB_ExitCode.RTLIB_OK
+
+    def onRelease(self):
+        # The view keeps the EXC alive
+        self.data.release()
+        self.data = None
+        return bq.RTLIB_ExitCode.RTLIB_OK
+
+
+def measure(exc_class, services, cycles):
+    exc = exc_class("bench_" + exc_class.__name__, services, cycles)
+    start = time.perf_counter()
+    exc.Start()
+    exc.WaitCompletion()
+    elapsed = time.perf_counter() - start
+    del exc
+    return elapsed * 1e6 / cycles
+
+
+def main():
+    cycles = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+    services = bq.RTLIB_Services_Wrapper()
+    bq.RTLIB_InitStub(services)
+
+    for exc_class in (Empty, MonitorCalls, MonitorViews):
+        us_per_cycle = measure(exc_class, services.services, cycles)
+        print("%-14s %8.2f us/cycle" % (exc_class.__name__, us_per_cycle))
+
+
+if __name__ == "__main__":
+    main()
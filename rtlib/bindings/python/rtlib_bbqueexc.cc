@@ -1,13 +1,106 @@
 #include "rtlib_bbqueexc.h"
 
+const char * PyBbqueEXC::callback_names[PyBbqueEXC::CALLBACK_COUNT] = {
+   "onSetup",
+   "onConfigure",
+   "onSuspend",
+   "onResume",
+   "onRun",
+   "onMonitor",
+   "onRelease"
+};
+
+void PyBbqueEXC::ResolveOverrides() {
+   if (callbacks_resolved)
+      return;
+
+   for (int cb = 0; cb < CALLBACK_COUNT; ++cb) {
+      py::function overload = py::get_overload(
+            static_cast<const BbqueEXC *>(this), callback_names[cb]);
+      if (!overload) {
+         dispatching[cb] = Dispatching::DEFAULT;
+         continue;
+      }
+      if (!py::hasattr(overload, "__func__") ||
+            !py::hasattr(overload, "__self__")) {
+         dispatching[cb] = Dispatching::LOOKUP;
+         continue;
+      }
+      callbacks[cb] = overload.attr("__func__");
+      py_self = overload.attr("__self__").ptr();
+      dispatching[cb] = Dispatching::CACHED;
+   }
+
+   callbacks_resolved = true;
+}
+
+/* The control thread keeps its python thread state */
+static thread_local bool thread_state_kept = false;
+
+void PyBbqueEXC::KeepThreadState(py::gil_scoped_acquire &gil) {
+   if (thread_state_kept)
+      return;
+   // One more reference to the thread state of this acquisition: pybind11
+   // does not delete it at the release, and finds it at the next one
+   gil.inc_ref();
+   thread_state_kept = true;
+}
+
+void PyBbqueEXC::ReleaseThreadState() {
+   if (!thread_state_kept || !Py_IsInitialized())
+      return;
+   // Drop the kept reference: the end of this acquisition deletes the
+   // thread state, and releases the GIL
+   py::gil_scoped_acquire gil;
+   gil.dec_ref();
+   thread_state_kept = false;
+}
+
+void PyBbqueEXC::UpdateCycleData(bool with_rates) {
+   cycle_data.values[RTLIB_CycleData_Wrapper::CYCLES] = Cycles();
+   cycle_data.values[RTLIB_CycleData_Wrapper::AWM_ID] = CurrentAWM();
+   if (!with_rates)
+      return;
+
+   float cps = GetCPS();
+   cycle_data.values[RTLIB_CycleData_Wrapper::CPS] = cps;
+   cycle_data.values[RTLIB_CycleData_Wrapper::JPS] = GetJPS();
+   cycle_data.values[RTLIB_CycleData_Wrapper::CTIME_MS] =
+      (cps > 0) ? 1e3 / cps : 0;
+}
+
+void PyBbqueEXC::UpdateAWMResources() {
+   for (int r_type = SYSTEM; r_type < RTLIB_AWMResources_Wrapper::COUNT; ++r_type) {
+      if (GetAssignedResources(static_cast<RTLIB_ResourceType_t>(r_type),
+               awm_resources.values[r_type]) != RTLIB_OK)
+         awm_resources.values[r_type] = -1;
+   }
+}
+
 void init_BbqueEXC(py::module &m) {
    py::class_<BbqueEXC, PyBbqueEXC>(m, "BbqueEXC")
       .def(py::init<std::string const &,
             std::string const &,
             RTLIB_Services_t * const>())
-      .def("Start", &BbqueEXC::Start)
-      .def("WaitCompletion", &BbqueEXC::WaitCompletion)
-      .def("Terminate", &BbqueEXC::Terminate)
+      .def("Start", [](BbqueEXC &bbqueEXC)
+            {
+               PyBbqueEXC *py_exc = dynamic_cast<PyBbqueEXC *>(&bbqueEXC);
+               if (py_exc)
+                  py_exc->ResolveOverrides();
+               py::gil_scoped_release release;
+               return bbqueEXC.Start();
+            })
+      // The control thread needs the GIL to call the python callbacks
+      .def("WaitCompletion", [](BbqueEXC &bbqueEXC)
+            {
+               py::gil_scoped_release release;
+               return bbqueEXC.WaitCompletion();
+            })
+      .def("Terminate", [](BbqueEXC &bbqueEXC)
+            {
+               py::gil_scoped_release release;
+               return bbqueEXC.Terminate();
+            })
       .def("isRegistered", &BbqueEXC::isRegistered)
       .def("Enable", &BbqueEXC::Enable)
       .def("SetAWMConstraints",
@@ -52,6 +145,16 @@ void init_BbqueEXC(py::module &m) {
       .def("Configuration", &BbqueEXC::Configuration)
       .def_property_readonly("exc_name", &PyBbqueEXC::get_exc_name)
       .def_property_readonly("rpc_name", &PyBbqueEXC::get_rpc_name)
+      .def_property_readonly("cycle_data", [](BbqueEXC &bbqueEXC)
+            {
+               PyBbqueEXC *py_exc = dynamic_cast<PyBbqueEXC *>(&bbqueEXC);
+               return py_exc ? &py_exc->get_cycle_data() : nullptr;
+            }, py::return_value_policy::reference_internal)
+      .def_property_readonly("awm_resources", [](BbqueEXC &bbqueEXC)
+            {
+               PyBbqueEXC *py_exc = dynamic_cast<PyBbqueEXC *>(&bbqueEXC);
+               return py_exc ? &py_exc->get_awm_resources() : nullptr;
+            }, py::return_value_policy::reference_internal)
       .def_property_readonly("logger", [](PyBbqueEXC &bbqueEXC)
             {
                auto logger_w = new RTLIB_Logger_Wrapper(bbqueEXC.get_logger());
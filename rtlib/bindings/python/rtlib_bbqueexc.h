@@ -20,71 +20,85 @@ class PyBbqueEXC : public BbqueEXC {
    public:
       using BbqueEXC::BbqueEXC;
 
+      /*
+       * The callbacks that can be reimplemented on the python side
+       */
+      enum Callback {
+         ON_SETUP = 0,
+         ON_CONFIGURE,
+         ON_SUSPEND,
+         ON_RESUME,
+         ON_RUN,
+         ON_MONITOR,
+         ON_RELEASE,
+         CALLBACK_COUNT
+      };
+
+      /*
+       * Look up the python overrides once, such that the control loop
+       * neither resolves them by name at each cycle, nor takes the GIL to
+       * run the callbacks not overridden. The unbound functions are kept,
+       * since the bound methods would reference the python object from the
+       * C++ one. Called from python (GIL held) before the EXC starts.
+       */
+      void ResolveOverrides();
+
       /*
        * onSetup, onConfigure, onSuspend, onResume, onRun, onMonitor and onSetup
        * are the virtual methods that can be reimplemented on the python side.
-       * the py::gil_scoped_release at the start of each function is neede to python
-       * GIL, the lock mechanism for python thread safety. Since RTLIB is already
-       * thread safe, we let it deal with that. If we don't release the lock, we risk
-       * a deadlock between the futexes and mutexs used by the two locking mechanisms
+       * They are called by the control thread of the EXC, which does not
+       * hold the python GIL: it is acquired only to call the python
+       * overrides. The default implementations run without it.
        */
       RTLIB_ExitCode_t onSetup() override {
-         py::gil_scoped_release release;
-
-         PYBIND11_OVERLOAD(
-               RTLIB_ExitCode,
-               BbqueEXC,
-               onSetup,
-               );
+         RTLIB_ExitCode_t result;
+         if (Dispatch(ON_SETUP, result))
+            return result;
+         return BbqueEXC::onSetup();
       };
       RTLIB_ExitCode_t onConfigure(int8_t awm_id) override {
-         py::gil_scoped_release release;
-         PYBIND11_OVERLOAD(
-               RTLIB_ExitCode,
-               BbqueEXC,
-               onConfigure,
-               awm_id
-               );
+         RTLIB_ExitCode_t result;
+         if (IsOverridden(ON_CONFIGURE))
+            UpdateAWMResources();
+         if (Dispatch(ON_CONFIGURE, result, awm_id))
+            return result;
+         return BbqueEXC::onConfigure(awm_id);
       };
       RTLIB_ExitCode_t onSuspend() override {
-         py::gil_scoped_release release;
-         PYBIND11_OVERLOAD(
-               RTLIB_ExitCode,
-               BbqueEXC,
-               onSuspend,
-               );
+         RTLIB_ExitCode_t result;
+         if (Dispatch(ON_SUSPEND, result))
+            return result;
+         return BbqueEXC::onSuspend();
       };
       RTLIB_ExitCode_t onResume() override {
-         py::gil_scoped_release release;
-         PYBIND11_OVERLOAD(
-               RTLIB_ExitCode,
-               BbqueEXC,
-               onResume,
-               );
+         RTLIB_ExitCode_t result;
+         if (Dispatch(ON_RESUME, result))
+            return result;
+         return BbqueEXC::onResume();
       };
       RTLIB_ExitCode_t onRun() override {
-         py::gil_scoped_release release;
-         PYBIND11_OVERLOAD(
-               RTLIB_ExitCode,
-               BbqueEXC,
-               onRun,
-               );
+         RTLIB_ExitCode_t result;
+         if (IsOverridden(ON_RUN))
+            UpdateCycleData(false);
+         if (Dispatch(ON_RUN, result))
+            return result;
+         return BbqueEXC::onRun();
       };
       RTLIB_ExitCode_t onMonitor() override {
-         py::gil_scoped_release release;
-         PYBIND11_OVERLOAD(
-               RTLIB_ExitCode,
-               BbqueEXC,
-               onMonitor,
-               );
+         RTLIB_ExitCode_t result;
+         if (IsOverridden(ON_MONITOR))
+            UpdateCycleData(true);
+         if (Dispatch(ON_MONITOR, result))
+            return result;
+         return BbqueEXC::onMonitor();
       };
       RTLIB_ExitCode_t onRelease() override {
-         py::gil_scoped_release release;
-         PYBIND11_OVERLOAD(
-               RTLIB_ExitCode,
-               BbqueEXC,
-               onRelease,
-               );
+         RTLIB_ExitCode_t result;
+         if (!Dispatch(ON_RELEASE, result))
+            result = BbqueEXC::onRelease();
+         // The last callback of the control thread
+         ReleaseThreadState();
+         return result;
       };
 
       std::unique_ptr<bu::Logger>& get_logger() {
@@ -96,6 +110,90 @@ class PyBbqueEXC : public BbqueEXC {
       std::string const get_rpc_name() {
          return rpc_name;
       };
+      RTLIB_CycleData_Wrapper & get_cycle_data() {
+         return cycle_data;
+      };
+      RTLIB_AWMResources_Wrapper & get_awm_resources() {
+         return awm_resources;
+      };
+
+   private:
+
+      /*
+       * How a callback is dispatched: not overridden (C++ default), cached
+       * unbound function, or look-up by name at each call (e.g., overrides
+       * not resolved yet, or callable attributes other than methods)
+       */
+      enum class Dispatching {
+         DEFAULT,
+         CACHED,
+         LOOKUP
+      };
+
+      static const char * callback_names[CALLBACK_COUNT];
+
+      bool callbacks_resolved = false;
+
+      Dispatching dispatching[CALLBACK_COUNT];
+
+      py::object callbacks[CALLBACK_COUNT];
+
+      /* The python object (borrowed: it owns this one) */
+      py::handle py_self;
+
+      RTLIB_CycleData_Wrapper cycle_data;
+
+      RTLIB_AWMResources_Wrapper awm_resources;
+
+      inline bool IsOverridden(Callback cb) const {
+         return !callbacks_resolved || (dispatching[cb] != Dispatching::DEFAULT);
+      }
+
+      /*
+       * Call the python override of a callback, if any
+       *
+       * @return false if the callback is not overridden, i.e. the default
+       * implementation must be called
+       */
+      template <typename... Args>
+      bool Dispatch(Callback cb, RTLIB_ExitCode_t & result, Args... args) {
+         if (!IsOverridden(cb))
+            return false;
+
+         py::gil_scoped_acquire gil;
+         KeepThreadState(gil);
+
+         if (callbacks_resolved && (dispatching[cb] == Dispatching::CACHED)) {
+            result = callbacks[cb](py_self, args...).template cast<RTLIB_ExitCode_t>();
+            return true;
+         }
+
+         py::function overload = py::get_overload(
+               static_cast<const BbqueEXC *>(this), callback_names[cb]);
+         if (!overload)
+            return false;
+         result = overload(args...).template cast<RTLIB_ExitCode_t>();
+         return true;
+      }
+
+      /*
+       * Keep the python thread state of the control thread across the
+       * callbacks, instead of creating and deleting it at each GIL
+       * acquisition: the first acquisition of the thread takes one more
+       * reference to it.
+       */
+      static void KeepThreadState(py::gil_scoped_acquire &gil);
+
+      /*
+       * Delete the python thread state kept by the control thread, if any.
+       * To be called without the GIL and with no acquisition alive, at the
+       * end of the control loop.
+       */
+      static void ReleaseThreadState();
+
+      void UpdateCycleData(bool with_rates);
+
+      void UpdateAWMResources();
 };
 
 void init_BbqueEXC(py::module &m);
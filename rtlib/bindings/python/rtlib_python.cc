@@ -2,6 +2,7 @@
 #include "rtlib_enums.h"
 #include "rtlib_types_wrappers.h"
 #include "rtlib_bbqueexc.h"
+#include "rtlib_stub_services.h"
 
 namespace py = pybind11;
 
@@ -43,6 +44,7 @@ PYBIND11_PLUGIN(barbeque) {
    init_enums(m);
    init_wrappers(m);
    init_BbqueEXC(m);
+   init_stub_services(m);
 
    m.attr("__version__") = py::str("dev");
 
@@ -0,0 +1,12 @@
+#include "rtlib_stub_services.h"
+#include "rtlib_types_wrappers.h"
+
+void init_stub_services(py::module &m) {
+   m.def("RTLIB_InitStub",
+         [](RTLIB_Services_Wrapper &services) {
+            services.services = RTLIB_StubServices();
+            return RTLIB_OK;
+         }, R"pbdoc(
+      Initialize stub RTLib services, not connected to the BarbequeRTRM
+   )pbdoc");
+}
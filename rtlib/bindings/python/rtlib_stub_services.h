@@ -0,0 +1,12 @@
+#ifndef RTLIB_STUB_SERVICES_H
+#define RTLIB_STUB_SERVICES_H
+
+#include <pybind11/pybind11.h>
+
+#include "rtlib_stub.h"
+
+namespace py = pybind11;
+
+void init_stub_services(py::module &m);
+
+#endif
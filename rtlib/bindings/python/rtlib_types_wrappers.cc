@@ -18,6 +18,36 @@ void init_wrappers(py::module &m) {
       .def(py::init<int>())
       .def("masks", &RTLIB_AffinityMasks_Wrapper::masks);
 
+   // in-place updated views, through the buffer protocol
+   py::class_<RTLIB_CycleData_Wrapper> cycle_data(
+         m, "RTLIB_CycleData", py::buffer_protocol());
+   cycle_data.def_buffer([](RTLIB_CycleData_Wrapper &data) -> py::buffer_info {
+         return py::buffer_info(
+               data.values,
+               sizeof(double),
+               py::format_descriptor<double>::format(),
+               1,
+               { (size_t) RTLIB_CycleData_Wrapper::COUNT },
+               { sizeof(double) });
+         });
+   cycle_data.attr("CYCLES") = py::int_(RTLIB_CycleData_Wrapper::CYCLES);
+   cycle_data.attr("AWM_ID") = py::int_(RTLIB_CycleData_Wrapper::AWM_ID);
+   cycle_data.attr("CPS") = py::int_(RTLIB_CycleData_Wrapper::CPS);
+   cycle_data.attr("JPS") = py::int_(RTLIB_CycleData_Wrapper::JPS);
+   cycle_data.attr("CTIME_MS") = py::int_(RTLIB_CycleData_Wrapper::CTIME_MS);
+
+   py::class_<RTLIB_AWMResources_Wrapper>(
+         m, "RTLIB_AWMResources", py::buffer_protocol())
+      .def_buffer([](RTLIB_AWMResources_Wrapper &resources) -> py::buffer_info {
+         return py::buffer_info(
+               resources.values,
+               sizeof(int32_t),
+               py::format_descriptor<int32_t>::format(),
+               1,
+               { (size_t) RTLIB_AWMResources_Wrapper::COUNT },
+               { sizeof(int32_t) });
+         });
+
    py::class_<RTLIB_Logger_Wrapper>(m, "RTLIB_Logger_Wrapper")
       .def("Debug", &RTLIB_Logger_Wrapper::Debug)
       .def("Info", &RTLIB_Logger_Wrapper::Info)
@@ -58,6 +58,41 @@ class RTLIB_AffinityMasks_Wrapper {
       std::vector<int32_t> _masks;
 };
 
+/*
+ * Statistics of the current cycle, updated in place by the control loop right
+ * before the python callbacks are called. The python side accesses them
+ * through the buffer protocol, e.g.:
+ *
+ *    data = memoryview(self.cycle_data)
+ *    cps  = data[barbeque.RTLIB_CycleData.CPS]
+ *
+ * such that no call back into the RTLib is needed at each cycle. The values
+ * are consistent within a callback only.
+ */
+struct RTLIB_CycleData_Wrapper {
+   enum Index {
+      CYCLES = 0,
+      AWM_ID,
+      CPS,
+      JPS,
+      CTIME_MS,
+      COUNT
+   };
+   double values[COUNT] = {0};
+};
+
+/*
+ * Amount of resources assigned in the current AWM, indexed by
+ * RTLIB_ResourceType and updated in place right before onConfigure (-1 if
+ * not available)
+ */
+struct RTLIB_AWMResources_Wrapper {
+   enum Index {
+      COUNT = ACCELERATOR + 1
+   };
+   int32_t values[COUNT] = {0};
+};
+
 /*
  * Simple wrapper for the logger, the formatting is done on the python side
  * so we just pass a string as argument
@@ -588,8 +588,12 @@ RTLIB_ExitCode_t BbqueRPC_FIFO_Client::_RTNotify(pRegisteredEXC_t prec, int gap,
 			gap,
 			cpu_usage,
 			cycle_time_ms,
+			{},
+			{}
 		}
 	};
+	GetQuantileStats(prec,
+		rf_EXC_RTNOTIFY.pyl.ctime_q, rf_EXC_RTNOTIFY.pyl.rtime_q);
 	logger->Debug("_RTNotify: Set Goal-Gap for EXC [%d:%d]...",
 		rf_EXC_RTNOTIFY.pyl.hdr.app_pid,
 		rf_EXC_RTNOTIFY.pyl.hdr.exc_id);
@@ -886,9 +890,13 @@ RTLIB_ExitCode_t BbqueRPC_FIFO_Client::_GetRuntimeProfileResp(
 				prec->id
 			},
 			exc_time,
-			mem_time
+			mem_time,
+			{},
+			{}
 		}
 	};
+	GetQuantileStats(prec,
+		rf_BBQ_GET_PROFILE_RESP.pyl.ctime_q, rf_BBQ_GET_PROFILE_RESP.pyl.rtime_q);
 	// Sending RPC response
 	logger->Debug("_GetRuntimeProfileResp: Setting runtime profile info for EXC [%d:%d]...",
 		rf_BBQ_GET_PROFILE_RESP.pyl.hdr.app_pid,
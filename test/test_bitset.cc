@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <string>
+
+#include "bbque/res/bitset.h"
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "BITSET     [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "BITSET     [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "BITSET     [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "BITSET     [ERR]", fmt)
+
+using bbque::res::ResourceBitset;
+
+static ResourceBitset Make(std::initializer_list<BBQUE_RID_TYPE> ids) {
+	ResourceBitset rbs;
+	for (auto id: ids)
+		rbs.Set(id);
+	return rbs;
+}
+
+// Check the bits, the counters and the CG string of a bitset
+static bool Check(char const * what, ResourceBitset const & rbs,
+		std::string const & cg_str, BBQUE_RID_TYPE first,
+		BBQUE_RID_TYPE last, BBQUE_RID_TYPE count) {
+	if ((rbs.ToStringCG() == cg_str) && (rbs.FirstSet() == first) &&
+			(rbs.LastSet() == last) && (rbs.Count() == count))
+		return true;
+	fprintf(stderr, FMT_ERR("%s: '%s' [%d, %d] count=%d, expected '%s' "
+		"[%d, %d] count=%d\n"), what, rbs.ToStringCG().c_str(),
+		rbs.FirstSet(), rbs.LastSet(), rbs.Count(),
+		cg_str.c_str(), first, last, count);
+	return false;
+}
+
+TestResult_t test_bitset(int, char *[]) {
+	// The highest ID, and its string
+	BBQUE_RID_TYPE const top = BBQUE_MAX_R_ID_NUM;
+	std::string const top_str(std::to_string(top));
+
+	fprintf(stderr, FMT_INF("Here is the resource bitset test\n"));
+
+	// CG string: ascending order, and IDs of any number of digits
+	ResourceBitset a(Make({ top, 3, 12, 7 }));
+	if (!Check("Set", a, "3,7,12," + top_str, 3, top, 4))
+		return TEST_FAILED;
+
+	// Intersection, not a replacement
+	ResourceBitset b(Make({ 7, 8, top }));
+	ResourceBitset c(a);
+	c &= b;
+	if (!Check("&=", c, "7," + top_str, 7, top, 2))
+		return TEST_FAILED;
+	if (!Check("&", a & b, "7," + top_str, 7, top, 2) ||
+			!Check("|", a | b, "3,7,8,12," + top_str, 3, top, 5))
+		return TEST_FAILED;
+	c = a;
+	c &= Make({ 1, 2 });
+	if (!Check("&= (disjoint)", c, "", R_ID_NONE, R_ID_NONE, 0))
+		return TEST_FAILED;
+	c = a;
+	c -= b;
+	if (!Check("-=", c, "3,12", 3, 12, 2))
+		return TEST_FAILED;
+
+	// Single bit reset, boundaries included
+	c = a;
+	c.Reset(12);
+	if (!Check("Reset(12)", c, "3,7," + top_str, 3, top, 3))
+		return TEST_FAILED;
+	c.Reset(3);
+	c.Reset(top);
+	if (!Check("Reset(3,top)", c, "7", 7, 7, 1))
+		return TEST_FAILED;
+	c.Reset(5);
+	c.Reset(7);
+	if (!Check("Reset(7)", c, "", R_ID_NONE, R_ID_NONE, 0))
+		return TEST_FAILED;
+	c.Set(9);
+	if (!Check("Set after Reset", c, "9", 9, 9, 1))
+		return TEST_FAILED;
+	if (c.Reset(BBQUE_MAX_R_ID_NUM + 1) != ResourceBitset::OUT_OF_RANGE)
+		return TEST_FAILED;
+
+	// Full reset
+	c = a;
+	c.Reset();
+	c.Set(2);
+	if (!Check("Reset", c, "2", 2, 2, 1))
+		return TEST_FAILED;
+
+	// Scanning
+	if ((a.NextSet(R_ID_NONE) != 3) || (a.NextSet(7) != 12) ||
+			(a.NextSet(top) != R_ID_NONE)) {
+		fprintf(stderr, FMT_ERR("Wrong NextSet() results\n"));
+		return TEST_FAILED;
+	}
+	if (!Check("FirstN(2)", a.FirstN(2), "3,7", 3, 7, 2) ||
+			!Check("FirstN(10)", a.FirstN(10), "3,7,12," + top_str, 3, top, 4))
+		return TEST_FAILED;
+
+	return TEST_PASSED;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bbque/utils/cgroups.h"
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "CGROUPS    [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "CGROUPS    [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "CGROUPS    [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "CGROUPS    [ERR]", fmt)
+
+// Number of reconfigurations to measure
+#define CGROUPS_TEST_UPDATES 1000
+
+using bbque::utils::CGroups;
+
+// The fake cgroup filesystem
+static std::string cgfs_root;
+
+static const char * cgfs_attributes[] = {
+	"cpuset/bbque/test/cpuset.cpus",
+	"cpuset/bbque/test/cpuset.mems",
+	"cpuset/bbque/test/cgroup.procs",
+	"cpu/bbque/test/cpu.cfs_period_us",
+	"cpu/bbque/test/cpu.cfs_quota_us",
+	"cpu/bbque/test/cgroup.procs",
+	"memory/bbque/test/memory.limit_in_bytes",
+	"memory/bbque/test/cgroup.procs",
+};
+
+static bool SetupFakeCgroupFs() {
+	char root_tmpl[] = "/tmp/bbque_cgfs_XXXXXX";
+	if (!::mkdtemp(root_tmpl))
+		return false;
+	cgfs_root = root_tmpl;
+
+	for (auto controller: {"cpuset", "cpu", "memory"}) {
+		std::string dir(cgfs_root + "/" + controller);
+		::mkdir(dir.c_str(), 0755);
+		::mkdir((dir + "/bbque").c_str(), 0755);
+		::mkdir((dir + "/bbque/test").c_str(), 0755);
+	}
+	for (auto attribute: cgfs_attributes)
+		std::ofstream(cgfs_root + "/" + attribute);
+
+	CGroups::SetMountPoint(CGroups::CGC::CPUSET, (cgfs_root + "/cpuset").c_str());
+	CGroups::SetMountPoint(CGroups::CGC::CPU, (cgfs_root + "/cpu").c_str());
+	// Co-mounted, as in the "cpu,cpuacct" hierarchy
+	CGroups::SetMountPoint(CGroups::CGC::CPUACCT, (cgfs_root + "/cpu").c_str());
+	CGroups::SetMountPoint(CGroups::CGC::MEMORY, (cgfs_root + "/memory").c_str());
+	return true;
+}
+
+static void CleanupFakeCgroupFs() {
+	for (auto attribute: cgfs_attributes)
+		::unlink((cgfs_root + "/" + attribute).c_str());
+	for (auto controller: {"cpuset", "cpu", "memory"}) {
+		std::string dir(cgfs_root + "/" + controller);
+		::rmdir((dir + "/bbque/test").c_str());
+		::rmdir((dir + "/bbque").c_str());
+		::rmdir(dir.c_str());
+	}
+	::rmdir(cgfs_root.c_str());
+}
+
+static std::string ReadAttribute(const char * attribute) {
+	std::string value;
+	std::ifstream(cgfs_root + "/" + attribute) >> value;
+	return value;
+}
+
+TestResult_t test_cgroups(int, char *[]) {
+	CGroups::CGSetup cgsetup;
+	CGroups::CGSetup cgcache;
+	bbque::utils::Timer tmr;
+	uint8_t nr_writes;
+
+	fprintf(stderr, FMT_INF("Here is the CGroups actuation test\n"));
+
+	// The logger only: the controllers are mounted on the fake filesystem
+	CGroups::Init("bq.cgroups.test");
+	if (!SetupFakeCgroupFs()) {
+		fprintf(stderr, FMT_ERR("Fake cgroup filesystem setup FAILED\n"));
+		return TEST_FAILED;
+	}
+
+	// First commit: all the attributes written
+	cgsetup.cpuset.cpus = "0-3";
+	cgsetup.cpuset.mems = "0";
+	cgsetup.cpu.cfs_period_us = "100000";
+	cgsetup.cpu.cfs_quota_us  = "200000";
+	cgsetup.memory.limit_in_bytes = "1073741824";
+	if ((CGroups::WriteCgroupDiff("/bbque/test", cgsetup, cgcache, &nr_writes)
+			!= CGroups::CGResult::OK) || (nr_writes != 5)) {
+		fprintf(stderr, FMT_ERR("First commit FAILED\n"));
+		CleanupFakeCgroupFs();
+		return TEST_FAILED;
+	}
+	if (CGroups::AttachTask("/bbque/test", ::getpid()) != CGroups::CGResult::OK) {
+		fprintf(stderr, FMT_ERR("Task attach FAILED\n"));
+		CleanupFakeCgroupFs();
+		return TEST_FAILED;
+	}
+
+	// Unchanged commit: nothing written
+	CGroups::WriteCgroupDiff("/bbque/test", cgsetup, cgcache, &nr_writes);
+	if (nr_writes != 0) {
+		fprintf(stderr, FMT_ERR("Unchanged commit: %d attributes written\n"),
+			nr_writes);
+		CleanupFakeCgroupFs();
+		return TEST_FAILED;
+	}
+
+	// Budget-only reconfigurations: the quota only
+	tmr.start();
+	for (int i = 0; i < CGROUPS_TEST_UPDATES; ++i) {
+		cgsetup.cpu.cfs_quota_us = std::to_string(100000 + (i % 2) * 50000);
+		CGroups::WriteCgroupDiff("/bbque/test", cgsetup, cgcache, &nr_writes);
+		if (nr_writes != 1) {
+			fprintf(stderr, FMT_ERR("Quota update: %d attributes written\n"),
+				nr_writes);
+			CleanupFakeCgroupFs();
+			return TEST_FAILED;
+		}
+	}
+	double diff_us = tmr.getElapsedTimeUs() / CGROUPS_TEST_UPDATES;
+
+	// Full rewrites, for comparison
+	tmr.start();
+	for (int i = 0; i < CGROUPS_TEST_UPDATES; ++i) {
+		CGroups::CGSetup nocache;
+		cgsetup.cpu.cfs_quota_us = std::to_string(100000 + (i % 2) * 50000);
+		CGroups::WriteCgroupDiff("/bbque/test", cgsetup, nocache);
+	}
+	double full_us = tmr.getElapsedTimeUs() / CGROUPS_TEST_UPDATES;
+
+	fprintf(stderr, FMT_INF("Reconfiguration latency: differential %.1f us, "
+		"full %.1f us\n"), diff_us, full_us);
+
+	bool values_ok =
+		(ReadAttribute("cpuset/bbque/test/cpuset.cpus") == "0-3") &&
+		(ReadAttribute("cpu/bbque/test/cpu.cfs_quota_us") ==
+			cgsetup.cpu.cfs_quota_us) &&
+		(ReadAttribute("cpu/bbque/test/cgroup.procs") ==
+			std::to_string(::getpid()));
+	CleanupFakeCgroupFs();
+
+	if (!values_ok) {
+		fprintf(stderr, FMT_ERR("Unexpected attribute values\n"));
+		return TEST_FAILED;
+	}
+
+	return TEST_PASSED;
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "mmkp_solver.h"
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "MMKP       [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "MMKP       [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "MMKP       [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "MMKP       [ERR]", fmt)
+
+// Random instances solved by brute force
+#define MMKP_TEST_INSTANCES   50
+#define MMKP_TEST_CLASSES      6
+#define MMKP_TEST_ITEMS        4
+#define MMKP_TEST_DIMENSIONS   3
+// Large instances, to check the time limits (the second one with a search
+// space small enough for the exact solving)
+#define MMKP_TEST_LARGE_CLASSES 200
+#define MMKP_TEST_EXACT_CLASSES  27
+#define MMKP_TEST_BUDGET_US    2000.0
+#define MMKP_TEST_EXACT_BUDGET_US 50.0
+
+#define MMKP_TEST_EPSILON      1e-6
+
+using bbque::plugins::MMKPSolver;
+
+struct Item {
+	double value;
+	MMKPSolver::Weights_t weights;
+};
+
+typedef std::vector<std::vector<Item>> Instance_t;
+
+// Strongly correlated values and weights make the hardest instances
+static Instance_t RandomInstance(std::mt19937 & rng,
+		uint32_t nr_classes, std::vector<uint64_t> const & capacities,
+		bool correlated = false) {
+	std::uniform_int_distribution<uint64_t> weight(0, 60);
+	std::uniform_real_distribution<double> noise(0.5, 1.5);
+	Instance_t instance(nr_classes);
+	for (auto & cl: instance) {
+		for (uint32_t i = 0; i < MMKP_TEST_ITEMS; ++i) {
+			Item item;
+			double total = 0;
+			for (uint32_t d = 0; d < capacities.size(); ++d) {
+				uint64_t w = weight(rng);
+				item.weights.emplace_back(d, w);
+				total += w;
+			}
+			// Bigger items are worth more, with some noise
+			if (correlated)
+				item.value = total + 10;
+			else
+				item.value = total * noise(rng);
+			cl.push_back(item);
+		}
+	}
+	return instance;
+}
+
+static void Load(MMKPSolver & solver, Instance_t const & instance) {
+	for (auto const & cl: instance) {
+		uint32_t class_id = solver.AddClass();
+		for (uint32_t i = 0; i < cl.size(); ++i)
+			solver.AddItem(class_id, i, cl[i].value, cl[i].weights);
+	}
+}
+
+// Value of the selection, or -1 if it exceeds some capacity
+static double Evaluate(Instance_t const & instance,
+		std::vector<uint64_t> const & capacities,
+		std::vector<int32_t> const & selected) {
+	std::vector<uint64_t> used(capacities.size(), 0);
+	double value = 0;
+	for (uint32_t c = 0; c < instance.size(); ++c) {
+		if (selected[c] < 0)
+			continue;
+		auto const & item(instance[c][selected[c]]);
+		value += item.value;
+		for (auto const & w: item.weights)
+			used[w.first] += w.second;
+	}
+	for (uint32_t d = 0; d < capacities.size(); ++d) {
+		if (used[d] > capacities[d])
+			return -1;
+	}
+	return value;
+}
+
+static double BruteForce(Instance_t const & instance,
+		std::vector<uint64_t> const & capacities) {
+	std::vector<int32_t> selected(instance.size(), -1);
+	double best = 0;
+	while (true) {
+		best = std::max(best, Evaluate(instance, capacities, selected));
+		// Next combination ("no item" included)
+		uint32_t c = 0;
+		for (; c < instance.size(); ++c) {
+			if (++selected[c] < (int32_t) instance[c].size())
+				break;
+			selected[c] = -1;
+		}
+		if (c == instance.size())
+			return best;
+	}
+}
+
+static std::vector<int32_t> Selection(MMKPSolver const & solver,
+		uint32_t nr_classes) {
+	std::vector<int32_t> selected;
+	for (uint32_t c = 0; c < nr_classes; ++c)
+		selected.push_back(solver.Selected(c));
+	return selected;
+}
+
+TestResult_t test_mmkp(int, char *[]) {
+	std::mt19937 rng(2019);
+	std::vector<uint64_t> capacities(MMKP_TEST_DIMENSIONS, 100);
+
+	fprintf(stderr, FMT_INF("Here is the MMKP solver test\n"));
+
+	double greedy_gap = 0;
+	for (int k = 0; k < MMKP_TEST_INSTANCES; ++k) {
+		auto instance(RandomInstance(rng, MMKP_TEST_CLASSES, capacities));
+		double optimum = BruteForce(instance, capacities);
+
+		// Greedy only: feasible, and not better than the optimum
+		MMKPSolver greedy(capacities);
+		Load(greedy, instance);
+		greedy.Solve(0, 0);
+		double greedy_value = Evaluate(instance, capacities,
+			Selection(greedy, MMKP_TEST_CLASSES));
+		if ((greedy_value < 0) ||
+				(greedy.GreedyValue() > optimum + MMKP_TEST_EPSILON) ||
+				(greedy.Value() < greedy.GreedyValue() - MMKP_TEST_EPSILON)) {
+			fprintf(stderr, FMT_ERR("[%d] Greedy solution not valid\n"), k);
+			return TEST_FAILED;
+		}
+		// The bound holds even without the search
+		if (greedy.UpperBound() < optimum - MMKP_TEST_EPSILON) {
+			fprintf(stderr, FMT_ERR("[%d] Upper bound %.2f below the optimum "
+				"%.2f\n"), k, greedy.UpperBound(), optimum);
+			return TEST_FAILED;
+		}
+		greedy_gap += (optimum - greedy.GreedyValue()) / optimum;
+
+		// Exact solving: the optimum
+		MMKPSolver exact(capacities);
+		Load(exact, instance);
+		auto result = exact.Solve(MMKP_TEST_BUDGET_US, 1000000);
+		double value = Evaluate(instance, capacities,
+			Selection(exact, MMKP_TEST_CLASSES));
+		if ((result != MMKPSolver::MMKP_OPTIMAL) ||
+				(std::abs(value - optimum) > MMKP_TEST_EPSILON) ||
+				(std::abs(exact.Value() - optimum) > MMKP_TEST_EPSILON)) {
+			fprintf(stderr, FMT_ERR("[%d] Optimum not found: %.2f vs %.2f "
+				"[result=%d]\n"), k, value, optimum, result);
+			return TEST_FAILED;
+		}
+	}
+	fprintf(stderr, FMT_INF("%d instances: greedy gap %.2f%% (mean)\n"),
+		MMKP_TEST_INSTANCES, 100 * greedy_gap / MMKP_TEST_INSTANCES);
+
+	// Large instances: the time limits hold, in both modes
+	struct {
+		uint32_t nr_classes;
+		uint64_t exact_max_space;
+		double budget_us;
+		double limit_us;
+	} large_cases[] = {
+		{ MMKP_TEST_LARGE_CLASSES, 0, MMKP_TEST_BUDGET_US,
+			MMKP_TEST_BUDGET_US },
+		{ MMKP_TEST_EXACT_CLASSES, ~0ULL, MMKP_TEST_EXACT_BUDGET_US,
+			MMKP_TEST_EXACT_BUDGET_US * MMKP_EXACT_TIME_FACTOR }
+	};
+	for (auto const & lc: large_cases) {
+		auto large(RandomInstance(rng, lc.nr_classes, capacities, true));
+		MMKPSolver solver(capacities);
+		Load(solver, large);
+		bbque::utils::Timer tmr;
+		tmr.start();
+		auto result = solver.Solve(lc.budget_us, lc.exact_max_space);
+		double elapsed_us = tmr.getElapsedTimeUs();
+		fprintf(stderr, FMT_INF("%d classes: %.0f us [limit %.0f us], "
+			"gap %.2f%%, %lu nodes [result=%d]\n"),
+			lc.nr_classes, elapsed_us, lc.limit_us, 100 * solver.Gap(),
+			solver.NodesCount(), result);
+		// Some slack for the last deadline check
+		if (elapsed_us > 2 * lc.limit_us) {
+			fprintf(stderr, FMT_ERR("Time limit not respected\n"));
+			return TEST_FAILED;
+		}
+		if (Evaluate(large, capacities,
+				Selection(solver, lc.nr_classes)) < 0) {
+			fprintf(stderr, FMT_ERR("Solution not feasible\n"));
+			return TEST_FAILED;
+		}
+	}
+
+	return TEST_PASSED;
+}
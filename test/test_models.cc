@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bbque/pm/model_manager.h"
+#include "bbque/pm/models/model_online.h"
+#include "bbque/res/resource_path.h"
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "MODELS     [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "MODELS     [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "MODELS     [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "MODELS     [ERR]", fmt)
+
+// Samples of the training and of the evaluation traces
+#define MODELS_TEST_TRAINING   2000
+#define MODELS_TEST_EVALUATION 500
+// Number of queries to measure
+#define MODELS_TEST_QUERIES    100000
+
+// Maximum errors accepted
+#define MODELS_TEST_MAX_POWER_ERROR  0.05
+#define MODELS_TEST_MAX_TEMP_ERROR   2.5
+#define MODELS_TEST_MAX_LOAD_ERROR   0.05
+// Processing elements of the binding domain budgeted
+#define MODELS_TEST_DOMAIN_PES  4
+// Expected query cost: the timing depends on the host, thus only reported
+#define MODELS_TEST_EXPECTED_QUERY_US  10.0
+
+using bbque::pm::ModelManager;
+using bbque::pm::ModelPtr_t;
+using bbque::pm::OnlineModel;
+
+/*
+ * A synthetic CPU: power (W) from load and frequency (GHz), and a first-order
+ * thermal response to the power, converging to t_amb + r_th * P (Celsius)
+ */
+struct SyntheticCPU {
+	double t_amb = 35.0;
+	double r_th  = 6.0;
+	double temp  = 35.0;
+	double load  = 0.5;
+	double freq  = 1.2;
+
+	static double Power(double load, double freq) {
+		return 0.8 + 0.5 * freq + 1.2 * load * freq
+			+ 0.35 * load * freq * freq * freq;
+	}
+
+	double SteadyTemperature(double power) const {
+		return t_amb + r_th * power;
+	}
+
+	// Random walk of the load, frequency changes every 20 samples, 2% noise
+	// on the power and 0.25 degrees on the temperature
+	OnlineModel::Sample Next(std::mt19937 & rng, int k) {
+		static const double freqs[] = { 1.2, 1.6, 2.0, 2.4, 2.8 };
+		std::normal_distribution<double> step(0, 0.1);
+		std::normal_distribution<double> noise(0, 1);
+		load = std::min(std::max(load + step(rng), 0.0), 1.0);
+		if (k % 20 == 0)
+			freq = freqs[rng() % 5];
+		double power = Power(load, freq);
+		temp += 0.1 * (SteadyTemperature(power) - temp);
+		return {
+			static_cast<uint32_t>(load * 100),
+			static_cast<uint32_t>(freq * 1e6),
+			static_cast<uint32_t>(power * (1 + 0.02 * noise(rng)) * 1e3),
+			static_cast<uint32_t>((temp + 0.25 * noise(rng)) * 1e3)
+		};
+	}
+};
+
+// Mean relative error of the power estimation, on an evaluation trace
+static double PowerError(OnlineModel & model, std::mt19937 & rng) {
+	SyntheticCPU cpu;
+	double error = 0;
+	for (int k = 0; k < MODELS_TEST_EVALUATION; ++k) {
+		OnlineModel::Sample s(cpu.Next(rng, k));
+		double power = SyntheticCPU::Power(s.load / 100.0, s.freq_khz / 1e6);
+		error += std::fabs(model.GetPowerFromLoad(s.load, s.freq_khz) / 1e3
+			- power) / power;
+	}
+	return error / MODELS_TEST_EVALUATION;
+}
+
+// Maximum error of the steady state temperature, over the power range
+static double TemperatureError(OnlineModel & model, SyntheticCPU const & cpu) {
+	double error = 0;
+	for (double power = 1.5; power <= 12.0; power += 0.5) {
+		double temp = model.GetTemperatureFromPower(power * 1e3) / 1e3;
+		error = std::max(error,
+			std::fabs(temp - cpu.SteadyTemperature(power)));
+	}
+	return error;
+}
+
+/*
+ * The budget of a binding domain, on the path built as the Tempura policy
+ * does ("sys0.cpu0.pe"), while the samples of each processing element are
+ * sent to the model manager as the power monitor does
+ */
+static TestResult_t TestDomainModel(std::mt19937 & rng) {
+	ModelManager & mm(ModelManager::GetInstance());
+	ModelPtr_t default_model(mm.GetModel("generic"));
+	bbque::res::ResourcePath r_path("sys0.cpu0");
+	r_path.AppendString("pe");
+
+	std::vector<std::string> pe_paths;
+	std::vector<SyntheticCPU> cpus(MODELS_TEST_DOMAIN_PES);
+	for (int i = 0; i < MODELS_TEST_DOMAIN_PES; ++i)
+		pe_paths.push_back("sys0.cpu0.pe" + std::to_string(i));
+
+	// Not all the processing elements trained: the static model answers
+	for (int k = 0; k < MODELS_TEST_TRAINING; ++k)
+		for (int i = 0; i < MODELS_TEST_DOMAIN_PES - 1; ++i)
+			mm.Update(pe_paths[i], cpus[i].Next(rng, k));
+	ModelPtr_t pmodel(mm.GetResourceModel(
+		r_path.ToString(), pe_paths, "generic"));
+	if (pmodel != default_model) {
+		fprintf(stderr, FMT_ERR("Model of <%s> from untrained resources\n"),
+			r_path.ToString().c_str());
+		return TEST_FAILED;
+	}
+
+	// All trained: the domain model, from the ones of the resources
+	int const last = MODELS_TEST_DOMAIN_PES - 1;
+	for (int k = 0; k < MODELS_TEST_TRAINING; ++k)
+		mm.Update(pe_paths[last], cpus[last].Next(rng, k));
+	pmodel = mm.GetResourceModel(r_path.ToString(), pe_paths, "generic");
+	fprintf(stderr, FMT_INF("Model of <%s>: '%s'\n"),
+		r_path.ToString().c_str(), pmodel->GetID().c_str());
+	if ((pmodel == default_model) || (pmodel->GetID() != r_path.ToString())) {
+		fprintf(stderr, FMT_ERR("No trained model of <%s>\n"),
+			r_path.ToString().c_str());
+		return TEST_FAILED;
+	}
+
+	// The power of the domain is the one of its resources, and an even
+	// share of it gives each resource half of its amount at half load, all
+	// of them at the same frequency
+	uint32_t power_crit = 0;
+	double power_half = 0;
+	for (int i = 0; i < MODELS_TEST_DOMAIN_PES; ++i) {
+		cpus[i].freq = 2.0;
+		mm.Update(pe_paths[i], cpus[i].Next(rng, 1));
+		power_crit += mm.GetResourceModel(pe_paths[i], "generic")
+			->GetPowerFromTemperature(80000);
+		power_half += SyntheticCPU::Power(0.5, cpus[i].freq);
+	}
+	uint32_t total = 100 * MODELS_TEST_DOMAIN_PES;
+	double load_err = std::fabs(
+		pmodel->GetResourceFromPower(power_half * 1e3, total) /
+			double(total) - 0.5);
+	fprintf(stderr, FMT_INF("Domain power from temperature: %u mW, resource "
+		"from power error: %.3f\n"),
+		pmodel->GetPowerFromTemperature(80000), load_err);
+	if ((pmodel->GetPowerFromTemperature(80000) != power_crit) ||
+			(load_err > MODELS_TEST_MAX_LOAD_ERROR)) {
+		fprintf(stderr, FMT_ERR("Domain model not matching the resources\n"));
+		return TEST_FAILED;
+	}
+
+	return TEST_PASSED;
+}
+
+TestResult_t test_models(int, char *[]) {
+	std::mt19937 rng(2019);
+	SyntheticCPU cpu;
+	OnlineModel model("sys0.cpu0.pe0", 7200);
+	bbque::utils::Timer tmr;
+
+	fprintf(stderr, FMT_INF("Here is the online power-thermal models test\n"));
+
+	// Not trained: the default model answers
+	if ((model.GetPowerFromTemperature(80000) != 7200) ||
+			(model.GetResourceFromPower(1000, 400) != 400)) {
+		fprintf(stderr, FMT_ERR("Untrained model not answering as the default\n"));
+		return TEST_FAILED;
+	}
+
+	// Training
+	tmr.start();
+	for (int k = 0; k < MODELS_TEST_TRAINING; ++k)
+		model.Update(cpu.Next(rng, k));
+	double update_us = tmr.getElapsedTimeUs() / MODELS_TEST_TRAINING;
+
+	double power_err = PowerError(model, rng);
+	double temp_err  = TemperatureError(model, cpu);
+	fprintf(stderr, FMT_INF("Power error: %.2f%%, steady temperature error: "
+		"%.2f C\n"), power_err * 100, temp_err);
+	if ((power_err > MODELS_TEST_MAX_POWER_ERROR) ||
+			(temp_err > MODELS_TEST_MAX_TEMP_ERROR)) {
+		fprintf(stderr, FMT_ERR("Prediction error too high\n"));
+		return TEST_FAILED;
+	}
+
+	// Budget queries, at the last sampled frequency
+	double power_half = SyntheticCPU::Power(0.5, cpu.freq);
+	double load_err = std::fabs(
+		model.GetResourceFromPower(power_half * 1e3, 400) / 400.0 - 0.5);
+	double power_crit = (80.0 - cpu.t_amb) / cpu.r_th;
+	double power_crit_err = std::fabs(
+		model.GetPowerFromTemperature(80000) / 1e3 - power_crit) / power_crit;
+	fprintf(stderr, FMT_INF("Resource from power error: %.3f, power from "
+		"temperature error: %.2f%%\n"), load_err, power_crit_err * 100);
+	if ((load_err > MODELS_TEST_MAX_LOAD_ERROR) ||
+			(power_crit_err > MODELS_TEST_MAX_POWER_ERROR)) {
+		fprintf(stderr, FMT_ERR("Budget query error too high\n"));
+		return TEST_FAILED;
+	}
+
+	// Query cost
+	uint32_t budget = 0;
+	tmr.start();
+	for (int q = 0; q < MODELS_TEST_QUERIES; ++q) {
+		budget += model.GetResourceFromPower(1000 + q % 8000, 400);
+		budget += model.GetPowerFromTemperature(60000 + q % 30000);
+	}
+	double query_us = tmr.getElapsedTimeUs() / (2 * MODELS_TEST_QUERIES);
+	fprintf(stderr, FMT_INF("Update: %.3f us, query: %.3f us [%u]%s\n"),
+		update_us, query_us, budget % 10,
+		(query_us > MODELS_TEST_EXPECTED_QUERY_US) ?
+			" (slower than expected)" : "");
+
+	// Restart: the saved state gives the same answers
+	std::stringstream state;
+	model.Save(state);
+	OnlineModel restored("sys0.cpu0.pe0", 7200);
+	if (!restored.Load(state) ||
+			(restored.Samples() != model.Samples()) ||
+			(restored.GetPowerFromTemperature(80000) !=
+				model.GetPowerFromTemperature(80000)) ||
+			(restored.GetResourceFromPower(3000, 400) !=
+				model.GetResourceFromPower(3000, 400))) {
+		fprintf(stderr, FMT_ERR("Restored model not matching\n"));
+		return TEST_FAILED;
+	}
+	std::stringstream garbage("1 100 nan");
+	if (restored.Load(garbage)) {
+		fprintf(stderr, FMT_ERR("Invalid state loaded\n"));
+		return TEST_FAILED;
+	}
+
+	// Idle resource: the samples do not excite the model, which must not
+	// drift away
+	for (int k = 0; k < MODELS_TEST_TRAINING; ++k) {
+		OnlineModel::Sample s(cpu.Next(rng, 1));
+		cpu.load = 0.05;
+		model.Update(s);
+	}
+	temp_err = TemperatureError(model, cpu);
+	fprintf(stderr, FMT_INF("Steady temperature error after idle: %.2f C\n"),
+		temp_err);
+	if (temp_err > MODELS_TEST_MAX_TEMP_ERROR) {
+		fprintf(stderr, FMT_ERR("Thermal model drifted\n"));
+		return TEST_FAILED;
+	}
+
+	// Change of the cooling conditions: the model follows
+	cpu.r_th = 8.0;
+	for (int k = 0; k < MODELS_TEST_TRAINING; ++k)
+		model.Update(cpu.Next(rng, k));
+	temp_err = TemperatureError(model, cpu);
+	fprintf(stderr, FMT_INF("Steady temperature error after the change: "
+		"%.2f C\n"), temp_err);
+	if (temp_err > MODELS_TEST_MAX_TEMP_ERROR) {
+		fprintf(stderr, FMT_ERR("Thermal model not adapted\n"));
+		return TEST_FAILED;
+	}
+
+	return TestDomainModel(rng);
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <thread>
+#include <vector>
+
+#include <CL/cl.h>
+
+#include "bbque/rtlib.h"
+#include "bbque/rtlib/bbque_ocl.h"
+#include "bbque/rtlib/bbque_ocl_stats.h"
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "OCL_PROF   [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "OCL_PROF   [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "OCL_PROF   [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "OCL_PROF   [ERR]", fmt)
+
+// Application threads enqueueing on the same command queue
+#define OCL_PROF_THREADS 4
+// Enqueue rounds, each one filling up half of the profiling records
+#define OCL_PROF_ROUNDS  8
+#define OCL_PROF_AWM     0
+
+// Set by RTLIB_Init(), used by the profiling dump
+extern RTLIB_Services_t rtlib_services;
+
+static const char * kernel_src =
+	"__kernel void inc(__global int * data) {\n"
+	"	data[get_global_id(0)] += 1;\n"
+	"}\n";
+
+static const char * GetUniqueID() {
+	return "0:test_ocl_prof:00";
+}
+
+/** A CPU device, if any, as PoCL provides, or the first one */
+static cl_device_id GetDevice() {
+	cl_uint nr_platforms = 0;
+	if ((clGetPlatformIDs(0, NULL, &nr_platforms) != CL_SUCCESS) ||
+			(nr_platforms == 0))
+		return NULL;
+	std::vector<cl_platform_id> platforms(nr_platforms);
+	clGetPlatformIDs(nr_platforms, platforms.data(), NULL);
+
+	cl_device_id device = NULL;
+	cl_device_type const types[] = { CL_DEVICE_TYPE_CPU, CL_DEVICE_TYPE_ALL };
+	for (auto type: types) {
+		for (auto platform: platforms) {
+			if (clGetDeviceIDs(platform, type, 1, &device, NULL) == CL_SUCCESS)
+				return device;
+		}
+	}
+	return NULL;
+}
+
+TestResult_t test_ocl_prof(int, char *[]) {
+	cl_int status;
+
+	fprintf(stderr, FMT_INF("Here is the OpenCL profiling test\n"));
+
+	rtlib_services.Utils.GetUniqueID_String = GetUniqueID;
+	rtlib_ocl_init();
+
+	cl_device_id device = GetDevice();
+	if (device == NULL) {
+		fprintf(stderr, FMT_ERR("No OpenCL device available\n"));
+		return TEST_FAILED;
+	}
+	cl_context context = clCreateContext(NULL, 1, &device, NULL, NULL, &status);
+	cl_command_queue queue = clCreateCommandQueue(context, device,
+		CL_QUEUE_PROFILING_ENABLE, &status);
+	cl_program program = clCreateProgramWithSource(context, 1, &kernel_src,
+		NULL, &status);
+	if ((status != CL_SUCCESS) ||
+			(clBuildProgram(program, 1, &device, NULL, NULL, NULL) != CL_SUCCESS)) {
+		fprintf(stderr, FMT_ERR("Kernel not built [%d]\n"), status);
+		return TEST_FAILED;
+	}
+	cl_kernel kernel = clCreateKernel(program, "inc", &status);
+	size_t const work_size = 64;
+	cl_mem data = clCreateBuffer(context, CL_MEM_READ_WRITE,
+		work_size * sizeof (cl_int), NULL, &status);
+	clSetKernelArg(kernel, 0, sizeof (cl_mem), &data);
+
+	// Every command profiled. In each round, the threads enqueue half of
+	// the records, half of the commands with an event requested, and then
+	// the round is folded: no command is left out for lack of records.
+	rtlib_ocl_prof_enable(0, 1);
+	rtlib_ocl_prof_clean(OCL_PROF_AWM);
+	uint32_t const per_thread = BBQUE_OCL_PROF_RECORDS / (2 * OCL_PROF_THREADS);
+	for (int round = 0; round < OCL_PROF_ROUNDS; ++round) {
+		std::vector<std::thread> threads;
+		for (int t = 0; t < OCL_PROF_THREADS; ++t) {
+			threads.emplace_back([&]() {
+				for (uint32_t i = 0; i < per_thread; ++i) {
+					cl_event event;
+					bool with_event = (i % 2);
+					clEnqueueNDRangeKernel(queue, kernel, 1, NULL, &work_size,
+						NULL, 0, NULL, with_event ? &event : NULL);
+					if (with_event)
+						clReleaseEvent(event);
+				}
+			});
+		}
+		for (auto & thr: threads)
+			thr.join();
+		clFinish(queue);
+		rtlib_ocl_flush_events();
+	}
+
+	OclEventsStatsMap_t ocl_stats;
+	rtlib_ocl_prof_get(OCL_PROF_AWM, ocl_stats);
+
+	uint32_t const expected = OCL_PROF_ROUNDS * OCL_PROF_THREADS * per_thread;
+	size_t profiled = 0;
+	auto queue_it = ocl_stats.find(queue);
+	if (queue_it != ocl_stats.end()) {
+		auto & cmd_prof(queue_it->second->cmd_prof);
+		auto cmd_it = cmd_prof.find(CL_COMMAND_NDRANGE_KERNEL);
+		if (cmd_it != cmd_prof.end())
+			profiled = boost::accumulators::count(
+				cmd_it->second[CL_CMD_EXEC_TIME]);
+	}
+	fprintf(stderr, FMT_INF("Commands profiled: %zu of %u\n"),
+		profiled, expected);
+
+	clReleaseMemObject(data);
+	clReleaseKernel(kernel);
+	clReleaseProgram(program);
+	clReleaseCommandQueue(queue);
+	clReleaseContext(context);
+
+	if (profiled != expected) {
+		fprintf(stderr, FMT_ERR("Profiling records lost or double "
+			"reserved\n"));
+		return TEST_FAILED;
+	}
+	return TEST_PASSED;
+}
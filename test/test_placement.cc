@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+
+#include "bbque/placement_policy.h"
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "PLACEMENT  [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "PLACEMENT  [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "PLACEMENT  [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "PLACEMENT  [ERR]", fmt)
+
+// Number of placement stages to simulate
+#define PLACEMENT_TEST_ROUNDS 20
+
+using bbque::PlacementPolicy;
+
+/*
+ * A local node with a given free capacity and a queue of READY EXCs, and
+ * two remote nodes. Each round is a placement stage, as run by the
+ * PlacementManager: the offloaded EXCs are no more READY locally.
+ */
+struct Cluster {
+	float free = 0.55;
+	uint32_t ready = 10;
+	uint32_t hosted = 0;
+	std::map<int, float> remote = { {1, 0.9}, {2, 0.6} };
+	std::map<int, uint32_t> offloaded;
+
+	uint32_t Round(PlacementPolicy const & policy) {
+		uint32_t moved = 0;
+		float local = policy.LocalHeadroom(free, ready, hosted);
+		while (ready > 0 && policy.MustOffload(local)) {
+			int system_id = policy.SelectTarget(local, remote);
+			if (system_id < 0)
+				break;
+			++offloaded[system_id];
+			--ready;
+			++moved;
+		}
+		return moved;
+	}
+};
+
+TestResult_t test_placement(int, char *[]) {
+	PlacementPolicy policy(0.2, 0.1, 0.1);
+
+	fprintf(stderr, FMT_INF("Here is the cross-node placement test\n"));
+
+	// Offloading converges: what is moved in the first round is not moved
+	// again, and the projected headroom is back over the threshold
+	Cluster cluster;
+	uint32_t first = cluster.Round(policy);
+	uint32_t total = first;
+	for (int r = 1; r < PLACEMENT_TEST_ROUNDS; ++r)
+		total += cluster.Round(policy);
+	float local = policy.LocalHeadroom(
+		cluster.free, cluster.ready, cluster.hosted);
+	fprintf(stderr, FMT_INF("Offloaded: %u in the first round, %u in total, "
+		"local headroom %.2f\n"), first, total, local);
+	if ((first == 0) || (total != first) || policy.MustOffload(local)) {
+		fprintf(stderr, FMT_ERR("Offloading not converging\n"));
+		return TEST_FAILED;
+	}
+
+	// Each remote node keeps its headroom over the threshold, plus the
+	// hysteresis band
+	for (auto const & node: cluster.remote) {
+		fprintf(stderr, FMT_INF("sys%d: %u EXCs, headroom %.2f\n"),
+			node.first, cluster.offloaded[node.first], node.second);
+		if (node.second < (0.2 + 0.1 - 1e-3)) {
+			fprintf(stderr, FMT_ERR("Remote node overloaded\n"));
+			return TEST_FAILED;
+		}
+	}
+
+	// Right after offloading, no recall: the hysteresis band
+	if (policy.MustRecall(local, cluster.remote[1])) {
+		fprintf(stderr, FMT_ERR("EXC recalled right after offloading\n"));
+		return TEST_FAILED;
+	}
+	// ...but the EXCs come back when the local node has room again
+	if (!policy.MustRecall(local + 0.3, cluster.remote[1])) {
+		fprintf(stderr, FMT_ERR("EXC not recalled\n"));
+		return TEST_FAILED;
+	}
+
+	// Remote nodes full: nothing to offload, and the local one does not
+	// accept other EXCs
+	Cluster full;
+	full.remote = { {1, 0.25}, {2, 0.1} };
+	if (full.Round(policy) != 0) {
+		fprintf(stderr, FMT_ERR("EXC offloaded to an overloaded node\n"));
+		return TEST_FAILED;
+	}
+	if (policy.CanHost(policy.LocalHeadroom(
+			full.free, full.ready, full.hosted))) {
+		fprintf(stderr, FMT_ERR("Remote EXC accepted by an overloaded node\n"));
+		return TEST_FAILED;
+	}
+
+	// The EXCs hosted for the other nodes count as local demand
+	Cluster idle;
+	idle.ready = 0;
+	idle.free  = 0.65;
+	uint32_t accepted = 0;
+	while (policy.CanHost(policy.LocalHeadroom(
+			idle.free, idle.ready, idle.hosted))) {
+		++idle.hosted;
+		++accepted;
+	}
+	fprintf(stderr, FMT_INF("Remote EXCs accepted by an idle node: %u\n"),
+		accepted);
+	if (accepted != 3) {
+		fprintf(stderr, FMT_ERR("Wrong number of remote EXCs accepted\n"));
+		return TEST_FAILED;
+	}
+
+	return TEST_PASSED;
+}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "bbque/pm/powercap_zones.h"
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "POWERCAP   [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "POWERCAP   [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "POWERCAP   [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "POWERCAP   [ERR]", fmt)
+
+// Counters range, and power limits of the fake zones
+#define POWERCAP_TEST_MAX_ENERGY_UJ  1000000000ULL
+#define POWERCAP_TEST_LIMIT_UW         65000000ULL
+#define POWERCAP_TEST_MAX_POWER_UW     95000000ULL
+
+using bbque::PowercapZones;
+
+// The fake sysfs tree
+static std::string sysfs_root;
+
+static const char * zone_dirs[] = {
+	"intel-rapl:0",
+	"intel-rapl:0:0",
+	"intel-rapl:0:1",
+	"intel-rapl:1",
+};
+
+static const char * zone_files[] = {
+	"name",
+	"energy_uj",
+	"max_energy_range_uj",
+	"constraint_0_power_limit_uw",
+	"constraint_0_max_power_uw",
+};
+
+static std::string ZonePath(std::string const & zone, std::string const & file) {
+	return sysfs_root + BBQUE_PM_POWERCAP_CLASS_DIR "/" + zone + "/" + file;
+}
+
+template<typename T>
+static void WriteZone(std::string const & zone, std::string const & file,
+		T const & value) {
+	std::ofstream(ZonePath(zone, file)) << value << "\n";
+}
+
+static uint64_t ReadLimit(std::string const & zone) {
+	uint64_t limit_uw = 0;
+	std::ifstream(ZonePath(zone, "constraint_0_power_limit_uw")) >> limit_uw;
+	return limit_uw;
+}
+
+static bool SetupFakePowercapFs() {
+	char root_tmpl[] = "/tmp/bbque_sysfs_XXXXXX";
+	if (!::mkdtemp(root_tmpl))
+		return false;
+	sysfs_root = root_tmpl;
+	::mkdir((sysfs_root + "/class").c_str(), 0755);
+	::mkdir((sysfs_root + BBQUE_PM_POWERCAP_CLASS_DIR).c_str(), 0755);
+
+	// Two packages, the first one with the "core" and "dram" sub-zones
+	const char * names[] = { "package-0", "core", "dram", "package-1" };
+	for (int i = 0; i < 4; ++i) {
+		std::string dir(sysfs_root + BBQUE_PM_POWERCAP_CLASS_DIR "/" +
+			zone_dirs[i]);
+		::mkdir(dir.c_str(), 0755);
+		WriteZone(zone_dirs[i], "name", names[i]);
+		WriteZone(zone_dirs[i], "energy_uj", 0);
+		WriteZone(zone_dirs[i], "max_energy_range_uj",
+			POWERCAP_TEST_MAX_ENERGY_UJ);
+		WriteZone(zone_dirs[i], "constraint_0_power_limit_uw",
+			POWERCAP_TEST_LIMIT_UW);
+		WriteZone(zone_dirs[i], "constraint_0_max_power_uw",
+			POWERCAP_TEST_MAX_POWER_UW);
+	}
+	// The first package is close to wrapping around
+	WriteZone(zone_dirs[0], "energy_uj", POWERCAP_TEST_MAX_ENERGY_UJ - 1000);
+	return true;
+}
+
+static void CleanupFakePowercapFs() {
+	for (auto zone: zone_dirs) {
+		for (auto file: zone_files)
+			::unlink(ZonePath(zone, file).c_str());
+		::rmdir((sysfs_root + BBQUE_PM_POWERCAP_CLASS_DIR "/" + zone).c_str());
+	}
+	::rmdir((sysfs_root + BBQUE_PM_POWERCAP_CLASS_DIR).c_str());
+	::rmdir((sysfs_root + "/class").c_str());
+	::rmdir(sysfs_root.c_str());
+}
+
+static TestResult_t CheckZones() {
+	PowercapZones pcz(sysfs_root);
+
+	// Discovery: the sub-zones belong to the package preceding them
+	if (pcz.Zones().size() != 4) {
+		fprintf(stderr, FMT_ERR("%lu zones found, 4 expected\n"),
+			pcz.Zones().size());
+		return TEST_FAILED;
+	}
+	auto pkg0(pcz.Select(0, false));
+	auto dram0(pcz.Select(0, true));
+	auto pkgs(pcz.Select(-1, false));
+	if ((pkg0.size() != 1) || (dram0.size() != 1) || (pkgs.size() != 2) ||
+			(pcz.Select(1, true).size() != 0)) {
+		fprintf(stderr, FMT_ERR("Wrong zones selection\n"));
+		return TEST_FAILED;
+	}
+
+	// Energy and power, with the first package wrapping around
+	WriteZone(zone_dirs[0], "energy_uj", 999);
+	WriteZone(zone_dirs[2], "energy_uj", 5000);
+	WriteZone(zone_dirs[3], "energy_uj", 10000);
+	std::this_thread::sleep_for(
+		std::chrono::milliseconds(2 * BBQUE_PM_POWERCAP_SAMPLE_MS));
+	pcz.Sample();
+	fprintf(stderr, FMT_INF("package-0: %lu uJ, %u mW\n"),
+		pkg0[0]->energy_uj, pkg0[0]->power_mw);
+	fprintf(stderr, FMT_INF("package-1: %lu uJ, %u mW\n"),
+		pkgs[1]->energy_uj, pkgs[1]->power_mw);
+	fprintf(stderr, FMT_INF("dram: %lu uJ, %u mW\n"),
+		dram0[0]->energy_uj, dram0[0]->power_mw);
+	if ((pkg0[0]->energy_uj != 2000) || (pkgs[1]->energy_uj != 10000) ||
+			(dram0[0]->energy_uj != 5000)) {
+		fprintf(stderr, FMT_ERR("Wrong energy values\n"));
+		return TEST_FAILED;
+	}
+	if ((pkgs[1]->power_mw == 0) ||
+			(pkgs[1]->power_mw > 10000 * 1e3 /
+				(2 * BBQUE_PM_POWERCAP_SAMPLE_MS * 1e3))) {
+		fprintf(stderr, FMT_ERR("Wrong power value\n"));
+		return TEST_FAILED;
+	}
+
+	// Too early for another sampling
+	WriteZone(zone_dirs[3], "energy_uj", 20000);
+	pcz.Sample();
+	if (pkgs[1]->energy_uj != 10000) {
+		fprintf(stderr, FMT_ERR("Sampling period not respected\n"));
+		return TEST_FAILED;
+	}
+
+	// Power limits
+	uint64_t max_uw;
+	if (!pcz.GetMaxPower(*pkg0[0], max_uw) ||
+			(max_uw != POWERCAP_TEST_MAX_POWER_UW)) {
+		fprintf(stderr, FMT_ERR("Wrong maximum power\n"));
+		return TEST_FAILED;
+	}
+	uint64_t limit_uw;
+	if (!pcz.SetLimit(*pkgs[1], 40000000) ||
+			!pcz.GetLimit(*pkgs[1], limit_uw) || (limit_uw != 40000000)) {
+		fprintf(stderr, FMT_ERR("Power limit not set\n"));
+		return TEST_FAILED;
+	}
+	return TEST_PASSED;
+}
+
+TestResult_t test_powercap(int, char *[]) {
+
+	fprintf(stderr, FMT_INF("Here is the powercap zones test\n"));
+
+	// Wrap around: the counter steps from the maximum value to 0
+	if ((PowercapZones::EnergyDelta(10, 10, 100) != 0) ||
+			(PowercapZones::EnergyDelta(100, 0, 100) != 1) ||
+			(PowercapZones::EnergyDelta(90, 9, 100) != 20)) {
+		fprintf(stderr, FMT_ERR("Wrong energy delta on wrap around\n"));
+		return TEST_FAILED;
+	}
+
+	if (!SetupFakePowercapFs()) {
+		fprintf(stderr, FMT_ERR("Fake sysfs tree setup failed\n"));
+		return TEST_FAILED;
+	}
+	TestResult_t result = CheckZones();
+
+	// The power limits are restored at the destruction
+	if ((result == TEST_PASSED) &&
+			(ReadLimit(zone_dirs[3]) != POWERCAP_TEST_LIMIT_UW)) {
+		fprintf(stderr, FMT_ERR("Power limit not restored\n"));
+		result = TEST_FAILED;
+	}
+
+	CleanupFakePowercapFs();
+	return result;
+}
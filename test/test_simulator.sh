@@ -0,0 +1,90 @@
+#!/bin/bash
+#
+# Smoke run of the Test Platform Proxy simulator
+#
+# A short scaling sweep on a synthetic platform, with the daemon exiting at
+# the end, then the checks of the CSV report: one row per step, with the
+# number of EXCs of the step and values in range.
+#
+# Usage: ./test_simulator.sh barbeque bbque.conf plugins_dir [work_dir]
+
+BBQUE_BIN=$1
+BBQUE_CONF=$2
+BBQUE_PLUGINS=$3
+WORK_DIR=${4:-$(mktemp -d /tmp/bbque_sim.XXXXXX)}
+
+SIM_STEPS="4,16,64"
+SIM_TIMEOUT=300
+
+function Fail {
+	echo "[FAILED] $1"
+	exit 1
+}
+
+[ -x "$BBQUE_BIN" ]     || Fail "$BBQUE_BIN is not an executable"
+[ -f "$BBQUE_CONF" ]    || Fail "$BBQUE_CONF is not a file"
+[ -d "$BBQUE_PLUGINS" ] || Fail "$BBQUE_PLUGINS is not a directory"
+mkdir -p $WORK_DIR
+
+# The sections appended after the existing ones extend them
+SIM_CONF=$WORK_DIR/bbque_sim.conf
+SIM_REPORT=$WORK_DIR/bbque_sim.csv
+rm -f $SIM_REPORT
+cp $BBQUE_CONF $SIM_CONF
+cat >> $SIM_CONF <<EOF
+
+[bbque]
+lockfile = $WORK_DIR/bbque.lock
+pidfile  = $WORK_DIR/bbque.pid
+rundir   = $WORK_DIR
+
+[Simulator]
+cpus      = 4
+pes       = 4
+excs      = $SIM_STEPS
+rounds    = 3
+seed      = 1
+report    = $SIM_REPORT
+exit      = true
+EOF
+
+echo "Simulation [$SIM_STEPS], report in <$SIM_REPORT>..."
+timeout $SIM_TIMEOUT $BBQUE_BIN -c $SIM_CONF -p $BBQUE_PLUGINS \
+	> $WORK_DIR/bbque_sim.log 2>&1
+RESULT=$?
+[ $RESULT -eq 124 ] && Fail "no exit after ${SIM_TIMEOUT}s"
+[ -f $SIM_REPORT ]  || Fail "no report [exit code $RESULT]"
+
+HEADER="policy,excs,sched_mean_us,sched_max_us,sync_mean_us,sync_max_us,running_pct,awm_value,cpu_usage_pct,rss_kb"
+[ "$(head -n 1 $SIM_REPORT)" == "$HEADER" ] || Fail "unexpected report header"
+
+tail -n +2 $SIM_REPORT | awk -F, -v steps="$SIM_STEPS" '
+	BEGIN { nr_steps = split(steps, excs, ",") }
+	{
+		++row
+		if ($2 != excs[row])
+			fail("step " row ": " $2 " EXCs instead of " excs[row])
+		if ($3 <= 0 || $4 < $3 || $5 < 0 || $6 < $5)
+			fail("step " row ": wrong latencies")
+		if ($7 < 0 || $7 > 100 || $9 < 0 || $9 > 100)
+			fail("step " row ": percentage out of range")
+		if ($7 > 0 && $8 <= 0)
+			fail("step " row ": EXCs running without AWM value")
+		if ($10 <= 0)
+			fail("step " row ": no resident memory")
+		printf "step %2d: %5d EXCs, sched %9.1f us, running %5.1f%%\n",
+			row, $2, $3, $7
+	}
+	END {
+		if (failed)
+			exit 1
+		if (row != nr_steps)
+			fail(row " report rows instead of " nr_steps)
+	}
+	function fail(msg) {
+		print "[FAILED] " msg
+		failed = 1
+		exit 1
+	}' || exit 1
+
+echo "[PASSED]"
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "bbque/app/schedulable.h"
+#include "bbque/resource_accounter.h"
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "SNAPSHOT   [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "SNAPSHOT   [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "SNAPSHOT   [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "SNAPSHOT   [ERR]", fmt)
+
+// Threads changing the state of the same EXC, and threads reading it
+#define SNAPSHOT_WRITERS     2
+#define SNAPSHOT_READERS     2
+// Duration of the state changes, READY -> SYNC -> READY each
+#define SNAPSHOT_TIME_MS  2000
+
+using bbque::app::Schedulable;
+
+namespace bbque {
+
+// The scheduling state is changed without working modes: the accounter,
+// used by Schedulable::Reshuffling() only, is never accessed
+ResourceAccounter & ResourceAccounter::GetInstance() {
+	static std::aligned_storage<sizeof(ResourceAccounter),
+		alignof(ResourceAccounter)>::type unused;
+	return *reinterpret_cast<ResourceAccounter *>(&unused);
+}
+
+bool ResourceAccounter::IsReshuffling(
+		br::ResourceAssignmentMapPtr_t const &,
+		br::ResourceAssignmentMapPtr_t const &) {
+	return false;
+}
+
+} // namespace bbque
+
+/**
+ * An EXC moving between READY and SYNC, as in a sequence of scheduling
+ * rounds not assigning any working mode
+ */
+class TestEXC: public Schedulable {
+
+public:
+
+	TestEXC() {
+		schedule.state = NEW;
+		schedule.preSyncState = NEW;
+		schedule.syncState = SYNC_NONE;
+		SetState(READY);
+	}
+
+	/** Enter a synchronization state, and go back to READY */
+	void Synchronize(SyncState_t sync) {
+		SetState(SYNC, sync);
+		SetState(READY);
+	}
+
+};
+
+/**
+ * The SetState() updates of a snapshot, all of which are done at once:
+ * - READY, with no synchronization pending, from SYNC;
+ * - SYNC, with a synchronization pending, from READY.
+ */
+static bool Consistent(Schedulable::SchedulingSnapshot_t const & snap) {
+	if (snap.Synching())
+		return (snap.preSyncState == Schedulable::READY) &&
+			(snap.syncState != Schedulable::SYNC_NONE) &&
+			(snap.syncState != Schedulable::DISABLED);
+	return (snap.state == Schedulable::READY) &&
+		(snap.preSyncState == Schedulable::SYNC) &&
+		(snap.syncState == Schedulable::SYNC_NONE) &&
+		snap.Active() && !snap.Starting() && !snap.Blocking();
+}
+
+TestResult_t test_snapshot(int, char *[]) {
+	TestEXC exc;
+	std::atomic<int> nr_writers(SNAPSHOT_WRITERS);
+	std::atomic<uint64_t> nr_changes(0);
+	std::atomic<uint64_t> nr_reads(0);
+	std::atomic<uint64_t> nr_torn(0);
+
+	fprintf(stderr, FMT_INF("Here is the scheduling snapshot test\n"));
+
+	// Start from a SYNC -> READY change, as the snapshots checked
+	exc.Synchronize(Schedulable::STARTING);
+
+	auto end = std::chrono::steady_clock::now() +
+		std::chrono::milliseconds(SNAPSHOT_TIME_MS);
+	std::vector<std::thread> threads;
+	for (int w = 0; w < SNAPSHOT_WRITERS; ++w) {
+		threads.emplace_back([&, w]() {
+			uint64_t changes = 0;
+			do {
+				exc.Synchronize((Schedulable::SyncState_t)
+					((w + changes) % Schedulable::DISABLED));
+				++changes;
+			} while (std::chrono::steady_clock::now() < end);
+			nr_changes += changes;
+			--nr_writers;
+		});
+	}
+	for (int r = 0; r < SNAPSHOT_READERS; ++r) {
+		threads.emplace_back([&]() {
+			uint64_t reads = 0;
+			uint64_t torn = 0;
+			do {
+				if (!Consistent(exc.GetSchedulingSnapshot()))
+					++torn;
+				++reads;
+			} while (nr_writers > 0);
+			nr_reads += reads;
+			nr_torn  += torn;
+		});
+	}
+	for (auto & thr: threads)
+		thr.join();
+
+	fprintf(stderr, FMT_INF("State changes: %lu, snapshots read: %lu, "
+		"torn: %lu\n"), nr_changes.load(), nr_reads.load(), nr_torn.load());
+	if (nr_torn > 0) {
+		fprintf(stderr, FMT_ERR("Torn scheduling snapshots\n"));
+		return TEST_FAILED;
+	}
+
+	// The accessors read the same snapshot
+	if (!exc.Active() || exc.Synching() ||
+			(exc.SyncState() != Schedulable::SYNC_NONE) ||
+			(exc.PreSyncState() != Schedulable::SYNC)) {
+		fprintf(stderr, FMT_ERR("Wrong final state [%s, %s]\n"),
+			Schedulable::StateStr(exc.State()),
+			Schedulable::SyncStateStr(exc.SyncState()));
+		return TEST_FAILED;
+	}
+
+	return TEST_PASSED;
+}
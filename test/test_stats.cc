@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2019  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include "bbque/utils/stats.h"
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "STATS      [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "STATS      [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "STATS      [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "STATS      [ERR]", fmt)
+
+// Observations per distribution
+#define STATS_SAMPLES 20000
+// Maximum estimation error, as a fraction of the inter-percentile range
+// [p1, p99.9] of the samples
+#define STATS_MAX_ERROR 0.03
+
+using bbque::utils::QuantileStats;
+
+// The exact quantile of a sorted sample set
+static double Exact(std::vector<double> const & sorted, double p) {
+	return sorted[static_cast<size_t>(std::round(p * (sorted.size() - 1)))];
+}
+
+static bool CheckDistribution(char const * name,
+		std::function<double()> sample) {
+	QuantileStats qs;
+	std::vector<double> values;
+	for (int i = 0; i < STATS_SAMPLES; ++i) {
+		values.push_back(sample());
+		qs.InsertValue(values.back());
+	}
+	std::sort(values.begin(), values.end());
+	double range = Exact(values, 0.999) - Exact(values, 0.01);
+
+	double const ps[] = { 0.50, 0.95, 0.99 };
+	double const est[] = { qs.GetP50(), qs.GetP95(), qs.GetP99() };
+	for (int i = 0; i < 3; ++i) {
+		double exact = Exact(values, ps[i]);
+		double error = std::abs(est[i] - exact) / range;
+		fprintf(stderr, FMT_DBG("%-11s p%02.0f: %9.4f, exact %9.4f "
+			"[error %.2f%%]\n"), name, 100 * ps[i], est[i], exact,
+			100 * error);
+		if (error > STATS_MAX_ERROR) {
+			fprintf(stderr, FMT_ERR("%s: p%02.0f estimation error %.2f%%\n"),
+				name, 100 * ps[i], 100 * error);
+			return false;
+		}
+	}
+	return qs.GetCount() == STATS_SAMPLES;
+}
+
+TestResult_t test_stats(int, char *[]) {
+	std::mt19937 rng(2019);
+
+	fprintf(stderr, FMT_INF("Here is the streaming quantiles test\n"));
+
+	// Less than five observations: exact quantiles of the samples
+	QuantileStats few;
+	few.InsertValue(3);
+	few.InsertValue(1);
+	few.InsertValue(2);
+	if ((few.GetP50() != 2) || (few.GetP99() != 3)) {
+		fprintf(stderr, FMT_ERR("Wrong quantiles of three samples\n"));
+		return TEST_FAILED;
+	}
+	few.Reset();
+	if ((few.GetCount() != 0) || (few.GetP95() != 0)) {
+		fprintf(stderr, FMT_ERR("Quantiles not reset\n"));
+		return TEST_FAILED;
+	}
+
+	// Known distributions, symmetric and (heavy) tailed, as the cycle
+	// times usually are
+	std::uniform_real_distribution<double> uniform(10.0, 20.0);
+	std::normal_distribution<double> normal(100.0, 15.0);
+	std::exponential_distribution<double> exponential(0.1);
+	std::lognormal_distribution<double> lognormal(3.0, 0.6);
+	if (!CheckDistribution("uniform", [&]() { return uniform(rng); }) ||
+			!CheckDistribution("normal", [&]() { return normal(rng); }) ||
+			!CheckDistribution("exponential",
+				[&]() { return exponential(rng); }) ||
+			!CheckDistribution("lognormal", [&]() { return lognormal(rng); }))
+		return TEST_FAILED;
+
+	// Sorted input, as a monotonically growing cycle time
+	int next = 0;
+	if (!CheckDistribution("ascending", [&]() { return next++; }))
+		return TEST_FAILED;
+
+	return TEST_PASSED;
+}
@@ -31,39 +31,16 @@
 #include <sys/syscall.h>
 
 #include <bbque/utils/timer.h>
+#include <bbque/utils/utility.h>
 #include <bbque/rtlib/bbque_exc.h>
 
-// Console colors definition
-#define COLOR_WHITE  "\033[1;37m"
-#define COLOR_LGRAY  "\033[37m"
-#define COLOR_GRAY   "\033[1;30m"
-#define COLOR_BLACK  "\033[30m"
-#define COLOR_RED    "\033[31m"
-#define COLOR_LRED   "\033[1;31m"
-#define COLOR_GREEN  "\033[32m"
-#define COLOR_LGREEN "\033[1;32m"
-#define COLOR_BROWN  "\033[33m"
-#define COLOR_YELLOW "\033[1;33m"
-#define COLOR_BLUE   "\033[34m"
-#define COLOR_LBLUE  "\033[1;34m"
-#define COLOR_PURPLE "\033[35m"
-#define COLOR_PINK   "\033[1;35m"
-#define COLOR_CYAN   "\033[36m"
-#define COLOR_LCYAN  "\033[1;36m"
-
-// Generic console logging message
+// Generic console logging message, replacing the modules one
+#undef BBQUE_FMT
 # define BBQUE_FMT(color, module, fmt) \
 	        color "[%05d - %11.6f] " module ": " fmt "\033[0m", \
 			gettid(),\
 			test_tmr.getElapsedTime()
 
-// Generic code block comment on DEBUG compilation
-#ifdef BBQUE_DEBUG
-# define DB(x) x
-#else
-# define DB(x)
-#endif
-
 using bbque::rtlib::BbqueEXC;
 
 /**
@@ -105,11 +82,4 @@ extern std::mt19937 rng_engine;
  */
 extern bbque::utils::Timer test_tmr;
 
-/**
- * Return the PID of the calling process/thread
- */
-inline pid_t gettid() {
-	        return syscall(SYS_gettid);
-}
-
 #endif // BBQUE_TESTS_H_